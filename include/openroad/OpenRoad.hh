@@ -162,17 +162,26 @@ public:
   // Return true if the command units have been initialized.
   bool unitsInitialized();
 
+  // cache_dir keeps binary copies of the tech and library read from
+  // the file so reading it again skips the LEF parser (null disables).
   void readLef(const char *filename,
 	       const char *lib_name,
 	       bool make_tech,
-	       bool make_library);
+	       bool make_library,
+	       const char *cache_dir = nullptr);
 
+  // num_threads parses the net sections of the file in parallel
+  // (0 uses all hardware threads).
   void readDef(const char *filename,
                bool order_wires,
-               bool continue_on_errors);
+               bool continue_on_errors,
+               int num_threads = 1);
+  // num_threads formats the components and nets in parallel
+  // (0 uses all hardware threads).
   void writeDef(const char *filename,
 		// major.minor (avoid including defout.h)
-		string version);
+		string version,
+		int num_threads = 1);
   
   void writeCdl(const char *filename, bool includeFillers);
 
@@ -184,8 +193,28 @@ public:
 		    std::vector<sta::LibertyCell*> *remove_cells);
   void linkDesign(const char *top_cell_name);
 
-  void readDb(const char *filename);
-  void writeDb(const char *filename);
+  // profile is all, no_parasitics or placement (see dbDatabase::LoadProfile).
+  void readDb(const char *filename,
+              const char *profile);
+  // Apply a delta written by writeDbDelta to the block read from its base.
+  void readDbDelta(const char *filename);
+  // A base db starts recording block edits for delta checkpoints.
+  void writeDb(const char *filename,
+               bool compress,
+               bool base);
+  // Write the block edits recorded since the last base db was written.
+  void writeDbDelta(const char *filename);
+  // Fold a delta into its base in a scratch database and write the result
+  // to new_base_filename. The session database is not touched.
+  void compactDb(const char *base_filename,
+                 const char *delta_filename,
+                 const char *new_base_filename,
+                 bool compress);
+
+  // Report the memory held by the db tables of every block and the
+  // resident set size with its change since the previous report.
+  // With a json_filename the same data is also written there as JSON.
+  void reportDbMemory(const char *json_filename);
 
   // Observer interface
   class Observer
@@ -234,6 +263,8 @@ private:
   par::PartitionMgr *partitionMgr_;
 
   std::set<Observer *> observers_;
+  // Resident set size (bytes) at the previous reportDbMemory.
+  size_t last_rss_;
 };
 
 // Return the bounding box of the db rows.
@@ -0,0 +1,5 @@
+#!/bin/bash
+set -x
+set -e
+cmake -DCMAKE_BUILD_TYPE=RelWithDebInfo -DTHREAD_SANITIZER=ON -B build .
+time cmake --build build -j 8
@@ -0,0 +1,11 @@
+#!/bin/bash
+# The OpenDB unit tests, which cover the concurrent read mode of dbBlock,
+# fail on the first data race.
+set -x
+set -e
+export TSAN_OPTIONS="halt_on_error=1"
+cd src/OpenDB/tests
+for test in ../../../build/src/OpenDB/tests/cpp/Test*
+do
+    BASE_DIR=$(pwd) $test
+done
@@ -63,6 +63,14 @@ struct GSegment
   }
 };
 
+// Guide for the detailed router: a box of a net route in DBU on a routing
+// layer, as written to the guide file.
+struct GGuide
+{
+  int layer;
+  odb::Rect box;
+};
+
 class GCellCongestion
 {
  public:
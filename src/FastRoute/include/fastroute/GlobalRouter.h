@@ -82,6 +82,7 @@ class RoutingLayer;
 class SteinerTree;
 class RoutePt;
 class GrouteRenderer;
+class GRouteDbCbk;
 
 
 struct RegionAdjustment
@@ -184,12 +185,15 @@ class GlobalRouter
   void setGridOrigin(long x, long y);
   void setPDRevForHighFanout(int pdRevForHighFanout);
   void setAllowOverflow(bool allowOverflow);
+  void setThreads(int threads);
   void setReportCongestion(char* congestFile);
   void setMacroExtension(int macroExtension);
   void printGrid();
 
   // flow functions
   void writeGuides(const char* fileName);
+  // Guides of the net route, in the order of the guide file.
+  void getGuides(odb::dbNet* db_net, std::vector<GGuide>& guides);
   void startFastRoute();
   void estimateRC();
   void runFastRoute(bool onlySignal);
@@ -200,6 +204,12 @@ class GlobalRouter
   void repairAntennas(sta::LibertyPort* diodePort);
   void addDirtyNet(odb::dbNet* net);
 
+  // incremental global routing functions
+  void startIncremental();
+  void endIncremental();
+  void removeNet(odb::dbNet* db_net);
+  void rollbackIncremental();
+
   // congestion drive replace functions
   ROUTE_ getRoute();
 
@@ -262,6 +272,9 @@ class GlobalRouter
   void addRemainingGuides(NetRouteMap& routes, std::vector<Net*>& nets);
   void connectPadPins(NetRouteMap& routes);
   void mergeBox(std::vector<odb::Rect>& guideBox);
+  void addGuides(std::vector<odb::Rect>& guideBox,
+                 int layer,
+                 std::vector<GGuide>& guides);
   odb::Rect globalRoutingToBox(const GSegment& route);
   bool segmentsConnect(const GSegment& seg0,
                        const GSegment& seg1,
@@ -286,8 +299,16 @@ class GlobalRouter
   void getPreviousCapacities(int previousMinLayer, int previousMaxLayer);
   void restorePreviousCapacities(int previousMinLayer, int previousMaxLayer);
   void removeDirtyNetsUsage();
+  void removeRouteUsage(GRoute& route, const char* netName);
+  bool segmentGCells(const GSegment& segment,
+                     odb::Point& lower,
+                     odb::Point& upper);
   void updateDirtyNets();
 
+  // incremental functions
+  void addNewDirtyNets();
+  void addOverflowNets();
+
   // db functions
   void initGrid(int maxLayer);
   void initRoutingLayers(std::vector<RoutingLayer>& routingLayers);
@@ -344,6 +365,7 @@ class GlobalRouter
   int _overflowIterations;
   int _pdRevForHighFanout;
   bool _allowOverflow;
+  int _threads;
   bool _reportCongest;
   std::vector<int> _vCapacities;
   std::vector<int> _hCapacities;
@@ -385,6 +407,11 @@ class GlobalRouter
   odb::dbBlock* _block;
 
   std::set<odb::dbNet*> _dirtyNets;
+
+  // Incremental routing variables
+  GRouteDbCbk* _dbCbk = nullptr;
+  // routes of the nets destroyed since startIncremental, with the net names
+  std::vector<std::pair<std::string, GRoute>> _removedRoutes;
 };
 
 std::string getITermName(odb::dbITerm* iterm);
@@ -0,0 +1,100 @@
+/////////////////////////////////////////////////////////////////////////////
+//
+// BSD 3-Clause License
+//
+// Copyright (c) 2019, University of California, San Diego.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "GRouteDbCbk.h"
+
+#include "fastroute/GlobalRouter.h"
+
+namespace grt {
+
+GRouteDbCbk::GRouteDbCbk(GlobalRouter* grouter) : _grouter(grouter)
+{
+}
+
+void GRouteDbCbk::inDbPostMoveInst(odb::dbInst* inst)
+{
+  instItermsDirty(inst);
+}
+
+void GRouteDbCbk::inDbInstSwapMasterAfter(odb::dbInst* inst)
+{
+  instItermsDirty(inst);
+}
+
+void GRouteDbCbk::inDbNetCreate(odb::dbNet* net)
+{
+  _grouter->addDirtyNet(net);
+}
+
+void GRouteDbCbk::inDbNetDestroy(odb::dbNet* net)
+{
+  _grouter->removeNet(net);
+}
+
+void GRouteDbCbk::inDbITermPostConnect(odb::dbITerm* iterm)
+{
+  _grouter->addDirtyNet(iterm->getNet());
+}
+
+void GRouteDbCbk::inDbITermPostDisconnect(odb::dbITerm*, odb::dbNet* net)
+{
+  _grouter->addDirtyNet(net);
+}
+
+void GRouteDbCbk::inDbBTermPostConnect(odb::dbBTerm* bterm)
+{
+  _grouter->addDirtyNet(bterm->getNet());
+}
+
+void GRouteDbCbk::inDbBTermPostDisConnect(odb::dbBTerm*, odb::dbNet* net)
+{
+  _grouter->addDirtyNet(net);
+}
+
+void GRouteDbCbk::inDbBlockRollback(odb::dbBlock*)
+{
+  _grouter->rollbackIncremental();
+}
+
+void GRouteDbCbk::instItermsDirty(odb::dbInst* inst)
+{
+  for (odb::dbITerm* iterm : inst->getITerms()) {
+    if (iterm->getNet() != nullptr) {
+      _grouter->addDirtyNet(iterm->getNet());
+    }
+  }
+}
+
+}  // namespace grt
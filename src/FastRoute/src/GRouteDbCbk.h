@@ -0,0 +1,72 @@
+/////////////////////////////////////////////////////////////////////////////
+//
+// BSD 3-Clause License
+//
+// Copyright (c) 2019, University of California, San Diego.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "opendb/db.h"
+#include "opendb/dbBlockCallBackObj.h"
+
+namespace grt {
+
+class GlobalRouter;
+
+// Marks the nets touched by netlist and placement changes as dirty while
+// global routing is incremental (global_route -start_incremental).
+class GRouteDbCbk : public odb::dbBlockCallBackObj
+{
+ public:
+  GRouteDbCbk(GlobalRouter* grouter);
+
+  virtual void inDbPostMoveInst(odb::dbInst* inst);
+  virtual void inDbInstSwapMasterAfter(odb::dbInst* inst);
+
+  virtual void inDbNetCreate(odb::dbNet* net);
+  virtual void inDbNetDestroy(odb::dbNet* net);
+
+  virtual void inDbITermPostConnect(odb::dbITerm* iterm);
+  virtual void inDbITermPostDisconnect(odb::dbITerm* iterm, odb::dbNet* net);
+
+  virtual void inDbBTermPostConnect(odb::dbBTerm* bterm);
+  virtual void inDbBTermPostDisConnect(odb::dbBTerm* bterm, odb::dbNet* net);
+
+  virtual void inDbBlockRollback(odb::dbBlock* block);
+
+ private:
+  void instItermsDirty(odb::dbInst* inst);
+
+  GlobalRouter* _grouter;
+};
+
+}  // namespace grt
@@ -49,6 +49,7 @@
 
 #include "AntennaRepair.h"
 #include "FastRoute.h"
+#include "GRouteDbCbk.h"
 #include "Grid.h"
 #include "RcTreeBuilder.h"
 #include "RoutingLayer.h"
@@ -90,6 +91,7 @@ void GlobalRouter::init()
   _overflowIterations = 50;
   _pdRevForHighFanout = -1;
   _allowOverflow = false;
+  _threads = 1;
   _seed = 0;
   _reportCongest = false;
 
@@ -142,6 +144,7 @@ void GlobalRouter::clearFlow()
 GlobalRouter::~GlobalRouter()
 {
   deleteComponents();
+  delete _dbCbk;
 }
 
 void GlobalRouter::startFastRoute()
@@ -172,6 +175,7 @@ void GlobalRouter::startFastRoute()
   _fastRoute->setOverflowIterations(_overflowIterations);
   _fastRoute->setPDRevForHighFanout(_pdRevForHighFanout);
   _fastRoute->setAllowOverflow(_allowOverflow);
+  _fastRoute->setThreads(_threads);
 
   _logger->report("Min routing layer: {}", _minRoutingLayer);
   _logger->report("Max routing layer: {}", _maxRoutingLayer);
@@ -464,75 +468,89 @@ void GlobalRouter::restorePreviousCapacities(int previousMinLayer,
 void GlobalRouter::removeDirtyNetsUsage()
 {
   for (odb::dbNet* db_net : _dirtyNets) {
-    GRoute& netRoute = _routes[db_net];
-    int segsCnt = 0;
-    for (GSegment& segment : netRoute) {
-      if (!(segment.initLayer != segment.finalLayer
-            || (segment.initX == segment.finalX
-                && segment.initY == segment.finalY))) {
-        odb::Point initOnGrid = _grid->getPositionOnGrid(
-            odb::Point(segment.initX, segment.initY));
-        odb::Point finalOnGrid = _grid->getPositionOnGrid(
-            odb::Point(segment.finalX, segment.finalY));
-
-        if (initOnGrid.y() == finalOnGrid.y()) {
-          int minX = (initOnGrid.x() <= finalOnGrid.x()) ? initOnGrid.x()
-                                                         : finalOnGrid.x();
-          int maxX = (initOnGrid.x() > finalOnGrid.x()) ? initOnGrid.x()
-                                                        : finalOnGrid.x();
-
-          minX = (minX - (_grid->getTileWidth() / 2)) / _grid->getTileWidth();
-          maxX = (maxX - (_grid->getTileWidth() / 2)) / _grid->getTileWidth();
-          int y = (initOnGrid.y() - (_grid->getTileHeight() / 2))
-                  / _grid->getTileHeight();
-
-          for (int x = minX; x < maxX; x++) {
-            int newCap
-                = _fastRoute->getEdgeCurrentResource(
-                      x, y, segment.initLayer, x + 1, y, segment.initLayer)
-                  + 1;
-            _fastRoute->addAdjustment(x,
-                                      y,
-                                      segment.initLayer,
-                                      x + 1,
-                                      y,
-                                      segment.initLayer,
-                                      newCap,
-                                      false);
-          }
-        } else if (initOnGrid.x() == finalOnGrid.x()) {
-          int minY = (initOnGrid.y() <= finalOnGrid.y()) ? initOnGrid.y()
-                                                         : finalOnGrid.y();
-          int maxY = (initOnGrid.y() > finalOnGrid.y()) ? initOnGrid.y()
-                                                        : finalOnGrid.y();
-
-          minY = (minY - (_grid->getTileHeight() / 2)) / _grid->getTileHeight();
-          maxY = (maxY - (_grid->getTileHeight() / 2)) / _grid->getTileHeight();
-          int x = (initOnGrid.x() - (_grid->getTileWidth() / 2))
-                  / _grid->getTileWidth();
-
-          for (int y = minY; y < maxY; y++) {
-            int newCap
-                = _fastRoute->getEdgeCurrentResource(
-                      x, y, segment.initLayer, x, y + 1, segment.initLayer)
-                  + 1;
-            _fastRoute->addAdjustment(x,
-                                      y,
-                                      segment.initLayer,
-                                      x,
-                                      y + 1,
-                                      segment.initLayer,
-                                      newCap,
-                                      false);
-          }
-        } else {
-          _logger->error(GRT, 70, "Invalid segment for net {}.", db_net->getConstName());
-        }
+    removeRouteUsage(_routes[db_net], db_net->getConstName());
+  }
+  for (auto& removed_route : _removedRoutes) {
+    removeRouteUsage(removed_route.second, removed_route.first.c_str());
+  }
+}
+
+void GlobalRouter::removeRouteUsage(GRoute& route, const char* netName)
+{
+  for (GSegment& segment : route) {
+    odb::Point lower, upper;
+    if (!segmentGCells(segment, lower, upper)) {
+      continue;
+    }
+
+    if (lower.y() == upper.y()) {
+      int y = lower.y();
+      for (int x = lower.x(); x < upper.x(); x++) {
+        int newCap = _fastRoute->getEdgeCurrentResource(
+                         x, y, segment.initLayer, x + 1, y, segment.initLayer)
+                     + 1;
+        _fastRoute->addAdjustment(x,
+                                  y,
+                                  segment.initLayer,
+                                  x + 1,
+                                  y,
+                                  segment.initLayer,
+                                  newCap,
+                                  false);
       }
+    } else if (lower.x() == upper.x()) {
+      int x = lower.x();
+      for (int y = lower.y(); y < upper.y(); y++) {
+        int newCap = _fastRoute->getEdgeCurrentResource(
+                         x, y, segment.initLayer, x, y + 1, segment.initLayer)
+                     + 1;
+        _fastRoute->addAdjustment(x,
+                                  y,
+                                  segment.initLayer,
+                                  x,
+                                  y + 1,
+                                  segment.initLayer,
+                                  newCap,
+                                  false);
+      }
+    } else {
+      _logger->error(GRT, 70, "Invalid segment for net {}.", netName);
     }
   }
 }
 
+// GCells at the ends of a wire segment, lower and upper sorted on both axes.
+// Returns false for vias and segments without length, which use no edge.
+bool GlobalRouter::segmentGCells(const GSegment& segment,
+                                 odb::Point& lower,
+                                 odb::Point& upper)
+{
+  if (segment.initLayer != segment.finalLayer
+      || (segment.initX == segment.finalX
+          && segment.initY == segment.finalY)) {
+    return false;
+  }
+
+  odb::Point initOnGrid
+      = _grid->getPositionOnGrid(odb::Point(segment.initX, segment.initY));
+  odb::Point finalOnGrid
+      = _grid->getPositionOnGrid(odb::Point(segment.finalX, segment.finalY));
+
+  int tileWidth = _grid->getTileWidth();
+  int tileHeight = _grid->getTileHeight();
+  int minX = std::min(initOnGrid.x(), finalOnGrid.x());
+  int maxX = std::max(initOnGrid.x(), finalOnGrid.x());
+  int minY = std::min(initOnGrid.y(), finalOnGrid.y());
+  int maxY = std::max(initOnGrid.y(), finalOnGrid.y());
+
+  lower = odb::Point((minX - (tileWidth / 2)) / tileWidth,
+                     (minY - (tileHeight / 2)) / tileHeight);
+  upper = odb::Point((maxX - (tileWidth / 2)) / tileWidth,
+                     (maxY - (tileHeight / 2)) / tileHeight);
+
+  return true;
+}
+
 void GlobalRouter::updateDirtyNets()
 {
   for (odb::dbNet* db_net : _dirtyNets) {
@@ -544,6 +562,194 @@ void GlobalRouter::updateDirtyNets()
   }
 }
 
+void GlobalRouter::startIncremental()
+{
+  if (!haveRoutes()) {
+    _logger->error(GRT, 209, "Incremental global routing needs a previous global routing.");
+  }
+  if (_dbCbk == nullptr) {
+    _dbCbk = new GRouteDbCbk(this);
+  }
+  _dirtyNets.clear();
+  _removedRoutes.clear();
+  _dbCbk->addOwner(_block);
+}
+
+void GlobalRouter::endIncremental()
+{
+  if (_dbCbk == nullptr || !_dbCbk->hasOwner()) {
+    _logger->error(GRT, 210, "global_route -end_incremental without -start_incremental.");
+  }
+  _dbCbk->removeOwner();
+
+  // Resources left by the previous routing, before the grid is rebuilt
+  getPreviousCapacities(_minRoutingLayer, _maxRoutingLayer);
+  addOverflowNets();
+
+  clearFlow();
+  startFastRoute();
+  addNewDirtyNets();
+  updateDirtyNets();
+  std::vector<Net*> dirtyNets;
+  getNetsByType(NetType::Antenna, dirtyNets);
+  initializeNets(dirtyNets);
+  applyAdjustments();
+  _logger->info(GRT, 211, "#Nets to reroute: {}.", dirtyNets.size());
+
+  // The other nets keep their routes and the grid usage of the previous
+  // routing, without the usage of the nets rerouted or destroyed.
+  restorePreviousCapacities(_minRoutingLayer, _maxRoutingLayer);
+  removeDirtyNetsUsage();
+
+  for (odb::dbNet* db_net : _dirtyNets) {
+    _routes.erase(db_net);
+  }
+  NetRouteMap newRoute = findRouting(dirtyNets);
+  mergeResults(newRoute);
+
+  _dirtyNets.clear();
+  _removedRoutes.clear();
+
+  computeWirelength();
+}
+
+void GlobalRouter::removeNet(odb::dbNet* db_net)
+{
+  _dirtyNets.erase(db_net);
+
+  auto route = _routes.find(db_net);
+  if (route != _routes.end()) {
+    _removedRoutes.push_back({db_net->getName(), route->second});
+    _routes.erase(route);
+  }
+
+  auto net = _db_net_map.find(db_net);
+  if (net != _db_net_map.end()) {
+    // The last net takes the place of the removed one so the pointers to
+    // the other nets stay valid.
+    Net* removedNet = net->second;
+    _db_net_map.erase(net);
+    if (removedNet != &_nets->back()) {
+      *removedNet = _nets->back();
+      _db_net_map[removedNet->getDbNet()] = removedNet;
+    }
+    _nets->pop_back();
+  }
+}
+
+// A dbBlockSnapshot rollback restores the block without the net callbacks,
+// so any net may have been destroyed or created again. The routes of the
+// nets that are gone are dropped and every net is rerouted.
+void GlobalRouter::rollbackIncremental()
+{
+  std::set<odb::dbNet*> nets;
+  for (odb::dbNet* db_net : _block->getNets()) {
+    nets.insert(db_net);
+  }
+
+  // The pointers of the nets that are gone are stale and not dereferenced.
+  for (auto route = _routes.begin(); route != _routes.end();) {
+    if (nets.find(route->first) == nets.end()) {
+      _removedRoutes.push_back({"", route->second});
+      route = _routes.erase(route);
+    } else {
+      ++route;
+    }
+  }
+  _nets->erase(std::remove_if(_nets->begin(),
+                              _nets->end(),
+                              [&](const Net& net) {
+                                return nets.find(net.getDbNet()) == nets.end();
+                              }),
+               _nets->end());
+  _db_net_map.clear();
+  for (Net& net : *_nets) {
+    _db_net_map[net.getDbNet()] = &net;
+  }
+
+  _dirtyNets = nets;
+}
+
+// Adds the dirty nets created since startIncremental to the netlist.
+void GlobalRouter::addNewDirtyNets()
+{
+  std::set<odb::dbNet*> newNets;
+  for (odb::dbNet* db_net : _dirtyNets) {
+    if (_db_net_map.find(db_net) == _db_net_map.end()) {
+      newNets.insert(db_net);
+    }
+  }
+  if (newNets.empty()) {
+    return;
+  }
+
+  addNets(newNets);
+  // _nets may have grown past its capacity, moving the nets
+  for (Net& net : *_nets) {
+    _db_net_map[net.getDbNet()] = &net;
+  }
+  // Power and special nets are not routed
+  for (odb::dbNet* db_net : newNets) {
+    if (_db_net_map.find(db_net) == _db_net_map.end()) {
+      _dirtyNets.erase(db_net);
+    }
+  }
+}
+
+// Nets crossing an edge without resources left in the previous routing are
+// rerouted with the dirty nets, so their congestion is also repaired.
+void GlobalRouter::addOverflowNets()
+{
+  // getPreviousCapacities has no usage for the edges along the last row and
+  // column of the grid, so those edges are not checked.
+  int xGrids = _grid->getXGrids();
+  int yGrids = _grid->getYGrids();
+
+  std::vector<odb::dbNet*> overflowNets;
+  for (auto& net_route : _routes) {
+    odb::dbNet* db_net = net_route.first;
+    if (_dirtyNets.find(db_net) != _dirtyNets.end()
+        || db_net->getSigType() == odb::dbSigType::CLOCK) {
+      continue;
+    }
+
+    for (GSegment& segment : net_route.second) {
+      odb::Point lower, upper;
+      int layer = segment.initLayer;
+      if (layer < _minRoutingLayer || layer > _maxRoutingLayer
+          || !segmentGCells(segment, lower, upper)) {
+        continue;
+      }
+
+      bool overflow = false;
+      if (lower.y() == upper.y()) {
+        if (lower.y() < 0 || lower.y() >= yGrids - 1) {
+          continue;
+        }
+        int maxX = std::min(upper.x(), xGrids - 1);
+        for (int x = std::max(lower.x(), 0); x < maxX && !overflow; x++) {
+          overflow = oldHUsages[layer - 1][lower.y()][x] < 0;
+        }
+      } else if (lower.x() == upper.x()) {
+        if (lower.x() < 0 || lower.x() >= xGrids - 1) {
+          continue;
+        }
+        int maxY = std::min(upper.y(), yGrids - 1);
+        for (int y = std::max(lower.y(), 0); y < maxY && !overflow; y++) {
+          overflow = oldVUsages[layer - 1][lower.x()][y] < 0;
+        }
+      }
+
+      if (overflow) {
+        overflowNets.push_back(db_net);
+        break;
+      }
+    }
+  }
+
+  _dirtyNets.insert(overflowNets.begin(), overflowNets.end());
+}
+
 void GlobalRouter::setSpacingsAndMinWidths()
 {
   for (int l = 1; l <= _grid->getNumLayers(); l++) {
@@ -1269,6 +1475,11 @@ void GlobalRouter::setAllowOverflow(bool allowOverflow)
   _allowOverflow = allowOverflow;
 }
 
+void GlobalRouter::setThreads(int threads)
+{
+  _threads = threads;
+}
+
 void GlobalRouter::setReportCongestion(char* congestFile)
 {
   _reportCongest = true;
@@ -1288,13 +1499,8 @@ void GlobalRouter::writeGuides(const char* fileName)
     guideFile.close();
     _logger->error(GRT, 73, "Guides file could not be opened.");
   }
-  RoutingLayer phLayerF;
-
-  int offsetX = _gridOrigin->x();
-  int offsetY = _gridOrigin->y();
 
   _logger->info(GRT, 14, "Num routed nets: {}", _routes.size());
-  int finalLayer;
 
   // Sort nets so guide file net order is consistent.
   std::vector<odb::dbNet*> sorted_nets;
@@ -1306,87 +1512,95 @@ void GlobalRouter::writeGuides(const char* fileName)
               return strcmp(net1->getConstName(), net2->getConstName()) < 0;
             });
 
+  std::vector<GGuide> guides;
   for (odb::dbNet* db_net : sorted_nets) {
-    GRoute& route = _routes[db_net];
-    if (!route.empty()) {
+    getGuides(db_net, guides);
+    if (!guides.empty()) {
       guideFile << db_net->getConstName() << "\n";
       guideFile << "(\n";
-      std::vector<odb::Rect> guideBox;
-      finalLayer = -1;
-      for (GSegment& segment : route) {
-        if (segment.initLayer != finalLayer && finalLayer != -1) {
-          mergeBox(guideBox);
-          for (odb::Rect& guide : guideBox) {
-            guideFile << guide.xMin() + offsetX << " " << guide.yMin() + offsetY
-                      << " " << guide.xMax() + offsetX << " "
-                      << guide.yMax() + offsetY << " " << phLayerF.getName()
-                      << "\n";
-          }
-          guideBox.clear();
-          finalLayer = segment.initLayer;
-        }
-        if (segment.initLayer == segment.finalLayer) {
-          if (segment.initLayer < _minRoutingLayer
-              && segment.initX != segment.finalX
-              && segment.initY != segment.finalY) {
-            _logger->error(GRT, 74, "Routing with guides in blocked metal for net {}.",
-                  db_net->getConstName());
-          }
+      for (GGuide& guide : guides) {
+        const odb::Rect& box = guide.box;
+        guideFile << box.xMin() << " " << box.yMin() << " " << box.xMax()
+                  << " " << box.yMax() << " "
+                  << getRoutingLayerByIndex(guide.layer).getName() << "\n";
+      }
+      guideFile << ")\n";
+    }
+  }
 
-          guideBox.push_back(globalRoutingToBox(segment));
-          if (segment.finalLayer < _minRoutingLayer && !_unidirectionalRoute) {
-            phLayerF = getRoutingLayerByIndex(
-                (segment.finalLayer + (_minRoutingLayer - segment.finalLayer)));
-          } else {
-            phLayerF = getRoutingLayerByIndex(segment.finalLayer);
-          }
-          finalLayer = segment.finalLayer;
-        } else {
-          if (abs(segment.finalLayer - segment.initLayer) > 1) {
-            _logger->error(GRT, 75, "Connection between non-adjacent layers in net {}.",
-                  db_net->getConstName());
-          } else {
-            RoutingLayer phLayerI;
-            if (segment.initLayer < _minRoutingLayer && !_unidirectionalRoute) {
-              phLayerI = getRoutingLayerByIndex(_minRoutingLayer);
-            } else {
-              phLayerI = getRoutingLayerByIndex(segment.initLayer);
-            }
-            if (segment.finalLayer < _minRoutingLayer
-                && !_unidirectionalRoute) {
-              phLayerF = getRoutingLayerByIndex(_minRoutingLayer);
-            } else {
-              phLayerF = getRoutingLayerByIndex(segment.finalLayer);
-            }
-            finalLayer = segment.finalLayer;
-            odb::Rect box;
-            guideBox.push_back(globalRoutingToBox(segment));
-            mergeBox(guideBox);
-            for (odb::Rect& guide : guideBox) {
-              guideFile << guide.xMin() + offsetX << " "
-                        << guide.yMin() + offsetY << " "
-                        << guide.xMax() + offsetX << " "
-                        << guide.yMax() + offsetY << " " << phLayerI.getName()
-                        << "\n";
-            }
-            guideBox.clear();
+  guideFile.close();
+}
 
-            guideBox.push_back(globalRoutingToBox(segment));
-          }
-        }
+void GlobalRouter::getGuides(odb::dbNet* db_net, std::vector<GGuide>& guides)
+{
+  guides.clear();
+  auto net_route = _routes.find(db_net);
+  if (net_route == _routes.end()) {
+    return;
+  }
+
+  GRoute& route = net_route->second;
+  std::vector<odb::Rect> guideBox;
+  int phLayerF = -1;
+  int finalLayer = -1;
+  for (GSegment& segment : route) {
+    if (segment.initLayer != finalLayer && finalLayer != -1) {
+      addGuides(guideBox, phLayerF, guides);
+      finalLayer = segment.initLayer;
+    }
+    if (segment.initLayer == segment.finalLayer) {
+      if (segment.initLayer < _minRoutingLayer
+          && segment.initX != segment.finalX
+          && segment.initY != segment.finalY) {
+        _logger->error(GRT, 74, "Routing with guides in blocked metal for net {}.",
+              db_net->getConstName());
       }
-      mergeBox(guideBox);
-      for (odb::Rect& guide : guideBox) {
-        guideFile << guide.xMin() + offsetX << " " << guide.yMin() + offsetY
-                  << " " << guide.xMax() + offsetX << " "
-                  << guide.yMax() + offsetY << " " << phLayerF.getName()
-                  << "\n";
+
+      guideBox.push_back(globalRoutingToBox(segment));
+      if (segment.finalLayer < _minRoutingLayer && !_unidirectionalRoute) {
+        phLayerF = _minRoutingLayer;
+      } else {
+        phLayerF = segment.finalLayer;
+      }
+      finalLayer = segment.finalLayer;
+    } else {
+      if (abs(segment.finalLayer - segment.initLayer) > 1) {
+        _logger->error(GRT, 75, "Connection between non-adjacent layers in net {}.",
+              db_net->getConstName());
+      } else {
+        int phLayerI;
+        if (segment.initLayer < _minRoutingLayer && !_unidirectionalRoute) {
+          phLayerI = _minRoutingLayer;
+        } else {
+          phLayerI = segment.initLayer;
+        }
+        if (segment.finalLayer < _minRoutingLayer && !_unidirectionalRoute) {
+          phLayerF = _minRoutingLayer;
+        } else {
+          phLayerF = segment.finalLayer;
+        }
+        finalLayer = segment.finalLayer;
+        guideBox.push_back(globalRoutingToBox(segment));
+        addGuides(guideBox, phLayerI, guides);
+
+        guideBox.push_back(globalRoutingToBox(segment));
       }
-      guideFile << ")\n";
     }
   }
+  addGuides(guideBox, phLayerF, guides);
+}
 
-  guideFile.close();
+// Merges the boxes of guideBox on layer and moves them to guides.
+void GlobalRouter::addGuides(std::vector<odb::Rect>& guideBox,
+                             int layer,
+                             std::vector<GGuide>& guides)
+{
+  mergeBox(guideBox);
+  for (odb::Rect& box : guideBox) {
+    box.moveDelta(_gridOrigin->x(), _gridOrigin->y());
+    guides.push_back({layer, box});
+  }
+  guideBox.clear();
 }
 
 RoutingLayer GlobalRouter::getRoutingLayerByIndex(int index)
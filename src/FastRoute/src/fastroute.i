@@ -150,6 +150,12 @@ set_allow_overflow(bool allowOverflow)
   getFastRoute()->setAllowOverflow(allowOverflow);
 }
 
+void
+set_threads(int threads)
+{
+  getFastRoute()->setThreads(threads);
+}
+
 void
 set_seed(unsigned seed)
 {
@@ -204,6 +210,18 @@ repair_antennas(LibertyPort* diodePort)
   getFastRoute()->repairAntennas(diodePort);
 }
 
+void
+start_incremental()
+{
+  getFastRoute()->startIncremental();
+}
+
+void
+end_incremental()
+{
+  getFastRoute()->endIncremental();
+}
+
 void
 clear_fastroute()
 {
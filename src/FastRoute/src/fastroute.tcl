@@ -170,6 +170,7 @@ sta::define_cmd_args "global_route" {[-guide_file out_file] \
                                   [-grid_origin origin] \
                                   [-allow_overflow] \
                                   [-seed seed] \
+                                  [-threads count] \
                                   [-report_congestion congest_file] \
                                   [-clock_layers layers] \
                                   [-clock_pdrev_fanout fanout] \
@@ -182,6 +183,8 @@ sta::define_cmd_args "global_route" {[-guide_file out_file] \
                                   [-max_routing_layer max_layer] \
                                   [-layers_adjustments layers_adjustments] \
                                   [-layers_pitches layers_pitches] \
+                                  [-start_incremental] \
+                                  [-end_incremental] \
 }
 
 # sta::define_cmd_alias "fastroute" "global_route"
@@ -194,12 +197,13 @@ proc fastroute { args } {
 proc global_route { args } {
   sta::parse_key_args "global_route" args \
     keys {-guide_file -layers -tile_size -verbose -layers_adjustments \ 
-          -overflow_iterations -grid_origin -seed -report_congestion \
+          -overflow_iterations -grid_origin -seed -threads -report_congestion \
           -clock_layers -clock_pdrev_fanout -clock_topology_priority \
           -clock_tracks_cost -macro_extension \
           -output_file -min_routing_layer -max_routing_layer -layers_pitches \
          } \
-    flags {-unidirectional_routing -allow_overflow -only_signal_nets} \
+    flags {-unidirectional_routing -allow_overflow -only_signal_nets \
+           -start_incremental -end_incremental} \
 
   if { ![ord::db_has_tech] } {
     utl::error GRT 51 "missing dbTech."
@@ -209,6 +213,22 @@ proc global_route { args } {
     utl::error GRT 52 "missing dbBlock."
   }
 
+  if { [info exists flags(-start_incremental)] } {
+    if { [info exists flags(-end_incremental)] } {
+      utl::error GRT 212 "-start_incremental and -end_incremental cannot be used together."
+    }
+    grt::start_incremental
+    return
+  }
+
+  if { [info exists flags(-end_incremental)] } {
+    grt::end_incremental
+    if { [info exists keys(-guide_file)] } {
+      grt::write_guides $keys(-guide_file)
+    }
+    return
+  }
+
   if { [info exists keys(-verbose) ] } {
     set verbose $keys(-verbose)
     grt::set_verbose $verbose
@@ -303,6 +323,14 @@ proc global_route { args } {
 
   grt::set_allow_overflow [info exists flags(-allow_overflow)]
 
+  if { [info exists keys(-threads)] } {
+    set threads $keys(-threads)
+    sta::check_positive_integer "-threads" $threads
+    grt::set_threads $threads
+  } else {
+    grt::set_threads 1
+  }
+
   if { [info exists keys(-macro_extension)] } {
     set macro_extension $keys(-macro_extension)
     grt::set_macro_extension $macro_extension
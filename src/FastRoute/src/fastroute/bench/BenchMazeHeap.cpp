@@ -0,0 +1,250 @@
+////////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2018, Iowa State University All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+// Times the maze expansion of mazeRouteMSMD, the search over a grid of
+// congestion costs from a source subtree, with the float** heap it used to
+// have and with MazeHeap, and checks that both pop the grids in the same
+// order.
+//
+//   BenchMazeHeap [region] [searches]
+//
+// region is the side of the square search region in grids (default 200).
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "MazeHeap.h"
+
+using namespace grt;
+
+static const float infinity = 1e7;
+
+// the heap of mazeRouteMSMD before MazeHeap
+
+static void heapify(float** array, int heapSize, int i)
+{
+  int l, r, smallest;
+  float* tmp = array[i];
+  while (true) {
+    l = 2 * i + 1;
+    r = 2 * i + 2;
+    if (l < heapSize && *(array[l]) < *tmp) {
+      smallest = l;
+      if (r < heapSize && *(array[r]) < *(array[l]))
+        smallest = r;
+    } else {
+      smallest = i;
+      if (r < heapSize && *(array[r]) < *tmp)
+        smallest = r;
+    }
+    if (smallest == i) {
+      break;
+    }
+    array[i] = array[smallest];
+    i = smallest;
+  }
+  array[i] = tmp;
+}
+
+static void updateHeap(float** array, int i)
+{
+  float* tmpi = array[i];
+  while (i > 0 && *(array[(i - 1) / 2]) > *tmpi) {
+    array[i] = array[(i - 1) / 2];
+    i = (i - 1) / 2;
+  }
+  array[i] = tmpi;
+}
+
+struct Grid
+{
+  int side;
+  std::vector<float> hCost;  // cost of the edge right of a grid
+  std::vector<float> vCost;  // cost of the edge above a grid
+  std::vector<float> dist;
+  std::vector<int> sources;
+};
+
+static void relax(Grid& grid,
+                  int from,
+                  int to,
+                  float cost,
+                  float** heap,
+                  int& heapLen,
+                  MazeHeap<float>* mazeHeap)
+{
+  float d = grid.dist[from] + cost;
+  if (grid.dist[to] >= infinity) {
+    grid.dist[to] = d;
+    if (mazeHeap) {
+      mazeHeap->push(&grid.dist[to]);
+    } else {
+      heap[heapLen++] = &grid.dist[to];
+      updateHeap(heap, heapLen - 1);
+    }
+  } else if (grid.dist[to] > d) {
+    grid.dist[to] = d;
+    if (mazeHeap) {
+      mazeHeap->decrease(&grid.dist[to]);
+    } else {
+      int ind = 0;
+      while (heap[ind] != &grid.dist[to])
+        ind++;
+      updateHeap(heap, ind);
+    }
+  }
+}
+
+// expand the whole region from the sources, returns the number of grids
+// popped and appends them to order
+static long search(Grid& grid,
+                   MazeHeap<float>* mazeHeap,
+                   std::vector<int>& order)
+{
+  int side = grid.side;
+  std::vector<float*> heap(side * side);
+  int heapLen = 0;
+  long pops = 0;
+
+  std::fill(grid.dist.begin(), grid.dist.end(), infinity);
+  if (mazeHeap) {
+    mazeHeap->clear();
+  }
+  for (int source : grid.sources) {
+    grid.dist[source] = 0;
+    if (mazeHeap) {
+      mazeHeap->push(&grid.dist[source]);
+    } else {
+      heap[heapLen++] = &grid.dist[source];
+    }
+  }
+
+  while (mazeHeap ? !mazeHeap->empty() : heapLen > 0) {
+    int cur;
+    if (mazeHeap) {
+      cur = mazeHeap->top();
+      mazeHeap->pop();
+    } else {
+      cur = heap[0] - grid.dist.data();
+      heap[0] = heap[--heapLen];
+      heapify(heap.data(), heapLen, 0);
+    }
+    order.push_back(cur);
+    pops++;
+
+    int x = cur % side;
+    int y = cur / side;
+    float** heapArray = heap.data();
+    if (x > 0) {
+      float cost = grid.hCost[cur - 1];
+      relax(grid, cur, cur - 1, cost, heapArray, heapLen, mazeHeap);
+    }
+    if (x < side - 1) {
+      float cost = grid.hCost[cur];
+      relax(grid, cur, cur + 1, cost, heapArray, heapLen, mazeHeap);
+    }
+    if (y > 0) {
+      float cost = grid.vCost[cur - side];
+      relax(grid, cur, cur - side, cost, heapArray, heapLen, mazeHeap);
+    }
+    if (y < side - 1) {
+      float cost = grid.vCost[cur];
+      relax(grid, cur, cur + side, cost, heapArray, heapLen, mazeHeap);
+    }
+  }
+
+  return pops;
+}
+
+int main(int argc, char** argv)
+{
+  int side = argc > 1 ? atoi(argv[1]) : 200;
+  int searches = argc > 2 ? atoi(argv[2]) : 20;
+
+  std::mt19937 random(1);
+  // congestion costs as built by mazeRouteMSMD from its cost tables
+  std::uniform_int_distribution<int> usage(0, 20);
+
+  Grid grid;
+  grid.side = side;
+  grid.hCost.resize(side * side);
+  grid.vCost.resize(side * side);
+  grid.dist.resize(side * side);
+  for (int i = 0; i < side * side; i++) {
+    grid.hCost[i] = 1 + 0.5f * usage(random);
+    grid.vCost[i] = 1 + 0.5f * usage(random);
+  }
+  // a source subtree along a diagonal route
+  for (int i = side / 4; i < side / 2; i++) {
+    grid.sources.push_back(i * side + i);
+  }
+
+  std::vector<int> pos(side * side);
+  MazeHeap<float> mazeHeap;
+  mazeHeap.init(grid.dist.data(), pos.data());
+
+  std::vector<int> oldOrder;
+  std::vector<int> newOrder;
+  double seconds[2];
+  long pops[2] = {0, 0};
+  for (int mode = 0; mode < 2; mode++) {
+    std::vector<int>& order = mode == 0 ? oldOrder : newOrder;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < searches; i++) {
+      order.clear();
+      pops[mode] += search(grid, mode == 0 ? nullptr : &mazeHeap, order);
+    }
+    seconds[mode] = std::chrono::duration<double>(
+                        std::chrono::steady_clock::now() - start)
+                        .count();
+  }
+
+  printf("%dx%d region, %d searches\n", side, side, searches);
+  printf("float** heap: %.3fs, %.2fM grids/s\n",
+         seconds[0],
+         pops[0] / seconds[0] / 1e6);
+  printf("MazeHeap:     %.3fs, %.2fM grids/s\n",
+         seconds[1],
+         pops[1] / seconds[1] / 1e6);
+
+  if (oldOrder != newOrder) {
+    printf("grids popped in a different order\n");
+    return 1;
+  }
+
+  return 0;
+}
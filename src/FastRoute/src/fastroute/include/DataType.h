@@ -203,6 +203,12 @@ typedef struct
   int edgeID;
 } OrderNetEdge;
 
+typedef struct
+{
+  int x1, x2;  // grid columns, both inclusive
+  int y1, y2;  // grid rows, both inclusive
+} MazeRegion;  // the grids maze routing of a net is confined to
+
 typedef enum
 {
   NORTH,
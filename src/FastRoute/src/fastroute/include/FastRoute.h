@@ -40,6 +40,9 @@
 #include <string>
 #include <vector>
 
+#include "DataType.h"
+#include "MazeHeap.h"
+#include "boost/multi_array.hpp"
 #include "fastroute/GRoute.h"
 
 namespace utl {
@@ -48,6 +51,8 @@ class Logger;
 
 namespace grt {
 
+// Each FastRouteCore owns its grid, nets and routing state, so independent
+// routers can run side by side, also on separate threads.
 class FastRouteCore
 {
  public:
@@ -117,10 +122,384 @@ class FastRouteCore
   void setOverflowIterations(int iterations);
   void setPDRevForHighFanout(int pdRevHihgFanout);
   void setAllowOverflow(bool allow);
+  // Maze route nets with disjoint routing regions in parallel.
+  void setThreads(int threads);
 
  private:
   NetRouteMap getRoutes();
+
+  // DataProc.cpp
+  void init_usage();
+
+  // EdgeShift.cpp
+  int edgeShift(Tree* t, int net);
+  int edgeShiftNew(Tree* t, int net);
+
+  // RSMT.cpp
+  int mapxy(int nx, int xs[], int nxs[], int d);
+  void copyStTree(int ind, Tree rsmt);
+  void fluteNormal(int netID,
+                   int d,
+                   DTYPE x[],
+                   DTYPE y[],
+                   int acc,
+                   float coeffV,
+                   Tree* t);
+  void fluteCongest(int netID,
+                    int d,
+                    DTYPE x[],
+                    DTYPE y[],
+                    int acc,
+                    float coeffV,
+                    Tree* t);
+  Bool netCongestion(int netID);
+  Bool VTreeSuite(int netID);
+  Bool HTreeSuite(int netID);
+  float coeffADJ(int netID);
+  void gen_brk_RSMT(Bool congestionDriven,
+                    Bool reRoute,
+                    Bool genTree,
+                    Bool newType,
+                    Bool noADJ);
+
+  // RipUp.cpp
+  void ripupSegL(Segment* seg);
+  void ripupSegZ(Segment* seg);
+  void newRipup(TreeEdge* treeedge,
+                TreeNode* treenodes,
+                int x1,
+                int y1,
+                int x2,
+                int y2,
+                int netID);
+  Bool newRipupType2(TreeEdge* treeedge,
+                     TreeNode* treenodes,
+                     int x1,
+                     int y1,
+                     int x2,
+                     int y2,
+                     int deg,
+                     int netID);
+  Bool newRipupCheck(TreeEdge* treeedge,
+                     int x1,
+                     int y1,
+                     int x2,
+                     int y2,
+                     int ripup_threshold,
+                     int netID,
+                     int edgeID);
+  Bool newRipup3DType3(int netID, int edgeID);
+  void newRipupNet(int netID);
+
+  // maze.cpp
+  void convertToMazerouteNet(int netID);
+  void convertToMazeroute();
+  void updateCongestionHistory(int round, int upType);
+  void setupHeap(int netID,
+                 int edgeID,
+                 MazeHeap<float>& heap1,
+                 float** heap2,
+                 int* heapLen2,
+                 int regionX1,
+                 int regionX2,
+                 int regionY1,
+                 int regionY2);
+  int copyGrids(TreeNode* treenodes,
+                int n1,
+                int n2,
+                TreeEdge* treeedges,
+                int edge_n1n2,
+                int gridsX_n1n2[],
+                int gridsY_n1n2[]);
+  void updateRouteType1(TreeNode* treenodes,
+                        int n1,
+                        int A1,
+                        int A2,
+                        int E1x,
+                        int E1y,
+                        TreeEdge* treeedges,
+                        int edge_n1A1,
+                        int edge_n1A2);
+  void updateRouteType2(TreeNode* treenodes,
+                        int n1,
+                        int A1,
+                        int A2,
+                        int C1,
+                        int C2,
+                        int E1x,
+                        int E1y,
+                        TreeEdge* treeedges,
+                        int edge_n1A1,
+                        int edge_n1A2,
+                        int edge_C1C2);
+  void reInitTree(int netID);
+  Bool mazeRouteNet(int netID,
+                    int iter,
+                    int expand,
+                    int ripup_threshold,
+                    int mazeedge_Threshold,
+                    const MazeRegion& clip,
+                    MazeHeap<float>& heap1,
+                    float** heap2,
+                    OrderNetEdge* netEO);
+  void mazeRouteMSMD(int iter,
+                     int expand,
+                     float costHeight,
+                     int ripup_threshold,
+                     int mazeedge_Threshold,
+                     Bool Ordering,
+                     int cost_type);
+  Bool netCongested(int netID, int ripup_threshold, int mazeedge_Threshold);
+  MazeRegion netRegion(int netID, int expand);
+  int mazeHeapSize(int netID, int layers);
+  void mazeBatches(const std::vector<MazeRegion>& regions,
+                   std::vector<std::vector<int>>& batches);
+  void mazeRouteMSMDBatches(int iter,
+                            int expand,
+                            int ripup_threshold,
+                            int mazeedge_Threshold,
+                            Bool Ordering);
+  int getOverflow2Dmaze(int* maxOverflow, int* tUsage);
+  int getOverflow2D(int* maxOverflow);
+  int getOverflow3D();
+  void initialCongestionHistory(int round);
+  void reduceCongestionHistory(int round);
+  void InitEstUsage();
+  void str_accu(int rnd);
+  void InitLastUsage(int upType);
+
+  // maze3D.cpp
+  void setupHeap3D(int netID,
+                   int edgeID,
+                   MazeHeap<int>& heap13D,
+                   short** heap23D,
+                   int* heapLen2,
+                   int regionX1,
+                   int regionX2,
+                   int regionY1,
+                   int regionY2);
+  void newUpdateNodeLayers(TreeNode* treenodes, int edgeID, int n1, int lastL);
+  int copyGrids3D(TreeNode* treenodes,
+                  int n1,
+                  int n2,
+                  TreeEdge* treeedges,
+                  int edge_n1n2,
+                  int gridsX_n1n2[],
+                  int gridsY_n1n2[],
+                  int gridsL_n1n2[]);
+  void updateRouteType13D(int netID,
+                          TreeNode* treenodes,
+                          int n1,
+                          int A1,
+                          int A2,
+                          int E1x,
+                          int E1y,
+                          TreeEdge* treeedges,
+                          int edge_n1A1,
+                          int edge_n1A2);
+  void updateRouteType23D(int netID,
+                          TreeNode* treenodes,
+                          int n1,
+                          int A1,
+                          int A2,
+                          int C1,
+                          int C2,
+                          int E1x,
+                          int E1y,
+                          TreeEdge* treeedges,
+                          int edge_n1A1,
+                          int edge_n1A2,
+                          int edge_C1C2);
+  void mazeRouteNet3D(int netID,
+                      int expand,
+                      int ripupTHlb,
+                      int ripupTHub,
+                      const MazeRegion& clip,
+                      Bool* pop_heap23D,
+                      MazeHeap<int>& heap13D,
+                      short** heap23D,
+                      int* xcor,
+                      int* ycor,
+                      int* dcor);
+  void mazeRouteMSMDOrder3D(int expand, int ripupTHlb, int ripupTHub);
+  void mazeRouteMSMDOrder3DBatches(int expand,
+                                   int ripupTHlb,
+                                   int ripupTHub,
+                                   Bool* pop_heap23D);
+  void getLayerRange(TreeNode* treenodes, int edgeID, int n1, int deg);
+
+  // route.cpp
+  void estimateOneSeg(Segment* seg);
+  void routeSegV(Segment* seg);
+  void routeSegH(Segment* seg);
+  void routeSegL(Segment* seg);
+  void routeSegLFirstTime(Segment* seg);
+  void routeLAll(Bool firstTime);
+  void newrouteL(int netID, RouteType ripuptype, Bool viaGuided);
+  void newrouteLAll(Bool firstTime, Bool viaGuided);
+  void newrouteZ_edge(int netID, int edgeID);
+  void newrouteZ(int netID, int threshold);
+  void newrouteZAll(int threshold);
+  void routeMonotonic(int netID, int edgeID, int threshold);
+  void routeMonotonicAll(int threshold);
+  void spiralRoute(int netID, int edgeID);
+  void spiralRouteAll();
+  void routeLVEnew(int netID, int edgeID, int threshold, int enlarge);
+  void routeLVAll(int threshold, int expand);
+  void newrouteLInMaze(int netID);
+
+  // utility.cpp
+  void printEdge(int netID, int edgeID);
+  void plotTree(int netID);
+  void getlen();
+  void ConvertToFull3DType2();
+  void netpinOrderInc();
+  void fillVIA();
+  int threeDVIA();
+  void assignEdge(int netID, int edgeID, Bool processDIR);
+  void newLayerAssignmentV4();
+  void newLA();
+  void printEdge3D(int netID, int edgeID);
+  void printTree3D(int netID);
+  void checkRoute3D();
+  void write3D();
+  void StNetOrder();
+  void recoverEdge(int netID, int edgeID);
+  void checkUsage();
+  void netedgeOrderDec(int netID, OrderNetEdge* netEO);
+  void printEdge2D(int netID, int edgeID);
+  void printTree2D(int netID);
+  Bool checkRoute2DTree(int netID);
+  void writeRoute3D(char routingfile3D[]);
+  void copyRS();
+  void copyBR();
+  void freeRR();
+
+  utl::Logger* logger;
   int maxNetDegree;
+
+  // Router state. Everything the routing steps share lives here, so that
+  // independent routers do not interfere with each other.
+  int newnetID = 0;
+  int segcount = 0;
+  int pinInd = 0;
+  int numAdjust = 0;
+  int vCapacity = 0;
+  int hCapacity = 0;
+  int MD = 0;
+
+  int XRANGE = 0, YRANGE = 0;
+  int xGrid = 0, yGrid = 0, numGrids = 0, numNets = 0, invalidNets = 0;
+  int* vCapacity3D = nullptr;
+  int* hCapacity3D = nullptr;
+  float vCapacity_lb = 0, hCapacity_lb = 0, vCapacity_ub = 0, hCapacity_ub = 0;
+  int MaxDegree = 0;
+  int* MinWidth = nullptr;
+  int* MinSpacing = nullptr;
+  int* ViaSpacing = nullptr;
+  int xcorner = 0, ycorner = 0, wTile = 0, hTile = 0;
+  int costheight = 0, ripup_threshold = 0, ahTH = 0;
+  // # nets need to be routed (having pins in different grids)
+  int numValidNets = 0;
+  int numLayers = 0;
+  int totalNumSeg = 0;    // total # segments
+  int totalOverflow = 0;  // total # overflow
+  int mazeThreshold = 0;  // the wirelen threshold to do maze routing
+  FrNet** nets = nullptr;
+  Edge* h_edges = nullptr;
+  Edge* v_edges = nullptr;
+  boost::multi_array<float, 2> d1;
+  boost::multi_array<float, 2> d2;
+  int layerOrientation = 0;
+  float alpha = 0;
+  int verbose = 0;
+  int overflowIterations = 0;
+  int pdRevForHighFanout = 0;
+  bool allowOverflow = false;
+  int numThreads = 1;
+
+  Bool** HV = nullptr;
+  Bool** hyperV = nullptr;
+  Bool** hyperH = nullptr;
+  int** corrEdge = nullptr;
+  int SLOPE = 0;
+
+  // coefficient
+  float LB = 0;
+  float UB = 0;
+  int THRESH_M = 0;
+  float LOGIS_COF = 0;
+  int ENLARGE = 0;
+  int STEP = 0;
+  int COSHEIGHT = 0;
+  int STOP = 0;
+  int VCA = 0;
+  int L = 0;
+  int VIA = 0, slope = 0, max_adj = 0;
+
+  Segment* seglist = nullptr;
+  int* seglistIndex = nullptr;  // the index for the segments for each net
+  int* seglistCnt = nullptr;    // the number of segements for each net
+  Tree* trees = nullptr;        // the tree topologies
+  StTree* sttrees = nullptr;    // the Steiner trees
+  // the copies of xs, ys and the vertical sequence for nets, used for
+  // second FLUTE
+  DTYPE** gxs = nullptr;
+  DTYPE** gys = nullptr;
+  DTYPE** gs = nullptr;
+  Edge3D* h_edges3D = nullptr;
+  Edge3D* v_edges3D = nullptr;
+
+  OrderNetPin* treeOrderPV = nullptr;
+  OrderTree* treeOrderCong = nullptr;
+  int numTreeedges = 0;
+  int viacost = 0;
+
+  int** layerGrid = nullptr;
+  int** gridD = nullptr;
+  int** viaLink = nullptr;
+
+  boost::multi_array<int, 3> d13D;
+  boost::multi_array<short, 3> d23D;
+
+  dirctionT*** directions3D = nullptr;
+  int*** corrEdge3D = nullptr;
+  parent3D*** pr3D = nullptr;
+
+  int mazeedge_Threshold = 0;
+  Bool** inRegion = nullptr;
+
+  int gridHV = 0, gridH = 0, gridV = 0;
+  int* gridHs = nullptr;
+  int* gridVs = nullptr;
+
+  // positions of the grids of d13D in the heap13Ds
+  std::vector<int> heap13DPos;
+
+  float* h_costTable = nullptr;
+  float* v_costTable = nullptr;
+  Bool stopDEC = 0, errorPRONE = 0;
+  int* xcor = nullptr;
+  int* ycor = nullptr;
+  int* dcor = nullptr;
+
+  StTree* sttreesBK = nullptr;
+
+  boost::multi_array<short, 2> parentX1, parentY1, parentX3, parentY3;
+
+  // positions of the grids of d1 in the heap1s
+  std::vector<int> heap1Pos;
+  Bool* pop_heap2 = nullptr;
+
+  float* costHVH = nullptr;      // Horizontal first Z
+  float* costVHV = nullptr;      // Vertical first Z
+  float* costH = nullptr;        // Horizontal segment cost
+  float* costV = nullptr;        // Vertical segment cost
+  float* costLR = nullptr;       // Left and right boundary cost
+  float* costTB = nullptr;       // Top and bottom boundary cost
+  float* costHVHtest = nullptr;  // Vertical first Z
+  float* costVtest = nullptr;    // Vertical segment cost
+  float* costTBtest = nullptr;   // Top and bottom boundary cost
 };
 
 }  // namespace grt
@@ -0,0 +1,144 @@
+////////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2018, Iowa State University All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __MAZEHEAP_H__
+#define __MAZEHEAP_H__
+
+#include <vector>
+
+namespace grt {
+
+// Binary min heap of the grids of a distance array (d1, d13D), ordered by
+// their distances. Grids are given by their address in the array and
+// reported by their offset from its start, like the float** and int** heaps
+// it replaces. The heap position of every grid is kept in pos, an int array
+// as large as the distance array, so lowering the distance of a grid in the
+// heap needs no search. The sift order is the one of the old heaps, so the
+// grids come out in the same order.
+//
+// A grid may be pushed more than once while its distance is 0 (setupHeap
+// does so for routes sharing grids). decrease must only be called for grids
+// pushed once.
+template <typename T>
+class MazeHeap
+{
+ public:
+  void init(T* dist, int* pos)
+  {
+    dist_ = dist;
+    pos_ = pos;
+    size_ = 0;
+  }
+
+  void clear() { size_ = 0; }
+  int size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  // offset of the grid with the smallest distance
+  int top() const { return heap_[0]; }
+
+  void push(T* d)
+  {
+    int grid = d - dist_;
+    if (size_ < (int) heap_.size()) {
+      heap_[size_] = grid;
+    } else {
+      heap_.push_back(grid);
+    }
+    pos_[grid] = size_;
+    size_++;
+    siftUp(size_ - 1);
+  }
+
+  void pop()
+  {
+    size_--;
+    if (size_ > 0) {
+      place(0, heap_[size_]);
+      siftDown(0);
+    }
+  }
+
+  // *d, in the heap, has been lowered
+  void decrease(T* d) { siftUp(pos_[d - dist_]); }
+
+ private:
+  void place(int i, int grid)
+  {
+    heap_[i] = grid;
+    pos_[grid] = i;
+  }
+
+  void siftUp(int i)
+  {
+    int grid = heap_[i];
+    while (i > 0 && dist_[heap_[(i - 1) / 2]] > dist_[grid]) {
+      place(i, heap_[(i - 1) / 2]);
+      i = (i - 1) / 2;
+    }
+    place(i, grid);
+  }
+
+  void siftDown(int i)
+  {
+    int l, r, smallest;
+    int grid = heap_[i];
+    while (true) {
+      l = 2 * i + 1;
+      r = 2 * i + 2;
+      if (l < size_ && dist_[heap_[l]] < dist_[grid]) {
+        smallest = l;
+        if (r < size_ && dist_[heap_[r]] < dist_[heap_[l]])
+          smallest = r;
+      } else {
+        smallest = i;
+        if (r < size_ && dist_[heap_[r]] < dist_[grid])
+          smallest = r;
+      }
+      if (smallest == i) {
+        break;
+      }
+      place(i, heap_[smallest]);
+      i = smallest;
+    }
+    place(i, grid);
+  }
+
+  T* dist_ = nullptr;
+  int* pos_ = nullptr;
+  std::vector<int> heap_;
+  int size_ = 0;
+};
+
+}  // namespace grt
+
+#endif /* __MAZEHEAP_H__ */
@@ -30,7 +30,6 @@
 // POSSIBILITY OF SUCH DAMAGE.
 ////////////////////////////////////////////////////////////////////////////////
 
-#include "EdgeShift.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -39,7 +38,6 @@
 
 #include "DataProc.h"
 #include "DataType.h"
-#include "RipUp.h"
 #include "flute.h"
 #include "route.h"
 
@@ -47,7 +45,7 @@ namespace grt {
 #define HORIZONTAL 1
 #define VERTICAL 0
 
-int edgeShift(Tree* t, int net)
+int FastRouteCore::edgeShift(Tree* t, int net)
 {
   int i, j, k, l, m, deg, root, x, y, n, n1, n2, n3;
   int maxX, minX, maxY, minY, maxX1, minX1, maxY1, minY1, maxX2, minX2, maxY2,
@@ -396,7 +394,7 @@ int edgeShift(Tree* t, int net)
 }
 
 // exchange Steiner nodes at the same position, then call edgeShift()
-int edgeShiftNew(Tree* t, int net)
+int FastRouteCore::edgeShiftNew(Tree* t, int net)
 {
   int i, j, n;
   int deg, pairCnt, cur_pairN1, cur_pairN2;
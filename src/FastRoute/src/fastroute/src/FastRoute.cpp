@@ -50,8 +50,6 @@
 
 #include "DataProc.h"
 #include "DataType.h"
-#include "RSMT.h"
-#include "RipUp.h"
 #include "flute.h"
 #include "maze.h"
 #include "maze3D.h"
@@ -64,14 +62,6 @@ namespace grt {
 
 using utl::GRT;
 
-int newnetID;
-int segcount;
-int pinInd;
-int numAdjust;
-int vCapacity;
-int hCapacity;
-int MD;
-
 FastRouteCore::FastRouteCore(utl::Logger* log)
 {
   newnetID = 0;
@@ -199,14 +189,8 @@ void FastRouteCore::deleteComponents()
 
   if (pop_heap2)
     delete[] pop_heap2;
-  if (heap1)
-    delete[] heap1;
-  if (heap2)
-    delete[] heap2;
 
   pop_heap2 = nullptr;
-  heap1 = nullptr;
-  heap2 = nullptr;
 
   if (xcor)
     delete[] xcor;
@@ -214,13 +198,10 @@ void FastRouteCore::deleteComponents()
     delete[] ycor;
   if (dcor)
     delete[] dcor;
-  if (netEO)
-    delete[] netEO;
 
   xcor = nullptr;
   ycor = nullptr;
   dcor = nullptr;
-  netEO = nullptr;
 
   if (HV) {
     for (int i = 0; i < YRANGE; i++) {
@@ -282,6 +263,11 @@ void FastRouteCore::deleteComponents()
   d1.resize(boost::extents[0][0]);
   d2.resize(boost::extents[0][0]);
 
+  heap13DPos.clear();
+  heap13DPos.shrink_to_fit();
+  heap1Pos.clear();
+  heap1Pos.shrink_to_fit();
+
   if (vCapacity3D)
     delete[] vCapacity3D;
   if (hCapacity3D)
@@ -430,6 +416,9 @@ void FastRouteCore::setGridsAndLayers(int x, int y, int nLayers)
   d1.resize(boost::extents[YRANGE][XRANGE]);
   d2.resize(boost::extents[YRANGE][XRANGE]);
 
+  heap13DPos.resize(d13D.num_elements());
+  heap1Pos.resize(d1.num_elements());
+
   HV = new Bool*[YRANGE];
   for (int i = 0; i < YRANGE; i++) {
     HV[i] = new Bool[XRANGE];
@@ -859,10 +848,6 @@ void FastRouteCore::initAuxVar()
 
   pop_heap2 = new Bool[yGrid * XRANGE];
 
-  // allocate memory for priority queue
-  heap1 = new float*[yGrid * xGrid];
-  heap2 = new float*[yGrid * xGrid];
-
   sttreesBK = NULL;
 }
 
@@ -1041,7 +1026,6 @@ NetRouteMap FastRouteCore::run()
   xcor = new int[maxPin];
   ycor = new int[maxPin];
   dcor = new int[maxPin];
-  netEO = new OrderNetEdge[maxPin];
 
   Bool input, WriteOut;
   input = WriteOut = 0;
@@ -1084,11 +1068,11 @@ NetRouteMap FastRouteCore::run()
   VIA = 2;
   // viacost = VIA;
   viacost = 0;
-  gen_brk_RSMT(FALSE, FALSE, FALSE, FALSE, noADJ, logger);
+  gen_brk_RSMT(FALSE, FALSE, FALSE, FALSE, noADJ);
   if (verbose > 1)
     logger->info(GRT, 97, "First L Route.");
   routeLAll(TRUE);
-  gen_brk_RSMT(TRUE, TRUE, TRUE, FALSE, noADJ, logger);
+  gen_brk_RSMT(TRUE, TRUE, TRUE, FALSE, noADJ);
   getOverflow2D(&maxOverflow);
   if (verbose > 1)
     logger->info(GRT, 98, "Second L Route.");
@@ -1446,9 +1430,6 @@ NetRouteMap FastRouteCore::run()
 
   NetRouteMap routes = getRoutes();
 
-  delete[] netEO;
-  netEO = nullptr;
-
   /* TODO:  <11-07-19, this function leads to a segfault, but as the OS
    * frees all memory after the application end (next line) we can omit
    * this function call for now.> */
@@ -1481,6 +1462,11 @@ void FastRouteCore::setAllowOverflow(bool allow)
   allowOverflow = allow;
 }
 
+void FastRouteCore::setThreads(int threads)
+{
+  numThreads = threads;
+}
+
 ////////////////////////////////////////////////////////////////
 
 const char* getNetName(odb::dbNet* db_net);
@@ -30,7 +30,6 @@
 // POSSIBILITY OF SUCH DAMAGE.
 ////////////////////////////////////////////////////////////////////////////////
 
-#include "RSMT.h"
 
 #include <math.h>
 #include <stdio.h>
@@ -40,8 +39,6 @@
 
 #include "DataProc.h"
 #include "DataType.h"
-#include "EdgeShift.h"
-#include "RipUp.h"
 #include "flute.h"
 #include "pdrev/pdrev.h"
 #include "route.h"
@@ -131,7 +128,7 @@ static int orderx2(const void* a, const void* b)
   // return ((struct Segment*)a->x1-(struct Segment*)b->x1);
 }
 
-int orderx(const void* a, const void* b)
+static int orderx(const void* a, const void* b)
 {
   struct pnt *pa, *pb;
 
@@ -161,7 +158,7 @@ static int ordery(const void* a, const void* b)
 }
 
 // binary search to map the new coordinates to original coordinates
-int mapxy(int nx, int xs[], int nxs[], int d)
+int FastRouteCore::mapxy(int nx, int xs[], int nxs[], int d)
 {
   int max, min, mid;
 
@@ -183,7 +180,7 @@ int mapxy(int nx, int xs[], int nxs[], int d)
   return -1;
 }
 
-void copyStTree(int ind, Tree rsmt)
+void FastRouteCore::copyStTree(int ind, Tree rsmt)
 {
   int i, d, numnodes, numedges;
   int n, x1, y1, x2, y2, edgecnt;
@@ -252,13 +249,13 @@ void copyStTree(int ind, Tree rsmt)
   }
 }
 
-void fluteNormal(int netID,
-                 int d,
-                 DTYPE x[],
-                 DTYPE y[],
-                 int acc,
-                 float coeffV,
-                 Tree* t)
+void FastRouteCore::fluteNormal(int netID,
+                                int d,
+                                DTYPE x[],
+                                DTYPE y[],
+                                int acc,
+                                float coeffV,
+                                Tree* t)
 {
   DTYPE *xs, *ys, minval, x_max, x_min, x_mid, y_max, y_min, y_mid, *tmp_xs,
       *tmp_ys;
@@ -446,13 +443,13 @@ void fluteNormal(int netID,
   }
 }
 
-void fluteCongest(int netID,
-                  int d,
-                  DTYPE x[],
-                  DTYPE y[],
-                  int acc,
-                  float coeffV,
-                  Tree* t)
+void FastRouteCore::fluteCongest(int netID,
+                                 int d,
+                                 DTYPE x[],
+                                 DTYPE y[],
+                                 int acc,
+                                 float coeffV,
+                                 Tree* t)
 {
   DTYPE *xs, *ys, *nxs, *nys, *x_seg, *y_seg, minval, x_max, x_min, x_mid,
       y_max, y_min, y_mid;
@@ -612,7 +609,7 @@ void fluteCongest(int netID,
   // return t;
 }
 
-Bool netCongestion(int netID)
+Bool FastRouteCore::netCongestion(int netID)
 {
   int i, j, edgeID, edgelength, *gridsX, *gridsY;
   int n1, n2, x1, y1, x2, y2, distance, grid, ymin, ymax;
@@ -666,7 +663,7 @@ Bool netCongestion(int netID)
   return (FALSE);
 }
 
-Bool VTreeSuite(int netID)
+Bool FastRouteCore::VTreeSuite(int netID)
 {
   int xmin, xmax, ymin, ymax;
 
@@ -698,7 +695,7 @@ Bool VTreeSuite(int netID)
   }
 }
 
-Bool HTreeSuite(int netID)
+Bool FastRouteCore::HTreeSuite(int netID)
 {
   int xmin, xmax, ymin, ymax;
 
@@ -730,7 +727,7 @@ Bool HTreeSuite(int netID)
   }
 }
 
-float coeffADJ(int netID)
+float FastRouteCore::coeffADJ(int netID)
 {
   int xmin, xmax, ymin, ymax, Hcap, Vcap;
   float Husage, Vusage, coef;
@@ -798,12 +795,11 @@ float coeffADJ(int netID)
   return (coef);
 }
 
-void gen_brk_RSMT(Bool congestionDriven,
-                  Bool reRoute,
-                  Bool genTree,
-                  Bool newType,
-                  Bool noADJ,
-                  Logger* logger)
+void FastRouteCore::gen_brk_RSMT(Bool congestionDriven,
+                                 Bool reRoute,
+                                 Bool genTree,
+                                 Bool newType,
+                                 Bool noADJ)
 {
   int i, j, d, n, n1, n2;
   int x1, y1, x2, y2;
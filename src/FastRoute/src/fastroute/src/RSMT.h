@@ -1,72 +0,0 @@
-////////////////////////////////////////////////////////////////////////////////
-// BSD 3-Clause License
-//
-// Copyright (c) 2018, Iowa State University All rights reserved.
-//
-// Redistribution and use in source and binary forms, with or without
-// modification, are permitted provided that the following conditions are met:
-//
-// * Redistributions of source code must retain the above copyright notice,
-// this list of conditions and the following disclaimer.
-//
-// * Redistributions in binary form must reproduce the above copyright notice,
-// this list of conditions and the following disclaimer in the documentation
-// and/or other materials provided with the distribution.
-//
-// * Neither the name of the copyright holder nor the names of its contributors
-// may be used to endorse or promote products derived from this software
-// without specific prior written permission.
-//
-// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
-// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
-// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
-// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
-// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
-// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
-// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
-// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
-// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
-// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
-// POSSIBILITY OF SUCH DAMAGE.
-////////////////////////////////////////////////////////////////////////////////
-
-#ifndef __RSMT_H__
-#define __RSMT_H__
-
-#include "DataType.h"
-
-namespace utl {
-class Logger;
-} // namespace utl
-
-namespace grt {
-
-using utl::Logger;
-
-extern int** V_table;
-extern int** H_table;
-
-extern void copyStTree(int ind, Tree rsmt);
-extern void gen_brk_RSMT(Bool congestionDriven,
-                         Bool reRoute,
-                         Bool genTree,
-                         Bool newType,
-                         Bool noADJ,
-                         Logger* logger);
-extern void fluteNormal(int netID,
-                        int d,
-                        DTYPE x[],
-                        DTYPE y[],
-                        int acc,
-                        float coeffV,
-                        Tree* t);
-extern void fluteCongest(int netID,
-                         int d,
-                         DTYPE x[],
-                         DTYPE y[],
-                         int acc,
-                         float coeffV,
-                         Tree* t);
-
-}  // namespace grt
-#endif /* __RSMT_H__ */
@@ -30,7 +30,6 @@
 // POSSIBILITY OF SUCH DAMAGE.
 ////////////////////////////////////////////////////////////////////////////////
 
-#include "RipUp.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -50,7 +49,7 @@ namespace grt {
 using utl::GRT;
 
 // rip-up a L segment
-void ripupSegL(Segment* seg)
+void FastRouteCore::ripupSegL(Segment* seg)
 {
   int edgeCost = nets[seg->netID]->edgeCost;
   int i, grid;
@@ -80,7 +79,7 @@ void ripupSegL(Segment* seg)
   }
 }
 
-void ripupSegZ(Segment* seg)
+void FastRouteCore::ripupSegZ(Segment* seg)
 {
   int i, grid;
   int ymin, ymax;
@@ -137,13 +136,13 @@ void ripupSegZ(Segment* seg)
   }
 }
 
-void newRipup(TreeEdge* treeedge,
-              TreeNode* treenodes,
-              int x1,
-              int y1,
-              int x2,
-              int y2,
-              int netID)
+void FastRouteCore::newRipup(TreeEdge* treeedge,
+                             TreeNode* treenodes,
+                             int x1,
+                             int y1,
+                             int x2,
+                             int y2,
+                             int netID)
 {
   short *gridsX, *gridsY;
   int i, j, grid, Zpoint, ymin, ymax, xmin, n1, n2;
@@ -232,14 +231,14 @@ void newRipup(TreeEdge* treeedge,
   }
 }
 
-Bool newRipupType2(TreeEdge* treeedge,
-                   TreeNode* treenodes,
-                   int x1,
-                   int y1,
-                   int x2,
-                   int y2,
-                   int deg,
-                   int netID)
+Bool FastRouteCore::newRipupType2(TreeEdge* treeedge,
+                                  TreeNode* treenodes,
+                                  int x1,
+                                  int y1,
+                                  int x2,
+                                  int y2,
+                                  int deg,
+                                  int netID)
 {
   int i, j, grid, Zpoint, ymin, ymax, xmin, n1, n2;
   int *gridsX, *gridsY;
@@ -329,14 +328,14 @@ Bool newRipupType2(TreeEdge* treeedge,
   }
 }
 
-Bool newRipupCheck(TreeEdge* treeedge,
-                   int x1,
-                   int y1,
-                   int x2,
-                   int y2,
-                   int ripup_threshold,
-                   int netID,
-                   int edgeID)
+Bool FastRouteCore::newRipupCheck(TreeEdge* treeedge,
+                                  int x1,
+                                  int y1,
+                                  int x2,
+                                  int y2,
+                                  int ripup_threshold,
+                                  int netID,
+                                  int edgeID)
 {
   short *gridsX, *gridsY;
   int i, grid, Zpoint, ymin, xmin, max_usageH, max_usageV;
@@ -395,7 +394,7 @@ Bool newRipupCheck(TreeEdge* treeedge,
   }
 }
 
-Bool newRipup3DType3(int netID, int edgeID)
+Bool FastRouteCore::newRipup3DType3(int netID, int edgeID)
 {
   short *gridsX, *gridsY, *gridsL;
   int i, k, grid, Zpoint, ymin, ymax, xmin, lv, lh, n1a, n2a, hl, bl, hid, bid,
@@ -526,7 +525,7 @@ Bool newRipup3DType3(int netID, int edgeID)
   return (TRUE);
 }
 
-void newRipupNet(int netID)
+void FastRouteCore::newRipupNet(int netID)
 {
   short *gridsX, *gridsY;
   int i, j, grid, Zpoint, ymin, ymax, xmin, n1, n2, edgeID;
@@ -33,18 +33,18 @@
 #include "maze.h"
 
 #include <math.h>
+#include <omp.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <iomanip>
 #include <sstream>
 
 #include <algorithm>
+#include <exception>
+#include <vector>
 
 #include "DataProc.h"
 #include "DataType.h"
-#include "EdgeShift.h"
-#include "RSMT.h"
-#include "RipUp.h"
 #include "flute.h"
 #include "pdrev/pdrev.h"
 #include "route.h"
@@ -55,12 +55,7 @@ namespace grt {
 
 using utl::GRT;
 
-#define PARENT(i) (i - 1) / 2
-//#define PARENT(i) ((i-1)>>1)
-#define LEFT(i) 2 * i + 1
-#define RIGHT(i) 2 * i + 2
-
-void convertToMazerouteNet(int netID)
+void FastRouteCore::convertToMazerouteNet(int netID)
 {
   short *gridsX, *gridsY;
   int i, edgeID, edgelength;
@@ -206,7 +201,7 @@ void convertToMazerouteNet(int netID)
   }  // loop for all the edges
 }
 
-void convertToMazeroute()
+void FastRouteCore::convertToMazeroute()
 {
   int i, j, grid, netID;
 
@@ -229,73 +224,12 @@ void convertToMazeroute()
   }
 }
 
-// non recursive version of heapify
-void heapify(float** array, int heapSize, int i)
-{
-  int l, r, smallest;
-  float* tmp;
-  Bool STOP = FALSE;
-
-  tmp = array[i];
-  do {
-    l = LEFT(i);
-    r = RIGHT(i);
-
-    if (l < heapSize && *(array[l]) < *tmp) {
-      smallest = l;
-      if (r < heapSize && *(array[r]) < *(array[l]))
-        smallest = r;
-    } else {
-      smallest = i;
-      if (r < heapSize && *(array[r]) < *tmp)
-        smallest = r;
-    }
-    if (smallest != i) {
-      array[i] = array[smallest];
-      i = smallest;
-    } else {
-      array[i] = tmp;
-      STOP = TRUE;
-    }
-  } while (!STOP);
-}
-
-// build heap for an list of grid
-void buildHeap(float** array, int arrayLen)
-{
-  int i;
-
-  for (i = arrayLen / 2 - 1; i >= 0; i--)
-    heapify(array, arrayLen, i);
-}
-
-void updateHeap(float** array, int arrayLen, int i)
-{
-  int parent;
-  float* tmpi;
-
-  tmpi = array[i];
-  while (i > 0 && *(array[PARENT(i)]) > *tmpi) {
-    parent = PARENT(i);
-    array[i] = array[parent];
-    i = parent;
-  }
-  array[i] = tmpi;
-}
-
-// extract the entry with minimum distance from Priority queue
-void extractMin(float** array, int arrayLen)
-{
-  array[0] = array[arrayLen - 1];
-  heapify(array, arrayLen - 1, 0);
-}
-
 /*
  * num_iteration : the total number of iterations for maze route to run
  * round : the number of maze route stages runned
  */
 
-void updateCongestionHistory(int round, int upType)
+void FastRouteCore::updateCongestionHistory(int round, int upType)
 {
   int i, j, grid, maxlimit, overflow;
 
@@ -475,16 +409,17 @@ void updateCongestionHistory(int round, int upType)
 // edgeID  - the ID for the tree edge to route
 // d1      - the distance of any grid from the source subtree t1
 // d2      - the distance of any grid from the destination subtree t2
-// heap1   - the heap storing the addresses for d1[][]
-// heap2   - the heap storing the addresses for d2[][]
-void setupHeap(int netID,
-               int edgeID,
-               int* heapLen1,
-               int* heapLen2,
-               int regionX1,
-               int regionX2,
-               int regionY1,
-               int regionY2)
+// heap1   - the heap of the grids of d1[][]
+// heap2   - the list of the addresses for d2[][]
+void FastRouteCore::setupHeap(int netID,
+                              int edgeID,
+                              MazeHeap<float>& heap1,
+                              float** heap2,
+                              int* heapLen2,
+                              int regionX1,
+                              int regionX2,
+                              int regionY1,
+                              int regionY2)
 {
   int i, j, d, numNodes, n1, n2, x1, y1, x2, y2;
   int nbr, nbrX, nbrY, cur, edge;
@@ -500,6 +435,8 @@ void setupHeap(int netID,
       inRegion[i][j] = TRUE;
   }
 
+  heap1.clear();
+
   treeedges = sttrees[netID].edges;
   treenodes = sttrees[netID].nodes;
   d = sttrees[netID].deg;
@@ -514,8 +451,7 @@ void setupHeap(int netID,
   if (d == 2)  // 2-pin net
   {
     d1[y1][x1] = 0;
-    heap1[0] = &d1[y1][x1];
-    *heapLen1 = 1;
+    heap1.push(&d1[y1][x1]);
     d2[y2][x2] = 0;
     heap2[0] = &d2[y2][x2];
     *heapLen2 = 1;
@@ -535,19 +471,16 @@ void setupHeap(int netID,
     {
       // just need to put n1 itself into heap1
       d1[y1][x1] = 0;
-      heap1[0] = &d1[y1][x1];
+      heap1.push(&d1[y1][x1]);
       visited[n1] = TRUE;
-      *heapLen1 = 1;
     } else  // n1 is a Steiner node
     {
-      heapcnt = 0;
       queuehead = queuetail = 0;
 
       // add n1 into heap1
       d1[y1][x1] = 0;
-      heap1[0] = &d1[y1][x1];
+      heap1.push(&d1[y1][x1]);
       visited[n1] = TRUE;
-      heapcnt++;
 
       // add n1 into the queue
       queue[queuetail] = n1;
@@ -575,8 +508,7 @@ void setupHeap(int netID,
                     nbrX = treenodes[nbr].x;
                     nbrY = treenodes[nbr].y;
                     d1[nbrY][nbrX] = 0;
-                    heap1[heapcnt] = &d1[nbrY][nbrX];
-                    heapcnt++;
+                    heap1.push(&d1[nbrY][nbrX]);
                     corrEdge[nbrY][nbrX] = edge;
                   }
 
@@ -592,8 +524,7 @@ void setupHeap(int netID,
 
                       if (inRegion[y_grid][x_grid]) {
                         d1[y_grid][x_grid] = 0;
-                        heap1[heapcnt] = &d1[y_grid][x_grid];
-                        heapcnt++;
+                        heap1.push(&d1[y_grid][x_grid]);
                         corrEdge[y_grid][x_grid] = edge;
                       }
                     }
@@ -606,13 +537,12 @@ void setupHeap(int netID,
                 // add the neighbor of cur node into queue
                 queue[queuetail] = nbr;
                 queuetail++;
-              }             // if the node is not visited
-            }               // if nbr!=n2
-          }                 // loop i (3 neigbors for cur node)
-        }                   // if cur node is a Steiner nodes
-      }                     // while queue is not empty
-      *heapLen1 = heapcnt;  // record the length of heap1
-    }                       // else n1 is not a Pin node
+              }  // if the node is not visited
+            }    // if nbr!=n2
+          }      // loop i (3 neigbors for cur node)
+        }        // if cur node is a Steiner nodes
+      }          // while queue is not empty
+    }            // else n1 is not a Pin node
 
     // find all the grids on subtree t2 (connect to n2) and put them into heap2
     // find all the grids on tree edges in subtree t2 (connecting to n2) and put
@@ -710,13 +640,13 @@ void setupHeap(int netID,
   }
 }
 
-int copyGrids(TreeNode* treenodes,
-              int n1,
-              int n2,
-              TreeEdge* treeedges,
-              int edge_n1n2,
-              int gridsX_n1n2[],
-              int gridsY_n1n2[])
+int FastRouteCore::copyGrids(TreeNode* treenodes,
+                             int n1,
+                             int n2,
+                             TreeEdge* treeedges,
+                             int edge_n1n2,
+                             int gridsX_n1n2[],
+                             int gridsY_n1n2[])
 {
   int i, cnt;
   int n1x, n1y;
@@ -761,15 +691,15 @@ int copyGrids(TreeNode* treenodes,
   return (cnt);
 }
 
-void updateRouteType1(TreeNode* treenodes,
-                      int n1,
-                      int A1,
-                      int A2,
-                      int E1x,
-                      int E1y,
-                      TreeEdge* treeedges,
-                      int edge_n1A1,
-                      int edge_n1A2)
+void FastRouteCore::updateRouteType1(TreeNode* treenodes,
+                                     int n1,
+                                     int A1,
+                                     int A2,
+                                     int E1x,
+                                     int E1y,
+                                     TreeEdge* treeedges,
+                                     int edge_n1A1,
+                                     int edge_n1A2)
 {
   int i, cnt, A1x, A1y, A2x, A2y;
   int cnt_n1A1, cnt_n1A2, E1_pos;
@@ -896,18 +826,18 @@ void updateRouteType1(TreeNode* treenodes,
   delete[] gridsY_n1A2;
 }
 
-void updateRouteType2(TreeNode* treenodes,
-                      int n1,
-                      int A1,
-                      int A2,
-                      int C1,
-                      int C2,
-                      int E1x,
-                      int E1y,
-                      TreeEdge* treeedges,
-                      int edge_n1A1,
-                      int edge_n1A2,
-                      int edge_C1C2)
+void FastRouteCore::updateRouteType2(TreeNode* treenodes,
+                                     int n1,
+                                     int A1,
+                                     int A2,
+                                     int C1,
+                                     int C2,
+                                     int E1x,
+                                     int E1y,
+                                     TreeEdge* treeedges,
+                                     int edge_n1A1,
+                                     int edge_n1A2,
+                                     int edge_C1C2)
 {
   int i, cnt, A1x, A1y, A2x, A2y, C1x, C1y, C2x, C2y;
   int edge_n1C1, edge_n1C2, edge_A1A2;
@@ -1029,7 +959,7 @@ void updateRouteType2(TreeNode* treenodes,
   delete[] gridsY_C1C2;
 }
 
-void reInitTree(int netID)
+void FastRouteCore::reInitTree(int netID)
 {
   int deg, numEdges, edgeID, d, j;
   TreeEdge* treeedge;
@@ -1070,35 +1000,694 @@ void reInitTree(int netID)
   convertToMazerouteNet(netID);
 }
 
-void mazeRouteMSMD(int iter,
-                   int expand,
-                   float costHeight,
-                   int ripup_threshold,
-                   int mazeedge_Threshold,
-                   Bool Ordering,
-                   int cost_type)
+// rip up and maze route the congested edges of one net, the search regions
+// are kept inside clip. Returns TRUE if the tree of the net got broken and
+// has to be rebuilt.
+Bool FastRouteCore::mazeRouteNet(int netID,
+                                 int iter,
+                                 int expand,
+                                 int ripup_threshold,
+                                 int mazeedge_Threshold,
+                                 const MazeRegion& clip,
+                                 MazeHeap<float>& heap1,
+                                 float** heap2,
+                                 OrderNetEdge* netEO)
 {
-  int grid, netID, nidRPC;
-  float forange;
+  int grid;
 
   // maze routing for multi-source, multi-destination
   Bool hypered, enter;
   int i, j, deg, edgeID, n1, n2, n1x, n1y, n2x, n2y, ymin, ymax, xmin, xmax,
       curX, curY, crossX, crossY, tmpX, tmpY, tmpi, min_x, min_y, num_edges;
   int regionX1, regionX2, regionY1, regionY2;
-  int heapLen1, heapLen2, ind, ind1, tmpind;
+  int heapLen2, ind1, tmpind;
   int endpt1, endpt2, A1, A2, B1, B2, C1, C2, D1, D2, cnt, cnt_n1n2;
   int edge_n1n2, edge_n1A1, edge_n1A2, edge_n1C1, edge_n1C2, edge_A1A2,
       edge_C1C2;
   int edge_n2B1, edge_n2B2, edge_n2D1, edge_n2D2, edge_B1B2, edge_D1D2;
   int E1x, E1y, E2x, E2y;
   int tmp_grid, tmp_cost;
-  int preX, preY, origENG, edgeREC;
+  int preX, preY, origENG, edgeREC, enlarge;
 
-  float tmp, *dtmp;
+  float tmp;
   TreeEdge *treeedges, *treeedge;
   TreeNode* treenodes;
 
+  deg = sttrees[netID].deg;
+
+  origENG = expand;
+
+  netedgeOrderDec(netID, netEO);
+
+  treeedges = sttrees[netID].edges;
+  treenodes = sttrees[netID].nodes;
+  // loop for all the tree edges (2*deg-3)
+  num_edges = 2 * deg - 3;
+  for (edgeREC = 0; edgeREC < num_edges; edgeREC++) {
+    edgeID = netEO[edgeREC].edgeID;
+    treeedge = &(treeedges[edgeID]);
+
+    n1 = treeedge->n1;
+    n2 = treeedge->n2;
+    n1x = treenodes[n1].x;
+    n1y = treenodes[n1].y;
+    n2x = treenodes[n2].x;
+    n2y = treenodes[n2].y;
+    treeedge->len = ADIFF(n2x, n1x) + ADIFF(n2y, n1y);
+
+    if (treeedge->len
+        > mazeedge_Threshold)  // only route the non-degraded edges (len>0)
+    {
+      enter = newRipupCheck(
+          treeedge, n1x, n1y, n2x, n2y, ripup_threshold, netID, edgeID);
+
+      // ripup the routing for the edge
+      if (enter) {
+        if (n1y <= n2y) {
+          ymin = n1y;
+          ymax = n2y;
+        } else {
+          ymin = n2y;
+          ymax = n1y;
+        }
+
+        if (n1x <= n2x) {
+          xmin = n1x;
+          xmax = n2x;
+        } else {
+          xmin = n2x;
+          xmax = n1x;
+        }
+
+        enlarge
+            = std::min(origENG, (iter / 6 + 3) * treeedge->route.routelen);
+        regionX1 = std::max(clip.x1, xmin - enlarge);
+        regionX2 = std::min(clip.x2, xmax + enlarge);
+        regionY1 = std::max(clip.y1, ymin - enlarge);
+        regionY2 = std::min(clip.y2, ymax + enlarge);
+
+        // initialize d1[][] and d2[][] as BIG_INT
+        for (i = regionY1; i <= regionY2; i++) {
+          for (j = regionX1; j <= regionX2; j++) {
+            d1[i][j] = BIG_INT;
+            d2[i][j] = BIG_INT;
+            hyperH[i][j] = FALSE;
+            hyperV[i][j] = FALSE;
+          }
+        }
+
+        // setup heap1, heap2 and initialize d1[][] and d2[][] for all the
+        // grids on the two subtrees
+        setupHeap(netID,
+                  edgeID,
+                  heap1,
+                  heap2,
+                  &heapLen2,
+                  regionX1,
+                  regionX2,
+                  regionY1,
+                  regionY2);
+
+        // while loop to find shortest path
+        ind1 = heap1.top();
+        for (i = 0; i < heapLen2; i++)
+          pop_heap2[(heap2[i] - &d2[0][0])] = TRUE;
+
+        while (pop_heap2[ind1]
+               == FALSE)  // stop until the grid position been popped out from
+                          // both heap1 and heap2
+        {
+          // relax all the adjacent grids within the enlarged region for
+          // source subtree
+          curX = ind1 % XRANGE;
+          curY = ind1 / XRANGE;
+          if (d1[curY][curX] != 0) {
+            if (HV[curY][curX]) {
+              preX = parentX1[curY][curX];
+              preY = parentY1[curY][curX];
+            } else {
+              preX = parentX3[curY][curX];
+              preY = parentY3[curY][curX];
+            }
+          } else {
+            preX = curX;
+            preY = curY;
+          }
+
+          heap1.pop();
+
+          // left
+          if (curX > regionX1) {
+            grid = curY * (xGrid - 1) + curX - 1;
+            if ((preY == curY) || (d1[curY][curX] == 0)) {
+              tmp = d1[curY][curX]
+                    + h_costTable[h_edges[grid].usage + h_edges[grid].red
+                                  + L * h_edges[grid].last_usage];
+            } else {
+              if (curX < regionX2 - 1) {
+                tmp_grid = curY * (xGrid - 1) + curX;
+                tmp_cost = d1[curY][curX + 1]
+                           + h_costTable[h_edges[tmp_grid].usage
+                                         + h_edges[tmp_grid].red
+                                         + L * h_edges[tmp_grid].last_usage];
+
+                if (tmp_cost < d1[curY][curX] + VIA) {
+                  hyperH[curY][curX] = TRUE;
+                }
+              }
+              tmp = d1[curY][curX] + VIA
+                    + h_costTable[h_edges[grid].usage + h_edges[grid].red
+                                  + L * h_edges[grid].last_usage];
+            }
+            tmpX = curX - 1;  // the left neighbor
+
+            if (d1[curY][tmpX]
+                >= BIG_INT)  // left neighbor not been put into heap1
+            {
+              d1[curY][tmpX] = tmp;
+              parentX3[curY][tmpX] = curX;
+              parentY3[curY][tmpX] = curY;
+              HV[curY][tmpX] = FALSE;
+              heap1.push(&d1[curY][tmpX]);
+            } else if (d1[curY][tmpX] > tmp)  // left neighbor been put into
+                                              // heap1 but needs update
+            {
+              d1[curY][tmpX] = tmp;
+              parentX3[curY][tmpX] = curX;
+              parentY3[curY][tmpX] = curY;
+              HV[curY][tmpX] = FALSE;
+              heap1.decrease(&d1[curY][tmpX]);
+            }
+          }
+          // right
+          if (curX < regionX2) {
+            grid = curY * (xGrid - 1) + curX;
+            if ((preY == curY) || (d1[curY][curX] == 0)) {
+              tmp = d1[curY][curX]
+                    + h_costTable[h_edges[grid].usage + h_edges[grid].red
+                                  + L * h_edges[grid].last_usage];
+            } else {
+              if (curX > regionX1 + 1) {
+                tmp_grid = curY * (xGrid - 1) + curX - 1;
+                tmp_cost = d1[curY][curX - 1]
+                           + h_costTable[h_edges[tmp_grid].usage
+                                         + h_edges[tmp_grid].red
+                                         + L * h_edges[tmp_grid].last_usage];
+
+                if (tmp_cost < d1[curY][curX] + VIA) {
+                  hyperH[curY][curX] = TRUE;
+                }
+              }
+              tmp = d1[curY][curX] + VIA
+                    + h_costTable[h_edges[grid].usage + h_edges[grid].red
+                                  + L * h_edges[grid].last_usage];
+            }
+            tmpX = curX + 1;  // the right neighbor
+
+            if (d1[curY][tmpX]
+                >= BIG_INT)  // right neighbor not been put into heap1
+            {
+              d1[curY][tmpX] = tmp;
+              parentX3[curY][tmpX] = curX;
+              parentY3[curY][tmpX] = curY;
+              HV[curY][tmpX] = FALSE;
+              heap1.push(&d1[curY][tmpX]);
+            } else if (d1[curY][tmpX] > tmp)  // right neighbor been put into
+                                              // heap1 but needs update
+            {
+              d1[curY][tmpX] = tmp;
+              parentX3[curY][tmpX] = curX;
+              parentY3[curY][tmpX] = curY;
+              HV[curY][tmpX] = FALSE;
+              heap1.decrease(&d1[curY][tmpX]);
+            }
+          }
+          // bottom
+          if (curY > regionY1) {
+            grid = (curY - 1) * xGrid + curX;
+
+            if ((preX == curX) || (d1[curY][curX] == 0)) {
+              tmp = d1[curY][curX]
+                    + v_costTable[v_edges[grid].usage + v_edges[grid].red
+                                  + L * v_edges[grid].last_usage];
+            } else {
+              if (curY < regionY2 - 1) {
+                tmp_grid = curY * xGrid + curX;
+                tmp_cost = d1[curY + 1][curX]
+                           + v_costTable[v_edges[tmp_grid].usage
+                                         + v_edges[tmp_grid].red
+                                         + L * v_edges[tmp_grid].last_usage];
+
+                if (tmp_cost < d1[curY][curX] + VIA) {
+                  hyperV[curY][curX] = TRUE;
+                }
+              }
+              tmp = d1[curY][curX] + VIA
+                    + v_costTable[v_edges[grid].usage + v_edges[grid].red
+                                  + L * v_edges[grid].last_usage];
+            }
+            tmpY = curY - 1;  // the bottom neighbor
+            if (d1[tmpY][curX]
+                >= BIG_INT)  // bottom neighbor not been put into heap1
+            {
+              d1[tmpY][curX] = tmp;
+              parentX1[tmpY][curX] = curX;
+              parentY1[tmpY][curX] = curY;
+              HV[tmpY][curX] = TRUE;
+              heap1.push(&d1[tmpY][curX]);
+            } else if (d1[tmpY][curX] > tmp)  // bottom neighbor been put into
+                                              // heap1 but needs update
+            {
+              d1[tmpY][curX] = tmp;
+              parentX1[tmpY][curX] = curX;
+              parentY1[tmpY][curX] = curY;
+              HV[tmpY][curX] = TRUE;
+              heap1.decrease(&d1[tmpY][curX]);
+            }
+          }
+          // top
+          if (curY < regionY2) {
+            grid = curY * xGrid + curX;
+
+            if ((preX == curX) || (d1[curY][curX] == 0)) {
+              tmp = d1[curY][curX]
+                    + v_costTable[v_edges[grid].usage + v_edges[grid].red
+                                  + L * v_edges[grid].last_usage];
+            } else {
+              if (curY > regionY1 + 1) {
+                tmp_grid = (curY - 1) * xGrid + curX;
+                tmp_cost = d1[curY - 1][curX]
+                           + v_costTable[v_edges[tmp_grid].usage
+                                         + v_edges[tmp_grid].red
+                                         + L * v_edges[tmp_grid].last_usage];
+
+                if (tmp_cost < d1[curY][curX] + VIA) {
+                  hyperV[curY][curX] = TRUE;
+                }
+              }
+              tmp = d1[curY][curX] + VIA
+                    + v_costTable[v_edges[grid].usage + v_edges[grid].red
+                                  + L * v_edges[grid].last_usage];
+            }
+            tmpY = curY + 1;  // the top neighbor
+            if (d1[tmpY][curX]
+                >= BIG_INT)  // top neighbor not been put into heap1
+            {
+              d1[tmpY][curX] = tmp;
+              parentX1[tmpY][curX] = curX;
+              parentY1[tmpY][curX] = curY;
+              HV[tmpY][curX] = TRUE;
+              heap1.push(&d1[tmpY][curX]);
+            } else if (d1[tmpY][curX] > tmp)  // top neighbor been put into
+                                              // heap1 but needs update
+            {
+              d1[tmpY][curX] = tmp;
+              parentX1[tmpY][curX] = curX;
+              parentY1[tmpY][curX] = curY;
+              HV[tmpY][curX] = TRUE;
+              heap1.decrease(&d1[tmpY][curX]);
+            }
+          }
+
+          // update ind1 for next loop
+          ind1 = heap1.top();
+
+        }  // while loop
+
+        for (i = 0; i < heapLen2; i++)
+          pop_heap2[(heap2[i] - &d2[0][0])] = FALSE;
+
+        crossX = ind1 % XRANGE;
+        crossY = ind1 / XRANGE;
+
+        cnt = 0;
+        curX = crossX;
+        curY = crossY;
+        std::vector<int> tmp_gridsX, tmp_gridsY;
+        while (d1[curY][curX] != 0)  // loop until reach subtree1
+        {
+          hypered = FALSE;
+          if (cnt != 0) {
+            if (curX != tmpX && hyperH[curY][curX]) {
+              curX = 2 * curX - tmpX;
+              hypered = TRUE;
+            }
+
+            if (curY != tmpY && hyperV[curY][curX]) {
+              curY = 2 * curY - tmpY;
+              hypered = TRUE;
+            }
+          }
+          tmpX = curX;
+          tmpY = curY;
+          if (!hypered) {
+            if (HV[tmpY][tmpX]) {
+              curY = parentY1[tmpY][tmpX];
+            } else {
+              curX = parentX3[tmpY][tmpX];
+            }
+          }
+          tmp_gridsX.push_back(curX);
+          tmp_gridsY.push_back(curY);
+          cnt++;
+        }
+        // reverse the grids on the path
+        std::vector<int> gridsX(tmp_gridsX.rbegin(), tmp_gridsX.rend());
+        std::vector<int> gridsY(tmp_gridsY.rbegin(), tmp_gridsY.rend());
+
+        // add the connection point (crossX, crossY)
+        gridsX.push_back(crossX);
+        gridsY.push_back(crossY);
+        cnt++;
+
+        curX = crossX;
+        curY = crossY;
+        cnt_n1n2 = cnt;
+
+        // change the tree structure according to the new routing for the tree
+        // edge find E1 and E2, and the endpoints of the edges they are on
+        E1x = gridsX[0];
+        E1y = gridsY[0];
+        E2x = gridsX.back();
+        E2y = gridsY.back();
+
+        edge_n1n2 = edgeID;
+        // (1) consider subtree1
+        if (n1 >= deg && (E1x != n1x || E1y != n1y))
+        // n1 is not a pin and E1!=n1, then make change to subtree1,
+        // otherwise, no change to subtree1
+        {
+          // find the endpoints of the edge E1 is on
+          endpt1 = treeedges[corrEdge[E1y][E1x]].n1;
+          endpt2 = treeedges[corrEdge[E1y][E1x]].n2;
+
+          // find A1, A2 and edge_n1A1, edge_n1A2
+          if (treenodes[n1].nbr[0] == n2) {
+            A1 = treenodes[n1].nbr[1];
+            A2 = treenodes[n1].nbr[2];
+            edge_n1A1 = treenodes[n1].edge[1];
+            edge_n1A2 = treenodes[n1].edge[2];
+          } else if (treenodes[n1].nbr[1] == n2) {
+            A1 = treenodes[n1].nbr[0];
+            A2 = treenodes[n1].nbr[2];
+            edge_n1A1 = treenodes[n1].edge[0];
+            edge_n1A2 = treenodes[n1].edge[2];
+          } else {
+            A1 = treenodes[n1].nbr[0];
+            A2 = treenodes[n1].nbr[1];
+            edge_n1A1 = treenodes[n1].edge[0];
+            edge_n1A2 = treenodes[n1].edge[1];
+          }
+
+          if (endpt1 == n1 || endpt2 == n1)  // E1 is on (n1, A1) or (n1, A2)
+          {
+            // if E1 is on (n1, A2), switch A1 and A2 so that E1 is always on
+            // (n1, A1)
+            if (endpt1 == A2 || endpt2 == A2) {
+              tmpi = A1;
+              A1 = A2;
+              A2 = tmpi;
+              tmpi = edge_n1A1;
+              edge_n1A1 = edge_n1A2;
+              edge_n1A2 = tmpi;
+            }
+
+            // update route for edge (n1, A1), (n1, A2)
+            updateRouteType1(treenodes,
+                             n1,
+                             A1,
+                             A2,
+                             E1x,
+                             E1y,
+                             treeedges,
+                             edge_n1A1,
+                             edge_n1A2);
+            // update position for n1
+            treenodes[n1].x = E1x;
+            treenodes[n1].y = E1y;
+          }     // if E1 is on (n1, A1) or (n1, A2)
+          else  // E1 is not on (n1, A1) or (n1, A2), but on (C1, C2)
+          {
+            C1 = endpt1;
+            C2 = endpt2;
+            edge_C1C2 = corrEdge[E1y][E1x];
+
+            // update route for edge (n1, C1), (n1, C2) and (A1, A2)
+            updateRouteType2(treenodes,
+                             n1,
+                             A1,
+                             A2,
+                             C1,
+                             C2,
+                             E1x,
+                             E1y,
+                             treeedges,
+                             edge_n1A1,
+                             edge_n1A2,
+                             edge_C1C2);
+            // update position for n1
+            treenodes[n1].x = E1x;
+            treenodes[n1].y = E1y;
+            // update 3 edges (n1, A1)->(C1, n1), (n1, A2)->(n1, C2), (C1,
+            // C2)->(A1, A2)
+            edge_n1C1 = edge_n1A1;
+            treeedges[edge_n1C1].n1 = C1;
+            treeedges[edge_n1C1].n2 = n1;
+            edge_n1C2 = edge_n1A2;
+            treeedges[edge_n1C2].n1 = n1;
+            treeedges[edge_n1C2].n2 = C2;
+            edge_A1A2 = edge_C1C2;
+            treeedges[edge_A1A2].n1 = A1;
+            treeedges[edge_A1A2].n2 = A2;
+            // update nbr and edge for 5 nodes n1, A1, A2, C1, C2
+            // n1's nbr (n2, A1, A2)->(n2, C1, C2)
+            treenodes[n1].nbr[0] = n2;
+            treenodes[n1].edge[0] = edge_n1n2;
+            treenodes[n1].nbr[1] = C1;
+            treenodes[n1].edge[1] = edge_n1C1;
+            treenodes[n1].nbr[2] = C2;
+            treenodes[n1].edge[2] = edge_n1C2;
+            // A1's nbr n1->A2
+            for (i = 0; i < 3; i++) {
+              if (treenodes[A1].nbr[i] == n1) {
+                treenodes[A1].nbr[i] = A2;
+                treenodes[A1].edge[i] = edge_A1A2;
+                break;
+              }
+            }
+            // A2's nbr n1->A1
+            for (i = 0; i < 3; i++) {
+              if (treenodes[A2].nbr[i] == n1) {
+                treenodes[A2].nbr[i] = A1;
+                treenodes[A2].edge[i] = edge_A1A2;
+                break;
+              }
+            }
+            // C1's nbr C2->n1
+            for (i = 0; i < 3; i++) {
+              if (treenodes[C1].nbr[i] == C2) {
+                treenodes[C1].nbr[i] = n1;
+                treenodes[C1].edge[i] = edge_n1C1;
+                break;
+              }
+            }
+            // C2's nbr C1->n1
+            for (i = 0; i < 3; i++) {
+              if (treenodes[C2].nbr[i] == C1) {
+                treenodes[C2].nbr[i] = n1;
+                treenodes[C2].edge[i] = edge_n1C2;
+                break;
+              }
+            }
+
+          }  // else E1 is not on (n1, A1) or (n1, A2), but on (C1, C2)
+        }    // n1 is not a pin and E1!=n1
+
+        // (2) consider subtree2
+        if (n2 >= deg && (E2x != n2x || E2y != n2y))
+        // n2 is not a pin and E2!=n2, then make change to subtree2,
+        // otherwise, no change to subtree2
+        {
+          // find the endpoints of the edge E1 is on
+          endpt1 = treeedges[corrEdge[E2y][E2x]].n1;
+          endpt2 = treeedges[corrEdge[E2y][E2x]].n2;
+
+          // find B1, B2
+          if (treenodes[n2].nbr[0] == n1) {
+            B1 = treenodes[n2].nbr[1];
+            B2 = treenodes[n2].nbr[2];
+            edge_n2B1 = treenodes[n2].edge[1];
+            edge_n2B2 = treenodes[n2].edge[2];
+          } else if (treenodes[n2].nbr[1] == n1) {
+            B1 = treenodes[n2].nbr[0];
+            B2 = treenodes[n2].nbr[2];
+            edge_n2B1 = treenodes[n2].edge[0];
+            edge_n2B2 = treenodes[n2].edge[2];
+          } else {
+            B1 = treenodes[n2].nbr[0];
+            B2 = treenodes[n2].nbr[1];
+            edge_n2B1 = treenodes[n2].edge[0];
+            edge_n2B2 = treenodes[n2].edge[1];
+          }
+
+          if (endpt1 == n2 || endpt2 == n2)  // E2 is on (n2, B1) or (n2, B2)
+          {
+            // if E2 is on (n2, B2), switch B1 and B2 so that E2 is always on
+            // (n2, B1)
+            if (endpt1 == B2 || endpt2 == B2) {
+              tmpi = B1;
+              B1 = B2;
+              B2 = tmpi;
+              tmpi = edge_n2B1;
+              edge_n2B1 = edge_n2B2;
+              edge_n2B2 = tmpi;
+            }
+
+            // update route for edge (n2, B1), (n2, B2)
+            updateRouteType1(treenodes,
+                             n2,
+                             B1,
+                             B2,
+                             E2x,
+                             E2y,
+                             treeedges,
+                             edge_n2B1,
+                             edge_n2B2);
+
+            // update position for n2
+            treenodes[n2].x = E2x;
+            treenodes[n2].y = E2y;
+          }     // if E2 is on (n2, B1) or (n2, B2)
+          else  // E2 is not on (n2, B1) or (n2, B2), but on (D1, D2)
+          {
+            D1 = endpt1;
+            D2 = endpt2;
+            edge_D1D2 = corrEdge[E2y][E2x];
+
+            // update route for edge (n2, D1), (n2, D2) and (B1, B2)
+            updateRouteType2(treenodes,
+                             n2,
+                             B1,
+                             B2,
+                             D1,
+                             D2,
+                             E2x,
+                             E2y,
+                             treeedges,
+                             edge_n2B1,
+                             edge_n2B2,
+                             edge_D1D2);
+            // update position for n2
+            treenodes[n2].x = E2x;
+            treenodes[n2].y = E2y;
+            // update 3 edges (n2, B1)->(D1, n2), (n2, B2)->(n2, D2), (D1,
+            // D2)->(B1, B2)
+            edge_n2D1 = edge_n2B1;
+            treeedges[edge_n2D1].n1 = D1;
+            treeedges[edge_n2D1].n2 = n2;
+            edge_n2D2 = edge_n2B2;
+            treeedges[edge_n2D2].n1 = n2;
+            treeedges[edge_n2D2].n2 = D2;
+            edge_B1B2 = edge_D1D2;
+            treeedges[edge_B1B2].n1 = B1;
+            treeedges[edge_B1B2].n2 = B2;
+            // update nbr and edge for 5 nodes n2, B1, B2, D1, D2
+            // n1's nbr (n1, B1, B2)->(n1, D1, D2)
+            treenodes[n2].nbr[0] = n1;
+            treenodes[n2].edge[0] = edge_n1n2;
+            treenodes[n2].nbr[1] = D1;
+            treenodes[n2].edge[1] = edge_n2D1;
+            treenodes[n2].nbr[2] = D2;
+            treenodes[n2].edge[2] = edge_n2D2;
+            // B1's nbr n2->B2
+            for (i = 0; i < 3; i++) {
+              if (treenodes[B1].nbr[i] == n2) {
+                treenodes[B1].nbr[i] = B2;
+                treenodes[B1].edge[i] = edge_B1B2;
+                break;
+              }
+            }
+            // B2's nbr n2->B1
+            for (i = 0; i < 3; i++) {
+              if (treenodes[B2].nbr[i] == n2) {
+                treenodes[B2].nbr[i] = B1;
+                treenodes[B2].edge[i] = edge_B1B2;
+                break;
+              }
+            }
+            // D1's nbr D2->n2
+            for (i = 0; i < 3; i++) {
+              if (treenodes[D1].nbr[i] == D2) {
+                treenodes[D1].nbr[i] = n2;
+                treenodes[D1].edge[i] = edge_n2D1;
+                break;
+              }
+            }
+            // D2's nbr D1->n2
+            for (i = 0; i < 3; i++) {
+              if (treenodes[D2].nbr[i] == D1) {
+                treenodes[D2].nbr[i] = n2;
+                treenodes[D2].edge[i] = edge_n2D2;
+                break;
+              }
+            }
+          }  // else E2 is not on (n2, B1) or (n2, B2), but on (D1, D2)
+        }    // n2 is not a pin and E2!=n2
+
+        // update route for edge (n1, n2) and edge usage
+        if (treeedges[edge_n1n2].route.type == MAZEROUTE) {
+          free(treeedges[edge_n1n2].route.gridsX);
+          free(treeedges[edge_n1n2].route.gridsY);
+        }
+        treeedges[edge_n1n2].route.gridsX
+            = (short*) calloc(cnt_n1n2, sizeof(short));
+        treeedges[edge_n1n2].route.gridsY
+            = (short*) calloc(cnt_n1n2, sizeof(short));
+        treeedges[edge_n1n2].route.type = MAZEROUTE;
+        treeedges[edge_n1n2].route.routelen = cnt_n1n2 - 1;
+        treeedges[edge_n1n2].len = ADIFF(E1x, E2x) + ADIFF(E1y, E2y);
+
+        for (i = 0; i < cnt_n1n2; i++) {
+          treeedges[edge_n1n2].route.gridsX[i] = gridsX[i];
+          treeedges[edge_n1n2].route.gridsY[i] = gridsY[i];
+        }
+
+        int edgeCost = nets[netID]->edgeCost;
+
+        // update edge usage
+        for (i = 0; i < cnt_n1n2 - 1; i++) {
+          if (gridsX[i] == gridsX[i + 1])  // a vertical edge
+          {
+            min_y = std::min(gridsY[i], gridsY[i + 1]);
+            v_edges[min_y * xGrid + gridsX[i]].usage += edgeCost;
+          } else  /// if(gridsY[i]==gridsY[i+1])// a horizontal edge
+          {
+            min_x = std::min(gridsX[i], gridsX[i + 1]);
+            h_edges[gridsY[i] * (xGrid - 1) + min_x].usage += edgeCost;
+          }
+        }
+
+        if (checkRoute2DTree(netID)) {
+          return TRUE;
+        }
+      }  // congested route
+    }    // maze routing
+  }      // loop edgeID
+
+  return FALSE;
+}
+
+void FastRouteCore::mazeRouteMSMD(int iter,
+                                  int expand,
+                                  float costHeight,
+                                  int ripup_threshold,
+                                  int mazeedge_Threshold,
+                                  Bool Ordering,
+                                  int cost_type)
+{
+  int i, j;
+  float forange;
+
   // allocate memory for distance and parent and pop_heap
   h_costTable = new float[40 * hCapacity];
   v_costTable = new float[40 * vCapacity];
@@ -1162,689 +1751,245 @@ void mazeRouteMSMD(int iter,
     StNetOrder();
   }
 
-  for (nidRPC = 0; nidRPC < numValidNets; nidRPC++) {
-    if (Ordering) {
-      netID = treeOrderCong[nidRPC].treeIndex;
-    } else {
-      netID = nidRPC;
-    }
-
-    deg = sttrees[netID].deg;
+  mazeRouteMSMDBatches(
+      iter, expand, ripup_threshold, mazeedge_Threshold, Ordering);
 
-    origENG = expand;
+  if (!h_costTable) {
+    delete[] h_costTable;
+  }
+  if (!v_costTable) {
+    delete[] v_costTable;
+  }
+}
 
-    netedgeOrderDec(netID);
+// check whether any edge mazeRouteNet would consider has a congested route,
+// with the same test as newRipupCheck
+Bool FastRouteCore::netCongested(int netID,
+                                 int ripup_threshold,
+                                 int mazeedge_Threshold)
+{
+  int i, edgeID, n1, n2, grid, ymin, xmin;
+  short *gridsX, *gridsY;
+  TreeEdge* treeedge;
 
-    treeedges = sttrees[netID].edges;
-    treenodes = sttrees[netID].nodes;
-    // loop for all the tree edges (2*deg-3)
-    num_edges = 2 * deg - 3;
-    for (edgeREC = 0; edgeREC < num_edges; edgeREC++) {
-      edgeID = netEO[edgeREC].edgeID;
-      treeedge = &(treeedges[edgeID]);
+  TreeEdge* treeedges = sttrees[netID].edges;
+  TreeNode* treenodes = sttrees[netID].nodes;
 
-      n1 = treeedge->n1;
-      n2 = treeedge->n2;
-      n1x = treenodes[n1].x;
-      n1y = treenodes[n1].y;
-      n2x = treenodes[n2].x;
-      n2y = treenodes[n2].y;
-      treeedge->len = ADIFF(n2x, n1x) + ADIFF(n2y, n1y);
+  for (edgeID = 0; edgeID < 2 * sttrees[netID].deg - 3; edgeID++) {
+    treeedge = &(treeedges[edgeID]);
+    n1 = treeedge->n1;
+    n2 = treeedge->n2;
+    if (ADIFF(treenodes[n2].x, treenodes[n1].x)
+                + ADIFF(treenodes[n2].y, treenodes[n1].y)
+            <= mazeedge_Threshold
+        || treeedge->route.type != MAZEROUTE) {
+      continue;
+    }
 
-      if (treeedge->len
-          > mazeedge_Threshold)  // only route the non-degraded edges (len>0)
+    gridsX = treeedge->route.gridsX;
+    gridsY = treeedge->route.gridsY;
+    for (i = 0; i < treeedge->route.routelen; i++) {
+      if (gridsX[i] == gridsX[i + 1])  // a vertical edge
       {
-        enter = newRipupCheck(
-            treeedge, n1x, n1y, n2x, n2y, ripup_threshold, netID, edgeID);
-
-        // ripup the routing for the edge
-        if (enter) {
-          if (n1y <= n2y) {
-            ymin = n1y;
-            ymax = n2y;
-          } else {
-            ymin = n2y;
-            ymax = n1y;
-          }
-
-          if (n1x <= n2x) {
-            xmin = n1x;
-            xmax = n2x;
-          } else {
-            xmin = n2x;
-            xmax = n1x;
-          }
-
-          enlarge
-              = std::min(origENG, (iter / 6 + 3) * treeedge->route.routelen);
-          regionX1 = std::max(0, xmin - enlarge);
-          regionX2 = std::min(xGrid - 1, xmax + enlarge);
-          regionY1 = std::max(0, ymin - enlarge);
-          regionY2 = std::min(yGrid - 1, ymax + enlarge);
-
-          // initialize d1[][] and d2[][] as BIG_INT
-          for (i = regionY1; i <= regionY2; i++) {
-            for (j = regionX1; j <= regionX2; j++) {
-              d1[i][j] = BIG_INT;
-              d2[i][j] = BIG_INT;
-              hyperH[i][j] = FALSE;
-              hyperV[i][j] = FALSE;
-            }
-          }
+        ymin = std::min(gridsY[i], gridsY[i + 1]);
+        grid = ymin * xGrid + gridsX[i];
+        if (v_edges[grid].usage + v_edges[grid].red
+            >= vCapacity - ripup_threshold) {
+          return (TRUE);
+        }
+      } else if (gridsY[i] == gridsY[i + 1])  // a horizontal edge
+      {
+        xmin = std::min(gridsX[i], gridsX[i + 1]);
+        grid = gridsY[i] * (xGrid - 1) + xmin;
+        if (h_edges[grid].usage + h_edges[grid].red
+            >= hCapacity - ripup_threshold) {
+          return (TRUE);
+        }
+      }
+    }
+  }
 
-          // setup heap1, heap2 and initialize d1[][] and d2[][] for all the
-          // grids on the two subtrees
-          setupHeap(netID,
-                    edgeID,
-                    &heapLen1,
-                    &heapLen2,
-                    regionX1,
-                    regionX2,
-                    regionY1,
-                    regionY2);
-
-          // while loop to find shortest path
-          ind1 = (heap1[0] - &d1[0][0]);
-          for (i = 0; i < heapLen2; i++)
-            pop_heap2[(heap2[i] - &d2[0][0])] = TRUE;
-
-          while (pop_heap2[ind1]
-                 == FALSE)  // stop until the grid position been popped out from
-                            // both heap1 and heap2
-          {
-            // relax all the adjacent grids within the enlarged region for
-            // source subtree
-            curX = ind1 % XRANGE;
-            curY = ind1 / XRANGE;
-            if (d1[curY][curX] != 0) {
-              if (HV[curY][curX]) {
-                preX = parentX1[curY][curX];
-                preY = parentY1[curY][curX];
-              } else {
-                preX = parentX3[curY][curX];
-                preY = parentY3[curY][curX];
-              }
-            } else {
-              preX = curX;
-              preY = curY;
-            }
+  return (FALSE);
+}
 
-            extractMin(heap1, heapLen1);
-            heapLen1--;
-
-            // left
-            if (curX > regionX1) {
-              grid = curY * (xGrid - 1) + curX - 1;
-              if ((preY == curY) || (d1[curY][curX] == 0)) {
-                tmp = d1[curY][curX]
-                      + h_costTable[h_edges[grid].usage + h_edges[grid].red
-                                    + L * h_edges[grid].last_usage];
-              } else {
-                if (curX < regionX2 - 1) {
-                  tmp_grid = curY * (xGrid - 1) + curX;
-                  tmp_cost = d1[curY][curX + 1]
-                             + h_costTable[h_edges[tmp_grid].usage
-                                           + h_edges[tmp_grid].red
-                                           + L * h_edges[tmp_grid].last_usage];
-
-                  if (tmp_cost < d1[curY][curX] + VIA) {
-                    hyperH[curY][curX] = TRUE;
-                  }
-                }
-                tmp = d1[curY][curX] + VIA
-                      + h_costTable[h_edges[grid].usage + h_edges[grid].red
-                                    + L * h_edges[grid].last_usage];
-              }
-              tmpX = curX - 1;  // the left neighbor
-
-              if (d1[curY][tmpX]
-                  >= BIG_INT)  // left neighbor not been put into heap1
-              {
-                d1[curY][tmpX] = tmp;
-                parentX3[curY][tmpX] = curX;
-                parentY3[curY][tmpX] = curY;
-                HV[curY][tmpX] = FALSE;
-                heap1[heapLen1] = &d1[curY][tmpX];
-                heapLen1++;
-                updateHeap(heap1, heapLen1, heapLen1 - 1);
-              } else if (d1[curY][tmpX] > tmp)  // left neighbor been put into
-                                                // heap1 but needs update
-              {
-                d1[curY][tmpX] = tmp;
-                parentX3[curY][tmpX] = curX;
-                parentY3[curY][tmpX] = curY;
-                HV[curY][tmpX] = FALSE;
-                dtmp = &d1[curY][tmpX];
-                ind = 0;
-                while (heap1[ind] != dtmp)
-                  ind++;
-                updateHeap(heap1, heapLen1, ind);
-              }
-            }
-            // right
-            if (curX < regionX2) {
-              grid = curY * (xGrid - 1) + curX;
-              if ((preY == curY) || (d1[curY][curX] == 0)) {
-                tmp = d1[curY][curX]
-                      + h_costTable[h_edges[grid].usage + h_edges[grid].red
-                                    + L * h_edges[grid].last_usage];
-              } else {
-                if (curX > regionX1 + 1) {
-                  tmp_grid = curY * (xGrid - 1) + curX - 1;
-                  tmp_cost = d1[curY][curX - 1]
-                             + h_costTable[h_edges[tmp_grid].usage
-                                           + h_edges[tmp_grid].red
-                                           + L * h_edges[tmp_grid].last_usage];
-
-                  if (tmp_cost < d1[curY][curX] + VIA) {
-                    hyperH[curY][curX] = TRUE;
-                  }
-                }
-                tmp = d1[curY][curX] + VIA
-                      + h_costTable[h_edges[grid].usage + h_edges[grid].red
-                                    + L * h_edges[grid].last_usage];
-              }
-              tmpX = curX + 1;  // the right neighbor
-
-              if (d1[curY][tmpX]
-                  >= BIG_INT)  // right neighbor not been put into heap1
-              {
-                d1[curY][tmpX] = tmp;
-                parentX3[curY][tmpX] = curX;
-                parentY3[curY][tmpX] = curY;
-                HV[curY][tmpX] = FALSE;
-                heap1[heapLen1] = &d1[curY][tmpX];
-                heapLen1++;
-                updateHeap(heap1, heapLen1, heapLen1 - 1);
-              } else if (d1[curY][tmpX] > tmp)  // right neighbor been put into
-                                                // heap1 but needs update
-              {
-                d1[curY][tmpX] = tmp;
-                parentX3[curY][tmpX] = curX;
-                parentY3[curY][tmpX] = curY;
-                HV[curY][tmpX] = FALSE;
-                dtmp = &d1[curY][tmpX];
-                ind = 0;
-                while (heap1[ind] != dtmp)
-                  ind++;
-                updateHeap(heap1, heapLen1, ind);
-              }
-            }
-            // bottom
-            if (curY > regionY1) {
-              grid = (curY - 1) * xGrid + curX;
-
-              if ((preX == curX) || (d1[curY][curX] == 0)) {
-                tmp = d1[curY][curX]
-                      + v_costTable[v_edges[grid].usage + v_edges[grid].red
-                                    + L * v_edges[grid].last_usage];
-              } else {
-                if (curY < regionY2 - 1) {
-                  tmp_grid = curY * xGrid + curX;
-                  tmp_cost = d1[curY + 1][curX]
-                             + v_costTable[v_edges[tmp_grid].usage
-                                           + v_edges[tmp_grid].red
-                                           + L * v_edges[tmp_grid].last_usage];
-
-                  if (tmp_cost < d1[curY][curX] + VIA) {
-                    hyperV[curY][curX] = TRUE;
-                  }
-                }
-                tmp = d1[curY][curX] + VIA
-                      + v_costTable[v_edges[grid].usage + v_edges[grid].red
-                                    + L * v_edges[grid].last_usage];
-              }
-              tmpY = curY - 1;  // the bottom neighbor
-              if (d1[tmpY][curX]
-                  >= BIG_INT)  // bottom neighbor not been put into heap1
-              {
-                d1[tmpY][curX] = tmp;
-                parentX1[tmpY][curX] = curX;
-                parentY1[tmpY][curX] = curY;
-                HV[tmpY][curX] = TRUE;
-                heap1[heapLen1] = &d1[tmpY][curX];
-                heapLen1++;
-                updateHeap(heap1, heapLen1, heapLen1 - 1);
-              } else if (d1[tmpY][curX] > tmp)  // bottom neighbor been put into
-                                                // heap1 but needs update
-              {
-                d1[tmpY][curX] = tmp;
-                parentX1[tmpY][curX] = curX;
-                parentY1[tmpY][curX] = curY;
-                HV[tmpY][curX] = TRUE;
-                dtmp = &d1[tmpY][curX];
-                ind = 0;
-                while (heap1[ind] != dtmp)
-                  ind++;
-                updateHeap(heap1, heapLen1, ind);
-              }
-            }
-            // top
-            if (curY < regionY2) {
-              grid = curY * xGrid + curX;
-
-              if ((preX == curX) || (d1[curY][curX] == 0)) {
-                tmp = d1[curY][curX]
-                      + v_costTable[v_edges[grid].usage + v_edges[grid].red
-                                    + L * v_edges[grid].last_usage];
-              } else {
-                if (curY > regionY1 + 1) {
-                  tmp_grid = (curY - 1) * xGrid + curX;
-                  tmp_cost = d1[curY - 1][curX]
-                             + v_costTable[v_edges[tmp_grid].usage
-                                           + v_edges[tmp_grid].red
-                                           + L * v_edges[tmp_grid].last_usage];
-
-                  if (tmp_cost < d1[curY][curX] + VIA) {
-                    hyperV[curY][curX] = TRUE;
-                  }
-                }
-                tmp = d1[curY][curX] + VIA
-                      + v_costTable[v_edges[grid].usage + v_edges[grid].red
-                                    + L * v_edges[grid].last_usage];
-              }
-              tmpY = curY + 1;  // the top neighbor
-              if (d1[tmpY][curX]
-                  >= BIG_INT)  // top neighbor not been put into heap1
-              {
-                d1[tmpY][curX] = tmp;
-                parentX1[tmpY][curX] = curX;
-                parentY1[tmpY][curX] = curY;
-                HV[tmpY][curX] = TRUE;
-                heap1[heapLen1] = &d1[tmpY][curX];
-                heapLen1++;
-                updateHeap(heap1, heapLen1, heapLen1 - 1);
-              } else if (d1[tmpY][curX] > tmp)  // top neighbor been put into
-                                                // heap1 but needs update
-              {
-                d1[tmpY][curX] = tmp;
-                parentX1[tmpY][curX] = curX;
-                parentY1[tmpY][curX] = curY;
-                HV[tmpY][curX] = TRUE;
-                dtmp = &d1[tmpY][curX];
-                ind = 0;
-                while (heap1[ind] != dtmp)
-                  ind++;
-                updateHeap(heap1, heapLen1, ind);
-              }
-            }
+// the bounding box of the nodes and routes of a net enlarged by expand. The
+// nodes and routes stay inside while the net is maze routed within it.
+MazeRegion FastRouteCore::netRegion(int netID, int expand)
+{
+  int i, d, edgeID;
+  Route* route;
 
-            // update ind1 for next loop
-            ind1 = (heap1[0] - &d1[0][0]);
+  TreeEdge* treeedges = sttrees[netID].edges;
+  TreeNode* treenodes = sttrees[netID].nodes;
+  int deg = sttrees[netID].deg;
 
-          }  // while loop
+  MazeRegion region = {xGrid, -1, yGrid, -1};
+  for (d = 0; d < 2 * deg - 2; d++) {
+    region.x1 = std::min(region.x1, (int) treenodes[d].x);
+    region.x2 = std::max(region.x2, (int) treenodes[d].x);
+    region.y1 = std::min(region.y1, (int) treenodes[d].y);
+    region.y2 = std::max(region.y2, (int) treenodes[d].y);
+  }
+  for (edgeID = 0; edgeID < 2 * deg - 3; edgeID++) {
+    route = &(treeedges[edgeID].route);
+    if (treeedges[edgeID].len > 0 && route->type == MAZEROUTE) {
+      for (i = 0; i <= route->routelen; i++) {
+        region.x1 = std::min(region.x1, (int) route->gridsX[i]);
+        region.x2 = std::max(region.x2, (int) route->gridsX[i]);
+        region.y1 = std::min(region.y1, (int) route->gridsY[i]);
+        region.y2 = std::max(region.y2, (int) route->gridsY[i]);
+      }
+    }
+  }
 
-          for (i = 0; i < heapLen2; i++)
-            pop_heap2[(heap2[i] - &d2[0][0])] = FALSE;
+  region.x1 = std::max(0, region.x1 - expand);
+  region.x2 = std::min(xGrid - 1, region.x2 + expand);
+  region.y1 = std::max(0, region.y1 - expand);
+  region.y2 = std::min(yGrid - 1, region.y2 + expand);
 
-          crossX = ind1 % XRANGE;
-          crossY = ind1 / XRANGE;
+  return region;
+}
 
-          cnt = 0;
-          curX = crossX;
-          curY = crossY;
-          std::vector<int> tmp_gridsX, tmp_gridsY;
-          while (d1[curY][curX] != 0)  // loop until reach subtree1
-          {
-            hypered = FALSE;
-            if (cnt != 0) {
-              if (curX != tmpX && hyperH[curY][curX]) {
-                curX = 2 * curX - tmpX;
-                hypered = TRUE;
-              }
+// an upper bound of the entries of heap2 (heap23D) maze routing a net
+// needs. setupHeap puts each node once per layer and each grid of the routes
+// once into it.
+int FastRouteCore::mazeHeapSize(int netID, int layers)
+{
+  int edgeID;
+  int size = 2 * sttrees[netID].deg * layers;
 
-              if (curY != tmpY && hyperV[curY][curX]) {
-                curY = 2 * curY - tmpY;
-                hypered = TRUE;
-              }
-            }
-            tmpX = curX;
-            tmpY = curY;
-            if (!hypered) {
-              if (HV[tmpY][tmpX]) {
-                curY = parentY1[tmpY][tmpX];
-              } else {
-                curX = parentX3[tmpY][tmpX];
-              }
-            }
-            tmp_gridsX.push_back(curX);
-            tmp_gridsY.push_back(curY);
-            cnt++;
-          }
-          // reverse the grids on the path
-          std::vector<int> gridsX(tmp_gridsX.rbegin(), tmp_gridsX.rend());
-          std::vector<int> gridsY(tmp_gridsY.rbegin(), tmp_gridsY.rend());
+  for (edgeID = 0; edgeID < 2 * sttrees[netID].deg - 3; edgeID++) {
+    if (sttrees[netID].edges[edgeID].len > 0) {
+      size += sttrees[netID].edges[edgeID].route.routelen + 1;
+    }
+  }
 
-          // add the connection point (crossX, crossY)
-          gridsX.push_back(crossX);
-          gridsY.push_back(crossY);
-          cnt++;
+  return size;
+}
 
-          curX = crossX;
-          curY = crossY;
-          cnt_n1n2 = cnt;
-
-          // change the tree structure according to the new routing for the tree
-          // edge find E1 and E2, and the endpoints of the edges they are on
-          E1x = gridsX[0];
-          E1y = gridsY[0];
-          E2x = gridsX.back();
-          E2y = gridsY.back();
-
-          edge_n1n2 = edgeID;
-          // (1) consider subtree1
-          if (n1 >= deg && (E1x != n1x || E1y != n1y))
-          // n1 is not a pin and E1!=n1, then make change to subtree1,
-          // otherwise, no change to subtree1
-          {
-            // find the endpoints of the edge E1 is on
-            endpt1 = treeedges[corrEdge[E1y][E1x]].n1;
-            endpt2 = treeedges[corrEdge[E1y][E1x]].n2;
-
-            // find A1, A2 and edge_n1A1, edge_n1A2
-            if (treenodes[n1].nbr[0] == n2) {
-              A1 = treenodes[n1].nbr[1];
-              A2 = treenodes[n1].nbr[2];
-              edge_n1A1 = treenodes[n1].edge[1];
-              edge_n1A2 = treenodes[n1].edge[2];
-            } else if (treenodes[n1].nbr[1] == n2) {
-              A1 = treenodes[n1].nbr[0];
-              A2 = treenodes[n1].nbr[2];
-              edge_n1A1 = treenodes[n1].edge[0];
-              edge_n1A2 = treenodes[n1].edge[2];
-            } else {
-              A1 = treenodes[n1].nbr[0];
-              A2 = treenodes[n1].nbr[1];
-              edge_n1A1 = treenodes[n1].edge[0];
-              edge_n1A2 = treenodes[n1].edge[1];
-            }
+// split nets, given in routing order with their regions, into batches of
+// nets with disjoint regions. A net goes into the batch after the last one
+// with a net it overlaps, so overlapping nets keep their routing order and
+// the result does not depend on how a batch is scheduled.
+void FastRouteCore::mazeBatches(const std::vector<MazeRegion>& regions,
+                                std::vector<std::vector<int>>& batches)
+{
+  int i, j, net, batch;
+  // for every grid, the number of batches holding a net over it
+  std::vector<int> depth(xGrid * yGrid, 0);
+
+  batches.clear();
+  for (net = 0; net < regions.size(); net++) {
+    const MazeRegion& region = regions[net];
+    batch = 0;
+    for (i = region.y1; i <= region.y2; i++) {
+      for (j = region.x1; j <= region.x2; j++)
+        batch = std::max(batch, depth[i * xGrid + j]);
+    }
+    for (i = region.y1; i <= region.y2; i++) {
+      for (j = region.x1; j <= region.x2; j++)
+        depth[i * xGrid + j] = batch + 1;
+    }
 
-            if (endpt1 == n1 || endpt2 == n1)  // E1 is on (n1, A1) or (n1, A2)
-            {
-              // if E1 is on (n1, A2), switch A1 and A2 so that E1 is always on
-              // (n1, A1)
-              if (endpt1 == A2 || endpt2 == A2) {
-                tmpi = A1;
-                A1 = A2;
-                A2 = tmpi;
-                tmpi = edge_n1A1;
-                edge_n1A1 = edge_n1A2;
-                edge_n1A2 = tmpi;
-              }
+    if (batch == batches.size()) {
+      batches.emplace_back();
+    }
+    batches[batch].push_back(net);
+  }
+}
 
-              // update route for edge (n1, A1), (n1, A2)
-              updateRouteType1(treenodes,
-                               n1,
-                               A1,
-                               A2,
-                               E1x,
-                               E1y,
-                               treeedges,
-                               edge_n1A1,
-                               edge_n1A2);
-              // update position for n1
-              treenodes[n1].x = E1x;
-              treenodes[n1].y = E1y;
-            }     // if E1 is on (n1, A1) or (n1, A2)
-            else  // E1 is not on (n1, A1) or (n1, A2), but on (C1, C2)
-            {
-              C1 = endpt1;
-              C2 = endpt2;
-              edge_C1C2 = corrEdge[E1y][E1x];
-
-              // update route for edge (n1, C1), (n1, C2) and (A1, A2)
-              updateRouteType2(treenodes,
-                               n1,
-                               A1,
-                               A2,
-                               C1,
-                               C2,
-                               E1x,
-                               E1y,
-                               treeedges,
-                               edge_n1A1,
-                               edge_n1A2,
-                               edge_C1C2);
-              // update position for n1
-              treenodes[n1].x = E1x;
-              treenodes[n1].y = E1y;
-              // update 3 edges (n1, A1)->(C1, n1), (n1, A2)->(n1, C2), (C1,
-              // C2)->(A1, A2)
-              edge_n1C1 = edge_n1A1;
-              treeedges[edge_n1C1].n1 = C1;
-              treeedges[edge_n1C1].n2 = n1;
-              edge_n1C2 = edge_n1A2;
-              treeedges[edge_n1C2].n1 = n1;
-              treeedges[edge_n1C2].n2 = C2;
-              edge_A1A2 = edge_C1C2;
-              treeedges[edge_A1A2].n1 = A1;
-              treeedges[edge_A1A2].n2 = A2;
-              // update nbr and edge for 5 nodes n1, A1, A2, C1, C2
-              // n1's nbr (n2, A1, A2)->(n2, C1, C2)
-              treenodes[n1].nbr[0] = n2;
-              treenodes[n1].edge[0] = edge_n1n2;
-              treenodes[n1].nbr[1] = C1;
-              treenodes[n1].edge[1] = edge_n1C1;
-              treenodes[n1].nbr[2] = C2;
-              treenodes[n1].edge[2] = edge_n1C2;
-              // A1's nbr n1->A2
-              for (i = 0; i < 3; i++) {
-                if (treenodes[A1].nbr[i] == n1) {
-                  treenodes[A1].nbr[i] = A2;
-                  treenodes[A1].edge[i] = edge_A1A2;
-                  break;
-                }
-              }
-              // A2's nbr n1->A1
-              for (i = 0; i < 3; i++) {
-                if (treenodes[A2].nbr[i] == n1) {
-                  treenodes[A2].nbr[i] = A1;
-                  treenodes[A2].edge[i] = edge_A1A2;
-                  break;
-                }
-              }
-              // C1's nbr C2->n1
-              for (i = 0; i < 3; i++) {
-                if (treenodes[C1].nbr[i] == C2) {
-                  treenodes[C1].nbr[i] = n1;
-                  treenodes[C1].edge[i] = edge_n1C1;
-                  break;
-                }
-              }
-              // C2's nbr C1->n1
-              for (i = 0; i < 3; i++) {
-                if (treenodes[C2].nbr[i] == C1) {
-                  treenodes[C2].nbr[i] = n1;
-                  treenodes[C2].edge[i] = edge_n1C2;
-                  break;
-                }
-              }
+// the nets of a mazeRouteMSMD round. The nets congested at the start of the
+// round are batched by mazeBatches and the nets of a batch rerouted on
+// numThreads threads, each within its region. One thread routes the same
+// nets in the same order, so the result does not depend on numThreads.
+// d1, d2 and the other grid indexed arrays are shared, the heaps are per
+// thread.
+void FastRouteCore::mazeRouteMSMDBatches(int iter,
+                                         int expand,
+                                         int ripup_threshold,
+                                         int mazeedge_Threshold,
+                                         Bool Ordering)
+{
+  int nidRPC, netID;
+  std::vector<int> netIDs;
+  std::vector<MazeRegion> regions;
 
-            }  // else E1 is not on (n1, A1) or (n1, A2), but on (C1, C2)
-          }    // n1 is not a pin and E1!=n1
+  for (nidRPC = 0; nidRPC < numValidNets; nidRPC++) {
+    if (Ordering) {
+      netID = treeOrderCong[nidRPC].treeIndex;
+    } else {
+      netID = nidRPC;
+    }
 
-          // (2) consider subtree2
-          if (n2 >= deg && (E2x != n2x || E2y != n2y))
-          // n2 is not a pin and E2!=n2, then make change to subtree2,
-          // otherwise, no change to subtree2
-          {
-            // find the endpoints of the edge E1 is on
-            endpt1 = treeedges[corrEdge[E2y][E2x]].n1;
-            endpt2 = treeedges[corrEdge[E2y][E2x]].n2;
-
-            // find B1, B2
-            if (treenodes[n2].nbr[0] == n1) {
-              B1 = treenodes[n2].nbr[1];
-              B2 = treenodes[n2].nbr[2];
-              edge_n2B1 = treenodes[n2].edge[1];
-              edge_n2B2 = treenodes[n2].edge[2];
-            } else if (treenodes[n2].nbr[1] == n1) {
-              B1 = treenodes[n2].nbr[0];
-              B2 = treenodes[n2].nbr[2];
-              edge_n2B1 = treenodes[n2].edge[0];
-              edge_n2B2 = treenodes[n2].edge[2];
-            } else {
-              B1 = treenodes[n2].nbr[0];
-              B2 = treenodes[n2].nbr[1];
-              edge_n2B1 = treenodes[n2].edge[0];
-              edge_n2B2 = treenodes[n2].edge[1];
-            }
+    if (netCongested(netID, ripup_threshold, mazeedge_Threshold)) {
+      netIDs.push_back(netID);
+      regions.push_back(netRegion(netID, expand));
+    }
+  }
 
-            if (endpt1 == n2 || endpt2 == n2)  // E2 is on (n2, B1) or (n2, B2)
-            {
-              // if E2 is on (n2, B2), switch B1 and B2 so that E2 is always on
-              // (n2, B1)
-              if (endpt1 == B2 || endpt2 == B2) {
-                tmpi = B1;
-                B1 = B2;
-                B2 = tmpi;
-                tmpi = edge_n2B1;
-                edge_n2B1 = edge_n2B2;
-                edge_n2B2 = tmpi;
-              }
+  std::vector<std::vector<int>> batches;
+  mazeBatches(regions, batches);
 
-              // update route for edge (n2, B1), (n2, B2)
-              updateRouteType1(treenodes,
-                               n2,
-                               B1,
-                               B2,
-                               E2x,
-                               E2y,
-                               treeedges,
-                               edge_n2B1,
-                               edge_n2B2);
-
-              // update position for n2
-              treenodes[n2].x = E2x;
-              treenodes[n2].y = E2y;
-            }     // if E2 is on (n2, B1) or (n2, B2)
-            else  // E2 is not on (n2, B1) or (n2, B2), but on (D1, D2)
-            {
-              D1 = endpt1;
-              D2 = endpt2;
-              edge_D1D2 = corrEdge[E2y][E2x];
-
-              // update route for edge (n2, D1), (n2, D2) and (B1, B2)
-              updateRouteType2(treenodes,
-                               n2,
-                               B1,
-                               B2,
-                               D1,
-                               D2,
-                               E2x,
-                               E2y,
-                               treeedges,
-                               edge_n2B1,
-                               edge_n2B2,
-                               edge_D1D2);
-              // update position for n2
-              treenodes[n2].x = E2x;
-              treenodes[n2].y = E2y;
-              // update 3 edges (n2, B1)->(D1, n2), (n2, B2)->(n2, D2), (D1,
-              // D2)->(B1, B2)
-              edge_n2D1 = edge_n2B1;
-              treeedges[edge_n2D1].n1 = D1;
-              treeedges[edge_n2D1].n2 = n2;
-              edge_n2D2 = edge_n2B2;
-              treeedges[edge_n2D2].n1 = n2;
-              treeedges[edge_n2D2].n2 = D2;
-              edge_B1B2 = edge_D1D2;
-              treeedges[edge_B1B2].n1 = B1;
-              treeedges[edge_B1B2].n2 = B2;
-              // update nbr and edge for 5 nodes n2, B1, B2, D1, D2
-              // n1's nbr (n1, B1, B2)->(n1, D1, D2)
-              treenodes[n2].nbr[0] = n1;
-              treenodes[n2].edge[0] = edge_n1n2;
-              treenodes[n2].nbr[1] = D1;
-              treenodes[n2].edge[1] = edge_n2D1;
-              treenodes[n2].nbr[2] = D2;
-              treenodes[n2].edge[2] = edge_n2D2;
-              // B1's nbr n2->B2
-              for (i = 0; i < 3; i++) {
-                if (treenodes[B1].nbr[i] == n2) {
-                  treenodes[B1].nbr[i] = B2;
-                  treenodes[B1].edge[i] = edge_B1B2;
-                  break;
-                }
-              }
-              // B2's nbr n2->B1
-              for (i = 0; i < 3; i++) {
-                if (treenodes[B2].nbr[i] == n2) {
-                  treenodes[B2].nbr[i] = B1;
-                  treenodes[B2].edge[i] = edge_B1B2;
-                  break;
-                }
-              }
-              // D1's nbr D2->n2
-              for (i = 0; i < 3; i++) {
-                if (treenodes[D1].nbr[i] == D2) {
-                  treenodes[D1].nbr[i] = n2;
-                  treenodes[D1].edge[i] = edge_n2D1;
-                  break;
-                }
-              }
-              // D2's nbr D1->n2
-              for (i = 0; i < 3; i++) {
-                if (treenodes[D2].nbr[i] == D1) {
-                  treenodes[D2].nbr[i] = n2;
-                  treenodes[D2].edge[i] = edge_n2D2;
-                  break;
-                }
-              }
-            }  // else E2 is not on (n2, B1) or (n2, B2), but on (D1, D2)
-          }    // n2 is not a pin and E2!=n2
+  std::vector<MazeHeap<float>> heap1s(numThreads);
+  std::vector<std::vector<float*>> heap2s(numThreads);
+  std::vector<std::vector<OrderNetEdge>> netEOs(numThreads);
+  std::vector<Bool> broken(netIDs.size(), FALSE);
+  std::exception_ptr error;
 
-          // update route for edge (n1, n2) and edge usage
-          if (treeedges[edge_n1n2].route.type == MAZEROUTE) {
-            free(treeedges[edge_n1n2].route.gridsX);
-            free(treeedges[edge_n1n2].route.gridsY);
-          }
-          treeedges[edge_n1n2].route.gridsX
-              = (short*) calloc(cnt_n1n2, sizeof(short));
-          treeedges[edge_n1n2].route.gridsY
-              = (short*) calloc(cnt_n1n2, sizeof(short));
-          treeedges[edge_n1n2].route.type = MAZEROUTE;
-          treeedges[edge_n1n2].route.routelen = cnt_n1n2 - 1;
-          treeedges[edge_n1n2].len = ADIFF(E1x, E2x) + ADIFF(E1y, E2y);
-
-          for (i = 0; i < cnt_n1n2; i++) {
-            treeedges[edge_n1n2].route.gridsX[i] = gridsX[i];
-            treeedges[edge_n1n2].route.gridsY[i] = gridsY[i];
-          }
+  // the heaps share heap1Pos like they share d1
+  for (MazeHeap<float>& heap : heap1s) {
+    heap.init(d1.data(), heap1Pos.data());
+  }
 
-          int edgeCost = nets[netID]->edgeCost;
+  for (const std::vector<int>& batch : batches) {
+#pragma omp parallel for num_threads(numThreads) schedule(dynamic)
+    for (int k = 0; k < batch.size(); k++) {
+      const int t = omp_get_thread_num();
+      const int net = batch[k];
+      const int heapSize = mazeHeapSize(netIDs[net], 1);
 
-          // update edge usage
-          for (i = 0; i < cnt_n1n2 - 1; i++) {
-            if (gridsX[i] == gridsX[i + 1])  // a vertical edge
-            {
-              min_y = std::min(gridsY[i], gridsY[i + 1]);
-              v_edges[min_y * xGrid + gridsX[i]].usage += edgeCost;
-            } else  /// if(gridsY[i]==gridsY[i+1])// a horizontal edge
-            {
-              min_x = std::min(gridsX[i], gridsX[i + 1]);
-              h_edges[gridsY[i] * (xGrid - 1) + min_x].usage += edgeCost;
-            }
-          }
+      if (heap2s[t].size() < heapSize) {
+        heap2s[t].resize(heapSize);
+      }
+      netEOs[t].resize(2 * sttrees[netIDs[net]].deg);
+
+      try {
+        broken[net] = mazeRouteNet(netIDs[net],
+                                   iter,
+                                   expand,
+                                   ripup_threshold,
+                                   mazeedge_Threshold,
+                                   regions[net],
+                                   heap1s[t],
+                                   heap2s[t].data(),
+                                   netEOs[t].data());
+      } catch (...) {
+#pragma omp critical
+        if (!error) {
+          error = std::current_exception();
+        }
+      }
+    }
 
-          if (checkRoute2DTree(netID)) {
-            reInitTree(netID);
-            return;
-          }
-        }  // congested route
-      }    // maze routing
-    }      // loop edgeID
-  }
+    if (error) {
+      std::rethrow_exception(error);
+    }
 
-  if (!h_costTable) {
-    delete[] h_costTable;
-  }
-  if (!v_costTable) {
-    delete[] v_costTable;
+    // a broken tree is rebuilt and ends the round
+    Bool rebuilt = FALSE;
+    for (int net : batch) {
+      if (broken[net]) {
+        reInitTree(netIDs[net]);
+        rebuilt = TRUE;
+      }
+    }
+    if (rebuilt) {
+      return;
+    }
   }
 }
 
-int getOverflow2Dmaze(int* maxOverflow, int* tUsage)
+int FastRouteCore::getOverflow2Dmaze(int* maxOverflow, int* tUsage)
 {
   int H_overflow = 0;
   int V_overflow = 0;
@@ -1917,7 +2062,7 @@ int getOverflow2Dmaze(int* maxOverflow, int* tUsage)
   return (totalOverflow);
 }
 
-int getOverflow2D(int* maxOverflow)
+int FastRouteCore::getOverflow2D(int* maxOverflow)
 {
   int i, j, grid, overflow, max_overflow, H_overflow, max_H_overflow,
       V_overflow, max_V_overflow, numedges;
@@ -1988,7 +2133,7 @@ int getOverflow2D(int* maxOverflow)
   return (totalOverflow);
 }
 
-int getOverflow3D(void)
+int FastRouteCore::getOverflow3D(void)
 {
   int i, j, k, grid, overflow, max_overflow, H_overflow, max_H_overflow,
       V_overflow, max_V_overflow;
@@ -2106,9 +2251,7 @@ int getOverflow3D(void)
   return (total_usage);
 }
 
-int unsolved;
-
-void initialCongestionHistory(int round)
+void FastRouteCore::initialCongestionHistory(int round)
 {
   int i, j, grid;
 
@@ -2129,7 +2272,7 @@ void initialCongestionHistory(int round)
   }
 }
 
-void reduceCongestionHistory(int round)
+void FastRouteCore::reduceCongestionHistory(int round)
 {
   int i, j, grid;
 
@@ -2150,7 +2293,7 @@ void reduceCongestionHistory(int round)
   }
 }
 
-void InitEstUsage()
+void FastRouteCore::InitEstUsage()
 {
   int i, j, grid;
   for (i = 0; i < yGrid; i++) {
@@ -2168,7 +2311,7 @@ void InitEstUsage()
   }
 }
 
-void str_accu(int rnd)
+void FastRouteCore::str_accu(int rnd)
 {
   int i, j, grid, overflow;
   for (i = 0; i < yGrid; i++) {
@@ -2192,7 +2335,7 @@ void str_accu(int rnd)
   }
 }
 
-void InitLastUsage(int upType)
+void FastRouteCore::InitLastUsage(int upType)
 {
   int i, j, grid;
   for (i = 0; i < yGrid; i++) {
@@ -33,15 +33,17 @@
 #include "maze3D.h"
 
 #include <math.h>
+#include <omp.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
 
 #include <algorithm>
+#include <exception>
+#include <vector>
 
 #include "DataProc.h"
 #include "DataType.h"
-#include "RipUp.h"
 #include "flute.h"
 #include "pdrev/pdrev.h"
 #include "route.h"
@@ -52,73 +54,15 @@ namespace grt {
 
 using utl::GRT;
 
-#define PARENT(i) (i - 1) / 2
-//#define PARENT(i) ((i-1)>>1)
-#define LEFT(i) 2 * i + 1
-#define RIGHT(i) 2 * i + 2
-
-// non recursive version of heapify-
-static void heapify3D(int** array, int heapSize, int i)
-{
-  int l, r, smallest;
-  int* tmp;
-  Bool STOP = FALSE;
-
-  tmp = array[i];
-  do {
-    l = LEFT(i);
-    r = RIGHT(i);
-
-    if (l < heapSize && *(array[l]) < *tmp) {
-      smallest = l;
-      if (r < heapSize && *(array[r]) < *(array[l]))
-        smallest = r;
-    } else {
-      smallest = i;
-      if (r < heapSize && *(array[r]) < *tmp)
-        smallest = r;
-    }
-    if (smallest != i) {
-      array[i] = array[smallest];
-      i = smallest;
-    } else {
-      array[i] = tmp;
-      STOP = TRUE;
-    }
-  } while (!STOP);
-}
-
-static void updateHeap3D(int** array, int arrayLen, int i)
-{
-  int parent;
-  int* tmpi;
-
-  tmpi = array[i];
-  while (i > 0 && *(array[PARENT(i)]) > *tmpi) {
-    parent = PARENT(i);
-    array[i] = array[parent];
-    i = parent;
-  }
-  array[i] = tmpi;
-}
-
-// extract the entry with minimum distance from Priority queue
-static void extractMin3D(int** array, int arrayLen)
-{
-  if (arrayLen < 1)
-    logger->error(GRT, 183, "Heap underflow.");
-  array[0] = array[arrayLen - 1];
-  heapify3D(array, arrayLen - 1, 0);
-}
-
-void setupHeap3D(int netID,
-                 int edgeID,
-                 int* heapLen1,
-                 int* heapLen2,
-                 int regionX1,
-                 int regionX2,
-                 int regionY1,
-                 int regionY2)
+void FastRouteCore::setupHeap3D(int netID,
+                                int edgeID,
+                                MazeHeap<int>& heap13D,
+                                short** heap23D,
+                                int* heapLen2,
+                                int regionX1,
+                                int regionX2,
+                                int regionY1,
+                                int regionY2)
 {
   int nt, nbr, nbrX, nbrY, cur, edge;
   int x_grid, y_grid, l_grid, heapcnt;
@@ -129,6 +73,8 @@ void setupHeap3D(int netID,
   TreeNode* treenodes = sttrees[netID].nodes;
 
   int d = sttrees[netID].deg;
+
+  heap13D.clear();
   // TODO: check this size
   int numNodes = 2 * d - 2;
   int heapVisited[numNodes];
@@ -146,8 +92,7 @@ void setupHeap3D(int netID,
   {
     d13D[0][y1][x1] = 0;
     directions3D[0][y1][x1] = ORIGIN;
-    heap13D[0] = &d13D[0][y1][x1];
-    *heapLen1 = 1;
+    heap13D.push(&d13D[0][y1][x1]);
     d23D[0][y2][x2] = 0;
     directions3D[0][y2][x2] = ORIGIN;
     heap23D[0] = &d23D[0][y2][x2];
@@ -168,22 +113,17 @@ void setupHeap3D(int netID,
     if (n1 < d)  // n1 is a Pin node
     {
       // just need to put n1 itself into heap13D
-      heapcnt = 0;
-
       nt = treenodes[n1].stackAlias;
 
       for (int l = treenodes[nt].botL; l <= treenodes[nt].topL; l++) {
         d13D[l][y1][x1] = 0;
-        heap13D[heapcnt] = &d13D[l][y1][x1];
+        heap13D.push(&d13D[l][y1][x1]);
         directions3D[l][y1][x1] = ORIGIN;
         heapVisited[n1] = TRUE;
-        heapcnt++;
       }
-      *heapLen1 = heapcnt;
 
     } else  // n1 is a Steiner node
     {
-      heapcnt = 0;
       queuehead = queuetail = 0;
 
       nt = treenodes[n1].stackAlias;
@@ -192,9 +132,8 @@ void setupHeap3D(int netID,
       for (int l = treenodes[nt].botL; l <= treenodes[nt].topL; l++) {
         d13D[l][y1][x1] = 0;
         directions3D[l][y1][x1] = ORIGIN;
-        heap13D[heapcnt] = &d13D[l][y1][x1];
+        heap13D.push(&d13D[l][y1][x1]);
         heapVisited[n1] = TRUE;
-        heapcnt++;
       }
 
       // add n1 into the heapQueue
@@ -227,8 +166,7 @@ void setupHeap3D(int netID,
                          l++) {
                       d13D[l][nbrY][nbrX] = 0;
                       directions3D[l][nbrY][nbrX] = ORIGIN;
-                      heap13D[heapcnt] = &d13D[l][nbrY][nbrX];
-                      heapcnt++;
+                      heap13D.push(&d13D[l][nbrY][nbrX]);
                       corrEdge3D[l][nbrY][nbrX] = edge;
                     }
                   }
@@ -246,9 +184,8 @@ void setupHeap3D(int netID,
 
                       if (inRegion[y_grid][x_grid]) {
                         d13D[l_grid][y_grid][x_grid] = 0;
-                        heap13D[heapcnt] = &d13D[l_grid][y_grid][x_grid];
+                        heap13D.push(&d13D[l_grid][y_grid][x_grid]);
                         directions3D[l_grid][y_grid][x_grid] = ORIGIN;
-                        heapcnt++;
                         corrEdge3D[l_grid][y_grid][x_grid] = edge;
                       }
                     }
@@ -259,13 +196,12 @@ void setupHeap3D(int netID,
                 // add the neighbor of cur node into heapQueue
                 heapQueue[queuetail] = nbr;
                 queuetail++;
-              }             // if the node is not heapVisited
-            }               // if nbr!=n2
-          }                 // loop i (3 neigbors for cur node)
-        }                   // if cur node is a Steiner nodes
-      }                     // while heapQueue is not empty
-      *heapLen1 = heapcnt;  // record the length of heap13D
-    }                       // else n1 is not a Pin node
+              }  // if the node is not heapVisited
+            }    // if nbr!=n2
+          }      // loop i (3 neigbors for cur node)
+        }        // if cur node is a Steiner nodes
+      }          // while heapQueue is not empty
+    }            // else n1 is not a Pin node
 
     // find all the grids on subtree t2 (connect to n2) and put them into
     // heap23D find all the grids on tree edges in subtree t2 (connecting to n2)
@@ -382,7 +318,10 @@ void setupHeap3D(int netID,
   }  // net with more than two pins
 }
 
-void newUpdateNodeLayers(TreeNode* treenodes, int edgeID, int n1, int lastL)
+void FastRouteCore::newUpdateNodeLayers(TreeNode* treenodes,
+                                        int edgeID,
+                                        int n1,
+                                        int lastL)
 {
   int con;
 
@@ -401,14 +340,14 @@ void newUpdateNodeLayers(TreeNode* treenodes, int edgeID, int n1, int lastL)
   }
 }
 
-int copyGrids3D(TreeNode* treenodes,
-                int n1,
-                int n2,
-                TreeEdge* treeedges,
-                int edge_n1n2,
-                int gridsX_n1n2[],
-                int gridsY_n1n2[],
-                int gridsL_n1n2[])
+int FastRouteCore::copyGrids3D(TreeNode* treenodes,
+                               int n1,
+                               int n2,
+                               TreeEdge* treeedges,
+                               int edge_n1n2,
+                               int gridsX_n1n2[],
+                               int gridsY_n1n2[],
+                               int gridsL_n1n2[])
 {
   int i, cnt;
   int n1x, n1y, n1l;
@@ -463,16 +402,16 @@ int copyGrids3D(TreeNode* treenodes,
   return (cnt);
 }
 
-void updateRouteType13D(int netID,
-                        TreeNode* treenodes,
-                        int n1,
-                        int A1,
-                        int A2,
-                        int E1x,
-                        int E1y,
-                        TreeEdge* treeedges,
-                        int edge_n1A1,
-                        int edge_n1A2)
+void FastRouteCore::updateRouteType13D(int netID,
+                                       TreeNode* treenodes,
+                                       int n1,
+                                       int A1,
+                                       int A2,
+                                       int E1x,
+                                       int E1y,
+                                       TreeEdge* treeedges,
+                                       int edge_n1A1,
+                                       int edge_n1A2)
 {
   int i, l, cnt, A1x, A1y, A2x, A2y;
   int cnt_n1A1, cnt_n1A2, E1_pos1, E1_pos2;
@@ -683,19 +622,19 @@ void updateRouteType13D(int netID,
   treenodes[n1].y = E1y;
 }
 
-void updateRouteType23D(int netID,
-                        TreeNode* treenodes,
-                        int n1,
-                        int A1,
-                        int A2,
-                        int C1,
-                        int C2,
-                        int E1x,
-                        int E1y,
-                        TreeEdge* treeedges,
-                        int edge_n1A1,
-                        int edge_n1A2,
-                        int edge_C1C2)
+void FastRouteCore::updateRouteType23D(int netID,
+                                       TreeNode* treenodes,
+                                       int n1,
+                                       int A1,
+                                       int A2,
+                                       int C1,
+                                       int C2,
+                                       int E1x,
+                                       int E1y,
+                                       TreeEdge* treeedges,
+                                       int edge_n1A1,
+                                       int edge_n1A2,
+                                       int edge_C1C2)
 {
   int i, cnt, A1x, A1y, A2x, A2y, C1x, C1y, C2x, C2y, extraLen, startIND;
   int edge_n1C1, edge_n1C2, edge_A1A2;
@@ -887,17 +826,27 @@ void updateRouteType23D(int netID,
   }
 }
 
-void mazeRouteMSMDOrder3D(int expand, int ripupTHlb, int ripupTHub)
+// rip up and maze route the edges of one net with length between ripupTHlb
+// and ripupTHub in 3D, the search regions are kept inside clip
+void FastRouteCore::mazeRouteNet3D(int netID,
+                                   int expand,
+                                   int ripupTHlb,
+                                   int ripupTHub,
+                                   const MazeRegion& clip,
+                                   Bool* pop_heap23D,
+                                   MazeHeap<int>& heap13D,
+                                   short** heap23D,
+                                   int* xcor,
+                                   int* ycor,
+                                   int* dcor)
 {
   short* gridsLtmp;
-  int netID, enlarge, endIND;
-  Bool* pop_heap23D;
+  int enlarge;
 
   int i, j, k, deg, n1, n2, n1x, n1y, n2x, n2y, ymin, ymax, xmin, xmax, curX,
-      curY, curL, crossX, crossY, crossL, tmpX, tmpY, tmpL, tmpi, min_x, min_y,
-      *dtmp;
+      curY, curL, crossX, crossY, crossL, tmpX, tmpY, tmpL, tmpi, min_x, min_y;
   int regionX1, regionX2, regionY1, regionY2, routeLen;
-  int heapLen1, heapLen2, ind, ind1, tmpind, grid;
+  int heapLen2, ind1, tmpind, grid;
   float tmp;
   TreeEdge *treeedges, *treeedge;
   TreeNode* treenodes;
@@ -906,883 +855,849 @@ void mazeRouteMSMDOrder3D(int expand, int ripupTHlb, int ripupTHub)
   int edge_n1n2, edge_n1A1, edge_n1A2, edge_n1C1, edge_n1C2, edge_A1A2,
       edge_C1C2;
   int edge_n2B1, edge_n2B2, edge_n2D1, edge_n2D2, edge_B1B2, edge_D1D2, D1, D2;
-  int E1x, E1y, E2x, E2y, range, corE1, corE2, edgeID;
+  int E1x, E1y, E2x, E2y, corE1, corE2, edgeID;
 
   Bool Horizontal, n1Shift, n2Shift, redundant;
   int lastL, origL, headRoom, tailRoom, newcnt_n1n2, numpoints, d, n1a, n2a,
       connectionCNT;
-  int origEng, orderIndex;
-
-  directions3D = new dirctionT**[numLayers];
-  corrEdge3D = new int**[numLayers];
-  pr3D = new parent3D**[numLayers];
-
-  for (i = 0; i < numLayers; i++) {
-    directions3D[i] = new dirctionT*[yGrid];
-    corrEdge3D[i] = new int*[yGrid];
-    pr3D[i] = new parent3D*[yGrid];
-
-    for (j = 0; j < yGrid; j++) {
-      directions3D[i][j] = new dirctionT[xGrid];
-      corrEdge3D[i][j] = new int[xGrid];
-      pr3D[i][j] = new parent3D[xGrid];
-    }
-  }
-
-  pop_heap23D = new Bool[numLayers * YRANGE * XRANGE];
-
-  // allocate memory for priority queue
-  heap13D = new int*[yGrid * xGrid * numLayers];
-  heap23D = new short*[yGrid * xGrid * numLayers];
+  int origEng;
+
+  int edgeCost = nets[netID]->edgeCost;
+
+  /* TODO:  <14-08-19, uncomment this to reproduce ispd18_test6> */
+  /* if (netID == 53757) { */
+  /*         continue; */
+  /* } */
+
+  enlarge = expand;
+  deg = sttrees[netID].deg;
+  treeedges = sttrees[netID].edges;
+  treenodes = sttrees[netID].nodes;
+  origEng = enlarge;
+
+  for (edgeID = 0; edgeID < 2 * deg - 3; edgeID++) {
+    treeedge = &(treeedges[edgeID]);
+
+    if (treeedge->len < ripupTHub && treeedge->len > ripupTHlb) {
+      n1 = treeedge->n1;
+      n2 = treeedge->n2;
+      n1x = treenodes[n1].x;
+      n1y = treenodes[n1].y;
+      n2x = treenodes[n2].x;
+      n2y = treenodes[n2].y;
+      routeLen = treeedges[edgeID].route.routelen;
+
+      if (n1y <= n2y) {
+        ymin = n1y;
+        ymax = n2y;
+      } else {
+        ymin = n2y;
+        ymax = n1y;
+      }
 
-  for (i = 0; i < yGrid; i++) {
-    for (j = 0; j < xGrid; j++) {
-      inRegion[i][j] = FALSE;
-    }
-  }
+      if (n1x <= n2x) {
+        xmin = n1x;
+        xmax = n2x;
+      } else {
+        xmin = n2x;
+        xmax = n1x;
+      }
 
-  range = YRANGE * XRANGE * numLayers;
-  for (i = 0; i < range; i++) {
-    pop_heap23D[i] = FALSE;
-  }
+      // ripup the routing for the edge
+      if (newRipup3DType3(netID, edgeID)) {
+        enlarge = std::min(origEng, treeedge->route.routelen);
 
-  endIND = numValidNets * 0.9;
+        regionX1 = std::max(clip.x1, xmin - enlarge);
+        regionX2 = std::min(clip.x2, xmax + enlarge);
+        regionY1 = std::max(clip.y1, ymin - enlarge);
+        regionY2 = std::min(clip.y2, ymax + enlarge);
 
-  for (orderIndex = 0; orderIndex < endIND; orderIndex++) {
-    netID = treeOrderPV[orderIndex].treeIndex;
+        n1Shift = FALSE;
+        n2Shift = FALSE;
+        n1a = treeedge->n1a;
+        n2a = treeedge->n2a;
 
-    int edgeCost = nets[netID]->edgeCost;
-
-    /* TODO:  <14-08-19, uncomment this to reproduce ispd18_test6> */
-    /* if (netID == 53757) { */
-    /*         continue; */
-    /* } */
-
-    enlarge = expand;
-    deg = sttrees[netID].deg;
-    treeedges = sttrees[netID].edges;
-    treenodes = sttrees[netID].nodes;
-    origEng = enlarge;
-
-    for (edgeID = 0; edgeID < 2 * deg - 3; edgeID++) {
-      treeedge = &(treeedges[edgeID]);
-
-      if (treeedge->len < ripupTHub && treeedge->len > ripupTHlb) {
-        n1 = treeedge->n1;
-        n2 = treeedge->n2;
-        n1x = treenodes[n1].x;
-        n1y = treenodes[n1].y;
-        n2x = treenodes[n2].x;
-        n2y = treenodes[n2].y;
-        routeLen = treeedges[edgeID].route.routelen;
-
-        if (n1y <= n2y) {
-          ymin = n1y;
-          ymax = n2y;
-        } else {
-          ymin = n2y;
-          ymax = n1y;
-        }
+        // initialize pop_heap13D[] and pop_heap23D[] as FALSE (for detecting
+        // the shortest path is found or not)
 
-        if (n1x <= n2x) {
-          xmin = n1x;
-          xmax = n2x;
-        } else {
-          xmin = n2x;
-          xmax = n1x;
+        for (k = 0; k < numLayers; k++) {
+          for (i = regionY1; i <= regionY2; i++) {
+            for (j = regionX1; j <= regionX2; j++) {
+              d13D[k][i][j] = BIG_INT;
+              d23D[k][i][j] = 256;
+            }
+          }
         }
 
-        // ripup the routing for the edge
-        if (newRipup3DType3(netID, edgeID)) {
-          enlarge = std::min(origEng, treeedge->route.routelen);
-
-          regionX1 = std::max(0, xmin - enlarge);
-          regionX2 = std::min(xGrid - 1, xmax + enlarge);
-          regionY1 = std::max(0, ymin - enlarge);
-          regionY2 = std::min(yGrid - 1, ymax + enlarge);
-
-          n1Shift = FALSE;
-          n2Shift = FALSE;
-          n1a = treeedge->n1a;
-          n2a = treeedge->n2a;
+        // setup heap13D, heap23D and initialize d13D[][] and d23D[][] for all
+        // the grids on the two subtrees
+        setupHeap3D(netID,
+                    edgeID,
+                    heap13D,
+                    heap23D,
+                    &heapLen2,
+                    regionX1,
+                    regionX2,
+                    regionY1,
+                    regionY2);
+
+        // while loop to find shortest path
+        ind1 = heap13D.top();
+
+        for (i = 0; i < heapLen2; i++)
+          pop_heap23D[heap23D[i] - &d23D[0][0][0]] = TRUE;
+
+        while (pop_heap23D[ind1]
+               == FALSE)  // stop until the grid position been popped out from
+                          // both heap13D and heap23D
+        {
+          // relax all the adjacent grids within the enlarged region for
+          // source subtree
+          curL = ind1 / (gridHV);
+          remd = ind1 % (gridHV);
+          curX = remd % XRANGE;
+          curY = remd / XRANGE;
+
+          if (heap13D.empty())
+            logger->error(GRT, 183, "Heap underflow.");
+          heap13D.pop();
+
+          if (((curL % 2) - layerOrientation) == 0) {
+            Horizontal = TRUE;
+          } else {
+            Horizontal = FALSE;
+          }
 
-          // initialize pop_heap13D[] and pop_heap23D[] as FALSE (for detecting
-          // the shortest path is found or not)
+          if (Horizontal) {
+            // left
+            if (curX > regionX1 && directions3D[curL][curY][curX] != EAST) {
+              grid = gridHs[curL] + curY * (xGrid - 1) + curX - 1;
+              tmp = d13D[curL][curY][curX] + 1;
+              if (h_edges3D[grid].usage < h_edges3D[grid].cap) {
+                tmpX = curX - 1;  // the left neighbor
 
-          for (k = 0; k < numLayers; k++) {
-            for (i = regionY1; i <= regionY2; i++) {
-              for (j = regionX1; j <= regionX2; j++) {
-                d13D[k][i][j] = BIG_INT;
-                d23D[k][i][j] = 256;
+                if (d13D[curL][curY][tmpX]
+                    >= BIG_INT)  // left neighbor not been put into heap13D
+                {
+                  d13D[curL][curY][tmpX] = tmp;
+                  pr3D[curL][curY][tmpX].l = curL;
+                  pr3D[curL][curY][tmpX].x = curX;
+                  pr3D[curL][curY][tmpX].y = curY;
+                  directions3D[curL][curY][tmpX] = WEST;
+                  heap13D.push(&d13D[curL][curY][tmpX]);
+                } else if (d13D[curL][curY][tmpX]
+                           > tmp)  // left neighbor been put into heap13D but
+                                   // needs update
+                {
+                  d13D[curL][curY][tmpX] = tmp;
+                  pr3D[curL][curY][tmpX].l = curL;
+                  pr3D[curL][curY][tmpX].x = curX;
+                  pr3D[curL][curY][tmpX].y = curY;
+                  directions3D[curL][curY][tmpX] = WEST;
+                  heap13D.decrease(&d13D[curL][curY][tmpX]);
+                }
               }
             }
-          }
+            // right
+            if (Horizontal && curX < regionX2
+                && directions3D[curL][curY][curX] != WEST) {
+              grid = gridHs[curL] + curY * (xGrid - 1) + curX;
 
-          // setup heap13D, heap23D and initialize d13D[][] and d23D[][] for all
-          // the grids on the two subtrees
-          setupHeap3D(netID,
-                      edgeID,
-                      &heapLen1,
-                      &heapLen2,
-                      regionX1,
-                      regionX2,
-                      regionY1,
-                      regionY2);
-
-          // while loop to find shortest path
-          ind1 = (heap13D[0] - &d13D[0][0][0]);
-
-          for (i = 0; i < heapLen2; i++)
-            pop_heap23D[heap23D[i] - &d23D[0][0][0]] = TRUE;
-
-          while (pop_heap23D[ind1]
-                 == FALSE)  // stop until the grid position been popped out from
-                            // both heap13D and heap23D
-          {
-            // relax all the adjacent grids within the enlarged region for
-            // source subtree
-            curL = ind1 / (gridHV);
-            remd = ind1 % (gridHV);
-            curX = remd % XRANGE;
-            curY = remd / XRANGE;
-
-            extractMin3D(heap13D, heapLen1);
-            // pop_heap13D[ind1] = TRUE;
-            heapLen1--;
-
-            if (((curL % 2) - layerOrientation) == 0) {
-              Horizontal = TRUE;
-            } else {
-              Horizontal = FALSE;
-            }
+              tmp = d13D[curL][curY][curX] + 1;
+              tmpX = curX + 1;  // the right neighbor
 
-            if (Horizontal) {
-              // left
-              if (curX > regionX1 && directions3D[curL][curY][curX] != EAST) {
-                grid = gridHs[curL] + curY * (xGrid - 1) + curX - 1;
-                tmp = d13D[curL][curY][curX] + 1;
-                if (h_edges3D[grid].usage < h_edges3D[grid].cap) {
-                  tmpX = curX - 1;  // the left neighbor
-
-                  if (d13D[curL][curY][tmpX]
-                      >= BIG_INT)  // left neighbor not been put into heap13D
-                  {
-                    d13D[curL][curY][tmpX] = tmp;
-                    pr3D[curL][curY][tmpX].l = curL;
-                    pr3D[curL][curY][tmpX].x = curX;
-                    pr3D[curL][curY][tmpX].y = curY;
-                    directions3D[curL][curY][tmpX] = WEST;
-                    heap13D[heapLen1] = &d13D[curL][curY][tmpX];
-                    heapLen1++;
-                    updateHeap3D(heap13D, heapLen1, heapLen1 - 1);
-                  } else if (d13D[curL][curY][tmpX]
-                             > tmp)  // left neighbor been put into heap13D but
-                                     // needs update
-                  {
-                    d13D[curL][curY][tmpX] = tmp;
-                    pr3D[curL][curY][tmpX].l = curL;
-                    pr3D[curL][curY][tmpX].x = curX;
-                    pr3D[curL][curY][tmpX].y = curY;
-                    directions3D[curL][curY][tmpX] = WEST;
-                    dtmp = &d13D[curL][curY][tmpX];
-                    ind = 0;
-                    while (heap13D[ind] != dtmp)
-                      ind++;
-                    updateHeap3D(heap13D, heapLen1, ind);
-                  }
-                }
-              }
-              // right
-              if (Horizontal && curX < regionX2
-                  && directions3D[curL][curY][curX] != WEST) {
-                grid = gridHs[curL] + curY * (xGrid - 1) + curX;
-
-                tmp = d13D[curL][curY][curX] + 1;
-                tmpX = curX + 1;  // the right neighbor
-
-                if (h_edges3D[grid].usage < h_edges3D[grid].cap) {
-                  if (d13D[curL][curY][tmpX]
-                      >= BIG_INT)  // right neighbor not been put into heap13D
-                  {
-                    d13D[curL][curY][tmpX] = tmp;
-                    pr3D[curL][curY][tmpX].l = curL;
-                    pr3D[curL][curY][tmpX].x = curX;
-                    pr3D[curL][curY][tmpX].y = curY;
-                    directions3D[curL][curY][tmpX] = EAST;
-                    heap13D[heapLen1] = &d13D[curL][curY][tmpX];
-                    heapLen1++;
-                    updateHeap3D(heap13D, heapLen1, heapLen1 - 1);
-                  } else if (d13D[curL][curY][tmpX]
-                             > tmp)  // right neighbor been put into heap13D but
-                                     // needs update
-                  {
-                    d13D[curL][curY][tmpX] = tmp;
-                    pr3D[curL][curY][tmpX].l = curL;
-                    pr3D[curL][curY][tmpX].x = curX;
-                    pr3D[curL][curY][tmpX].y = curY;
-                    directions3D[curL][curY][tmpX] = EAST;
-                    dtmp = &d13D[curL][curY][tmpX];
-                    ind = 0;
-                    while (heap13D[ind] != dtmp)
-                      ind++;
-                    updateHeap3D(heap13D, heapLen1, ind);
-                  }
+              if (h_edges3D[grid].usage < h_edges3D[grid].cap) {
+                if (d13D[curL][curY][tmpX]
+                    >= BIG_INT)  // right neighbor not been put into heap13D
+                {
+                  d13D[curL][curY][tmpX] = tmp;
+                  pr3D[curL][curY][tmpX].l = curL;
+                  pr3D[curL][curY][tmpX].x = curX;
+                  pr3D[curL][curY][tmpX].y = curY;
+                  directions3D[curL][curY][tmpX] = EAST;
+                  heap13D.push(&d13D[curL][curY][tmpX]);
+                } else if (d13D[curL][curY][tmpX]
+                           > tmp)  // right neighbor been put into heap13D but
+                                   // needs update
+                {
+                  d13D[curL][curY][tmpX] = tmp;
+                  pr3D[curL][curY][tmpX].l = curL;
+                  pr3D[curL][curY][tmpX].x = curX;
+                  pr3D[curL][curY][tmpX].y = curY;
+                  directions3D[curL][curY][tmpX] = EAST;
+                  heap13D.decrease(&d13D[curL][curY][tmpX]);
                 }
               }
-            } else {
-              // bottom
-              if (!Horizontal && curY > regionY1
-                  && directions3D[curL][curY][curX] != SOUTH) {
-                grid = gridVs[curL] + (curY - 1) * xGrid + curX;
-                tmp = d13D[curL][curY][curX] + 1;
-                tmpY = curY - 1;  // the bottom neighbor
-                if (v_edges3D[grid].usage < v_edges3D[grid].cap) {
-                  if (d13D[curL][tmpY][curX]
-                      >= BIG_INT)  // bottom neighbor not been put into heap13D
-                  {
-                    d13D[curL][tmpY][curX] = tmp;
-                    pr3D[curL][tmpY][curX].l = curL;
-                    pr3D[curL][tmpY][curX].x = curX;
-                    pr3D[curL][tmpY][curX].y = curY;
-                    directions3D[curL][tmpY][curX] = NORTH;
-                    heap13D[heapLen1] = &d13D[curL][tmpY][curX];
-                    heapLen1++;
-                    updateHeap3D(heap13D, heapLen1, heapLen1 - 1);
-                  } else if (d13D[curL][tmpY][curX]
-                             > tmp)  // bottom neighbor been put into heap13D
-                                     // but needs update
-                  {
-                    d13D[curL][tmpY][curX] = tmp;
-                    pr3D[curL][tmpY][curX].l = curL;
-                    pr3D[curL][tmpY][curX].x = curX;
-                    pr3D[curL][tmpY][curX].y = curY;
-                    directions3D[curL][tmpY][curX] = NORTH;
-                    dtmp = &d13D[curL][tmpY][curX];
-                    ind = 0;
-                    while (heap13D[ind] != dtmp)
-                      ind++;
-                    updateHeap3D(heap13D, heapLen1, ind);
-                  }
+            }
+          } else {
+            // bottom
+            if (!Horizontal && curY > regionY1
+                && directions3D[curL][curY][curX] != SOUTH) {
+              grid = gridVs[curL] + (curY - 1) * xGrid + curX;
+              tmp = d13D[curL][curY][curX] + 1;
+              tmpY = curY - 1;  // the bottom neighbor
+              if (v_edges3D[grid].usage < v_edges3D[grid].cap) {
+                if (d13D[curL][tmpY][curX]
+                    >= BIG_INT)  // bottom neighbor not been put into heap13D
+                {
+                  d13D[curL][tmpY][curX] = tmp;
+                  pr3D[curL][tmpY][curX].l = curL;
+                  pr3D[curL][tmpY][curX].x = curX;
+                  pr3D[curL][tmpY][curX].y = curY;
+                  directions3D[curL][tmpY][curX] = NORTH;
+                  heap13D.push(&d13D[curL][tmpY][curX]);
+                } else if (d13D[curL][tmpY][curX]
+                           > tmp)  // bottom neighbor been put into heap13D
+                                   // but needs update
+                {
+                  d13D[curL][tmpY][curX] = tmp;
+                  pr3D[curL][tmpY][curX].l = curL;
+                  pr3D[curL][tmpY][curX].x = curX;
+                  pr3D[curL][tmpY][curX].y = curY;
+                  directions3D[curL][tmpY][curX] = NORTH;
+                  heap13D.decrease(&d13D[curL][tmpY][curX]);
                 }
               }
-              // top
-              if (!Horizontal && curY < regionY2
-                  && directions3D[curL][curY][curX] != NORTH) {
-                grid = gridVs[curL] + curY * xGrid + curX;
-                tmp = d13D[curL][curY][curX] + 1;
-                tmpY = curY + 1;  // the top neighbor
-                if (v_edges3D[grid].usage < v_edges3D[grid].cap) {
-                  if (d13D[curL][tmpY][curX]
-                      >= BIG_INT)  // top neighbor not been put into heap13D
-                  {
-                    d13D[curL][tmpY][curX] = tmp;
-                    pr3D[curL][tmpY][curX].l = curL;
-                    pr3D[curL][tmpY][curX].x = curX;
-                    pr3D[curL][tmpY][curX].y = curY;
-                    directions3D[curL][tmpY][curX] = SOUTH;
-                    heap13D[heapLen1] = &d13D[curL][tmpY][curX];
-                    heapLen1++;
-                    updateHeap3D(heap13D, heapLen1, heapLen1 - 1);
-                  } else if (d13D[curL][tmpY][curX]
-                             > tmp)  // top neighbor been put into heap13D but
-                                     // needs update
-                  {
-                    d13D[curL][tmpY][curX] = tmp;
-                    pr3D[curL][tmpY][curX].l = curL;
-                    pr3D[curL][tmpY][curX].x = curX;
-                    pr3D[curL][tmpY][curX].y = curY;
-                    directions3D[curL][tmpY][curX] = SOUTH;
-                    dtmp = &d13D[curL][tmpY][curX];
-                    ind = 0;
-                    while (heap13D[ind] != dtmp)
-                      ind++;
-                    updateHeap3D(heap13D, heapLen1, ind);
-                  }
+            }
+            // top
+            if (!Horizontal && curY < regionY2
+                && directions3D[curL][curY][curX] != NORTH) {
+              grid = gridVs[curL] + curY * xGrid + curX;
+              tmp = d13D[curL][curY][curX] + 1;
+              tmpY = curY + 1;  // the top neighbor
+              if (v_edges3D[grid].usage < v_edges3D[grid].cap) {
+                if (d13D[curL][tmpY][curX]
+                    >= BIG_INT)  // top neighbor not been put into heap13D
+                {
+                  d13D[curL][tmpY][curX] = tmp;
+                  pr3D[curL][tmpY][curX].l = curL;
+                  pr3D[curL][tmpY][curX].x = curX;
+                  pr3D[curL][tmpY][curX].y = curY;
+                  directions3D[curL][tmpY][curX] = SOUTH;
+                  heap13D.push(&d13D[curL][tmpY][curX]);
+                } else if (d13D[curL][tmpY][curX]
+                           > tmp)  // top neighbor been put into heap13D but
+                                   // needs update
+                {
+                  d13D[curL][tmpY][curX] = tmp;
+                  pr3D[curL][tmpY][curX].l = curL;
+                  pr3D[curL][tmpY][curX].x = curX;
+                  pr3D[curL][tmpY][curX].y = curY;
+                  directions3D[curL][tmpY][curX] = SOUTH;
+                  heap13D.decrease(&d13D[curL][tmpY][curX]);
                 }
               }
             }
+          }
 
-            // down
-            if (curL > 0 && directions3D[curL][curY][curX] != UP) {
-              tmp = d13D[curL][curY][curX] + viacost;
-              tmpL = curL - 1;  // the bottom neighbor
-
-              if (d13D[tmpL][curY][curX]
-                  >= BIG_INT)  // bottom neighbor not been put into heap13D
-              {
-                d13D[tmpL][curY][curX] = tmp;
-                pr3D[tmpL][curY][curX].l = curL;
-                pr3D[tmpL][curY][curX].x = curX;
-                pr3D[tmpL][curY][curX].y = curY;
-                directions3D[tmpL][curY][curX] = DOWN;
-                heap13D[heapLen1] = &d13D[tmpL][curY][curX];
-                heapLen1++;
-                updateHeap3D(heap13D, heapLen1, heapLen1 - 1);
-              } else if (d13D[tmpL][curY][curX]
-                         > tmp)  // bottom neighbor been put into heap13D but
-                                 // needs update
-              {
-                d13D[tmpL][curY][curX] = tmp;
-                pr3D[tmpL][curY][curX].l = curL;
-                pr3D[tmpL][curY][curX].x = curX;
-                pr3D[tmpL][curY][curX].y = curY;
-                directions3D[tmpL][curY][curX] = DOWN;
-                dtmp = &d13D[tmpL][curY][curX];
-                ind = 0;
-                while (heap13D[ind] != dtmp)
-                  ind++;
-                updateHeap3D(heap13D, heapLen1, ind);
-              }
+          // down
+          if (curL > 0 && directions3D[curL][curY][curX] != UP) {
+            tmp = d13D[curL][curY][curX] + viacost;
+            tmpL = curL - 1;  // the bottom neighbor
+
+            if (d13D[tmpL][curY][curX]
+                >= BIG_INT)  // bottom neighbor not been put into heap13D
+            {
+              d13D[tmpL][curY][curX] = tmp;
+              pr3D[tmpL][curY][curX].l = curL;
+              pr3D[tmpL][curY][curX].x = curX;
+              pr3D[tmpL][curY][curX].y = curY;
+              directions3D[tmpL][curY][curX] = DOWN;
+              heap13D.push(&d13D[tmpL][curY][curX]);
+            } else if (d13D[tmpL][curY][curX]
+                       > tmp)  // bottom neighbor been put into heap13D but
+                               // needs update
+            {
+              d13D[tmpL][curY][curX] = tmp;
+              pr3D[tmpL][curY][curX].l = curL;
+              pr3D[tmpL][curY][curX].x = curX;
+              pr3D[tmpL][curY][curX].y = curY;
+              directions3D[tmpL][curY][curX] = DOWN;
+              heap13D.decrease(&d13D[tmpL][curY][curX]);
             }
+          }
 
-            // up
-            if (curL < numLayers - 1
-                && directions3D[curL][curY][curX] != DOWN) {
-              tmp = d13D[curL][curY][curX] + viacost;
-              tmpL = curL + 1;  // the bottom neighbor
-              if (d13D[tmpL][curY][curX]
-                  >= BIG_INT)  // bottom neighbor not been put into heap13D
-              {
-                d13D[tmpL][curY][curX] = tmp;
-                pr3D[tmpL][curY][curX].l = curL;
-                pr3D[tmpL][curY][curX].x = curX;
-                pr3D[tmpL][curY][curX].y = curY;
-                directions3D[tmpL][curY][curX] = UP;
-                heap13D[heapLen1] = &d13D[tmpL][curY][curX];
-                heapLen1++;
-                updateHeap3D(heap13D, heapLen1, heapLen1 - 1);
-              } else if (d13D[tmpL][curY][curX]
-                         > tmp)  // bottom neighbor been put into heap13D but
-                                 // needs update
-              {
-                d13D[tmpL][curY][curX] = tmp;
-                pr3D[tmpL][curY][curX].l = curL;
-                pr3D[tmpL][curY][curX].x = curX;
-                pr3D[tmpL][curY][curX].y = curY;
-                directions3D[tmpL][curY][curX] = UP;
-                dtmp = &d13D[tmpL][curY][curX];
-                ind = 0;
-                while (heap13D[ind] != dtmp)
-                  ind++;
-                updateHeap3D(heap13D, heapLen1, ind);
-              }
+          // up
+          if (curL < numLayers - 1
+              && directions3D[curL][curY][curX] != DOWN) {
+            tmp = d13D[curL][curY][curX] + viacost;
+            tmpL = curL + 1;  // the bottom neighbor
+            if (d13D[tmpL][curY][curX]
+                >= BIG_INT)  // bottom neighbor not been put into heap13D
+            {
+              d13D[tmpL][curY][curX] = tmp;
+              pr3D[tmpL][curY][curX].l = curL;
+              pr3D[tmpL][curY][curX].x = curX;
+              pr3D[tmpL][curY][curX].y = curY;
+              directions3D[tmpL][curY][curX] = UP;
+              heap13D.push(&d13D[tmpL][curY][curX]);
+            } else if (d13D[tmpL][curY][curX]
+                       > tmp)  // bottom neighbor been put into heap13D but
+                               // needs update
+            {
+              d13D[tmpL][curY][curX] = tmp;
+              pr3D[tmpL][curY][curX].l = curL;
+              pr3D[tmpL][curY][curX].x = curX;
+              pr3D[tmpL][curY][curX].y = curY;
+              directions3D[tmpL][curY][curX] = UP;
+              heap13D.decrease(&d13D[tmpL][curY][curX]);
             }
+          }
 
-            // update ind1 for next loop
-            ind1 = (heap13D[0] - &d13D[0][0][0]);
-          }  // while loop
+          // update ind1 for next loop
+          ind1 = heap13D.top();
+        }  // while loop
 
-          for (i = 0; i < heapLen2; i++)
-            pop_heap23D[heap23D[i] - &d23D[0][0][0]] = FALSE;
+        for (i = 0; i < heapLen2; i++)
+          pop_heap23D[heap23D[i] - &d23D[0][0][0]] = FALSE;
 
-          // get the new route for the edge and store it in gridsX[] and
-          // gridsY[] temporarily
+        // get the new route for the edge and store it in gridsX[] and
+        // gridsY[] temporarily
 
-          crossL = ind1 / (gridHV);
-          crossX = (ind1 % (gridHV)) % XRANGE;
-          crossY = (ind1 % (gridHV)) / XRANGE;
+        crossL = ind1 / (gridHV);
+        crossX = (ind1 % (gridHV)) % XRANGE;
+        crossY = (ind1 % (gridHV)) / XRANGE;
 
-          cnt = 0;
-          curX = crossX;
-          curY = crossY;
-          curL = crossL;
+        cnt = 0;
+        curX = crossX;
+        curY = crossY;
+        curL = crossL;
 
-          if (d13D[curL][curY][curX] == 0) {
-            recoverEdge(netID, edgeID);
-            break;
-          }
+        if (d13D[curL][curY][curX] == 0) {
+          recoverEdge(netID, edgeID);
+          break;
+        }
 
-          std::vector<int> tmp_gridsX, tmp_gridsY, tmp_gridsL;
+        std::vector<int> tmp_gridsX, tmp_gridsY, tmp_gridsL;
 
-          while (d13D[curL][curY][curX] != 0)  // loop until reach subtree1
-          {
-            tmpL = pr3D[curL][curY][curX].l;
-            tmpX = pr3D[curL][curY][curX].x;
-            tmpY = pr3D[curL][curY][curX].y;
-            curX = tmpX;
-            curY = tmpY;
-            curL = tmpL;
-            fflush(stdout);
-            tmp_gridsX.push_back(curX);
-            tmp_gridsY.push_back(curY);
-            tmp_gridsL.push_back(curL);
-            cnt++;
-          }
+        while (d13D[curL][curY][curX] != 0)  // loop until reach subtree1
+        {
+          tmpL = pr3D[curL][curY][curX].l;
+          tmpX = pr3D[curL][curY][curX].x;
+          tmpY = pr3D[curL][curY][curX].y;
+          curX = tmpX;
+          curY = tmpY;
+          curL = tmpL;
+          fflush(stdout);
+          tmp_gridsX.push_back(curX);
+          tmp_gridsY.push_back(curY);
+          tmp_gridsL.push_back(curL);
+          cnt++;
+        }
 
-          std::vector<int> gridsX(tmp_gridsX.rbegin(), tmp_gridsX.rend());
-          std::vector<int> gridsY(tmp_gridsY.rbegin(), tmp_gridsY.rend());
-          std::vector<int> gridsL(tmp_gridsL.rbegin(), tmp_gridsL.rend());
+        std::vector<int> gridsX(tmp_gridsX.rbegin(), tmp_gridsX.rend());
+        std::vector<int> gridsY(tmp_gridsY.rbegin(), tmp_gridsY.rend());
+        std::vector<int> gridsL(tmp_gridsL.rbegin(), tmp_gridsL.rend());
 
-          // add the connection point (crossX, crossY)
-          gridsX.push_back(crossX);
-          gridsY.push_back(crossY);
-          gridsL.push_back(crossL);
-          cnt++;
+        // add the connection point (crossX, crossY)
+        gridsX.push_back(crossX);
+        gridsY.push_back(crossY);
+        gridsL.push_back(crossL);
+        cnt++;
 
-          curX = crossX;
-          curY = crossY;
-          curL = crossL;
+        curX = crossX;
+        curY = crossY;
+        curL = crossL;
 
-          cnt_n1n2 = cnt;
+        cnt_n1n2 = cnt;
 
-          E1x = gridsX[0];
-          E1y = gridsY[0];
-          E2x = gridsX.back();
-          E2y = gridsY.back();
+        E1x = gridsX[0];
+        E1y = gridsY[0];
+        E2x = gridsX.back();
+        E2y = gridsY.back();
 
-          headRoom = 0;
-          origL = gridsL[0];
+        headRoom = 0;
+        origL = gridsL[0];
 
-          while (headRoom < gridsX.size() && gridsX[headRoom] == E1x
-                 && gridsY[headRoom] == E1y) {
-            headRoom++;
-          }
-          if (headRoom > 0) {
-            headRoom--;
-          }
+        while (headRoom < gridsX.size() && gridsX[headRoom] == E1x
+               && gridsY[headRoom] == E1y) {
+          headRoom++;
+        }
+        if (headRoom > 0) {
+          headRoom--;
+        }
+
+        lastL = gridsL[headRoom];
 
-          lastL = gridsL[headRoom];
+        // change the tree structure according to the new routing for the tree
+        // edge find E1 and E2, and the endpoints of the edges they are on
 
-          // change the tree structure according to the new routing for the tree
-          // edge find E1 and E2, and the endpoints of the edges they are on
+        edge_n1n2 = edgeID;
+        // (1) consider subtree1
+        if (n1 >= deg && (E1x != n1x || E1y != n1y))
+        // n1 is not a pin and E1!=n1, then make change to subtree1,
+        // otherwise, no change to subtree1
+        {
+          n1Shift = TRUE;
+          corE1 = corrEdge3D[origL][E1y][E1x];
+
+          endpt1 = treeedges[corE1].n1;
+          endpt2 = treeedges[corE1].n2;
+
+          // find A1, A2 and edge_n1A1, edge_n1A2
+          if (treenodes[n1].nbr[0] == n2) {
+            A1 = treenodes[n1].nbr[1];
+            A2 = treenodes[n1].nbr[2];
+            edge_n1A1 = treenodes[n1].edge[1];
+            edge_n1A2 = treenodes[n1].edge[2];
+          } else if (treenodes[n1].nbr[1] == n2) {
+            A1 = treenodes[n1].nbr[0];
+            A2 = treenodes[n1].nbr[2];
+            edge_n1A1 = treenodes[n1].edge[0];
+            edge_n1A2 = treenodes[n1].edge[2];
+          } else {
+            A1 = treenodes[n1].nbr[0];
+            A2 = treenodes[n1].nbr[1];
+            edge_n1A1 = treenodes[n1].edge[0];
+            edge_n1A2 = treenodes[n1].edge[1];
+          }
 
-          edge_n1n2 = edgeID;
-          // (1) consider subtree1
-          if (n1 >= deg && (E1x != n1x || E1y != n1y))
-          // n1 is not a pin and E1!=n1, then make change to subtree1,
-          // otherwise, no change to subtree1
+          if (endpt1 == n1 || endpt2 == n1)  // E1 is on (n1, A1) or (n1, A2)
           {
-            n1Shift = TRUE;
-            corE1 = corrEdge3D[origL][E1y][E1x];
-
-            endpt1 = treeedges[corE1].n1;
-            endpt2 = treeedges[corE1].n2;
-
-            // find A1, A2 and edge_n1A1, edge_n1A2
-            if (treenodes[n1].nbr[0] == n2) {
-              A1 = treenodes[n1].nbr[1];
-              A2 = treenodes[n1].nbr[2];
-              edge_n1A1 = treenodes[n1].edge[1];
-              edge_n1A2 = treenodes[n1].edge[2];
-            } else if (treenodes[n1].nbr[1] == n2) {
-              A1 = treenodes[n1].nbr[0];
-              A2 = treenodes[n1].nbr[2];
-              edge_n1A1 = treenodes[n1].edge[0];
-              edge_n1A2 = treenodes[n1].edge[2];
-            } else {
-              A1 = treenodes[n1].nbr[0];
-              A2 = treenodes[n1].nbr[1];
-              edge_n1A1 = treenodes[n1].edge[0];
-              edge_n1A2 = treenodes[n1].edge[1];
+            // if E1 is on (n1, A2), switch A1 and A2 so that E1 is always on
+            // (n1, A1)
+            if (endpt1 == A2 || endpt2 == A2) {
+              tmpi = A1;
+              A1 = A2;
+              A2 = tmpi;
+              tmpi = edge_n1A1;
+              edge_n1A1 = edge_n1A2;
+              edge_n1A2 = tmpi;
             }
 
-            if (endpt1 == n1 || endpt2 == n1)  // E1 is on (n1, A1) or (n1, A2)
-            {
-              // if E1 is on (n1, A2), switch A1 and A2 so that E1 is always on
-              // (n1, A1)
-              if (endpt1 == A2 || endpt2 == A2) {
-                tmpi = A1;
-                A1 = A2;
-                A2 = tmpi;
-                tmpi = edge_n1A1;
-                edge_n1A1 = edge_n1A2;
-                edge_n1A2 = tmpi;
-              }
-
-              // update route for edge (n1, A1), (n1, A2)
-              updateRouteType13D(netID,
-                                 treenodes,
-                                 n1,
-                                 A1,
-                                 A2,
-                                 E1x,
-                                 E1y,
-                                 treeedges,
-                                 edge_n1A1,
-                                 edge_n1A2);
-
-              // update position for n1
-
-              // treenodes[n1].l = E1l;
-              treenodes[n1].assigned = TRUE;
-            }     // if E1 is on (n1, A1) or (n1, A2)
-            else  // E1 is not on (n1, A1) or (n1, A2), but on (C1, C2)
-            {
-              C1 = endpt1;
-              C2 = endpt2;
-              edge_C1C2 = corrEdge3D[origL][E1y][E1x];
-
-              // update route for edge (n1, C1), (n1, C2) and (A1, A2)
-              updateRouteType23D(netID,
-                                 treenodes,
-                                 n1,
-                                 A1,
-                                 A2,
-                                 C1,
-                                 C2,
-                                 E1x,
-                                 E1y,
-                                 treeedges,
-                                 edge_n1A1,
-                                 edge_n1A2,
-                                 edge_C1C2);
-              // update position for n1
-              treenodes[n1].x = E1x;
-              treenodes[n1].y = E1y;
-              treenodes[n1].assigned = TRUE;
-              // update 3 edges (n1, A1)->(C1, n1), (n1, A2)->(n1, C2), (C1,
-              // C2)->(A1, A2)
-              edge_n1C1 = edge_n1A1;
-              treeedges[edge_n1C1].n1 = C1;
-              treeedges[edge_n1C1].n2 = n1;
-              edge_n1C2 = edge_n1A2;
-              treeedges[edge_n1C2].n1 = n1;
-              treeedges[edge_n1C2].n2 = C2;
-              edge_A1A2 = edge_C1C2;
-              treeedges[edge_A1A2].n1 = A1;
-              treeedges[edge_A1A2].n2 = A2;
-              // update nbr and edge for 5 nodes n1, A1, A2, C1, C2
-              // n1's nbr (n2, A1, A2)->(n2, C1, C2)
-              treenodes[n1].nbr[0] = n2;
-              treenodes[n1].edge[0] = edge_n1n2;
-              treenodes[n1].nbr[1] = C1;
-              treenodes[n1].edge[1] = edge_n1C1;
-              treenodes[n1].nbr[2] = C2;
-              treenodes[n1].edge[2] = edge_n1C2;
-              // A1's nbr n1->A2
-              for (i = 0; i < 3; i++) {
-                if (treenodes[A1].nbr[i] == n1) {
-                  treenodes[A1].nbr[i] = A2;
-                  treenodes[A1].edge[i] = edge_A1A2;
-                  break;
-                }
+            // update route for edge (n1, A1), (n1, A2)
+            updateRouteType13D(netID,
+                               treenodes,
+                               n1,
+                               A1,
+                               A2,
+                               E1x,
+                               E1y,
+                               treeedges,
+                               edge_n1A1,
+                               edge_n1A2);
+
+            // update position for n1
+
+            // treenodes[n1].l = E1l;
+            treenodes[n1].assigned = TRUE;
+          }     // if E1 is on (n1, A1) or (n1, A2)
+          else  // E1 is not on (n1, A1) or (n1, A2), but on (C1, C2)
+          {
+            C1 = endpt1;
+            C2 = endpt2;
+            edge_C1C2 = corrEdge3D[origL][E1y][E1x];
+
+            // update route for edge (n1, C1), (n1, C2) and (A1, A2)
+            updateRouteType23D(netID,
+                               treenodes,
+                               n1,
+                               A1,
+                               A2,
+                               C1,
+                               C2,
+                               E1x,
+                               E1y,
+                               treeedges,
+                               edge_n1A1,
+                               edge_n1A2,
+                               edge_C1C2);
+            // update position for n1
+            treenodes[n1].x = E1x;
+            treenodes[n1].y = E1y;
+            treenodes[n1].assigned = TRUE;
+            // update 3 edges (n1, A1)->(C1, n1), (n1, A2)->(n1, C2), (C1,
+            // C2)->(A1, A2)
+            edge_n1C1 = edge_n1A1;
+            treeedges[edge_n1C1].n1 = C1;
+            treeedges[edge_n1C1].n2 = n1;
+            edge_n1C2 = edge_n1A2;
+            treeedges[edge_n1C2].n1 = n1;
+            treeedges[edge_n1C2].n2 = C2;
+            edge_A1A2 = edge_C1C2;
+            treeedges[edge_A1A2].n1 = A1;
+            treeedges[edge_A1A2].n2 = A2;
+            // update nbr and edge for 5 nodes n1, A1, A2, C1, C2
+            // n1's nbr (n2, A1, A2)->(n2, C1, C2)
+            treenodes[n1].nbr[0] = n2;
+            treenodes[n1].edge[0] = edge_n1n2;
+            treenodes[n1].nbr[1] = C1;
+            treenodes[n1].edge[1] = edge_n1C1;
+            treenodes[n1].nbr[2] = C2;
+            treenodes[n1].edge[2] = edge_n1C2;
+            // A1's nbr n1->A2
+            for (i = 0; i < 3; i++) {
+              if (treenodes[A1].nbr[i] == n1) {
+                treenodes[A1].nbr[i] = A2;
+                treenodes[A1].edge[i] = edge_A1A2;
+                break;
               }
-              // A2's nbr n1->A1
-              for (i = 0; i < 3; i++) {
-                if (treenodes[A2].nbr[i] == n1) {
-                  treenodes[A2].nbr[i] = A1;
-                  treenodes[A2].edge[i] = edge_A1A2;
-                  break;
-                }
+            }
+            // A2's nbr n1->A1
+            for (i = 0; i < 3; i++) {
+              if (treenodes[A2].nbr[i] == n1) {
+                treenodes[A2].nbr[i] = A1;
+                treenodes[A2].edge[i] = edge_A1A2;
+                break;
               }
-              // C1's nbr C2->n1
-              for (i = 0; i < 3; i++) {
-                if (treenodes[C1].nbr[i] == C2) {
-                  treenodes[C1].nbr[i] = n1;
-                  treenodes[C1].edge[i] = edge_n1C1;
-                  break;
-                }
+            }
+            // C1's nbr C2->n1
+            for (i = 0; i < 3; i++) {
+              if (treenodes[C1].nbr[i] == C2) {
+                treenodes[C1].nbr[i] = n1;
+                treenodes[C1].edge[i] = edge_n1C1;
+                break;
               }
-              // C2's nbr C1->n1
-              for (i = 0; i < 3; i++) {
-                if (treenodes[C2].nbr[i] == C1) {
-                  treenodes[C2].nbr[i] = n1;
-                  treenodes[C2].edge[i] = edge_n1C2;
-                  break;
-                }
+            }
+            // C2's nbr C1->n1
+            for (i = 0; i < 3; i++) {
+              if (treenodes[C2].nbr[i] == C1) {
+                treenodes[C2].nbr[i] = n1;
+                treenodes[C2].edge[i] = edge_n1C2;
+                break;
               }
-            }  // else E1 is not on (n1, A1) or (n1, A2), but on (C1, C2)
-          }    // n1 is not a pin and E1!=n1
-          else {
-            newUpdateNodeLayers(treenodes, edge_n1n2, n1a, lastL);
-          }
+            }
+          }  // else E1 is not on (n1, A1) or (n1, A2), but on (C1, C2)
+        }    // n1 is not a pin and E1!=n1
+        else {
+          newUpdateNodeLayers(treenodes, edge_n1n2, n1a, lastL);
+        }
 
-          origL = gridsL[cnt_n1n2 - 1];
-          tailRoom = cnt_n1n2 - 1;
+        origL = gridsL[cnt_n1n2 - 1];
+        tailRoom = cnt_n1n2 - 1;
 
-          while (tailRoom > 0 && gridsX[tailRoom] == E2x
-                 && gridsY[tailRoom] == E2y) {
-            tailRoom--;
-          }
-          if (tailRoom < cnt_n1n2 - 1) {
-            tailRoom++;
-          }
+        while (tailRoom > 0 && gridsX[tailRoom] == E2x
+               && gridsY[tailRoom] == E2y) {
+          tailRoom--;
+        }
+        if (tailRoom < cnt_n1n2 - 1) {
+          tailRoom++;
+        }
+
+        lastL = gridsL[tailRoom];
 
-          lastL = gridsL[tailRoom];
+        // (2) consider subtree2
+        if (n2 >= deg && (E2x != n2x || E2y != n2y))
+        // n2 is not a pin and E2!=n2, then make change to subtree2,
+        // otherwise, no change to subtree2
+        {
+          // find the endpoints of the edge E1 is on
+
+          n2Shift = TRUE;
+          corE2 = corrEdge3D[origL][E2y][E2x];
+          endpt1 = treeedges[corE2].n1;
+          endpt2 = treeedges[corE2].n2;
+
+          // find B1, B2
+          if (treenodes[n2].nbr[0] == n1) {
+            B1 = treenodes[n2].nbr[1];
+            B2 = treenodes[n2].nbr[2];
+            edge_n2B1 = treenodes[n2].edge[1];
+            edge_n2B2 = treenodes[n2].edge[2];
+          } else if (treenodes[n2].nbr[1] == n1) {
+            B1 = treenodes[n2].nbr[0];
+            B2 = treenodes[n2].nbr[2];
+            edge_n2B1 = treenodes[n2].edge[0];
+            edge_n2B2 = treenodes[n2].edge[2];
+          } else {
+            B1 = treenodes[n2].nbr[0];
+            B2 = treenodes[n2].nbr[1];
+            edge_n2B1 = treenodes[n2].edge[0];
+            edge_n2B2 = treenodes[n2].edge[1];
+          }
 
-          // (2) consider subtree2
-          if (n2 >= deg && (E2x != n2x || E2y != n2y))
-          // n2 is not a pin and E2!=n2, then make change to subtree2,
-          // otherwise, no change to subtree2
+          if (endpt1 == n2 || endpt2 == n2)  // E2 is on (n2, B1) or (n2, B2)
           {
-            // find the endpoints of the edge E1 is on
-
-            n2Shift = TRUE;
-            corE2 = corrEdge3D[origL][E2y][E2x];
-            endpt1 = treeedges[corE2].n1;
-            endpt2 = treeedges[corE2].n2;
-
-            // find B1, B2
-            if (treenodes[n2].nbr[0] == n1) {
-              B1 = treenodes[n2].nbr[1];
-              B2 = treenodes[n2].nbr[2];
-              edge_n2B1 = treenodes[n2].edge[1];
-              edge_n2B2 = treenodes[n2].edge[2];
-            } else if (treenodes[n2].nbr[1] == n1) {
-              B1 = treenodes[n2].nbr[0];
-              B2 = treenodes[n2].nbr[2];
-              edge_n2B1 = treenodes[n2].edge[0];
-              edge_n2B2 = treenodes[n2].edge[2];
-            } else {
-              B1 = treenodes[n2].nbr[0];
-              B2 = treenodes[n2].nbr[1];
-              edge_n2B1 = treenodes[n2].edge[0];
-              edge_n2B2 = treenodes[n2].edge[1];
+            // if E2 is on (n2, B2), switch B1 and B2 so that E2 is always on
+            // (n2, B1)
+            if (endpt1 == B2 || endpt2 == B2) {
+              tmpi = B1;
+              B1 = B2;
+              B2 = tmpi;
+              tmpi = edge_n2B1;
+              edge_n2B1 = edge_n2B2;
+              edge_n2B2 = tmpi;
             }
 
-            if (endpt1 == n2 || endpt2 == n2)  // E2 is on (n2, B1) or (n2, B2)
-            {
-              // if E2 is on (n2, B2), switch B1 and B2 so that E2 is always on
-              // (n2, B1)
-              if (endpt1 == B2 || endpt2 == B2) {
-                tmpi = B1;
-                B1 = B2;
-                B2 = tmpi;
-                tmpi = edge_n2B1;
-                edge_n2B1 = edge_n2B2;
-                edge_n2B2 = tmpi;
-              }
-
-              // update route for edge (n2, B1), (n2, B2)
-              updateRouteType13D(netID,
-                                 treenodes,
-                                 n2,
-                                 B1,
-                                 B2,
-                                 E2x,
-                                 E2y,
-                                 treeedges,
-                                 edge_n2B1,
-                                 edge_n2B2);
-
-              // update position for n2
-              treenodes[n2].assigned = TRUE;
-            }     // if E2 is on (n2, B1) or (n2, B2)
-            else  // E2 is not on (n2, B1) or (n2, B2), but on (d13D, d23D)
-            {
-              D1 = endpt1;
-              D2 = endpt2;
-              edge_D1D2 = corrEdge3D[origL][E2y][E2x];
-
-              // update route for edge (n2, d13D), (n2, d23D) and (B1, B2)
-              updateRouteType23D(netID,
-                                 treenodes,
-                                 n2,
-                                 B1,
-                                 B2,
-                                 D1,
-                                 D2,
-                                 E2x,
-                                 E2y,
-                                 treeedges,
-                                 edge_n2B1,
-                                 edge_n2B2,
-                                 edge_D1D2);
-              // update position for n2
-              treenodes[n2].x = E2x;
-              treenodes[n2].y = E2y;
-              treenodes[n2].assigned = TRUE;
-              // update 3 edges (n2, B1)->(d13D, n2), (n2, B2)->(n2, d23D),
-              // (d13D, d23D)->(B1, B2)
-              edge_n2D1 = edge_n2B1;
-              treeedges[edge_n2D1].n1 = D1;
-              treeedges[edge_n2D1].n2 = n2;
-              edge_n2D2 = edge_n2B2;
-              treeedges[edge_n2D2].n1 = n2;
-              treeedges[edge_n2D2].n2 = D2;
-              edge_B1B2 = edge_D1D2;
-              treeedges[edge_B1B2].n1 = B1;
-              treeedges[edge_B1B2].n2 = B2;
-              // update nbr and edge for 5 nodes n2, B1, B2, d13D, d23D
-              // n1's nbr (n1, B1, B2)->(n1, d13D, d23D)
-              treenodes[n2].nbr[0] = n1;
-              treenodes[n2].edge[0] = edge_n1n2;
-              treenodes[n2].nbr[1] = D1;
-              treenodes[n2].edge[1] = edge_n2D1;
-              treenodes[n2].nbr[2] = D2;
-              treenodes[n2].edge[2] = edge_n2D2;
-              // B1's nbr n2->B2
-              for (i = 0; i < 3; i++) {
-                if (treenodes[B1].nbr[i] == n2) {
-                  treenodes[B1].nbr[i] = B2;
-                  treenodes[B1].edge[i] = edge_B1B2;
-                  break;
-                }
+            // update route for edge (n2, B1), (n2, B2)
+            updateRouteType13D(netID,
+                               treenodes,
+                               n2,
+                               B1,
+                               B2,
+                               E2x,
+                               E2y,
+                               treeedges,
+                               edge_n2B1,
+                               edge_n2B2);
+
+            // update position for n2
+            treenodes[n2].assigned = TRUE;
+          }     // if E2 is on (n2, B1) or (n2, B2)
+          else  // E2 is not on (n2, B1) or (n2, B2), but on (d13D, d23D)
+          {
+            D1 = endpt1;
+            D2 = endpt2;
+            edge_D1D2 = corrEdge3D[origL][E2y][E2x];
+
+            // update route for edge (n2, d13D), (n2, d23D) and (B1, B2)
+            updateRouteType23D(netID,
+                               treenodes,
+                               n2,
+                               B1,
+                               B2,
+                               D1,
+                               D2,
+                               E2x,
+                               E2y,
+                               treeedges,
+                               edge_n2B1,
+                               edge_n2B2,
+                               edge_D1D2);
+            // update position for n2
+            treenodes[n2].x = E2x;
+            treenodes[n2].y = E2y;
+            treenodes[n2].assigned = TRUE;
+            // update 3 edges (n2, B1)->(d13D, n2), (n2, B2)->(n2, d23D),
+            // (d13D, d23D)->(B1, B2)
+            edge_n2D1 = edge_n2B1;
+            treeedges[edge_n2D1].n1 = D1;
+            treeedges[edge_n2D1].n2 = n2;
+            edge_n2D2 = edge_n2B2;
+            treeedges[edge_n2D2].n1 = n2;
+            treeedges[edge_n2D2].n2 = D2;
+            edge_B1B2 = edge_D1D2;
+            treeedges[edge_B1B2].n1 = B1;
+            treeedges[edge_B1B2].n2 = B2;
+            // update nbr and edge for 5 nodes n2, B1, B2, d13D, d23D
+            // n1's nbr (n1, B1, B2)->(n1, d13D, d23D)
+            treenodes[n2].nbr[0] = n1;
+            treenodes[n2].edge[0] = edge_n1n2;
+            treenodes[n2].nbr[1] = D1;
+            treenodes[n2].edge[1] = edge_n2D1;
+            treenodes[n2].nbr[2] = D2;
+            treenodes[n2].edge[2] = edge_n2D2;
+            // B1's nbr n2->B2
+            for (i = 0; i < 3; i++) {
+              if (treenodes[B1].nbr[i] == n2) {
+                treenodes[B1].nbr[i] = B2;
+                treenodes[B1].edge[i] = edge_B1B2;
+                break;
               }
-              // B2's nbr n2->B1
-              for (i = 0; i < 3; i++) {
-                if (treenodes[B2].nbr[i] == n2) {
-                  treenodes[B2].nbr[i] = B1;
-                  treenodes[B2].edge[i] = edge_B1B2;
-                  break;
-                }
+            }
+            // B2's nbr n2->B1
+            for (i = 0; i < 3; i++) {
+              if (treenodes[B2].nbr[i] == n2) {
+                treenodes[B2].nbr[i] = B1;
+                treenodes[B2].edge[i] = edge_B1B2;
+                break;
               }
-              // D1's nbr D2->n2
-              for (i = 0; i < 3; i++) {
-                if (treenodes[D1].nbr[i] == D2) {
-                  treenodes[D1].nbr[i] = n2;
-                  treenodes[D1].edge[i] = edge_n2D1;
-                  break;
-                }
+            }
+            // D1's nbr D2->n2
+            for (i = 0; i < 3; i++) {
+              if (treenodes[D1].nbr[i] == D2) {
+                treenodes[D1].nbr[i] = n2;
+                treenodes[D1].edge[i] = edge_n2D1;
+                break;
               }
-              // D2's nbr D1->n2
-              for (i = 0; i < 3; i++) {
-                if (treenodes[D2].nbr[i] == D1) {
-                  treenodes[D2].nbr[i] = n2;
-                  treenodes[D2].edge[i] = edge_n2D2;
-                  break;
-                }
+            }
+            // D2's nbr D1->n2
+            for (i = 0; i < 3; i++) {
+              if (treenodes[D2].nbr[i] == D1) {
+                treenodes[D2].nbr[i] = n2;
+                treenodes[D2].edge[i] = edge_n2D2;
+                break;
               }
-            }     // else E2 is not on (n2, B1) or (n2, B2), but on (d13D, d23D)
-          } else  // n2 is not a pin and E2!=n2
-          {
-            newUpdateNodeLayers(treenodes, edge_n1n2, n2a, lastL);
-          }
+            }
+          }     // else E2 is not on (n2, B1) or (n2, B2), but on (d13D, d23D)
+        } else  // n2 is not a pin and E2!=n2
+        {
+          newUpdateNodeLayers(treenodes, edge_n1n2, n2a, lastL);
+        }
 
-          newcnt_n1n2 = tailRoom - headRoom + 1;
+        newcnt_n1n2 = tailRoom - headRoom + 1;
 
-          // update route for edge (n1, n2) and edge usage
-          if (treeedges[edge_n1n2].route.type == MAZEROUTE) {
-            free(treeedges[edge_n1n2].route.gridsX);
-            free(treeedges[edge_n1n2].route.gridsY);
-            free(treeedges[edge_n1n2].route.gridsL);
-          }
+        // update route for edge (n1, n2) and edge usage
+        if (treeedges[edge_n1n2].route.type == MAZEROUTE) {
+          free(treeedges[edge_n1n2].route.gridsX);
+          free(treeedges[edge_n1n2].route.gridsY);
+          free(treeedges[edge_n1n2].route.gridsL);
+        }
 
-          treeedges[edge_n1n2].route.gridsX
-              = (short*) calloc(newcnt_n1n2, sizeof(short));
-          treeedges[edge_n1n2].route.gridsY
-              = (short*) calloc(newcnt_n1n2, sizeof(short));
-          treeedges[edge_n1n2].route.gridsL
-              = (short*) calloc(newcnt_n1n2, sizeof(short));
-          treeedges[edge_n1n2].route.type = MAZEROUTE;
-          treeedges[edge_n1n2].route.routelen = newcnt_n1n2 - 1;
-          treeedges[edge_n1n2].len = ADIFF(E1x, E2x) + ADIFF(E1y, E2y);
-
-          j = headRoom;
-          for (i = 0; i < newcnt_n1n2; i++) {
-            treeedges[edge_n1n2].route.gridsX[i] = gridsX[j];
-            treeedges[edge_n1n2].route.gridsY[i] = gridsY[j];
-            treeedges[edge_n1n2].route.gridsL[i] = gridsL[j];
-            j++;
-          }
+        treeedges[edge_n1n2].route.gridsX
+            = (short*) calloc(newcnt_n1n2, sizeof(short));
+        treeedges[edge_n1n2].route.gridsY
+            = (short*) calloc(newcnt_n1n2, sizeof(short));
+        treeedges[edge_n1n2].route.gridsL
+            = (short*) calloc(newcnt_n1n2, sizeof(short));
+        treeedges[edge_n1n2].route.type = MAZEROUTE;
+        treeedges[edge_n1n2].route.routelen = newcnt_n1n2 - 1;
+        treeedges[edge_n1n2].len = ADIFF(E1x, E2x) + ADIFF(E1y, E2y);
+
+        j = headRoom;
+        for (i = 0; i < newcnt_n1n2; i++) {
+          treeedges[edge_n1n2].route.gridsX[i] = gridsX[j];
+          treeedges[edge_n1n2].route.gridsY[i] = gridsY[j];
+          treeedges[edge_n1n2].route.gridsL[i] = gridsL[j];
+          j++;
+        }
 
-          // update edge usage
-          for (i = headRoom; i < tailRoom; i++) {
-            if (gridsL[i] == gridsL[i + 1]) {
-              if (gridsX[i] == gridsX[i + 1])  // a vertical edge
-              {
-                min_y = std::min(gridsY[i], gridsY[i + 1]);
-                v_edges3D[gridsL[i] * gridV + min_y * xGrid + gridsX[i]].usage
-                    += edgeCost;
-              } else  /// if(gridsY[i]==gridsY[i+1])// a horizontal edge
-              {
-                min_x = std::min(gridsX[i], gridsX[i + 1]);
-                h_edges3D[gridsL[i] * gridH + gridsY[i] * (xGrid - 1) + min_x]
-                    .usage
-                    += edgeCost;
-              }
+        // update edge usage
+        for (i = headRoom; i < tailRoom; i++) {
+          if (gridsL[i] == gridsL[i + 1]) {
+            if (gridsX[i] == gridsX[i + 1])  // a vertical edge
+            {
+              min_y = std::min(gridsY[i], gridsY[i + 1]);
+              v_edges3D[gridsL[i] * gridV + min_y * xGrid + gridsX[i]].usage
+                  += edgeCost;
+            } else  /// if(gridsY[i]==gridsY[i+1])// a horizontal edge
+            {
+              min_x = std::min(gridsX[i], gridsX[i + 1]);
+              h_edges3D[gridsL[i] * gridH + gridsY[i] * (xGrid - 1) + min_x]
+                  .usage
+                  += edgeCost;
             }
           }
+        }
 
-          if (n1Shift || n2Shift) {
-            // re statis the node overlap
-            numpoints = 0;
-
-            for (d = 0; d < 2 * deg - 2; d++) {
-              treenodes[d].topL = -1;
-              treenodes[d].botL = numLayers;
-              treenodes[d].assigned = FALSE;
-              treenodes[d].stackAlias = d;
-              treenodes[d].conCNT = 0;
-              treenodes[d].hID = BIG_INT;
-              treenodes[d].lID = BIG_INT;
-              treenodes[d].status = 0;
-
-              if (d < deg) {
-                treenodes[d].botL = treenodes[d].topL = 0;
-                // treenodes[d].l = 0;
-                treenodes[d].assigned = TRUE;
-                treenodes[d].status = 1;
+        if (n1Shift || n2Shift) {
+          // re statis the node overlap
+          numpoints = 0;
+
+          for (d = 0; d < 2 * deg - 2; d++) {
+            treenodes[d].topL = -1;
+            treenodes[d].botL = numLayers;
+            treenodes[d].assigned = FALSE;
+            treenodes[d].stackAlias = d;
+            treenodes[d].conCNT = 0;
+            treenodes[d].hID = BIG_INT;
+            treenodes[d].lID = BIG_INT;
+            treenodes[d].status = 0;
+
+            if (d < deg) {
+              treenodes[d].botL = treenodes[d].topL = 0;
+              // treenodes[d].l = 0;
+              treenodes[d].assigned = TRUE;
+              treenodes[d].status = 1;
+
+              xcor[numpoints] = treenodes[d].x;
+              ycor[numpoints] = treenodes[d].y;
+              dcor[numpoints] = d;
+              numpoints++;
+            } else {
+              redundant = FALSE;
+              for (k = 0; k < numpoints; k++) {
+                if ((treenodes[d].x == xcor[k])
+                    && (treenodes[d].y == ycor[k])) {
+                  treenodes[d].stackAlias = dcor[k];
 
+                  redundant = TRUE;
+                  break;
+                }
+              }
+              if (!redundant) {
                 xcor[numpoints] = treenodes[d].x;
                 ycor[numpoints] = treenodes[d].y;
                 dcor[numpoints] = d;
                 numpoints++;
-              } else {
-                redundant = FALSE;
-                for (k = 0; k < numpoints; k++) {
-                  if ((treenodes[d].x == xcor[k])
-                      && (treenodes[d].y == ycor[k])) {
-                    treenodes[d].stackAlias = dcor[k];
-
-                    redundant = TRUE;
-                    break;
-                  }
-                }
-                if (!redundant) {
-                  xcor[numpoints] = treenodes[d].x;
-                  ycor[numpoints] = treenodes[d].y;
-                  dcor[numpoints] = d;
-                  numpoints++;
-                }
               }
-            }  // numerating for nodes
-            for (k = 0; k < 2 * deg - 3; k++) {
-              treeedge = &(treeedges[k]);
+            }
+          }  // numerating for nodes
+          for (k = 0; k < 2 * deg - 3; k++) {
+            treeedge = &(treeedges[k]);
 
-              if (treeedge->len > 0) {
-                routeLen = treeedge->route.routelen;
+            if (treeedge->len > 0) {
+              routeLen = treeedge->route.routelen;
 
-                n1 = treeedge->n1;
-                n2 = treeedge->n2;
-                gridsLtmp = treeedge->route.gridsL;
+              n1 = treeedge->n1;
+              n2 = treeedge->n2;
+              gridsLtmp = treeedge->route.gridsL;
 
-                n1a = treenodes[n1].stackAlias;
+              n1a = treenodes[n1].stackAlias;
 
-                n2a = treenodes[n2].stackAlias;
+              n2a = treenodes[n2].stackAlias;
 
-                treeedge->n1a = n1a;
-                treeedge->n2a = n2a;
+              treeedge->n1a = n1a;
+              treeedge->n2a = n2a;
 
-                connectionCNT = treenodes[n1a].conCNT;
-                treenodes[n1a].heights[connectionCNT] = gridsLtmp[0];
-                treenodes[n1a].eID[connectionCNT] = k;
-                treenodes[n1a].conCNT++;
+              connectionCNT = treenodes[n1a].conCNT;
+              treenodes[n1a].heights[connectionCNT] = gridsLtmp[0];
+              treenodes[n1a].eID[connectionCNT] = k;
+              treenodes[n1a].conCNT++;
 
-                if (gridsLtmp[0] > treenodes[n1a].topL) {
-                  treenodes[n1a].hID = k;
-                  treenodes[n1a].topL = gridsLtmp[0];
-                }
-                if (gridsLtmp[0] < treenodes[n1a].botL) {
-                  treenodes[n1a].lID = k;
-                  treenodes[n1a].botL = gridsLtmp[0];
-                }
+              if (gridsLtmp[0] > treenodes[n1a].topL) {
+                treenodes[n1a].hID = k;
+                treenodes[n1a].topL = gridsLtmp[0];
+              }
+              if (gridsLtmp[0] < treenodes[n1a].botL) {
+                treenodes[n1a].lID = k;
+                treenodes[n1a].botL = gridsLtmp[0];
+              }
 
-                treenodes[n1a].assigned = TRUE;
+              treenodes[n1a].assigned = TRUE;
 
-                connectionCNT = treenodes[n2a].conCNT;
-                treenodes[n2a].heights[connectionCNT] = gridsLtmp[routeLen];
-                treenodes[n2a].eID[connectionCNT] = k;
-                treenodes[n2a].conCNT++;
-                if (gridsLtmp[routeLen] > treenodes[n2a].topL) {
-                  treenodes[n2a].hID = k;
-                  treenodes[n2a].topL = gridsLtmp[routeLen];
-                }
-                if (gridsLtmp[routeLen] < treenodes[n2a].botL) {
-                  treenodes[n2a].lID = k;
-                  treenodes[n2a].botL = gridsLtmp[routeLen];
-                }
+              connectionCNT = treenodes[n2a].conCNT;
+              treenodes[n2a].heights[connectionCNT] = gridsLtmp[routeLen];
+              treenodes[n2a].eID[connectionCNT] = k;
+              treenodes[n2a].conCNT++;
+              if (gridsLtmp[routeLen] > treenodes[n2a].topL) {
+                treenodes[n2a].hID = k;
+                treenodes[n2a].topL = gridsLtmp[routeLen];
+              }
+              if (gridsLtmp[routeLen] < treenodes[n2a].botL) {
+                treenodes[n2a].lID = k;
+                treenodes[n2a].botL = gridsLtmp[routeLen];
+              }
 
-                treenodes[n2a].assigned = TRUE;
+              treenodes[n2a].assigned = TRUE;
 
-              }  // edge len > 0
+            }  // edge len > 0
 
-            }  // eunmerating edges
-          }  // if shift1 and shift2
-        }
+          }  // eunmerating edges
+        }  // if shift1 and shift2
       }
     }
   }
+}
+
+void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
+                                         int ripupTHlb,
+                                         int ripupTHub)
+{
+  Bool* pop_heap23D;
+
+  int i, j, range;
+
+  directions3D = new dirctionT**[numLayers];
+  corrEdge3D = new int**[numLayers];
+  pr3D = new parent3D**[numLayers];
+
+  for (i = 0; i < numLayers; i++) {
+    directions3D[i] = new dirctionT*[yGrid];
+    corrEdge3D[i] = new int*[yGrid];
+    pr3D[i] = new parent3D*[yGrid];
+
+    for (j = 0; j < yGrid; j++) {
+      directions3D[i][j] = new dirctionT[xGrid];
+      corrEdge3D[i][j] = new int[xGrid];
+      pr3D[i][j] = new parent3D[xGrid];
+    }
+  }
+
+  pop_heap23D = new Bool[numLayers * YRANGE * XRANGE];
+
+  for (i = 0; i < yGrid; i++) {
+    for (j = 0; j < xGrid; j++) {
+      inRegion[i][j] = FALSE;
+    }
+  }
+
+  range = YRANGE * XRANGE * numLayers;
+  for (i = 0; i < range; i++) {
+    pop_heap23D[i] = FALSE;
+  }
+
+  mazeRouteMSMDOrder3DBatches(expand, ripupTHlb, ripupTHub, pop_heap23D);
 
   for (i = 0; i < numLayers; i++) {
     for (j = 0; j < yGrid; j++) {
@@ -1803,11 +1718,105 @@ void mazeRouteMSMDOrder3D(int expand, int ripupTHlb, int ripupTHub)
   delete[] pr3D;
 
   delete[] pop_heap23D;
-  delete[] heap13D;
-  delete[] heap23D;
 }
 
-void getLayerRange(TreeNode* treenodes, int edgeID, int n1, int deg)
+// the nets of a mazeRouteMSMDOrder3D round, see mazeRouteMSMDBatches.
+// pop_heap23D and the other grid indexed arrays are shared, the heaps and
+// the node lists are per thread.
+void FastRouteCore::mazeRouteMSMDOrder3DBatches(int expand,
+                                                int ripupTHlb,
+                                                int ripupTHub,
+                                                Bool* pop_heap23D)
+{
+  int netID, edgeID, orderIndex, len;
+  Bool ripup;
+  std::vector<int> netIDs;
+  std::vector<MazeRegion> regions;
+
+  int endIND = numValidNets * 0.9;
+
+  for (orderIndex = 0; orderIndex < endIND; orderIndex++) {
+    netID = treeOrderPV[orderIndex].treeIndex;
+
+    // only edges of these lengths get ripped up, and the others do not
+    // change unless one of them does
+    ripup = FALSE;
+    for (edgeID = 0; edgeID < 2 * sttrees[netID].deg - 3; edgeID++) {
+      len = sttrees[netID].edges[edgeID].len;
+      if (len < ripupTHub && len > ripupTHlb) {
+        ripup = TRUE;
+        break;
+      }
+    }
+
+    if (ripup) {
+      netIDs.push_back(netID);
+      regions.push_back(netRegion(netID, expand));
+    }
+  }
+
+  std::vector<std::vector<int>> batches;
+  mazeBatches(regions, batches);
+
+  std::vector<MazeHeap<int>> heap13Ds(numThreads);
+  std::vector<std::vector<short*>> heap23Ds(numThreads);
+  std::vector<std::vector<int>> xcors(numThreads);
+  std::vector<std::vector<int>> ycors(numThreads);
+  std::vector<std::vector<int>> dcors(numThreads);
+  std::exception_ptr error;
+
+  // the heaps share heap13DPos like they share d13D
+  for (MazeHeap<int>& heap : heap13Ds) {
+    heap.init(d13D.data(), heap13DPos.data());
+  }
+
+  for (const std::vector<int>& batch : batches) {
+#pragma omp parallel for num_threads(numThreads) schedule(dynamic)
+    for (int k = 0; k < batch.size(); k++) {
+      const int t = omp_get_thread_num();
+      const int net = batch[k];
+      const int heapSize = mazeHeapSize(netIDs[net], numLayers);
+      const int numNodes = 2 * sttrees[netIDs[net]].deg;
+
+      if (heap23Ds[t].size() < heapSize) {
+        heap23Ds[t].resize(heapSize);
+      }
+      if (xcors[t].size() < numNodes) {
+        xcors[t].resize(numNodes);
+        ycors[t].resize(numNodes);
+        dcors[t].resize(numNodes);
+      }
+
+      try {
+        mazeRouteNet3D(netIDs[net],
+                       expand,
+                       ripupTHlb,
+                       ripupTHub,
+                       regions[net],
+                       pop_heap23D,
+                       heap13Ds[t],
+                       heap23Ds[t].data(),
+                       xcors[t].data(),
+                       ycors[t].data(),
+                       dcors[t].data());
+      } catch (...) {
+#pragma omp critical
+        if (!error) {
+          error = std::current_exception();
+        }
+      }
+    }
+
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+void FastRouteCore::getLayerRange(TreeNode* treenodes,
+                                  int edgeID,
+                                  int n1,
+                                  int deg)
 {
   int i, ntpL, nbtL, nhID, nlID;
 
@@ -41,7 +41,5 @@ typedef struct
   int l;
 } Pos3D;
 
-void mazeRouteMSMDOrder3D(int expand, int ripupTHlb, int ripupTHub);
-
 }  // namespace grt
 #endif /* __MAZE3D_H__ */
@@ -42,7 +42,6 @@
 
 #include "DataProc.h"
 #include "DataType.h"
-#include "RipUp.h"
 #include "flute.h"
 #include "utility/Logger.h"
 
@@ -52,20 +51,9 @@ namespace grt {
 
 using utl::GRT;
 
-float* costHVH;  // Horizontal first Z
-float* costVHV;  // Vertical first Z
-float* costH;    // Horizontal segment cost
-float* costV;    // Vertical segment cost
-float* costLR;   // Left and right boundary cost
-float* costTB;   // Top and bottom boundary cost
-
-float* costHVHtest;  // Vertical first Z
-float* costVtest;    // Vertical segment cost
-float* costTBtest;   // Top and bottom boundary cost
-
 // estimate the routing by assigning 1 for H and V segments, 0.5 to both
 // possible L for L segments
-void estimateOneSeg(Segment* seg)
+void FastRouteCore::estimateOneSeg(Segment* seg)
 {
   int i;
   int ymin, ymax;
@@ -103,7 +91,7 @@ void estimateOneSeg(Segment* seg)
   }
 }
 
-void routeSegV(Segment* seg)
+void FastRouteCore::routeSegV(Segment* seg)
 {
   int i;
   int ymin, ymax;
@@ -122,7 +110,7 @@ void routeSegV(Segment* seg)
     v_edges[i * xGrid + seg->x1].est_usage += edgeCost;
 }
 
-void routeSegH(Segment* seg)
+void FastRouteCore::routeSegH(Segment* seg)
 {
   int i;
 
@@ -133,7 +121,7 @@ void routeSegH(Segment* seg)
 }
 
 // L-route, based on previous L route
-void routeSegL(Segment* seg)
+void FastRouteCore::routeSegL(Segment* seg)
 {
   int i, grid, grid1;
   float costL1, costL2, tmp;
@@ -206,7 +194,7 @@ void routeSegL(Segment* seg)
 }
 
 // First time L-route, based on 0.5-0.5 estimation
-void routeSegLFirstTime(Segment* seg)
+void FastRouteCore::routeSegLFirstTime(Segment* seg)
 {
   int i, vedge, hedge;
   float costL1, costL2, tmp;
@@ -285,7 +273,7 @@ void routeSegLFirstTime(Segment* seg)
 
 // route all segments with L, firstTime: TRUE, no previous route, FALSE -
 // previous is L-route
-void routeLAll(Bool firstTime)
+void FastRouteCore::routeLAll(Bool firstTime)
 {
   int i, j;
 
@@ -320,7 +308,7 @@ void routeLAll(Bool firstTime)
 }
 
 // L-route, rip-up the previous route according to the ripuptype
-void newrouteL(int netID, RouteType ripuptype, Bool viaGuided)
+void FastRouteCore::newrouteL(int netID, RouteType ripuptype, Bool viaGuided)
 {
   int i, j, d, n1, n2, x1, y1, x2, y2, grid, grid1;
   float costL1, costL2, tmp;
@@ -476,7 +464,7 @@ void newrouteL(int netID, RouteType ripuptype, Bool viaGuided)
 
 // route all segments with L, firstTime: TRUE, first newrouteLAll, FALSE - not
 // first
-void newrouteLAll(Bool firstTime, Bool viaGuided)
+void FastRouteCore::newrouteLAll(Bool firstTime, Bool viaGuided)
 {
   int i;
 
@@ -491,7 +479,7 @@ void newrouteLAll(Bool firstTime, Bool viaGuided)
   }
 }
 
-void newrouteZ_edge(int netID, int edgeID)
+void FastRouteCore::newrouteZ_edge(int netID, int edgeID)
 {
   int i, j, n1, n2, x1, y1, x2, y2, segWidth, bestZ, grid, grid1, grid2, ymin,
       ymax;
@@ -638,7 +626,7 @@ void newrouteZ_edge(int netID, int edgeID)
 }
 
 // Z-route, rip-up the previous route according to the ripuptype
-void newrouteZ(int netID, int threshold)
+void FastRouteCore::newrouteZ(int netID, int threshold)
 {
   int ind, i, j, d, n1, n2, x1, y1, x2, y2, segWidth, segHeight, bestZ, grid,
       grid1, grid2, ymin, ymax, n1a, n2a, status1, status2;
@@ -963,7 +951,7 @@ void newrouteZ(int netID, int threshold)
 // ripup a tree edge according to its ripup type and Z-route it
 // route all segments with L, firstTime: TRUE, first newrouteLAll, FALSE - not
 // first
-void newrouteZAll(int threshold)
+void FastRouteCore::newrouteZAll(int threshold)
 {
   int i;
   for (i = 0; i < numValidNets; i++) {
@@ -972,7 +960,7 @@ void newrouteZAll(int threshold)
 }
 
 // Ripup the original route and do Monotonic routing within bounding box
-void routeMonotonic(int netID, int edgeID, int threshold)
+void FastRouteCore::routeMonotonic(int netID, int edgeID, int threshold)
 {
   int i, j, cnt, x, xl, yl, xr, yr, n1, n2, x1, y1, x2, y2, grid, xGrid_1,
       ind_i, ind_j, ind_x;
@@ -1205,7 +1193,7 @@ void routeMonotonic(int netID, int edgeID, int threshold)
   delete[] gridsY;
 }
 
-void routeMonotonicAll(int threshold)
+void FastRouteCore::routeMonotonicAll(int threshold)
 {
   int netID, edgeID;
 
@@ -1219,7 +1207,7 @@ void routeMonotonicAll(int threshold)
   }
 }
 
-void spiralRoute(int netID, int edgeID)
+void FastRouteCore::spiralRoute(int netID, int edgeID)
 {
   int j, n1, n2, x1, y1, x2, y2, grid, grid1, n1a, n2a;
   float costL1, costL2, tmp;
@@ -1397,7 +1385,7 @@ void spiralRoute(int netID, int edgeID)
     sttrees[netID].edges[edgeID].route.type = NOROUTE;
 }
 
-void spiralRouteAll()
+void FastRouteCore::spiralRouteAll()
 {
   int netID, d, k, edgeID, nodeID, deg, numpoints, n1, n2;
   int na;
@@ -1544,7 +1532,10 @@ void spiralRouteAll()
   }
 }
 
-void routeLVEnew(int netID, int edgeID, int threshold, int enlarge)
+void FastRouteCore::routeLVEnew(int netID,
+                                int edgeID,
+                                int threshold,
+                                int enlarge)
 {
   int i, j, cnt, xmin, xmax, ymin, ymax, n1, n2, x1, y1, x2, y2, grid, xGrid_1,
       deg, yminorig, ymaxorig;
@@ -1851,7 +1842,7 @@ void routeLVEnew(int netID, int edgeID, int threshold, int enlarge)
   delete[] gridsY;
 }
 
-void routeLVAll(int threshold, int expand)
+void FastRouteCore::routeLVAll(int threshold, int expand)
 {
   int netID, edgeID, numEdges, i, forange;
 
@@ -1878,7 +1869,7 @@ void routeLVAll(int threshold, int expand)
   delete[] h_costTable;
 }
 
-void newrouteLInMaze(int netID)
+void FastRouteCore::newrouteLInMaze(int netID)
 {
   int i, j, d, n1, n2, x1, y1, x2, y2, grid, grid1;
   int costL1, costL2, tmp;
@@ -40,30 +40,5 @@ namespace grt {
 #define SAMEX 0
 #define SAMEY 1
 
-extern float* costHVH;  // Horizontal first Z
-extern float* costVHV;  // Vertical first Z
-extern float* costH;    // Horizontal segment cost
-extern float* costV;    // Vertical segment cost
-extern float* costLR;   // Left and right boundary cost
-extern float* costTB;   // Top and bottom boundary cost
-
-extern float* costHVHtest;  // Vertical first Z
-extern float* costVtest;    // Vertical segment cost
-extern float* costTBtest;   // Top and bottom boundary cost
-
-// old functions for segment list data structure
-extern void routeSegL(Segment* seg);
-extern void routeLAll(Bool firstTime);
-// new functions for tree data structure
-extern void newrouteL(int netID, RouteType ripuptype, Bool viaGuided);
-extern void newrouteZ(int netID, int threshold);
-extern void newrouteZ_edge(int netID, int edgeID);
-extern void newrouteLAll(Bool firstTime, Bool viaGuided);
-extern void newrouteZAll(int threshold);
-extern void routeMonotonicAll(int threshold);
-extern void routeMonotonic(int netID, int edgeID, int threshold);
-extern void routeLVAll(int threshold, int expand);
-extern void spiralRouteAll();
-extern void newrouteLInMaze(int netID);
 }  // namespace grt
 #endif /* __ROUTE_H__ */
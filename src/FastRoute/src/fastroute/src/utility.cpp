@@ -46,7 +46,7 @@ namespace grt {
 
 using utl::GRT;
 
-void printEdge(int netID, int edgeID)
+void FastRouteCore::printEdge(int netID, int edgeID)
 {
   int i;
   TreeEdge edge;
@@ -69,7 +69,7 @@ void printEdge(int netID, int edgeID)
   logger->report("{}", routes_rpt);
 }
 
-void plotTree(int netID)
+void FastRouteCore::plotTree(int netID)
 {
   short *gridsX, *gridsY;
   int i, j, Zpoint, n1, n2, x1, x2, y1, y2, ymin, ymax, xmin, xmax;
@@ -172,7 +172,7 @@ void plotTree(int netID)
   fclose(fp);
 }
 
-void getlen()
+void FastRouteCore::getlen()
 {
   int i, edgeID, totlen = 0;
   TreeEdge* treeedge;
@@ -189,7 +189,7 @@ void getlen()
   logger->info(GRT, 196, "Routed len: {}", totlen);
 }
 
-void ConvertToFull3DType2()
+void FastRouteCore::ConvertToFull3DType2()
 {
   short *gridsX, *gridsY, *gridsL, tmpX[MAXLEN], tmpY[MAXLEN], tmpL[MAXLEN];
   int k, netID, edgeID, routeLen;
@@ -259,7 +259,7 @@ void ConvertToFull3DType2()
 
 static int comparePVMINX(const void* a, const void* b)
 {
-  int ret = -2;
+  int ret = 0;
   if (((OrderNetPin*) a)->minX > ((OrderNetPin*) b)->minX) {
     ret = 1;
   } else if (((OrderNetPin*) a)->minX == ((OrderNetPin*) b)->minX) {
@@ -267,16 +267,12 @@ static int comparePVMINX(const void* a, const void* b)
   } else if (((OrderNetPin*) a)->minX < ((OrderNetPin*) b)->minX) {
     ret = -1;
   }
-  if (ret == -2) {
-    logger->error(GRT, 175, "Invalid PVMINX comparison.");
-  } else {
-    return ret;
-  }
+  return ret;
 }
 
 static int comparePVPV(const void* a, const void* b)
 {
-  int ret = -2;
+  int ret = 0;
   if (((OrderNetPin*) a)->npv > ((OrderNetPin*) b)->npv) {
     ret = 1;
   } else if (((OrderNetPin*) a)->npv == ((OrderNetPin*) b)->npv) {
@@ -284,14 +280,10 @@ static int comparePVPV(const void* a, const void* b)
   } else if (((OrderNetPin*) a)->npv < ((OrderNetPin*) b)->npv) {
     ret = -1;
   }
-  if (ret == -2) {
-    logger->error(GRT, 176, "Invalid PVPV comparison.");
-  } else {
-    return ret;
-  }
+  return ret;
 }
 
-void netpinOrderInc()
+void FastRouteCore::netpinOrderInc()
 {
   int j, d, ind, totalLength, xmin;
   TreeNode* treenodes;
@@ -335,7 +327,7 @@ void netpinOrderInc()
   qsort(treeOrderPV, numValidNets, sizeof(OrderNetPin), comparePVPV);
 }
 
-void fillVIA()
+void FastRouteCore::fillVIA()
 {
   short tmpX[MAXLEN], tmpY[MAXLEN], *gridsX, *gridsY, *gridsL, tmpL[MAXLEN];
   int k, netID, edgeID, routeLen, n1a, n2a;
@@ -435,7 +427,7 @@ void fillVIA()
   }
 }
 
-int threeDVIA()
+int FastRouteCore::threeDVIA()
 {
   short* gridsL;
   int netID, edgeID, deg;
@@ -467,7 +459,7 @@ int threeDVIA()
   return (numVIA);
 }
 
-void assignEdge(int netID, int edgeID, Bool processDIR)
+void FastRouteCore::assignEdge(int netID, int edgeID, Bool processDIR)
 {
   short *gridsX, *gridsY, *gridsL;
   int i, k, l, grid, min_x, min_y, routelen, n1a, n2a, last_layer;
@@ -766,7 +758,7 @@ void assignEdge(int netID, int edgeID, Bool processDIR)
   }
 }
 
-void newLayerAssignmentV4()
+void FastRouteCore::newLayerAssignmentV4()
 {
   short* gridsL;
   int i, k, netID, edgeID, nodeID, routeLen;
@@ -908,7 +900,7 @@ void newLayerAssignmentV4()
   }
 }
 
-void newLA()
+void FastRouteCore::newLA()
 {
   int netID, d, k, edgeID, deg, numpoints, n1, n2;
   Bool redundant;
@@ -989,7 +981,7 @@ void newLA()
   ConvertToFull3DType2();
 }
 
-void printEdge3D(int netID, int edgeID)
+void FastRouteCore::printEdge3D(int netID, int edgeID)
 {
   int i;
   TreeEdge edge;
@@ -1017,7 +1009,7 @@ void printEdge3D(int netID, int edgeID)
   }
 }
 
-void printTree3D(int netID)
+void FastRouteCore::printTree3D(int netID)
 {
   int edgeID, nodeID;
   for (nodeID = 0; nodeID < 2 * sttrees[netID].deg - 2; nodeID++) {
@@ -1032,7 +1024,7 @@ void printTree3D(int netID)
   }
 }
 
-void checkRoute3D()
+void FastRouteCore::checkRoute3D()
 {
   short *gridsX, *gridsY, *gridsL;
   int i, netID, edgeID, nodeID, edgelength;
@@ -1120,7 +1112,7 @@ void checkRoute3D()
   }
 }
 
-void write3D()
+void FastRouteCore::write3D()
 {
   short *gridsX, *gridsY, *gridsL;
   int netID, i, edgeID, deg, lastX, lastY, lastL, xreal, yreal, routeLen;
@@ -1174,7 +1166,7 @@ void write3D()
 
 static int compareTEL(const void* a, const void* b)
 {
-  int ret = -2;
+  int ret = 0;
   if (((OrderTree*) a)->xmin < ((OrderTree*) b)->xmin) {
     ret = 1;
   } else if (((OrderTree*) a)->xmin == ((OrderTree*) b)->xmin) {
@@ -1182,14 +1174,10 @@ static int compareTEL(const void* a, const void* b)
   } else if (((OrderTree*) a)->xmin > ((OrderTree*) b)->xmin) {
     ret = -1;
   }
-  if (ret == -2) {
-    logger->error(GRT, 177, "Invalid TEL comparison.");
-  } else {
-    return ret;
-  }
+  return ret;
 }
 
-void StNetOrder()
+void FastRouteCore::StNetOrder()
 {
   short *gridsX, *gridsY;
   int i, j, d, ind, grid, min_x, min_y;
@@ -1237,7 +1225,7 @@ void StNetOrder()
   qsort(treeOrderCong, numValidNets, sizeof(OrderTree), compareTEL);
 }
 
-void recoverEdge(int netID, int edgeID)
+void FastRouteCore::recoverEdge(int netID, int edgeID)
 {
   short *gridsX, *gridsY, *gridsL;
   int i, grid, ymin, xmin, n1a, n2a;
@@ -1313,7 +1301,7 @@ void recoverEdge(int netID, int edgeID)
   }
 }
 
-void checkUsage()
+void FastRouteCore::checkUsage()
 {
   short *gridsX, *gridsY;
   int netID, i, k, edgeID, deg;
@@ -1382,7 +1370,7 @@ void checkUsage()
 
 static int compareEdgeLen(const void* a, const void* b)
 {
-  int ret = -2;
+  int ret = 0;
   if (((OrderNetEdge*) a)->length < ((OrderNetEdge*) b)->length) {
     ret = 1;
   } else if (((OrderNetEdge*) a)->length == ((OrderNetEdge*) b)->length) {
@@ -1390,14 +1378,10 @@ static int compareEdgeLen(const void* a, const void* b)
   } else if (((OrderNetEdge*) a)->length > ((OrderNetEdge*) b)->length) {
     ret = -1;
   }
-  if (ret == -2) {
-    logger->error(GRT, 178, "Invalid EdgeLen comparison.");
-  } else {
-    return ret;
-  }
+  return ret;
 }
 
-void netedgeOrderDec(int netID)
+void FastRouteCore::netedgeOrderDec(int netID, OrderNetEdge* netEO)
 {
   int j, d, numTreeedges;
 
@@ -1412,7 +1396,7 @@ void netedgeOrderDec(int netID)
   qsort(netEO, numTreeedges, sizeof(OrderNetEdge), compareEdgeLen);
 }
 
-void printEdge2D(int netID, int edgeID)
+void FastRouteCore::printEdge2D(int netID, int edgeID)
 {
   int i;
   TreeEdge edge;
@@ -1440,7 +1424,7 @@ void printEdge2D(int netID, int edgeID)
   }
 }
 
-void printTree2D(int netID)
+void FastRouteCore::printTree2D(int netID)
 {
   int edgeID, nodeID;
   for (nodeID = 0; nodeID < 2 * sttrees[netID].deg - 2; nodeID++) {
@@ -1455,7 +1439,7 @@ void printTree2D(int netID)
   }
 }
 
-Bool checkRoute2DTree(int netID)
+Bool FastRouteCore::checkRoute2DTree(int netID)
 {
   Bool STHwrong, gridFlag;
   short *gridsX, *gridsY;
@@ -1538,7 +1522,7 @@ Bool checkRoute2DTree(int netID)
   return (STHwrong);
 }
 
-void writeRoute3D(char routingfile3D[])
+void FastRouteCore::writeRoute3D(char routingfile3D[])
 {
   short *gridsX, *gridsY, *gridsL;
   int netID, i, edgeID, deg, lastX, lastY, lastL, xreal, yreal, routeLen;
@@ -1590,27 +1574,6 @@ void writeRoute3D(char routingfile3D[])
   fclose(fp);
 }
 
-float* pH;
-float* pV;
-struct BBox* netBox;
-struct BBox** pnetBox;
-
-struct TD
-{
-  int id;
-  float cost;
-};
-
-struct BBox
-{
-  int xmin;
-  int ymin;
-  int xmax;
-  int ymax;
-  int hSpan;
-  int vSpan;
-};  // lower_left corner and upper_right corner
-
 struct wire
 {
   int x1, y1, x2, y2;
@@ -1618,7 +1581,7 @@ struct wire
 };
 
 // Copy Routing Solution for the best routing solution so far
-void copyRS(void)
+void FastRouteCore::copyRS(void)
 {
   int i, j, netID, edgeID, numEdges, numNodes;
 
@@ -1683,7 +1646,7 @@ void copyRS(void)
   }
 }
 
-void copyBR(void)
+void FastRouteCore::copyBR(void)
 {
   short *gridsX, *gridsY;
   int i, j, netID, edgeID, numEdges, numNodes, grid, min_y, min_x;
@@ -1790,7 +1753,7 @@ void copyBR(void)
   }
 }
 
-void freeRR(void)
+void FastRouteCore::freeRR(void)
 {
   int netID, edgeID, numEdges;
   if (sttreesBK != NULL) {
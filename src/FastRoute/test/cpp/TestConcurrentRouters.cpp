@@ -0,0 +1,227 @@
+////////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2018, Iowa State University All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+// Routes synthetic designs with independent FastRouteCore instances, one
+// after the other and then on four threads at the same time, and checks
+// that each design gets the same routes both ways. Also routes a congested
+// design with maze routing on 1, 2 and 4 threads and checks that the routes
+// do not depend on the thread count.
+
+#define BOOST_TEST_MODULE TestConcurrentRouters
+#include <boost/test/included/unit_test.hpp>
+#include <functional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "FastRoute.h"
+#include "flute.h"
+#include "opendb/db.h"
+#include "spdlog/sinks/ostream_sink.h"
+#include "utility/Logger.h"
+
+using namespace grt;
+
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+static const int grids = 60;
+static const int layers = 4;
+static const int tile = 100;
+static const int net_count = 600;
+static const int capacity = 4;
+
+struct GridPin
+{
+  int x;
+  int y;
+};
+
+// Nets of 2 to 6 distinct gcell pins on layer 1, each within a 20x20
+// gcell window.
+static std::vector<std::vector<GridPin>> makeNets(int seed)
+{
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<int> corner(0, grids - 20);
+  std::uniform_int_distribution<int> offset(0, 19);
+  std::uniform_int_distribution<int> degree(2, 6);
+
+  std::vector<std::vector<GridPin>> nets(net_count);
+  for (std::vector<GridPin>& pins : nets) {
+    int x0 = corner(rng);
+    int y0 = corner(rng);
+    int deg = degree(rng);
+    while (static_cast<int>(pins.size()) < deg) {
+      GridPin pin{x0 + offset(rng), y0 + offset(rng)};
+      bool duplicate = false;
+      for (const GridPin& other : pins) {
+        duplicate |= other.x == pin.x && other.y == pin.y;
+      }
+      if (!duplicate) {
+        pins.push_back(pin);
+      }
+    }
+  }
+  return nets;
+}
+
+// Routes the nets of seed with a router of its own and hashes the routes.
+static size_t route(int seed,
+                    const std::vector<odb::dbNet*>& db_nets,
+                    utl::Logger* logger,
+                    int tracks = capacity,
+                    int threads = 1)
+{
+  std::vector<std::vector<GridPin>> nets = makeNets(seed);
+
+  FastRouteCore router(logger);
+  router.setLowerLeft(0, 0);
+  router.setTileSize(tile, tile);
+  router.setGridsAndLayers(grids, grids, layers);
+  router.setLayerOrientation(0);
+  for (int l = 1; l <= layers; l++) {
+    bool horizontal = (l - 1) % 2 == 0;
+    router.addHCapacity(horizontal ? tracks : 0, l);
+    router.addVCapacity(horizontal ? 0 : tracks, l);
+    router.addMinWidth(tile / 10, l);
+    router.addMinSpacing(tile / 10, l);
+    router.addViaSpacing(1, l);
+  }
+  router.setVerbose(0);
+  router.setOverflowIterations(50);
+  router.setPDRevForHighFanout(-1);
+  router.setAllowOverflow(true);
+  router.setThreads(threads);
+
+  router.setNumberNets(nets.size());
+  router.setMaxNetDegree(6);
+  for (size_t i = 0; i < nets.size(); i++) {
+    int netID = router.addNet(
+        db_nets[i], nets[i].size(), nets[i].size(), 0, false, 1);
+    for (const GridPin& pin : nets[i]) {
+      router.addPin(netID, pin.x, pin.y, 1);
+    }
+  }
+  router.initEdges();
+  router.setNumAdjustments(0);
+  router.initAuxVar();
+
+  NetRouteMap routes = router.run();
+
+  size_t hash = 0;
+  for (odb::dbNet* db_net : db_nets) {
+    for (const GSegment& segment : routes[db_net]) {
+      for (int value : {segment.initX,
+                        segment.initY,
+                        segment.initLayer,
+                        segment.finalX,
+                        segment.finalY,
+                        segment.finalLayer}) {
+        hash = hash * 31 + std::hash<int>()(value);
+      }
+    }
+  }
+  return hash;
+}
+
+BOOST_AUTO_TEST_CASE(test_concurrent_routers)
+{
+  stt::readLUT();
+  utl::Logger logger;
+
+  // The routes are keyed by dbNet.
+  odb::dbDatabase* db = odb::dbDatabase::create();
+  odb::dbTech::create(db);
+  odb::dbChip* chip = odb::dbChip::create(db);
+  odb::dbBlock* block = odb::dbBlock::create(chip, "top");
+  std::vector<odb::dbNet*> db_nets;
+  for (int i = 0; i < net_count; i++) {
+    std::string name = "n" + std::to_string(i);
+    db_nets.push_back(odb::dbNet::create(block, name.c_str()));
+  }
+
+  const int routers = 4;
+  std::vector<size_t> serial(routers);
+  for (int i = 0; i < routers; i++) {
+    serial[i] = route(i + 1, db_nets, &logger);
+  }
+  // Different designs get different routes.
+  BOOST_TEST(serial[0] != serial[1]);
+
+  std::vector<size_t> concurrent(routers);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < routers; i++) {
+    threads.emplace_back(
+        [&, i]() { concurrent[i] = route(i + 1, db_nets, &logger); });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  for (int i = 0; i < routers; i++) {
+    BOOST_TEST(concurrent[i] == serial[i]);
+  }
+
+  odb::dbDatabase::destroy(db);
+}
+
+// The nets on half the capacity overflow after pattern routing, so the
+// rip-up and reroute rounds run mazeRouteMSMD.
+BOOST_AUTO_TEST_CASE(test_maze_threads)
+{
+  stt::readLUT();
+  std::ostringstream log;
+  utl::Logger logger;
+  logger.addSink(std::make_shared<spdlog::sinks::ostream_sink_mt>(log));
+
+  odb::dbDatabase* db = odb::dbDatabase::create();
+  odb::dbTech::create(db);
+  odb::dbChip* chip = odb::dbChip::create(db);
+  odb::dbBlock* block = odb::dbBlock::create(chip, "top");
+  std::vector<odb::dbNet*> db_nets;
+  for (int i = 0; i < net_count; i++) {
+    std::string name = "n" + std::to_string(i);
+    db_nets.push_back(odb::dbNet::create(block, name.c_str()));
+  }
+
+  size_t serial = route(1, db_nets, &logger, capacity / 2, 1);
+  BOOST_TEST(log.str().find("GRT-0101") != std::string::npos);
+
+  for (int threads : {2, 4}) {
+    BOOST_TEST(route(1, db_nets, &logger, capacity / 2, threads) == serial);
+  }
+
+  odb::dbDatabase::destroy(db);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
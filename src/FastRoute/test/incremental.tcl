@@ -0,0 +1,68 @@
+# incremental global routing after moving an instance of gcd_nangate45
+source "helpers.tcl"
+read_lef "Nangate45/Nangate45.lef"
+read_def "gcd.def"
+
+# The guide lines of each net in a guide file.
+proc read_guides { file } {
+  set guides [dict create]
+  set net ""
+  set stream [open $file r]
+  while { [gets $stream line] >= 0 } {
+    if { $line == "(" } {
+      continue
+    } elseif { $line == ")" } {
+      set net ""
+    } elseif { $net == "" } {
+      set net $line
+      dict set guides $net {}
+    } else {
+      dict lappend guides $net $line
+    }
+  }
+  close $stream
+  return $guides
+}
+
+set guide_file1 [make_result_file incremental1.guide]
+set guide_file2 [make_result_file incremental2.guide]
+
+global_route
+write_guides $guide_file1
+
+global_route -start_incremental
+
+# Move _439_ one site to the right, inside its gcell. Only its nets are
+# rerouted.
+set inst [[ord::get_db_block] findInst "_439_"]
+$inst setLocation 66880 109200
+
+set moved_nets {}
+foreach iterm [$inst getITerms] {
+  set net [$iterm getNet]
+  if { $net != "NULL" } {
+    lappend moved_nets [$net getName]
+  }
+}
+
+global_route -end_incremental
+write_guides $guide_file2
+
+set guides1 [read_guides $guide_file1]
+set guides2 [read_guides $guide_file2]
+if { [lsort [dict keys $guides1]] != [lsort [dict keys $guides2]] } {
+  puts "fail: the routed nets changed"
+  exit 1
+}
+dict for {net guide} $guides1 {
+  if { [lsearch -exact $moved_nets $net] != -1 } {
+    if { [dict get $guides2 $net] == {} } {
+      puts "fail: $net has no guides after rerouting"
+      exit 1
+    }
+  } elseif { [dict get $guides2 $net] != $guide } {
+    puts "fail: $net was rerouted"
+    exit 1
+  }
+}
+puts "pass"
@@ -11,3 +11,8 @@ record_tests {
   repair_antennas1
   repair_antennas2
 }
+
+record_pass_fail_tests {
+  incremental
+  threads
+}
@@ -0,0 +1,24 @@
+# maze routing with 1 and 4 threads gives the same guides
+source "helpers.tcl"
+read_lef "Nangate45/Nangate45.lef"
+read_def "gcd.def"
+
+set guide_file1 [make_result_file threads1.guide]
+set guide_file2 [make_result_file threads4.guide]
+
+# Congest gcd so the overflow is repaired by maze routing.
+set_global_routing_layer_adjustment * 0.7
+global_route -layers 2-4 -threads 1
+write_guides $guide_file1
+
+grt::clear_fastroute
+
+set_global_routing_layer_adjustment * 0.7
+global_route -layers 2-4 -threads 4
+write_guides $guide_file2
+
+if { [diff_files $guide_file1 $guide_file2] } {
+  puts "fail: the guides depend on the thread count"
+  exit 1
+}
+puts "pass"
@@ -96,6 +96,8 @@ class dbCapNode;
 class dbRSeg;
 class dbCCSeg;
 class dbBlockSearch;
+class dbSpatialIndex;
+class dbWireShapeCache;
 class dbRow;
 class dbFill;
 class dbTechAntennaPinModel;
@@ -150,6 +152,18 @@ class dbViaParams;
 // Extraction Objects
 class dbExtControl;
 
+///
+/// dbMemoryUsage - Memory held by one object table or heap store of a
+/// block (see dbBlock::getMemoryUsage).
+///
+struct dbMemoryUsage
+{
+  std::string _name;    // object type, or name of the store
+  uint64      _count;   // number of objects or elements
+  uint64      _used;    // bytes held by them
+  uint64      _wasted;  // bytes allocated but unused: free slots, slack
+};
+
 ///
 /// dbProperty - Property base class.
 ///
@@ -339,12 +353,27 @@ class dbDatabase : public dbObject
   ///
   // dbObject * resolveDbName( const char * dbname );
 
+  ///
+  /// Sections of a compressed database that read() leaves compressed in
+  /// memory. A deferred section is decoded the first time it is accessed.
+  ///
+  enum LoadProfile
+  {
+    LOAD_ALL,            // everything
+    LOAD_NO_PARASITICS,  // defer the parasitics
+    LOAD_PLACEMENT       // defer the wires and the parasitics
+  };
+
   ///
   /// Read a database from this stream.
+  /// Databases written by writeCompressed() are recognized and their
+  /// sections are decompressed in parallel; sections excluded by the
+  /// load profile are only decompressed when they are accessed. The
+  /// profile is ignored for databases written by write().
   /// WARNING: This function destroys the data currently in the database.
   /// Throws ZIOError..
   ///
-  void read(FILE* file);
+  void read(FILE* file, LoadProfile profile = LOAD_ALL);
 
   ///
   /// Write a database to this stream.
@@ -352,6 +381,21 @@ class dbDatabase : public dbObject
   ///
   void write(FILE* file);
 
+  ///
+  /// Write a database to this stream as independently compressed sections:
+  /// the technology, the libraries, the netlist and the nets, wires and
+  /// parasitics of each block. The sections are serialized and compressed
+  /// on up to num_threads threads (0 uses all hardware threads).
+  /// Throws ZIOError..
+  ///
+  void writeCompressed(FILE* file, int num_threads = 0);
+
+  ///
+  /// The schema revision of the streams written by the write methods.
+  /// Data written under another revision can't be read back.
+  ///
+  static uint getSchemaRevision();
+
   /// Throws ZIOError..
   void writeTech(FILE* file);
   void writeLib(FILE* file, dbLib* lib);
@@ -362,6 +406,12 @@ class dbDatabase : public dbObject
   void writeNets(FILE* file, dbBlock* block);
   void writeParasitics(FILE* file, dbBlock* block);
   void readTech(FILE* file);
+
+  ///
+  /// Replace the contents of this library with a library written by
+  /// writeLib. The masters are given new master ids, in their order in
+  /// the library, so they stay unique across all libraries.
+  ///
   void readLib(FILE* file, dbLib*);
   void readLibs(FILE* file);
   void readBlock(FILE* file, dbBlock* block);
@@ -411,6 +461,28 @@ class dbDatabase : public dbObject
   static void writeEco(dbBlock* block, FILE* stream);
   static int  checkEco(dbBlock* block);
 
+  ///
+  /// Returns true if netlist changes are being collected on the block.
+  ///
+  static bool ecoInProgress(dbBlock* block);
+
+  ///
+  /// Returns true if the block has been changed since beginEco() in ways the
+  /// eco does not record: wires, special wires, bterms, pins, obstructions,
+  /// blockages, rows, fills or regions, or a dbBlockSnapshot rollback. A
+  /// delta written from such an eco does not reproduce the block.
+  ///
+  static bool ecoHasUnrecordedEdits(dbBlock* block);
+
+  ///
+  /// Write the netlist changes collected so far on the specified block
+  /// without ending the eco. If beginEco() is called right after the
+  /// database is written, the database and this delta reproduce the
+  /// current block: read the database, then readEco() and commitEco() the
+  /// delta.
+  ///
+  static void writeEcoDelta(dbBlock* block, FILE* stream);
+
   ///
   /// Commit any pending netlist changes.
   ///
@@ -812,6 +884,37 @@ class dbBlock : public dbObject
   ///
   dbBox* getBBox();
 
+  ///
+  /// Concurrent read access. From beginConcurrentRead() until the matching
+  /// endConcurrentRead() any number of threads may read this block and its
+  /// child blocks at the same time: iterate dbSets, find objects by id or
+  /// name, get bounding boxes, decode wires and read parasitics. No thread
+  /// may modify the database in this period. beginConcurrentRead() brings
+  /// the block bounding boxes, which readers would otherwise update lazily,
+  /// up to date; a stale bounding box covers the wires, so computing it
+  /// decodes wires deferred by dbDatabase::read. Other deferred sections
+  /// are decoded by the first access that needs them, and readers that
+  /// arrive meanwhile wait for it. Both are called from a single thread,
+  /// outside of the parallel region, and may be nested.
+  ///
+  void beginConcurrentRead();
+  void endConcurrentRead();
+  bool inConcurrentRead();
+
+  ///
+  /// Callback batches. From beginCallBackBatch() until the matching
+  /// commitCallBackBatch() instance moves (dbInst::setOrigin, setLocation,
+  /// setOrient and setInstPlacement) are not reported as they happen. The
+  /// commit calls inDbPostMoveInsts once with every instance moved in the
+  /// batch; no inDbPreMoveInst is sent, so a callback that needs the old
+  /// placement must keep it. Instances destroyed inside the batch are not
+  /// reported. Batches may be nested, the outermost commit delivers the
+  /// callbacks. See dbCallBackBatchScope.
+  ///
+  void beginCallBackBatch();
+  void commitCallBackBatch();
+  bool inCallBackBatch();
+
   ///
   /// Get the chip this block belongs too.
   ///
@@ -891,6 +994,13 @@ class dbBlock : public dbObject
   ///
   dbInst* findInst(const char* name);
 
+  ///
+  /// Find the instances of names; insts[i] is NULL if names[i] is not
+  /// found. Faster than calling findInst for each name.
+  ///
+  void findInsts(const std::vector<std::string>& names,
+                 std::vector<dbInst*>&           insts);
+
   ///
   /// Find a specific module in this block.
   /// Returns NULL if the object was not found.
@@ -962,6 +1072,13 @@ class dbBlock : public dbObject
   ///
   dbNet* findNet(const char* name);
 
+  ///
+  /// Find the nets of names; nets[i] is NULL if names[i] is not found.
+  /// Faster than calling findNet for each name.
+  ///
+  void findNets(const std::vector<std::string>& names,
+                std::vector<dbNet*>&            nets);
+
   ///
   /// Find a set of nets. Each name can be real name, or Nxxx, or xxx,
   /// where xxx is the net oid.
@@ -1061,6 +1178,45 @@ class dbBlock : public dbObject
   ///
   void adjustRC(double resFactor, double ccFactor, double gndcFactor);
 
+  ///
+  /// Flatten the hierarchical instances of this block. The objects of each
+  /// child block are copied into this block, named with the instance name
+  /// as prefix, and the instances and their child blocks are destroyed.
+  /// The hierarchy is flattened down to level levels; instances of deeper
+  /// child blocks are removed. The wires of the child blocks are translated
+  /// on up to num_threads threads (0 uses all hardware threads). Returns
+  /// false if an object could not be copied.
+  ///
+  bool flatten(int level = 1, int num_threads = 0);
+
+  ///
+  /// Returns a hash of the persistent content of this block: its fields,
+  /// its objects and their ids, and its parasitics. Blocks with equal
+  /// hashes write the same database file, so the hash can be used to
+  /// compare blocks or find duplicate checkpoints without a full diff.
+  ///
+  uint64 getContentHash();
+
+  ///
+  /// Keep the RC values of this block as 16 bit floats, which halves
+  /// their memory but keeps only about three significant digits, or
+  /// go back to 32 bit floats. Each of the resistance, capacitance and
+  /// coupling capacitance tables is scaled by a power of two to fit the
+  /// range of a 16 bit float. The values are written to a database file
+  /// as 32 bit floats and read back that way. Returns false, and leaves
+  /// the values unchanged, if the nonzero values of a table span more
+  /// than about 2^28.
+  ///
+  bool setCompactParasitics(bool compact);
+
+  ///
+  /// Returns true if the RC values are kept as 16 bit floats. A value
+  /// set after setCompactParasitics(true) rescales its table when it is
+  /// out of the range of the table, and returns the table to 32 bit
+  /// floats when the table can no longer be scaled to fit.
+  ///
+  bool hasCompactParasitics();
+
   ///
   /// add cc capacitance to gnd capacitance of capNodes of this block
   ///
@@ -1181,6 +1337,39 @@ class dbBlock : public dbObject
   ///
   void getMasters(std::vector<dbMaster*>& masters);
 
+  ///
+  /// Get the placement of every instance of this block as parallel arrays,
+  /// in getInsts() order: the instance, its location (dbInst::getLocation),
+  /// its orientation and the id of its master (dbMaster::getMasterId).
+  ///
+  void getInstPlacement(std::vector<dbInst*>&      insts,
+                        std::vector<int>&          xs,
+                        std::vector<int>&          ys,
+                        std::vector<dbOrientType>& orients,
+                        std::vector<int>&          master_ids);
+
+  ///
+  /// Place insts[i] at location (xs[i], ys[i]) with orientation orients[i],
+  /// as dbInst::setOrient followed by dbInst::setLocation. If orients is
+  /// empty the orientations are unchanged. The callbacks of this block see
+  /// the moved instances as one batch (dbBlockCallBackObj::inDbPreMoveInsts
+  /// and inDbPostMoveInsts), or as part of the open callback batch.
+  ///
+  void setInstPlacement(const std::vector<dbInst*>&      insts,
+                        const std::vector<int>&          xs,
+                        const std::vector<int>&          ys,
+                        const std::vector<dbOrientType>& orients);
+
+  ///
+  /// Get the pin center (dbITerm::getAvgXY) of every iterm of this block as
+  /// parallel arrays, ordered by instance (getInsts() order) and then by
+  /// master terminal. An iterm without pin geometry gets the center of its
+  /// instance.
+  ///
+  void getITermPinCenters(std::vector<dbITerm*>& iterms,
+                          std::vector<int>&      xs,
+                          std::vector<int>&      ys);
+
   ///
   /// Set the die area. The die-area is considered a constant regardless
   /// of the geometric elements of the dbBlock. It is generally a constant
@@ -1246,6 +1435,37 @@ class dbBlock : public dbObject
   ///
   dbBlockSearch* getSearchDb();
 
+  ///
+  /// Get the R-tree region search over the insts, wire shapes and fills of
+  /// this block. It is built on first use and then kept current through
+  /// the block callbacks; it is destroyed with the block.
+  ///
+  dbSpatialIndex* getSpatialIndex();
+
+  ///
+  /// Get the decoded wire shapes of this block. It is created on first use
+  /// and from then on dbWireShapeItr reads the wires of this block from it.
+  /// It is kept current through the block callbacks and destroyed with the
+  /// block, or by destroyWireShapeCache() to release its memory.
+  ///
+  dbWireShapeCache* getWireShapeCache();
+  void              destroyWireShapeCache();
+
+  ///
+  /// Get the memory used by this block (not its child blocks): one entry
+  /// for every object table, followed by the heap stores of the objects
+  /// (names, wire encodings, parasitic values, name hash tables and the
+  /// sections deferred by dbDatabase::read). O(objects) in runtime.
+  ///
+  void getMemoryUsage(std::vector<dbMemoryUsage>& usage);
+
+  ///
+  /// Returns true if the wires (parasitics) of this block were left
+  /// compressed by dbDatabase::read and have not been accessed since.
+  ///
+  bool hasDeferredWires();
+  bool hasDeferredParasitics();
+
   ///
   /// reset _netSdb
   ///
@@ -1562,6 +1782,54 @@ class dbBlock : public dbObject
   void ComputeBBox();
 };
 
+///
+/// Calls beginConcurrentRead() on a block for the lifetime of the scope,
+/// so the concurrent read also ends when an exception leaves the scope.
+/// A NULL block is not read concurrently.
+///
+class dbConcurrentReadScope
+{
+ public:
+  dbConcurrentReadScope(dbBlock* block) : _block(block)
+  {
+    if (_block)
+      _block->beginConcurrentRead();
+  }
+
+  ~dbConcurrentReadScope()
+  {
+    if (_block)
+      _block->endConcurrentRead();
+  }
+
+  dbConcurrentReadScope(const dbConcurrentReadScope&) = delete;
+  dbConcurrentReadScope& operator=(const dbConcurrentReadScope&) = delete;
+
+ private:
+  dbBlock* _block;
+};
+
+///
+/// Opens a callback batch on a block for the lifetime of the scope, so the
+/// batch is also committed when an exception leaves the scope.
+///
+class dbCallBackBatchScope
+{
+ public:
+  dbCallBackBatchScope(dbBlock* block) : _block(block)
+  {
+    _block->beginCallBackBatch();
+  }
+
+  ~dbCallBackBatchScope() { _block->commitCallBackBatch(); }
+
+  dbCallBackBatchScope(const dbCallBackBatchScope&) = delete;
+  dbCallBackBatchScope& operator=(const dbCallBackBatchScope&) = delete;
+
+ private:
+  dbBlock* _block;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 ///
 /// A block-terminal is the element used to represent connections in/out of
@@ -33,6 +33,7 @@
 #pragma once
 
 #include <list>
+#include <vector>
 #include "odb.h"
 
 namespace odb {
@@ -50,6 +51,7 @@ class dbBlockage;
 class dbObstruction;
 class dbRegion;
 class dbRow;
+class dbSBox;
 class dbSWire;
 ///////////////////////////////////////////////////////////////////////////////
 ///
@@ -71,6 +73,19 @@ class dbBlockCallBackObj
   virtual void inDbInstSwapMasterAfter(dbInst*) {}
   virtual void inDbPreMoveInst(dbInst*) {}
   virtual void inDbPostMoveInst(dbInst*) {}
+  // Moves made by dbBlock::setInstPlacement arrive as one batch, as do the
+  // moves of a callback batch (inDbPostMoveInsts only). By default each
+  // instance is passed to inDbPreMoveInst/inDbPostMoveInst.
+  virtual void inDbPreMoveInsts(const std::vector<dbInst*>& insts)
+  {
+    for (dbInst* inst : insts)
+      inDbPreMoveInst(inst);
+  }
+  virtual void inDbPostMoveInsts(const std::vector<dbInst*>& insts)
+  {
+    for (dbInst* inst : insts)
+      inDbPostMoveInst(inst);
+  }
   //dbInst End
 
   //dbNet Start
@@ -131,6 +146,7 @@ class dbBlockCallBackObj
   virtual void inDbWirePostAppend(dbWire*, dbWire*) {} //first is src, second is dst
   virtual void inDbWirePreCopy(dbWire*, dbWire*) {} //first is src, second is dst
   virtual void inDbWirePostCopy(dbWire*, dbWire*) {} //first is src, second is dst
+  virtual void inDbWirePostModify(dbWire*) {} // after dbWireEncoder::end
   //dbWire End
 
   //dbSWire Start
@@ -140,13 +156,22 @@ class dbBlockCallBackObj
   virtual void inDbSWirePostDestroySBoxes(dbSWire*) {}
   //dbSWire End
 
+  //dbSBox Start
+  virtual void inDbSBoxCreate(dbSBox*) {}
+  //dbSBox End
+
   //dbFill Start
   virtual void inDbFillCreate(dbFill*) {}
+  virtual void inDbFillDestroy(dbFill*) {}
   //dbFill End
 
   virtual void inDbBlockStreamOutBefore(dbBlock*) {}
   virtual void inDbBlockStreamOutAfter(dbBlock*) {}
   virtual void inDbBlockReadNetsBefore(dbBlock*) {}
+  // After dbBlockSnapshot::rollback(), which restores the block objects
+  // without calling their callbacks. Any object pointer a client kept may
+  // now refer to another object or to a destroyed one.
+  virtual void inDbBlockRollback(dbBlock*) {}
 
 
   // allow ECO client initialization - payam
@@ -0,0 +1,92 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2019, Nefelus Inc
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "odb.h"
+
+namespace odb {
+
+class dbBlock;
+class dbTableSnapshotBase;
+struct dbBlockSnapshotState;
+
+///
+/// dbBlockSnapshot - a saved state of a block, for trying a change and
+/// undoing it without writing and reading the database.
+///
+/// Taking a snapshot copies the pages of the block tables: a byte image of
+/// each page, and for the tables whose objects own names or vectors, a
+/// copy of the objects as well. rollback() compares the tables to the
+/// snapshot in parallel and rebuilds, in place, only the table pages that
+/// changed; the objects of the other pages are not touched. The snapshot
+/// stays valid after a rollback, so one snapshot serves any number of
+/// trials. Deleting the snapshot discards it.
+///
+/// The snapshot covers the objects of the block and its name hash tables,
+/// parasitics and extraction counters, and its child blocks: each child
+/// is rolled back the same way, and the children created since the
+/// snapshot are destroyed. A child block must not be destroyed while the
+/// snapshot exists. The chip, the tech and the libraries are not
+/// covered. The per object callbacks are not called for the objects a
+/// rollback restores; instead every block callback gets
+/// inDbBlockRollback() once the block is restored, and a client that
+/// keeps its own view of the block rebuilds it there. The spatial index
+/// of the block is discarded and the wire shape cache is cleared. The
+/// snapshot must be deleted before its block.
+///
+class dbBlockSnapshot
+{
+ public:
+  dbBlockSnapshot(dbBlock* block);
+  ~dbBlockSnapshot();
+
+  dbBlock* getBlock() const { return block_; }
+
+  ///
+  /// Restore the block to the state it had when the snapshot was taken.
+  /// Returns the number of table pages that were restored, in the block
+  /// and its children.
+  ///
+  uint rollback();
+
+ private:
+  dbBlock*                                          block_;
+  std::vector<std::unique_ptr<dbTableSnapshotBase>> tables_;
+  std::unique_ptr<dbBlockSnapshotState>             state_;
+  std::vector<std::unique_ptr<dbBlockSnapshot>>     children_;
+};
+
+}  // namespace odb
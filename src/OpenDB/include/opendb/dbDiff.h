@@ -34,6 +34,7 @@
 
 #include <vector>
 #include <string>
+#include <unordered_map>
 #include "odb.h"
 #include "dbId.h"
 #include "dbObject.h"
@@ -59,6 +60,8 @@ class dbDiff : public dbObject
   int                      _indent_per_level;
   bool                     _has_differences;
 
+  std::unordered_map<const void*, uint64> _content_hashes;
+
   void write_headers();
   void indent();
 
@@ -113,6 +116,17 @@ class dbDiff : public dbObject
   // Set the indent count per level (default is 4)
   void setIndentPerLevel(int n) { _indent_per_level = n; }
 
+  // Record the content hash of a table or block (see
+  // _dbBlock::getContentHashes).
+  void setContentHash(const void* object, uint64 hash)
+  {
+    _content_hashes[object] = hash;
+  }
+
+  // True if both objects have a recorded content hash and the hashes are
+  // equal, in which case there are no differences to look for.
+  bool sameContent(const void* lhs, const void* rhs) const;
+
   dbDiff& operator<<(bool c);
   dbDiff& operator<<(char c);
   dbDiff& operator<<(unsigned char c);
@@ -282,15 +296,15 @@ class dbDiff : public dbObject
            LHS_ITR,                       \
            RHS_ITR);
 
-#define DIFF_TABLE_NO_DEEP(TABLE)         \
-  if (!diff.deepDiff()) {                 \
-    TABLE->differences(diff, *rhs.TABLE); \
+#define DIFF_TABLE_NO_DEEP(TABLE)                                \
+  if (!diff.deepDiff() && !diff.sameContent(TABLE, rhs.TABLE)) { \
+    TABLE->differences(diff, *rhs.TABLE);                        \
   }
 
 #define DIFF_TABLE(TABLE)                                 \
   if (diff.deepDiff()) {                                  \
     set_symmetric_diff(diff, #TABLE, *TABLE, *rhs.TABLE); \
-  } else {                                                \
+  } else if (!diff.sameContent(TABLE, rhs.TABLE)) {       \
     TABLE->differences(diff, *rhs.TABLE);                 \
   }
 
@@ -36,6 +36,9 @@
 #include <stdio.h>
 #include <sys/times.h>
 
+#include <string>
+#include <vector>
+
 #include "odb.h"
 #include "ZInterface.h"
 
@@ -59,6 +62,30 @@ void error(int code, const char* msg, ...) ADS_FORMAT_PRINTF(2, 3);
 int debug(const char* mod, const char* tag, const char* msg, ...) ADS_FORMAT_PRINTF(3, 4);
 int isDebug(const char* mod, const char* tag);
 
+// A notice, warning or error held back by captureMessages.
+struct dbLogMessage
+{
+  enum Type
+  {
+    NOTICE_MSG,
+    WARNING_MSG,
+    ERROR_MSG
+  };
+
+  Type        _type;
+  int         _code;
+  const char* _format;
+  std::string _text;
+};
+
+// While messages is set, notice/warning/error calls made by the calling
+// thread are appended to it instead of printed; NULL prints them again.
+// Parallel passes use this to report in a deterministic order.
+void captureMessages(std::vector<dbLogMessage>* messages);
+
+// Print captured messages in order, as the original calls would have.
+void replayMessages(const std::vector<dbLogMessage>& messages);
+
 }  // namespace odb
 
 
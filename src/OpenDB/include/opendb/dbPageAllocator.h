@@ -0,0 +1,127 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2019, Nefelus Inc
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <stddef.h>
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "odb.h"
+
+namespace odb {
+
+///
+/// dbPageAllocator - the source of the memory for the pages of the object
+/// tables and paged vectors of the databases.
+///
+/// Each table takes its pages from the allocator that was installed when
+/// the table was created, so setPageAllocator only affects the tables
+/// created after it. The default allocator takes each page from malloc.
+/// An allocator must outlive the tables created while it was installed.
+///
+class dbPageAllocator
+{
+ public:
+  virtual ~dbPageAllocator() {}
+
+  ///
+  /// Get size bytes for a page. Throws ZOutOfMemory on failure.
+  ///
+  virtual void* allocate(size_t size) = 0;
+
+  ///
+  /// Give back a page of size bytes from allocate.
+  ///
+  virtual void deallocate(void* page, size_t size) = 0;
+};
+
+///
+/// dbHugePageArena - a page allocator that carves pages out of large
+/// chunks mapped from the system and marked for transparent huge pages,
+/// so the pages of a table sit close together and sweeps over them need
+/// fewer TLB entries.
+///
+/// A freed page is kept on a free-list for its size and handed out again
+/// to the next page of that size, so tables that are cleared and refilled
+/// (parasitics, snapshots, destroyed blocks) recycle their pages. The
+/// chunks are returned to the system when the arena is deleted.
+///
+class dbHugePageArena : public dbPageAllocator
+{
+ public:
+  ///
+  /// chunk_size is rounded up to a multiple of the 2MB huge page size.
+  /// Pages larger than a quarter of a chunk are taken from malloc.
+  ///
+  dbHugePageArena(size_t chunk_size = 64 << 20);
+  ~dbHugePageArena() override;
+
+  void* allocate(size_t size) override;
+  void  deallocate(void* page, size_t size) override;
+
+  ///
+  /// Bytes mapped from the system, and bytes held by allocated pages.
+  ///
+  void getUsage(uint64& mapped, uint64& allocated) const;
+
+ private:
+  static size_t roundSize(size_t size);
+
+  size_t                            _chunk_size;
+  std::vector<char*>                _chunks;
+  char*                             _next;
+  char*                             _end;
+  std::unordered_map<size_t, void*> _free_lists;
+  uint64                            _allocated;
+  mutable std::mutex                _mutex;
+};
+
+///
+/// The allocator that takes each page from malloc, the default.
+///
+dbPageAllocator* getMallocPageAllocator();
+
+///
+/// The allocator given to new tables, never NULL.
+///
+dbPageAllocator* getPageAllocator();
+
+///
+/// Give allocator, or malloc if allocator is NULL, to the tables created
+/// from now on.
+///
+void setPageAllocator(dbPageAllocator* allocator);
+
+}  // namespace odb
@@ -32,6 +32,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "ZException.h"
 #include "dbObject.h"
 #include "dbSet.h"
@@ -266,6 +268,9 @@ class dbShape
 ///
 /// RECT in the dbWire are treats as segments for convenience
 ///
+/// If the block of the wire has a dbWireShapeCache the shapes are read from
+/// the cache instead of being decoded.
+///
 class dbWireShapeItr
 {
  public:
@@ -284,8 +289,15 @@ class dbWireShapeItr
   int          _shape_id;
   bool         _has_width;
 
+  const std::vector<dbShape>* _cached_shapes;
+  const std::vector<int>*     _cached_ids;
+  const std::vector<Point>*   _cached_points;
+  int                         _cached_idx;
+
   unsigned char nextOp(int& value);
   unsigned char peekOp();
+  void          beginDecode(dbWire* wire);
+  bool          decodeNext(dbShape& shape);
 
  public:
   dbWireShapeItr();
@@ -294,6 +306,8 @@ class dbWireShapeItr
   void begin(dbWire* wire);
   bool next(dbShape& shape);
   int  getShapeId();
+
+  friend class dbWireShapeCache;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,144 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, OpenRoad Project
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/index/rtree.hpp>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "dbBlockCallBackObj.h"
+#include "geom.h"
+#include "odb.h"
+
+namespace odb {
+
+class dbTechLayer;
+
+///
+/// dbSpatialIndex - R-tree region search over the instances, routed wire
+/// shapes and fills of a block. Obtain it with dbBlock::getSpatialIndex().
+///
+/// The trees are bulk loaded once and then kept current through the block
+/// callbacks. Instance moves and fill changes are applied immediately. Wire
+/// edits only mark the net; its shapes are re-indexed on the next query
+/// (or by update()).
+///
+class dbSpatialIndex : public dbBlockCallBackObj
+{
+ public:
+  dbSpatialIndex(dbBlock* block);
+
+  ///
+  /// Find the instances whose bbox intersects area.
+  ///
+  void searchInsts(const Rect& area, std::vector<dbInst*>& insts);
+
+  ///
+  /// Find the wire, special wire and via shapes on layer that intersect
+  /// area, with the net that owns each shape.
+  ///
+  void searchShapes(dbTechLayer*                          layer,
+                    const Rect&                           area,
+                    std::vector<std::pair<Rect, dbNet*>>& shapes);
+
+  ///
+  /// Find the fills on layer that intersect area.
+  ///
+  void searchFills(dbTechLayer*          layer,
+                   const Rect&           area,
+                   std::vector<dbFill*>& fills);
+
+  ///
+  /// Re-index the shapes of the nets whose wires changed since the last
+  /// query. Queries do this themselves.
+  ///
+  void update();
+
+  void inDbInstCreate(dbInst* inst) override;
+  void inDbInstCreate(dbInst* inst, dbRegion* region) override;
+  void inDbInstDestroy(dbInst* inst) override;
+  void inDbInstSwapMasterBefore(dbInst* inst, dbMaster* master) override;
+  void inDbInstSwapMasterAfter(dbInst* inst) override;
+  void inDbPreMoveInst(dbInst* inst) override;
+  void inDbPostMoveInst(dbInst* inst) override;
+  void inDbNetDestroy(dbNet* net) override;
+  void inDbWireCreate(dbWire* wire) override;
+  void inDbWireDestroy(dbWire* wire) override;
+  void inDbWirePostModify(dbWire* wire) override;
+  void inDbWirePreAttach(dbWire* wire, dbNet* net) override;
+  void inDbWirePostAttach(dbWire* wire) override;
+  void inDbWirePreDetach(dbWire* wire) override;
+  void inDbWirePostAppend(dbWire* src, dbWire* dst) override;
+  void inDbWirePostCopy(dbWire* src, dbWire* dst) override;
+  void inDbSWireCreate(dbSWire* swire) override;
+  void inDbSWireDestroy(dbSWire* swire) override;
+  void inDbSWirePostDestroySBoxes(dbSWire* swire) override;
+  void inDbSBoxCreate(dbSBox* sbox) override;
+  void inDbFillCreate(dbFill* fill) override;
+  void inDbFillDestroy(dbFill* fill) override;
+
+ private:
+  using Point = boost::geometry::model::d2::point_xy<int>;
+  using Box   = boost::geometry::model::box<Point>;
+  template <typename T>
+  using Rtree
+      = boost::geometry::index::rtree<std::pair<Box, T>,
+                                      boost::geometry::index::quadratic<16>>;
+  using Shapes = std::vector<std::pair<dbTechLayer*, Box>>;
+
+  void   addInst(dbInst* inst);
+  void   removeInst(dbInst* inst);
+  void   markNet(dbNet* net);
+  void   removeNet(dbNet* net);
+  void   getNetShapes(dbNet* net, Shapes& shapes);
+  static Box  makeBox(const Rect& rect);
+  static Rect makeRect(const Box& box);
+
+  Rtree<dbInst*>                        insts_;
+  std::map<dbTechLayer*, Rtree<dbNet*>> shapes_;
+  std::map<dbTechLayer*, Rtree<dbFill*>> fills_;
+
+  // What is currently in the trees, so stale entries can be removed
+  // without re-deriving their old geometry.
+  std::unordered_map<dbInst*, Box>   inst_boxes_;
+  std::unordered_map<dbNet*, Shapes> net_shapes_;
+
+  // Nets whose wires changed since the last update.
+  std::set<dbNet*> dirty_nets_;
+};
+
+}  // namespace odb
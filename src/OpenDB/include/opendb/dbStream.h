@@ -44,12 +44,28 @@ namespace odb {
 
 class _dbDatabase;
 
+//
+// The streams do not call fwrite/fread per scalar. dbOStream collects the
+// encoded bytes in a fixed size buffer which is written out in large blocks.
+// dbIStream maps the file into memory and decodes directly from the mapped
+// pages, falling back to buffered reads if the file cannot be mapped
+// (e.g. a pipe). The encoding itself is unchanged, so existing databases
+// remain readable.
+//
 class dbOStream
 {
+  enum
+  {
+    BUFFER_SIZE = 1 << 16
+  };
+
   _dbDatabase* _db;
   FILE*        _f;
   double       _lef_area_factor;
   double       _lef_dist_factor;
+  char*        _buffer;
+  size_t       _buffer_cnt;
+  bool         _sectioned;
 
   void write_error()
   {
@@ -57,11 +73,40 @@ class dbOStream
                    "write failed on database stream; system io error: ");
   }
 
+  void write(const void* p, size_t n)
+  {
+    if (_buffer_cnt + n > BUFFER_SIZE) {
+      flush();
+
+      if (n > BUFFER_SIZE) {
+        if (fwrite(p, n, 1, _f) != 1)
+          write_error();
+        return;
+      }
+    }
+
+    memcpy(&_buffer[_buffer_cnt], p, n);
+    _buffer_cnt += n;
+  }
+
  public:
   dbOStream(_dbDatabase* db, FILE* f);
+  ~dbOStream();
+
+  // Write any buffered data to the underlying file. Writers must flush
+  // before the stream is destroyed, the destructor discards the buffer.
+  void flush();
 
   _dbDatabase* getDatabase() { return _db; }
 
+  //
+  // A sectioned stream leaves out the tech and lib tables of the database
+  // and the nets, wires and parasitics of each block. These are written as
+  // separate sections by dbDatabase::writeCompressed.
+  //
+  void setSectioned(bool value) { _sectioned = value; }
+  bool isSectioned() const { return _sectioned; }
+
   dbOStream& operator<<(bool c)
   {
     unsigned char b = (c == true ? 1 : 0);
@@ -70,81 +115,61 @@ class dbOStream
 
   dbOStream& operator<<(char c)
   {
-    int n = fwrite(&c, sizeof(c), 1, _f);
-    if (n != 1)
-      write_error();
+    write(&c, sizeof(c));
     return *this;
   }
 
   dbOStream& operator<<(unsigned char c)
   {
-    int n = fwrite(&c, sizeof(c), 1, _f);
-    if (n != 1)
-      write_error();
+    write(&c, sizeof(c));
     return *this;
   }
 
   dbOStream& operator<<(short c)
   {
-    int n = fwrite(&c, sizeof(c), 1, _f);
-    if (n != 1)
-      write_error();
+    write(&c, sizeof(c));
     return *this;
   }
 
   dbOStream& operator<<(unsigned short c)
   {
-    int n = fwrite(&c, sizeof(c), 1, _f);
-    if (n != 1)
-      write_error();
+    write(&c, sizeof(c));
     return *this;
   }
 
   dbOStream& operator<<(int c)
   {
-    int n = fwrite(&c, sizeof(c), 1, _f);
-    if (n != 1)
-      write_error();
+    write(&c, sizeof(c));
     return *this;
   }
 
   dbOStream& operator<<(uint64_t c)
   {
-    int n = fwrite(&c, sizeof(c), 1, _f);
-    if (n != 1)
-      write_error();
+    write(&c, sizeof(c));
     return *this;
   }
 
   dbOStream& operator<<(unsigned int c)
   {
-    int n = fwrite(&c, sizeof(c), 1, _f);
-    if (n != 1)
-      write_error();
+    write(&c, sizeof(c));
     return *this;
   }
 
   dbOStream& operator<<(float c)
   {
-    int n = fwrite(&c, sizeof(c), 1, _f);
-    if (n != 1)
-      write_error();
+    write(&c, sizeof(c));
     return *this;
   }
 
   dbOStream& operator<<(double c)
   {
-    int n = fwrite(&c, sizeof(c), 1, _f);
-    if (n != 1)
-      write_error();
+    write(&c, sizeof(c));
     return *this;
   }
 
   dbOStream& operator<<(long double c)
   {
-    int n = fwrite(&c, sizeof(c), 1, _f);
-    if (n != 1)
-      write_error();
+    write(&c, sizeof(c));
     return *this;
   }
 
@@ -155,9 +180,7 @@ class dbOStream
     } else {
       int l = strlen(c) + 1;
       *this << l;
-      int n = fwrite(c, l, 1, _f);
-      if (n != 1)
-        write_error();
+      write(c, l);
     }
 
     return *this;
@@ -206,7 +229,7 @@ class dbOStream
 
   void markStream()
   {
-    int marker = ftell(_f);
+    int marker = ftell(_f) + _buffer_cnt;
     int magic  = 0xCCCCCCCC;
     *this << magic;
     *this << marker;
@@ -223,10 +246,14 @@ class dbIStream
   _dbDatabase* _db;
   double       _lef_area_factor;
   double       _lef_dist_factor;
+  const char*  _map;       // mapped file, NULL if not mapped
+  size_t       _map_size;  // size of the mapped file
+  size_t       _map_pos;   // current file offset into the mapping
+  bool         _sectioned;
 
   void read_error()
   {
-    if (feof(_f))
+    if (_map || feof(_f))
       throw ZException(
           "read failed on database stream (unexpected end-of-file encounted).");
     else
@@ -234,11 +261,30 @@ class dbIStream
                      "read failed on database stream; system io error: ");
   }
 
+  void read(void* p, size_t n)
+  {
+    if (_map) {
+      if (n > _map_size - _map_pos)
+        read_error();
+      memcpy(p, &_map[_map_pos], n);
+      _map_pos += n;
+    } else if (fread(p, n, 1, _f) != 1)
+      read_error();
+  }
+
  public:
   dbIStream(_dbDatabase* db, FILE* f);
 
+  // Decode from a buffer in memory, the buffer is not owned by the stream.
+  dbIStream(_dbDatabase* db, const char* data, size_t size);
+  ~dbIStream();
+
   _dbDatabase* getDatabase() { return _db; }
 
+  // See dbOStream::setSectioned
+  void setSectioned(bool value) { _sectioned = value; }
+  bool isSectioned() const { return _sectioned; }
+
   dbIStream& operator>>(bool& c)
   {
     unsigned char b;
@@ -249,81 +295,61 @@ class dbIStream
 
   dbIStream& operator>>(char& c)
   {
-    int n = fread(&c, sizeof(c), 1, _f);
-    if (n != 1)
-      read_error();
+    read(&c, sizeof(c));
     return *this;
   }
 
   dbIStream& operator>>(unsigned char& c)
   {
-    int n = fread(&c, sizeof(c), 1, _f);
-    if (n != 1)
-      read_error();
+    read(&c, sizeof(c));
     return *this;
   }
 
   dbIStream& operator>>(short& c)
   {
-    int n = fread(&c, sizeof(c), 1, _f);
-    if (n != 1)
-      read_error();
+    read(&c, sizeof(c));
     return *this;
   }
 
   dbIStream& operator>>(unsigned short& c)
   {
-    int n = fread(&c, sizeof(c), 1, _f);
-    if (n != 1)
-      read_error();
+    read(&c, sizeof(c));
     return *this;
   }
 
   dbIStream& operator>>(int& c)
   {
-    int n = fread(&c, sizeof(c), 1, _f);
-    if (n != 1)
-      read_error();
+    read(&c, sizeof(c));
     return *this;
   }
 
   dbIStream& operator>>(uint64_t& c)
   {
-    int n = fread(&c, sizeof(c), 1, _f);
-    if (n != 1)
-      read_error();
+    read(&c, sizeof(c));
     return *this;
   }
 
   dbIStream& operator>>(unsigned int& c)
   {
-    int n = fread(&c, sizeof(c), 1, _f);
-    if (n != 1)
-      read_error();
+    read(&c, sizeof(c));
     return *this;
   }
 
   dbIStream& operator>>(float& c)
   {
-    int n = fread(&c, sizeof(c), 1, _f);
-    if (n != 1)
-      read_error();
+    read(&c, sizeof(c));
     return *this;
   }
 
   dbIStream& operator>>(double& c)
   {
-    int n = fread(&c, sizeof(c), 1, _f);
-    if (n != 1)
-      read_error();
+    read(&c, sizeof(c));
     return *this;
   }
 
   dbIStream& operator>>(long double& c)
   {
-    int n = fread(&c, sizeof(c), 1, _f);
-    if (n != 1)
-      read_error();
+    read(&c, sizeof(c));
     return *this;
   }
 
@@ -335,10 +361,8 @@ class dbIStream
     if (l == 0)
       c = NULL;
     else {
-      c     = (char*) malloc(l);
-      int n = fread(c, l, 1, _f);
-      if (n != 1)
-        read_error();
+      c = (char*) malloc(l);
+      read(c, l);
     }
 
     return *this;
@@ -390,7 +414,7 @@ class dbIStream
 
   void checkStream()
   {
-    int marker = ftell(_f);
+    int marker = _map ? _map_pos : ftell(_f);
     int magic  = 0xCCCCCCCC;
     int smarker;
     int smagic;
@@ -239,6 +239,13 @@ class dbWireEncoder
   ///
   ~dbWireEncoder();
 
+  ///
+  /// An encoder may be moved, so a wire encoded on one thread can be
+  /// finished (end) on another.
+  ///
+  dbWireEncoder(dbWireEncoder&&) = default;
+  dbWireEncoder& operator=(dbWireEncoder&&) = default;
+
   ///
   /// Begin a new encoding.
   ///
@@ -0,0 +1,112 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, OpenRoad Project
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "dbBlockCallBackObj.h"
+#include "dbShape.h"
+#include "odb.h"
+
+namespace odb {
+
+///
+/// dbWireShapeCache - The shapes of the wires of a block, decoded once.
+/// Obtain it with dbBlock::getWireShapeCache().
+///
+/// While a block has a cache, dbWireShapeItr reads the shapes of its wires
+/// from the cache, so tools that scan the same wires many times decode
+/// each wire only once. Wire edits drop the shapes of the edited wire
+/// through the block callbacks. Edits of the layer widths and vias the
+/// shapes are derived from are not tracked; call clear() after those.
+///
+/// The cache is opt-in: nothing creates it unless asked to, and
+/// dbBlock::destroyWireShapeCache() releases it. The shapes of a wire are
+/// kept in wire order, as dbWireShapeItr returns them, in a table indexed
+/// by the wire id.
+///
+class dbWireShapeCache : public dbBlockCallBackObj
+{
+ public:
+  struct Shapes
+  {
+    std::vector<dbShape> shapes;     // in dbWireShapeItr order
+    std::vector<int>     shape_ids;  // dbWireShapeItr::getShapeId()
+    std::vector<Point>   points;     // dbWireShapeItr::_prev_x/_prev_y
+  };
+
+  dbWireShapeCache(dbBlock* block);
+
+  ///
+  /// The shapes of wire, decoded now if they are not cached. May be called
+  /// from several threads in dbBlock concurrent read mode.
+  ///
+  const Shapes& getShapes(dbWire* wire);
+
+  ///
+  /// Decode the wires of all nets of the block that are not cached, on
+  /// num_threads threads (0 uses all hardware threads).
+  ///
+  void decodeAll(int num_threads = 0);
+
+  ///
+  /// Drop all cached shapes.
+  ///
+  void clear();
+
+  ///
+  /// Decode all shapes of wire in one pass.
+  ///
+  static void decode(dbWire* wire, Shapes& shapes);
+
+  void inDbWireDestroy(dbWire* wire) override;
+  void inDbWirePostModify(dbWire* wire) override;
+  void inDbWirePostAppend(dbWire* src, dbWire* dst) override;
+  void inDbWirePostCopy(dbWire* src, dbWire* dst) override;
+
+ private:
+  // Keeps an entry already in the slot of id. Called with lock_ held.
+  Shapes* insert(uint id, std::unique_ptr<Shapes> shapes);
+  void    remove(dbWire* wire);
+
+  // The slot of a wire that is not cached is empty. The entries are
+  // allocated one by one so references to them stay valid as the table
+  // grows.
+  dbBlock*                             block_;
+  std::mutex                           lock_;
+  std::vector<std::unique_ptr<Shapes>> shapes_;
+};
+
+}  // namespace odb
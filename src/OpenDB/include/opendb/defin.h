@@ -68,6 +68,10 @@ class defin
   void setAssemblyMode();
   void useBlockName(const char* name);
 
+  /// Parse the NETS and SPECIALNETS sections on up to num_threads threads
+  /// (0 uses all hardware threads). The default of 1 reads serially.
+  void setNumThreads(int num_threads);
+
   /// Create a new chip
   dbChip* createChip(std::vector<dbLib*>& search_libs, const char* def_file);
 
@@ -65,6 +65,10 @@ class defout
   void selectNet(dbNet* net);
   void setVersion(Version v);  // default is 5.8
 
+  // Format the components and nets on num_threads threads (0 uses all
+  // hardware threads). The file is the same as a single threaded write.
+  void setNumThreads(int num_threads);
+
   bool writeBlock(dbBlock* block, const char* def_file);
 };
 
@@ -33,6 +33,7 @@
 #pragma once
 
 #include "odb.h"
+#include <cstdint>
 #include <string>
 #include <list>
 
@@ -104,6 +105,8 @@ class lefin
   bool         _override_lef_dbu;
   bool         _master_modified;
   bool         _ignore_non_routing_layers;
+  std::string  _cache_dir;
+  uint64_t     _cache_tech_hash;
 
   void init();
   void setDBUPerMicron(int dbu);
@@ -128,6 +131,12 @@ class lefin
   }
 
   bool readLef(const char* lef_file);
+  std::string cacheFile(char kind, const char* lib_name, const char* lef_file);
+  uint64_t    techHash();
+  bool        readCache(const std::string& cache_file,
+                        const char*        lib_name,
+                        const char*        lef_file);
+  void        writeCache(const std::string& cache_file, bool tech, bool lib);
   bool addGeoms(dbObject* object, bool is_pin, lefiGeometries* geometry);
   void createLibrary();
   void createPolygon(dbObject*        object,
@@ -213,6 +222,15 @@ class lefin
   // Skip macro-obstructions in the lef file.
   void skipObstructions() { _skip_obstructions = true; }
 
+  //
+  // Keep a binary copy of each technology and library created from a LEF
+  // file in this directory, and load that copy instead of parsing the file
+  // when it is read again. Copies are keyed by the LEF file contents, the
+  // reader options and, for a library, the technology it is read into.
+  // An empty dir disables the cache.
+  //
+  void setCacheDir(const char* dir);
+
   //
   // Override the LEF DBU-PER-MICRON unit.
   // This function only is only effective when creating a technolgy, because the
@@ -40,18 +40,23 @@ class dbBlock;
 class dbNet;
 class dbWire;
 
+// The nets of a block are analyzed on up to num_threads threads (0 uses
+// all hardware threads); the reordered wires are written back in net
+// order, so the result does not depend on the thread count.
 void orderWires(dbBlock* b,
                 bool     force,
-                int      cutLength = 0,
-                int      maxLength = 0,
-                bool     quiet     = false);
+                int      cutLength   = 0,
+                int      maxLength   = 0,
+                bool     quiet       = false,
+                int      num_threads = 0);
 void orderWires(dbBlock*    b,
                 const char* net_name_or_id,
                 bool        force,
-                bool        verbose   = false,
-                bool        quiet     = false,
-                int         cutLength = 0,
-                int         maxLength = 0);
+                bool        verbose     = false,
+                bool        quiet       = false,
+                int         cutLength   = 0,
+                int         maxLength   = 0,
+                int         num_threads = 0);
 void orderWires(dbNet* net, bool force, bool verbose = false);
 
 // for the tiler
@@ -75,10 +75,17 @@ namespace odb {
           {% if 'no-cmp' not in field.flags %}
             {% if field.table %}
               if(*{{component}}!=*rhs.{{component}})
+                return false;
+            {% elif field.type == 'char *' %}
+              if({{component}} && rhs.{{component}}) {
+                if(strcmp({{component}},rhs.{{component}})!=0)
+                  return false;
+              } else if({{component}} || rhs.{{component}})
+                return false;
             {% else %}
               if({{component}}!=rhs.{{component}})
-            {% endif %}
                 return false;
+            {% endif %}
           {% endif %}
         {% endfor %}
       {% endif %}
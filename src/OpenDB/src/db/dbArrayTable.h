@@ -36,6 +36,7 @@
 
 #include "ZException.h"
 #include "dbCore.h"
+#include "dbPageAllocator.h"
 #include "dbVector.h"
 #include "odb.h"
 
@@ -70,7 +71,8 @@ class dbArrayTable : public dbObjectTable
   uint _free_list;          // objects on freelist
 
   // NON-PERSISTANT-DATA
-  dbArrayTablePage** _pages;  // page-table
+  dbArrayTablePage** _pages;      // page-table
+  dbPageAllocator*   _allocator;  // source of the pages
 
   void           resizePageTbl();
   void           newPage();
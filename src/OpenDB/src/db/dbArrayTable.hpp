@@ -110,7 +110,8 @@ void dbArrayTable<T>::clear()
         t->~T();
     }
 
-    free((void*) page);
+    _allocator->deallocate(page,
+                           page_size() * sizeof(T) + sizeof(dbObjectPage));
   }
 
   if (_pages)
@@ -141,6 +142,7 @@ dbArrayTable<T>::dbArrayTable(_dbDatabase* db,
   _objects_per_alloc = array_size;
   _free_list         = 0;
   _pages             = NULL;
+  _allocator         = getPageAllocator();
 }
 
 template <class T>
@@ -155,7 +157,8 @@ dbArrayTable<T>::dbArrayTable(_dbDatabase*           db,
       _alloc_cnt(t._alloc_cnt),
       _objects_per_alloc(t._objects_per_alloc),
       _free_list(t._free_list),
-      _pages(NULL)
+      _pages(NULL),
+      _allocator(getPageAllocator())
 {
   copy_pages(t);
 }
@@ -190,7 +193,7 @@ template <class T>
 void dbArrayTable<T>::newPage()
 {
   uint              size = page_size() * sizeof(T) + sizeof(dbObjectPage);
-  dbArrayTablePage* page = (dbArrayTablePage*) malloc(size);
+  dbArrayTablePage* page = (dbArrayTablePage*) _allocator->allocate(size);
   ZALLOCATED(page);
   memset(page, 0, size);
 
@@ -376,7 +379,7 @@ template <class T>
 void dbArrayTable<T>::copy_page(uint page_id, dbArrayTablePage* page)
 {
   uint              size = page_size() * sizeof(T) + sizeof(dbObjectPage);
-  dbArrayTablePage* p    = (dbArrayTablePage*) malloc(size);
+  dbArrayTablePage* p    = (dbArrayTablePage*) _allocator->allocate(size);
   ZALLOCATED(p);
   memset(p, 0, size);
   p->_table       = this;
@@ -440,7 +443,8 @@ dbIStream& operator>>(dbIStream& stream, dbArrayTable<T>& table)
   uint i;
   for (i = 0; i < table._page_cnt; ++i) {
     uint size = table.page_size() * sizeof(T) + sizeof(dbObjectPage);
-    dbArrayTablePage* page = (dbArrayTablePage*) malloc(size);
+    dbArrayTablePage* page
+        = (dbArrayTablePage*) table._allocator->allocate(size);
     ZALLOCATED(page);
     memset(page, 0, size);
     page->_page_addr = i << table._page_shift;
@@ -32,6 +32,7 @@
 
 #include <errno.h>
 #include <unistd.h>
+#include <functional>
 #include <memory>
 #include <string>
 
@@ -54,11 +55,13 @@
 #include "dbCapNode.h"
 #include "dbCapNodeItr.h"
 #include "dbChip.h"
+#include "dbContentHash.h"
 #include "dbDatabase.h"
 #include "dbDiff.h"
 #include "dbDiff.hpp"
 #include "dbExtControl.h"
 #include "dbFill.h"
+#include "dbFlatten.h"
 #include "dbGCellGrid.h"
 #include "dbGroup.h"
 #include "dbGroupInstItr.h"
@@ -79,6 +82,7 @@
 #include "dbNameCache.h"
 #include "dbNet.h"
 #include "dbObstruction.h"
+#include "dbParallel.h"
 #include "dbProperty.h"
 #include "dbPropertyItr.h"
 #include "dbRSeg.h"
@@ -93,6 +97,8 @@
 #include "dbSWireItr.h"
 #include "dbSearch.h"
 #include "dbShape.h"
+#include "dbSpatialIndex.h"
+#include "dbWireShapeCache.h"
 #include "dbTable.h"
 #include "dbTable.hpp"
 #include "dbTech.h"
@@ -141,26 +147,27 @@ template class dbHashTable<_dbBTerm>;
 
 _dbBlock::_dbBlock(_dbDatabase* db)
 {
-  _flags._valid_bbox       = 0;
-  _flags._buffer_altered   = 1;
-  _flags._active_pins      = 0;
-  _flags._skip_hier_stream = 0;
-  _flags._mme              = 0;
-  _flags._spare_bits_27    = 0;
-  _def_units               = 100;
-  _dbu_per_micron          = 1000;
-  _hier_delimeter          = 0;
-  _left_bus_delimeter      = 0;
-  _right_bus_delimeter     = 0;
-  _num_ext_corners         = 0;
-  _corners_per_block       = 0;
-  _corner_name_list        = 0;
-  _name                    = 0;
-  _maxCapNodeId            = 0;
-  _maxRSegId               = 0;
-  _maxCCSegId              = 0;
-  _minExtModelIndex        = -1;
-  _maxExtModelIndex        = -1;
+  _flags._valid_bbox         = 0;
+  _flags._buffer_altered     = 1;
+  _flags._active_pins        = 0;
+  _flags._skip_hier_stream   = 0;
+  _flags._mme                = 0;
+  _flags._compact_parasitics = 0;
+  _flags._spare_bits_26      = 0;
+  _def_units                 = 100;
+  _dbu_per_micron            = 1000;
+  _hier_delimeter            = 0;
+  _left_bus_delimeter        = 0;
+  _right_bus_delimeter       = 0;
+  _num_ext_corners           = 0;
+  _corners_per_block         = 0;
+  _corner_name_list          = 0;
+  _name                      = 0;
+  _maxCapNodeId              = 0;
+  _maxRSegId                 = 0;
+  _maxCCSegId                = 0;
+  _minExtModelIndex          = -1;
+  _maxExtModelIndex          = -1;
 
   _bterm_tbl = new dbTable<_dbBTerm>(
       db, this, (GetObjTbl_t) &_dbBlock::getObjectTable, dbBTermObj);
@@ -276,15 +283,15 @@ _dbBlock::_dbBlock(_dbDatabase* db)
       = new _dbNameCache(db, this, (GetObjTbl_t) &_dbBlock::getObjectTable);
   ZALLOCATED(_name_cache);
 
-  _r_val_tbl = new dbPagedVector<float, 4096, 12>();
+  _r_val_tbl = new dbParasiticValues();
   ZALLOCATED(_r_val_tbl);
   _r_val_tbl->push_back(0.0);
 
-  _c_val_tbl = new dbPagedVector<float, 4096, 12>();
+  _c_val_tbl = new dbParasiticValues();
   ZALLOCATED(_c_val_tbl);
   _c_val_tbl->push_back(0.0);
 
-  _cc_val_tbl = new dbPagedVector<float, 4096, 12>();
+  _cc_val_tbl = new dbParasiticValues();
   ZALLOCATED(_cc_val_tbl);
   _cc_val_tbl->push_back(0.0);
 
@@ -380,12 +387,19 @@ _dbBlock::_dbBlock(_dbDatabase* db)
   _prop_itr = new dbPropertyItr(_prop_tbl);
   ZALLOCATED(_prop_itr);
 
-  _num_ext_dbs     = 1;
-  _searchDb        = NULL;
-  _extmi           = NULL;
-  _ptFile          = NULL;
-  _journal         = NULL;
-  _journal_pending = NULL;
+  _num_ext_dbs      = 1;
+  _searchDb         = NULL;
+  _spatial_index    = NULL;
+  _wire_shape_cache = NULL;
+  _extmi            = NULL;
+  _ptFile           = NULL;
+  _journal          = NULL;
+  _journal_pending  = NULL;
+
+  _deferred_wires      = NULL;
+  _deferred_parasitics = NULL;
+  _concurrent_read_cnt = 0;
+  _callback_batch_cnt  = 0;
 
   _bterm_pins = nullptr;
 }
@@ -511,13 +525,13 @@ _dbBlock::_dbBlock(_dbDatabase* db, const _dbBlock& block)
   _name_cache = new _dbNameCache(db, this, *block._name_cache);
   ZALLOCATED(_name_cache);
 
-  _r_val_tbl = new dbPagedVector<float, 4096, 12>(*block._r_val_tbl);
+  _r_val_tbl = new dbParasiticValues(*block._r_val_tbl);
   ZALLOCATED(_r_val_tbl);
 
-  _c_val_tbl = new dbPagedVector<float, 4096, 12>(*block._c_val_tbl);
+  _c_val_tbl = new dbParasiticValues(*block._c_val_tbl);
   ZALLOCATED(_c_val_tbl);
 
-  _cc_val_tbl = new dbPagedVector<float, 4096, 12>(*block._cc_val_tbl);
+  _cc_val_tbl = new dbParasiticValues(*block._cc_val_tbl);
   ZALLOCATED(_cc_val_tbl);
 
   _cap_node_tbl = new dbTable<_dbCapNode>(db, this, *block._cap_node_tbl);
@@ -602,6 +616,8 @@ _dbBlock::_dbBlock(_dbDatabase* db, const _dbBlock& block)
 
   // ??? Initialize search-db on copy?
   _searchDb = NULL;
+  _spatial_index = NULL;
+  _wire_shape_cache = NULL;
 
   // ??? callbacks
   // _callbacks = ???
@@ -610,6 +626,21 @@ _dbBlock::_dbBlock(_dbDatabase* db, const _dbBlock& block)
   _extmi           = block._extmi;
   _journal         = NULL;
   _journal_pending = NULL;
+
+  _deferred_wires = NULL;
+  if (dbSection* section = block._deferred_wires.load()) {
+    _deferred_wires = new dbSection(*section);
+    ZALLOCATED(_deferred_wires.load());
+  }
+
+  _deferred_parasitics = NULL;
+  if (dbSection* section = block._deferred_parasitics.load()) {
+    _deferred_parasitics = new dbSection(*section);
+    ZALLOCATED(_deferred_parasitics.load());
+  }
+
+  _concurrent_read_cnt = 0;
+  _callback_batch_cnt  = 0;
 }
 
 _dbBlock::~_dbBlock()
@@ -680,11 +711,16 @@ _dbBlock::~_dbBlock()
   if (_searchDb)
     delete _searchDb;
 #endif
+  delete _spatial_index;
+  delete _wire_shape_cache;
   if (_journal)
     delete _journal;
 
   if (_journal_pending)
     delete _journal_pending;
+
+  delete _deferred_wires.load();
+  delete _deferred_parasitics.load();
 }
 
 void dbBlock::clear()
@@ -703,6 +739,13 @@ void dbBlock::clear()
 
   std::list<dbBlockCallBackObj*> callbacks;
 
+  // the spatial index and the wire shape cache are callbacks, drop them
+  // with the contents
+  delete block->_spatial_index;
+  block->_spatial_index = NULL;
+  delete block->_wire_shape_cache;
+  block->_wire_shape_cache = NULL;
+
   // save callbacks
   callbacks.swap(block->_callbacks);
 
@@ -809,6 +852,7 @@ dbObjectTable* _dbBlock::getObjectTable(dbObjectType type)
       return _blockage_tbl;
 
     case dbWireObj:
+      loadWires();
       return _wire_tbl;
 
     case dbSWireObj:
@@ -818,12 +862,15 @@ dbObjectTable* _dbBlock::getObjectTable(dbObjectType type)
       return _sbox_tbl;
 
     case dbCapNodeObj:
+      loadParasitics();
       return _cap_node_tbl;
 
     case dbRSegObj:
+      loadParasitics();
       return _r_seg_tbl;
 
     case dbCCSegObj:
+      loadParasitics();
       return _cc_seg_tbl;
 
     case dbRowObj:
@@ -856,14 +903,9 @@ dbObjectTable* _dbBlock::getObjectTable(dbObjectType type)
   return getTable()->getObjectTable(type);
 }
 
-dbOStream& operator<<(dbOStream& stream, const _dbBlock& block)
+// The fields of the block ahead of its children and tables.
+static void writeBlockHeader(dbOStream& stream, const _dbBlock& block)
 {
-  std::list<dbBlockCallBackObj*>::const_iterator cbitr;
-  for (cbitr = block._callbacks.begin(); cbitr != block._callbacks.end();
-       ++cbitr)
-    (**cbitr)().inDbBlockStreamOutBefore(
-        (dbBlock*) &block);  // client ECO initialization  - payam
-
   stream << block._def_units;
   stream << block._dbu_per_micron;
   stream << block._hier_delimeter;
@@ -899,6 +941,17 @@ dbOStream& operator<<(dbOStream& stream, const _dbBlock& block)
   stream << block._maxCCSegId;
   stream << block._minExtModelIndex;
   stream << block._maxExtModelIndex;
+}
+
+dbOStream& operator<<(dbOStream& stream, const _dbBlock& block)
+{
+  std::list<dbBlockCallBackObj*>::const_iterator cbitr;
+  for (cbitr = block._callbacks.begin(); cbitr != block._callbacks.end();
+       ++cbitr)
+    (**cbitr)().inDbBlockStreamOutBefore(
+        (dbBlock*) &block);  // client ECO initialization  - payam
+
+  writeBlockHeader(stream, block);
   if (block._flags._skip_hier_stream) {
     block.getImpl()->getLogger()->info(utl::ODB, 4, "Hierarchical block information is lost");
     stream << 0;
@@ -908,7 +961,8 @@ dbOStream& operator<<(dbOStream& stream, const _dbBlock& block)
   stream << block._currentCcAdjOrder;
   stream << *block._bterm_tbl;
   stream << *block._iterm_tbl;
-  stream << *block._net_tbl;
+  if (!stream.isSectioned())
+    stream << *block._net_tbl;
   stream << *block._inst_hdr_tbl;
   stream << *block._inst_tbl;
   stream << *block._module_tbl;
@@ -920,7 +974,8 @@ dbOStream& operator<<(dbOStream& stream, const _dbBlock& block)
   stream << *block._track_grid_tbl;
   stream << *block._obstruction_tbl;
   stream << *block._blockage_tbl;
-  stream << *block._wire_tbl;
+  if (!stream.isSectioned())
+    stream << *block._wire_tbl;
   stream << *block._swire_tbl;
   stream << *block._sbox_tbl;
   stream << *block._row_tbl;
@@ -932,13 +987,15 @@ dbOStream& operator<<(dbOStream& stream, const _dbBlock& block)
   stream << *block._layer_rule_tbl;
   stream << *block._prop_tbl;
   stream << *block._name_cache;
-  stream << *block._r_val_tbl;
-  stream << *block._c_val_tbl;
-  stream << *block._cc_val_tbl;
-  stream << *block._cap_node_tbl;  // DKF - 2/21/05
-  stream << *block._r_seg_tbl;     // DKF - 2/21/05
-  stream << *block._cc_seg_tbl;
-  stream << *block._extControl;
+  if (!stream.isSectioned()) {
+    stream << *block._r_val_tbl;
+    stream << *block._c_val_tbl;
+    stream << *block._cc_val_tbl;
+    stream << *block._cap_node_tbl;  // DKF - 2/21/05
+    stream << *block._r_seg_tbl;     // DKF - 2/21/05
+    stream << *block._cc_seg_tbl;
+    stream << *block._extControl;
+  }
 
   //---------------------------------------------------------- stream out
   // properties
@@ -992,7 +1049,8 @@ dbIStream& operator>>(dbIStream& stream, _dbBlock& block)
   stream >> block._currentCcAdjOrder;
   stream >> *block._bterm_tbl;
   stream >> *block._iterm_tbl;
-  stream >> *block._net_tbl;
+  if (!stream.isSectioned())
+    stream >> *block._net_tbl;
   stream >> *block._inst_hdr_tbl;
   stream >> *block._inst_tbl;
   stream >> *block._module_tbl;
@@ -1004,7 +1062,8 @@ dbIStream& operator>>(dbIStream& stream, _dbBlock& block)
   stream >> *block._track_grid_tbl;
   stream >> *block._obstruction_tbl;
   stream >> *block._blockage_tbl;
-  stream >> *block._wire_tbl;
+  if (!stream.isSectioned())
+    stream >> *block._wire_tbl;
   stream >> *block._swire_tbl;
   stream >> *block._sbox_tbl;
   stream >> *block._row_tbl;
@@ -1016,13 +1075,15 @@ dbIStream& operator>>(dbIStream& stream, _dbBlock& block)
   stream >> *block._layer_rule_tbl;
   stream >> *block._prop_tbl;
   stream >> *block._name_cache;
-  stream >> *block._r_val_tbl;
-  stream >> *block._c_val_tbl;
-  stream >> *block._cc_val_tbl;
-  stream >> *block._cap_node_tbl;  // DKF
-  stream >> *block._r_seg_tbl;     // DKF
-  stream >> *block._cc_seg_tbl;
-  stream >> *block._extControl;
+  if (!stream.isSectioned()) {
+    stream >> *block._r_val_tbl;
+    stream >> *block._c_val_tbl;
+    stream >> *block._cc_val_tbl;
+    stream >> *block._cap_node_tbl;  // DKF
+    stream >> *block._r_seg_tbl;     // DKF
+    stream >> *block._cc_seg_tbl;
+    stream >> *block._extControl;
+  }
 
   //---------------------------------------------------------- stream in
   // properties
@@ -1270,10 +1331,97 @@ bool _dbBlock::operator==(const _dbBlock& rhs) const
   return true;
 }
 
+void _dbBlock::getContentHashes(
+    std::vector<std::pair<const void*, uint64>>& hashes) const
+{
+  typedef std::pair<const void*, std::function<uint64()>> Part;
+  std::vector<Part> parts;
+
+  _dbDatabase* db       = getDatabase();
+  auto         addTable = [&](const auto* table) {
+    parts.push_back(Part(table, [table]() { return table->getContentHash(); }));
+  };
+
+  parts.push_back(Part(nullptr, [this, db]() {
+    return dbContentHash::hash(db, [this](dbOStream& stream) {
+      uint flags;
+      memcpy(&flags, &_flags, sizeof(flags));
+      stream << flags;
+      writeBlockHeader(stream, *this);
+      stream << _children;
+      stream << _currentCcAdjOrder;
+      stream << *_name_cache;
+      stream << *_extControl;
+    });
+  }));
+  parts.push_back(Part(nullptr, [this, db]() {
+    return dbContentHash::hash(db, [this](dbOStream& stream) {
+      stream << *_r_val_tbl;
+      stream << *_c_val_tbl;
+      stream << *_cc_val_tbl;
+    });
+  }));
+  addTable(_bterm_tbl);
+  addTable(_iterm_tbl);
+  addTable(_net_tbl);
+  addTable(_inst_hdr_tbl);
+  addTable(_inst_tbl);
+  addTable(_module_tbl);
+  addTable(_modinst_tbl);
+  addTable(_group_tbl);
+  addTable(_box_tbl);
+  addTable(_via_tbl);
+  addTable(_gcell_grid_tbl);
+  addTable(_track_grid_tbl);
+  addTable(_obstruction_tbl);
+  addTable(_blockage_tbl);
+  addTable(_wire_tbl);
+  addTable(_swire_tbl);
+  addTable(_sbox_tbl);
+  addTable(_row_tbl);
+  addTable(_fill_tbl);
+  addTable(_region_tbl);
+  addTable(_hier_tbl);
+  addTable(_bpin_tbl);
+  addTable(_non_default_rule_tbl);
+  addTable(_layer_rule_tbl);
+  addTable(_prop_tbl);
+  addTable(_cap_node_tbl);
+  addTable(_r_seg_tbl);
+  addTable(_cc_seg_tbl);
+
+  std::vector<uint64> part_hashes(parts.size());
+  runParallel(parts.size(), 0, [&](uint i) {
+    part_hashes[i] = parts[i].second();
+  });
+
+  uint64 block_hash = 0;
+  hashes.clear();
+  for (uint i = 0; i < parts.size(); ++i) {
+    block_hash = dbContentHash::combine(block_hash, part_hashes[i]);
+    if (parts[i].first)
+      hashes.push_back(std::make_pair(parts[i].first, part_hashes[i]));
+  }
+  hashes.push_back(std::make_pair(this, block_hash));
+}
+
 void _dbBlock::differences(dbDiff&         diff,
                            const char*     field,
                            const _dbBlock& rhs) const
 {
+  // Only the tables whose content hashes differ are compared object by
+  // object, and blocks with the same hash have nothing to report.
+  std::vector<std::pair<const void*, uint64>> hashes;
+  getContentHashes(hashes);
+  for (auto& hash : hashes)
+    diff.setContentHash(hash.first, hash.second);
+  rhs.getContentHashes(hashes);
+  for (auto& hash : hashes)
+    diff.setContentHash(hash.first, hash.second);
+
+  if (diff.sameContent(this, &rhs))
+    return;
+
   DIFF_BEGIN
   DIFF_FIELD(_flags._valid_bbox);
   DIFF_FIELD(_def_units);
@@ -1460,9 +1608,109 @@ dbBox* dbBlock::getBBox()
   return (dbBox*) bbox;
 }
 
+void dbBlock::beginConcurrentRead()
+{
+  _dbBlock* block = (_dbBlock*) this;
+
+  // Bring the lazily built state up to date before readers may share it.
+  // Deferred sections are left for the first reader that needs them.
+  if (block->_concurrent_read_cnt == 0) {
+    getBBox();
+    if (block->_spatial_index)
+      block->_spatial_index->update();
+  }
+  block->_concurrent_read_cnt++;
+
+  dbSet<dbBlock>           children = getChildren();
+  dbSet<dbBlock>::iterator itr;
+
+  for (itr = children.begin(); itr != children.end(); ++itr)
+    (*itr)->beginConcurrentRead();
+}
+
+void dbBlock::endConcurrentRead()
+{
+  _dbBlock* block = (_dbBlock*) this;
+  ZASSERT(block->_concurrent_read_cnt > 0);
+  block->_concurrent_read_cnt--;
+
+  dbSet<dbBlock>           children = getChildren();
+  dbSet<dbBlock>::iterator itr;
+
+  for (itr = children.begin(); itr != children.end(); ++itr)
+    (*itr)->endConcurrentRead();
+}
+
+bool dbBlock::inConcurrentRead()
+{
+  _dbBlock* block = (_dbBlock*) this;
+  return block->_concurrent_read_cnt > 0;
+}
+
+void dbBlock::beginCallBackBatch()
+{
+  _dbBlock* block = (_dbBlock*) this;
+  block->_callback_batch_cnt++;
+}
+
+void dbBlock::commitCallBackBatch()
+{
+  _dbBlock* block = (_dbBlock*) this;
+  ZASSERT(block->_callback_batch_cnt > 0);
+
+  if (--block->_callback_batch_cnt > 0)
+    return;
+
+  // An id is listed twice if its instance was destroyed and the id reused.
+  std::vector<dbInst*> moved;
+  moved.reserve(block->_batch_moved_ids.size());
+
+  for (dbInst* inst : block->_batch_moved_insts)
+    if (block->_batch_moved_ids.erase(inst->getId()))
+      moved.push_back(inst);
+
+  block->_batch_moved_insts.clear();
+  block->_batch_moved_ids.clear();
+
+  if (moved.empty())
+    return;
+
+  for (auto callback : block->_callbacks)
+    callback->inDbPostMoveInsts(moved);
+}
+
+bool dbBlock::inCallBackBatch()
+{
+  _dbBlock* block = (_dbBlock*) this;
+  return block->_callback_batch_cnt > 0;
+}
+
+void _dbBlock::preMoveInst(dbInst* inst)
+{
+  if (_callback_batch_cnt > 0) {
+    if (_batch_moved_ids.insert(inst->getId()).second)
+      _batch_moved_insts.push_back(inst);
+    return;
+  }
+
+  for (auto callback : _callbacks)
+    callback->inDbPreMoveInst(inst);
+}
+
+void _dbBlock::postMoveInst(dbInst* inst)
+{
+  if (_callback_batch_cnt > 0)
+    return;
+
+  for (auto callback : _callbacks)
+    callback->inDbPostMoveInst(inst);
+}
+
 void dbBlock::ComputeBBox()
 {
   _dbBlock* block = (_dbBlock*) this;
+  // Concurrent readers find the bbox valid unless the block was modified.
+  ZASSERT(block->_concurrent_read_cnt == 0);
   _dbBox*   bbox  = block->_box_tbl->getPtr(block->_bbox);
   bbox->_shape._rect.reset(INT_MAX, INT_MAX, INT_MIN, INT_MIN);
 
@@ -1516,6 +1764,7 @@ void dbBlock::ComputeBBox()
     bbox->_shape._rect.merge(box->getGeomShape());
   }
 
+  block->loadWires();
   dbSet<dbWire>           wires(block, block->_wire_tbl);
   dbSet<dbWire>::iterator witr;
 
@@ -1646,6 +1895,17 @@ dbInst* dbBlock::findInst(const char* name)
   return (dbInst*) block->_inst_hash.find(name);
 }
 
+void dbBlock::findInsts(const std::vector<std::string>& names,
+                        std::vector<dbInst*>&           insts)
+{
+  _dbBlock*             block = (_dbBlock*) this;
+  std::vector<_dbInst*> found;
+  block->_inst_hash.find(names, found);
+  insts.resize(found.size());
+  for (size_t i = 0; i < found.size(); ++i)
+    insts[i] = (dbInst*) found[i];
+}
+
 dbModule* dbBlock::findModule(const char* name)
 {
   _dbBlock* block = (_dbBlock*) this;
@@ -1718,6 +1978,7 @@ dbSet<dbNet> dbBlock::getNets()
 dbSet<dbCapNode> dbBlock::getCapNodes()
 {
   _dbBlock* block = (_dbBlock*) this;
+  block->loadParasitics();
   return dbSet<dbCapNode>(block, block->_cap_node_tbl);
 }
 
@@ -1727,6 +1988,17 @@ dbNet* dbBlock::findNet(const char* name)
   return (dbNet*) block->_net_hash.find(name);
 }
 
+void dbBlock::findNets(const std::vector<std::string>& names,
+                       std::vector<dbNet*>&            nets)
+{
+  _dbBlock*            block = (_dbBlock*) this;
+  std::vector<_dbNet*> found;
+  block->_net_hash.find(names, found);
+  nets.resize(found.size());
+  for (size_t i = 0; i < found.size(); ++i)
+    nets[i] = (dbNet*) found[i];
+}
+
 bool dbBlock::findSomeMaster(const char* names, std::vector<dbMaster*>& masters)
 {
   if (!names || names[0] == '\0')
@@ -1942,6 +2214,213 @@ void dbBlock::getMasters(std::vector<dbMaster*>& masters)
   }
 }
 
+void dbBlock::getInstPlacement(std::vector<dbInst*>&      insts,
+                               std::vector<int>&          xs,
+                               std::vector<int>&          ys,
+                               std::vector<dbOrientType>& orients,
+                               std::vector<int>&          master_ids)
+{
+  _dbBlock* block = (_dbBlock*) this;
+  uint      n     = block->_inst_tbl->size();
+
+  insts.clear();
+  xs.clear();
+  ys.clear();
+  orients.clear();
+  master_ids.clear();
+  insts.reserve(n);
+  xs.reserve(n);
+  ys.reserve(n);
+  orients.reserve(n);
+  master_ids.reserve(n);
+
+  // Master ids by instance header.
+  std::vector<int> hdr_master_ids(block->_inst_hdr_tbl->_top_idx + 1, -1);
+
+  dbSet<dbInst>           inst_set(block, block->_inst_tbl);
+  dbSet<dbInst>::iterator itr;
+
+  for (itr = inst_set.begin(); itr != inst_set.end(); ++itr) {
+    _dbInst* inst = (_dbInst*) *itr;
+    _dbBox*  bbox = block->_box_tbl->getPtr(inst->_bbox);
+    int&     id   = hdr_master_ids[inst->_inst_hdr];
+
+    if (id < 0)
+      id = (*itr)->getMaster()->getMasterId();
+
+    insts.push_back(*itr);
+    xs.push_back(bbox->_shape._rect.xMin());
+    ys.push_back(bbox->_shape._rect.yMin());
+    orients.push_back(dbOrientType(inst->_flags._orient));
+    master_ids.push_back(id);
+  }
+}
+
+void dbBlock::setInstPlacement(const std::vector<dbInst*>&      insts,
+                               const std::vector<int>&          xs,
+                               const std::vector<int>&          ys,
+                               const std::vector<dbOrientType>& orients)
+{
+  _dbBlock* block = (_dbBlock*) this;
+  ZASSERT((xs.size() == insts.size()) && (ys.size() == insts.size()));
+  ZASSERT(orients.empty() || (orients.size() == insts.size()));
+
+  // Master placement boundaries by instance header.
+  std::vector<Rect> boundaries(block->_inst_hdr_tbl->_top_idx + 1);
+  std::vector<bool> has_boundary(boundaries.size(), false);
+
+  std::vector<dbInst*>             moved;
+  std::vector<Point>               origins;
+  std::vector<dbOrientType::Value> moved_orients;
+
+  for (uint i = 0; i < insts.size(); ++i) {
+    _dbInst*            inst = (_dbInst*) insts[i];
+    uint                hdr  = inst->_inst_hdr;
+    dbOrientType::Value orient
+        = orients.empty() ? inst->_flags._orient : orients[i].getValue();
+
+    if (!has_boundary[hdr]) {
+      insts[i]->getMaster()->getPlacementBoundary(boundaries[hdr]);
+      has_boundary[hdr] = true;
+    }
+
+    Rect bbox = boundaries[hdr];
+    dbTransform(orient).apply(bbox);
+    Point origin(xs[i] - bbox.xMin(), ys[i] - bbox.yMin());
+
+    if ((origin.x() == inst->_x) && (origin.y() == inst->_y)
+        && (orient == inst->_flags._orient))
+      continue;
+
+    moved.push_back(insts[i]);
+    origins.push_back(origin);
+    moved_orients.push_back(orient);
+  }
+
+  if (moved.empty())
+    return;
+
+  if (block->_callback_batch_cnt > 0) {
+    // The commit of the open batch reports the moves.
+    for (dbInst* inst : moved)
+      if (block->_batch_moved_ids.insert(inst->getId()).second)
+        block->_batch_moved_insts.push_back(inst);
+  } else {
+    for (auto callback : block->_callbacks)
+      callback->inDbPreMoveInsts(moved);
+  }
+
+  for (uint i = 0; i < moved.size(); ++i) {
+    _dbInst* inst = (_dbInst*) moved[i];
+    inst->setPlacement(origins[i].x(), origins[i].y(), moved_orients[i]);
+  }
+
+  block->_flags._valid_bbox = 0;
+
+  if (block->_callback_batch_cnt > 0)
+    return;
+
+  for (auto callback : block->_callbacks)
+    callback->inDbPostMoveInsts(moved);
+}
+
+namespace {
+
+// Sums of the pin box coordinates of a master terminal:
+// x = sum(xMin + xMax), y = sum(yMin + yMax), n = 2 * number of boxes.
+struct PinSums
+{
+  int64_t x;
+  int64_t y;
+  int64_t n;
+};
+
+}  // namespace
+
+static PinSums getPinSums(dbMTerm* mterm)
+{
+  PinSums sums = {0, 0, 0};
+
+  dbSet<dbMPin>           mpins = mterm->getMPins();
+  dbSet<dbMPin>::iterator mpin_itr;
+  for (mpin_itr = mpins.begin(); mpin_itr != mpins.end(); mpin_itr++) {
+    dbSet<dbBox>           boxes = (*mpin_itr)->getGeometry();
+    dbSet<dbBox>::iterator box_itr;
+    for (box_itr = boxes.begin(); box_itr != boxes.end(); box_itr++) {
+      Rect rect;
+      (*box_itr)->getBox(rect);
+      sums.x += rect.xMin() + rect.xMax();
+      sums.y += rect.yMin() + rect.yMax();
+      sums.n += 2;
+    }
+  }
+
+  return sums;
+}
+
+void dbBlock::getITermPinCenters(std::vector<dbITerm*>& iterms,
+                                 std::vector<int>&      xs,
+                                 std::vector<int>&      ys)
+{
+  _dbBlock* block = (_dbBlock*) this;
+  uint      n     = block->_iterm_tbl->size();
+
+  iterms.clear();
+  xs.clear();
+  ys.clear();
+  iterms.reserve(n);
+  xs.reserve(n);
+  ys.reserve(n);
+
+  // Pin sums of the master terminals by instance header.
+  std::vector<std::vector<PinSums>> hdr_sums(block->_inst_hdr_tbl->_top_idx
+                                             + 1);
+
+  dbSet<dbInst>           inst_set(block, block->_inst_tbl);
+  dbSet<dbInst>::iterator itr;
+
+  for (itr = inst_set.begin(); itr != inst_set.end(); ++itr) {
+    _dbInst*              inst = (_dbInst*) *itr;
+    std::vector<PinSums>& sums = hdr_sums[inst->_inst_hdr];
+    uint                  cnt  = inst->_iterms.size();
+    _dbBox*               bbox = block->_box_tbl->getPtr(inst->_bbox);
+    const Rect&           rect = bbox->_shape._rect;
+
+    if (sums.size() != cnt) {
+      sums.clear();
+      for (uint i = 0; i < cnt; ++i) {
+        _dbITerm* iterm = block->_iterm_tbl->getPtr(inst->_iterms[i]);
+        sums.push_back(getPinSums(((dbITerm*) iterm)->getMTerm()));
+      }
+    }
+
+    // The pin box sums transform linearly; the images of the unit vectors
+    // give the orientation part of the instance transform.
+    dbTransform transform(inst->_flags._orient);
+    Point       ex(1, 0);
+    Point       ey(0, 1);
+    transform.apply(ex);
+    transform.apply(ey);
+
+    for (uint i = 0; i < cnt; ++i) {
+      const PinSums& s = sums[i];
+      int            x = (rect.xMin() + rect.xMax()) / 2;
+      int            y = (rect.yMin() + rect.yMax()) / 2;
+
+      if (s.n) {
+        int64_t sx = ex.x() * s.x + ey.x() * s.y + s.n * inst->_x;
+        int64_t sy = ex.y() * s.x + ey.y() * s.y + s.n * inst->_y;
+        x          = int((double) sx / s.n);
+        y          = int((double) sy / s.n);
+      }
+
+      iterms.push_back((dbITerm*) block->_iterm_tbl->getPtr(inst->_iterms[i]));
+      xs.push_back(x);
+      ys.push_back(y);
+    }
+  }
+}
+
 void dbBlock::setDieArea(const Rect& r)
 {
   _dbBlock* block  = (_dbBlock*) this;
@@ -1998,12 +2477,14 @@ void* dbBlock::getExtmi()
 dbExtControl* dbBlock::getExtControl()
 {
   _dbBlock* block = (_dbBlock*) this;
+  block->loadParasitics();
   return (block->_extControl);
 }
 
 void dbBlock::getExtCornerNames(std::list<std::string>& ecl)
 {
   _dbBlock* block = (_dbBlock*) this;
+  block->loadParasitics();
   if (block->_corner_name_list)
     ecl.push_back(block->_corner_name_list);
   else
@@ -2013,12 +2494,14 @@ void dbBlock::getExtCornerNames(std::list<std::string>& ecl)
 dbSet<dbCCSeg> dbBlock::getCCSegs()
 {
   _dbBlock* block = (_dbBlock*) this;
+  block->loadParasitics();
   return dbSet<dbCCSeg>(block, block->_cc_seg_tbl);
 }
 
 dbSet<dbRSeg> dbBlock::getRSegs()
 {
   _dbBlock* block = (_dbBlock*) this;
+  block->loadParasitics();
   return dbSet<dbRSeg>(block, block->_r_seg_tbl);
 }
 
@@ -2054,6 +2537,7 @@ void dbBlock::copyExtDb(uint   fr,
                         double gndcFactor)
 {
   _dbBlock* block = (_dbBlock*) this;
+  block->loadParasitics();
   uint      j;
   if (resFactor != 1.0) {
     for (j = 1; j < block->_r_val_tbl->size(); j += extDbCnt)
@@ -2145,6 +2629,7 @@ void dbBlock::undoAdjustedCC(std::vector<dbNet*>& nets,
 void dbBlock::adjustRC(double resFactor, double ccFactor, double gndcFactor)
 {
   _dbBlock* block = (_dbBlock*) this;
+  block->loadParasitics();
   uint      j;
   if (resFactor != 1.0) {
     for (j = 1; j < block->_r_val_tbl->size(); j++)
@@ -2160,12 +2645,69 @@ void dbBlock::adjustRC(double resFactor, double ccFactor, double gndcFactor)
   }
 }
 
+bool _dbBlock::setParasiticValuesCompact(bool compact)
+{
+  if (!_r_val_tbl->setCompact(compact))
+    return false;
+
+  if (!_c_val_tbl->setCompact(compact)) {
+    _r_val_tbl->setCompact(!compact);
+    return false;
+  }
+
+  if (!_cc_val_tbl->setCompact(compact)) {
+    _r_val_tbl->setCompact(!compact);
+    _c_val_tbl->setCompact(!compact);
+    return false;
+  }
+
+  return true;
+}
+
+bool dbBlock::setCompactParasitics(bool compact)
+{
+  _dbBlock* block = (_dbBlock*) this;
+  block->loadParasitics();
+
+  if (!block->setParasiticValuesCompact(compact))
+    return false;
+
+  block->_flags._compact_parasitics = compact ? 1 : 0;
+  return true;
+}
+
+bool dbBlock::flatten(int level, int num_threads)
+{
+  dbFlatten flatten;
+  flatten.setThreads(num_threads);
+  return flatten.flatten(this, level);
+}
+
+uint64 dbBlock::getContentHash()
+{
+  _dbBlock* block = (_dbBlock*) this;
+  block->loadWires();
+  block->loadParasitics();
+
+  std::vector<std::pair<const void*, uint64>> hashes;
+  block->getContentHashes(hashes);
+  return hashes.back().second;
+}
+
+bool dbBlock::hasCompactParasitics()
+{
+  _dbBlock* block = (_dbBlock*) this;
+  return block->_flags._compact_parasitics && block->_r_val_tbl->isCompact()
+         && block->_c_val_tbl->isCompact() && block->_cc_val_tbl->isCompact();
+}
+
 void dbBlock::getExtCount(int& numOfNet,
                           int& numOfRSeg,
                           int& numOfCapNode,
                           int& numOfCCSeg)
 {
   _dbBlock* block = (_dbBlock*) this;
+  block->loadParasitics();
   numOfNet        = block->_net_tbl->size();
   numOfRSeg       = block->_r_seg_tbl->size();
   numOfCapNode    = block->_cap_node_tbl->size();
@@ -2196,12 +2738,14 @@ int dbBlock::getMinExtMOdel()
 int dbBlock::getCornerCount()
 {
   _dbBlock* block = (_dbBlock*) this;
+  block->loadParasitics();
   return block->_num_ext_corners;
 }
 
 int dbBlock::getCornersPerBlock()
 {
   _dbBlock* block = (_dbBlock*) this;
+  block->loadParasitics();
   return block->_corners_per_block;
 }
 
@@ -2220,6 +2764,7 @@ int dbBlock::getExtDbCount()
 void dbBlock::initParasiticsValueTables()
 {
   _dbBlock* block = (_dbBlock*) this;
+  block->loadParasitics();
   if ((block->_r_seg_tbl->size() > 0) || (block->_cap_node_tbl->size() > 0)
       || (block->_cc_seg_tbl->size() > 0)) {
     dbSet<dbNet>           nets = getNets();
@@ -2283,7 +2828,7 @@ void dbBlock::initParasiticsValueTables()
     block->_cc_val_tbl->clear();
   else {
     delete block->_cc_val_tbl;
-    block->_cc_val_tbl = new dbPagedVector<float, 4096, 12>();
+    block->_cc_val_tbl = new dbParasiticValues();
     ZALLOCATED(block->_cc_val_tbl);
   }
   block->_cc_val_tbl->push_back(0.0);
@@ -2292,7 +2837,7 @@ void dbBlock::initParasiticsValueTables()
     block->_r_val_tbl->clear();
   else {
     delete block->_r_val_tbl;
-    block->_r_val_tbl = new dbPagedVector<float, 4096, 12>();
+    block->_r_val_tbl = new dbParasiticValues();
     ZALLOCATED(block->_r_val_tbl);
   }
   block->_r_val_tbl->push_back(0.0);
@@ -2301,10 +2846,11 @@ void dbBlock::initParasiticsValueTables()
     block->_c_val_tbl->clear();
   else {
     delete block->_c_val_tbl;
-    block->_c_val_tbl = new dbPagedVector<float, 4096, 12>();
+    block->_c_val_tbl = new dbParasiticValues();
     ZALLOCATED(block->_c_val_tbl);
   }
   block->_c_val_tbl->push_back(0.0);
+  block->setParasiticValuesCompact(block->_flags._compact_parasitics);
 }
 
 void dbBlock::setCornersPerBlock(int cornersPerBlock)
@@ -2401,12 +2947,14 @@ dbBlock* dbBlock::createExtCornerBlock(uint corner)
 char* dbBlock::getCornerNameList()
 {
   _dbBlock* block = (_dbBlock*) this;
+  block->loadParasitics();
 
   return block->_corner_name_list;
 }
 void dbBlock::setCornerNameList(char* name_list)
 {
   _dbBlock* block = (_dbBlock*) this;
+  block->loadParasitics();
 
   if (block->_corner_name_list != NULL)
     free(block->_corner_name_list);
@@ -2417,6 +2965,7 @@ void dbBlock::getExtCornerName(int corner, char* cName)
 {
   cName[0]        = '\0';
   _dbBlock* block = (_dbBlock*) this;
+  block->loadParasitics();
   if (block->_num_ext_corners == 0)
     return;
   ZASSERT((corner >= 0) && (corner < block->_num_ext_corners));
@@ -2443,6 +2992,7 @@ void dbBlock::getExtCornerName(int corner, char* cName)
 int dbBlock::getExtCornerIndex(const char* cornerName)
 {
   _dbBlock* block = (_dbBlock*) this;
+  block->loadParasitics();
 
   if (block->_corner_name_list == NULL)
     return -1;
@@ -2611,6 +3161,191 @@ dbBlockSearch* dbBlock::getSearchDb()
   return block->_searchDb;
 }
 
+dbSpatialIndex* dbBlock::getSpatialIndex()
+{
+  _dbBlock* block = (_dbBlock*) this;
+  if (block->_spatial_index == NULL) {
+    block->_spatial_index = new dbSpatialIndex(this);
+    ZALLOCATED(block->_spatial_index);
+  }
+  return block->_spatial_index;
+}
+
+dbWireShapeCache* dbBlock::getWireShapeCache()
+{
+  _dbBlock* block = (_dbBlock*) this;
+  if (block->_wire_shape_cache == NULL) {
+    block->_wire_shape_cache = new dbWireShapeCache(this);
+    ZALLOCATED(block->_wire_shape_cache);
+  }
+  return block->_wire_shape_cache;
+}
+
+void dbBlock::destroyWireShapeCache()
+{
+  _dbBlock* block = (_dbBlock*) this;
+  delete block->_wire_shape_cache;
+  block->_wire_shape_cache = NULL;
+}
+
+bool dbBlock::hasDeferredWires()
+{
+  _dbBlock* block = (_dbBlock*) this;
+  return block->_deferred_wires != NULL;
+}
+
+bool dbBlock::hasDeferredParasitics()
+{
+  _dbBlock* block = (_dbBlock*) this;
+  return block->_deferred_parasitics != NULL;
+}
+
+namespace {
+
+template <class T>
+void addTableUsage(std::vector<dbMemoryUsage>& usage, const dbTable<T>* table)
+{
+  dbMemoryUsage entry;
+  entry._name  = dbObject::getObjName(table->_type);
+  entry._count = table->size();
+  table->getMemoryUsage(entry._used, entry._wasted);
+  usage.push_back(entry);
+}
+
+template <class T>
+void addNameUsage(dbMemoryUsage& entry, dbTable<T>* table)
+{
+  for (uint id = table->begin(NULL); id != table->end(NULL);
+       id      = table->next(id)) {
+    const char* name = table->getPtr(id)->_name;
+    if (name) {
+      entry._count++;
+      entry._used += strlen(name) + 1;
+    }
+  }
+}
+
+template <class T>
+void addHashUsage(dbMemoryUsage& entry, const dbHashTable<T>& hash)
+{
+  uint64 used, wasted;
+  hash._hash_tbl.getMemoryUsage(used, wasted);
+  entry._count += hash._num_entries;
+  entry._used += used;
+  entry._wasted += wasted;
+  hash.getIndexMemoryUsage(used, wasted);
+  entry._used += used;
+  entry._wasted += wasted;
+}
+
+void addVectorUsage(std::vector<dbMemoryUsage>& usage,
+                    const char*                 name,
+                    const dbParasiticValues*    vector)
+{
+  dbMemoryUsage entry;
+  entry._name  = name;
+  entry._count = vector->size();
+  vector->getMemoryUsage(entry._used, entry._wasted);
+  usage.push_back(entry);
+}
+
+template <class T>
+void addVectorUsage(dbMemoryUsage& entry, const dbVector<T>& vector)
+{
+  entry._count += vector.size();
+  entry._used += vector.size() * sizeof(T);
+  entry._wasted += (vector.capacity() - vector.size()) * sizeof(T);
+}
+
+}  // namespace
+
+void dbBlock::getMemoryUsage(std::vector<dbMemoryUsage>& usage)
+{
+  _dbBlock* block = (_dbBlock*) this;
+
+  // The tables are read directly, deferred sections stay deferred.
+  addTableUsage(usage, block->_bterm_tbl);
+  addTableUsage(usage, block->_iterm_tbl);
+  addTableUsage(usage, block->_net_tbl);
+  addTableUsage(usage, block->_inst_hdr_tbl);
+  addTableUsage(usage, block->_inst_tbl);
+  addTableUsage(usage, block->_box_tbl);
+  addTableUsage(usage, block->_via_tbl);
+  addTableUsage(usage, block->_gcell_grid_tbl);
+  addTableUsage(usage, block->_track_grid_tbl);
+  addTableUsage(usage, block->_obstruction_tbl);
+  addTableUsage(usage, block->_blockage_tbl);
+  addTableUsage(usage, block->_wire_tbl);
+  addTableUsage(usage, block->_swire_tbl);
+  addTableUsage(usage, block->_sbox_tbl);
+  addTableUsage(usage, block->_row_tbl);
+  addTableUsage(usage, block->_fill_tbl);
+  addTableUsage(usage, block->_region_tbl);
+  addTableUsage(usage, block->_hier_tbl);
+  addTableUsage(usage, block->_bpin_tbl);
+  addTableUsage(usage, block->_non_default_rule_tbl);
+  addTableUsage(usage, block->_layer_rule_tbl);
+  addTableUsage(usage, block->_prop_tbl);
+  addTableUsage(usage, block->_module_tbl);
+  addTableUsage(usage, block->_modinst_tbl);
+  addTableUsage(usage, block->_group_tbl);
+  addTableUsage(usage, block->_cap_node_tbl);
+  addTableUsage(usage, block->_r_seg_tbl);
+  addTableUsage(usage, block->_cc_seg_tbl);
+
+  dbMemoryUsage     opcodes  = {"dbWire opcodes", 0, 0, 0};
+  dbMemoryUsage     data     = {"dbWire data", 0, 0, 0};
+  dbTable<_dbWire>* wire_tbl = block->_wire_tbl;
+  for (uint id = wire_tbl->begin(NULL); id != wire_tbl->end(NULL);
+       id      = wire_tbl->next(id)) {
+    _dbWire* wire = wire_tbl->getPtr(id);
+    addVectorUsage(opcodes, wire->_opcodes);
+    addVectorUsage(data, wire->_data);
+  }
+  usage.push_back(opcodes);
+  usage.push_back(data);
+
+  dbMemoryUsage     iterms   = {"dbInst iterm lists", 0, 0, 0};
+  dbTable<_dbInst>* inst_tbl = block->_inst_tbl;
+  for (uint id = inst_tbl->begin(NULL); id != inst_tbl->end(NULL);
+       id      = inst_tbl->next(id))
+    addVectorUsage(iterms, inst_tbl->getPtr(id)->_iterms);
+  usage.push_back(iterms);
+
+  addVectorUsage(usage, "dbRSeg resistances", block->_r_val_tbl);
+  addVectorUsage(usage, "dbRSeg capacitances", block->_c_val_tbl);
+  addVectorUsage(usage, "dbCCSeg capacitances", block->_cc_val_tbl);
+
+  dbMemoryUsage names = {"names", 0, 0, 0};
+  addNameUsage(names, block->_net_tbl);
+  addNameUsage(names, block->_inst_tbl);
+  addNameUsage(names, block->_bterm_tbl);
+  addNameUsage(names, block->_module_tbl);
+  addNameUsage(names, block->_modinst_tbl);
+  addNameUsage(names, block->_group_tbl);
+  usage.push_back(names);
+
+  dbMemoryUsage hashes = {"name hash tables", 0, 0, 0};
+  addHashUsage(hashes, block->_net_hash);
+  addHashUsage(hashes, block->_inst_hash);
+  addHashUsage(hashes, block->_bterm_hash);
+  addHashUsage(hashes, block->_module_hash);
+  addHashUsage(hashes, block->_modinst_hash);
+  addHashUsage(hashes, block->_group_hash);
+  usage.push_back(hashes);
+
+  dbMemoryUsage deferred = {"deferred sections", 0, 0, 0};
+  for (dbSection* section :
+       {block->_deferred_wires.load(), block->_deferred_parasitics.load()}) {
+    if (section) {
+      deferred._count++;
+      deferred._used += section->_data.size();
+      deferred._wasted += section->_data.capacity() - section->_data.size();
+    }
+  }
+  usage.push_back(deferred);
+}
+
 #ifdef ZUI
 ZPtr<ISdb> dbBlock::getSignalNetSdb(ZContext& context, dbTech* tech)
 {
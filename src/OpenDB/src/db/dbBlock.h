@@ -32,12 +32,17 @@
 
 #pragma once
 
+#include <atomic>
 #include <list>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "dbCore.h"
 #include "dbHashTable.h"
 #include "dbIntHashTable.h"
 #include "dbPagedVector.h"
+#include "dbParasiticValues.h"
 #include "dbTransform.h"
 #include "dbTypes.h"
 #include "dbVector.h"
@@ -117,7 +122,10 @@ class dbIStream;
 class dbOStream;
 class dbDiff;
 class dbBlockSearch;
+class dbSpatialIndex;
+class dbWireShapeCache;
 class dbBlockCallBackObj;
+struct dbSection;
 
 struct _dbBTermPin
 {
@@ -136,7 +144,8 @@ struct _dbBlockFlags
   uint _active_pins : 1;
   uint _mme : 1;
   uint _skip_hier_stream : 1;
-  uint _spare_bits_27 : 27;
+  uint _compact_parasitics : 1;
+  uint _spare_bits_26 : 26;
 };
 
 class _dbBlock : public _dbObject
@@ -212,9 +221,9 @@ class _dbBlock : public _dbObject
   dbTable<_dbGroup>*              _group_tbl;
   _dbNameCache*                   _name_cache;
 
-  dbPagedVector<float, 4096, 12>* _r_val_tbl;
-  dbPagedVector<float, 4096, 12>* _c_val_tbl;
-  dbPagedVector<float, 4096, 12>* _cc_val_tbl;
+  dbParasiticValues*              _r_val_tbl;
+  dbParasiticValues*              _c_val_tbl;
+  dbParasiticValues*              _cc_val_tbl;
   dbTable<_dbCapNode>*            _cap_node_tbl;
   dbTable<_dbRSeg>*               _r_seg_tbl;
   dbTable<_dbCCSeg>*              _cc_seg_tbl;
@@ -242,6 +251,8 @@ class _dbBlock : public _dbObject
   dbRegionItr*        _region_itr;
   dbPropertyItr*      _prop_itr;
   dbBlockSearch*      _searchDb;
+  dbSpatialIndex*     _spatial_index;
+  dbWireShapeCache*   _wire_shape_cache;
 
   float         _WNS[2];
   float         _TNS[2];
@@ -254,6 +265,21 @@ class _dbBlock : public _dbObject
   dbJournal* _journal;
   dbJournal* _journal_pending;
 
+  // Compressed sections left undecoded by dbDatabase::read (see
+  // dbDatabase::LoadProfile), decoded on first access. Concurrent readers
+  // may make that access together, see loadDeferredSection.
+  std::atomic<dbSection*> _deferred_wires;
+  std::atomic<dbSection*> _deferred_parasitics;
+
+  // Nesting depth of dbBlock::beginConcurrentRead.
+  uint _concurrent_read_cnt;
+
+  // Nesting depth of dbBlock::beginCallBackBatch, and the instances moved
+  // in the open batch (ids of destroyed instances are dropped from the set).
+  uint                     _callback_batch_cnt;
+  std::vector<dbInst*>     _batch_moved_insts;
+  std::unordered_set<uint> _batch_moved_ids;
+
   // This is a temporary vector to fix bterm pins pre dbBPin...
   std::vector<_dbBTermPin>* _bterm_pins;
 
@@ -272,9 +298,38 @@ class _dbBlock : public _dbObject
   bool operator==(const _dbBlock& rhs) const;
   bool operator!=(const _dbBlock& rhs) const { return !operator==(rhs); }
   void differences(dbDiff& diff, const char* field, const _dbBlock& rhs) const;
+
+  // Content hashes of the tables of the block, and last that of the block
+  // itself, which folds in the hashes of its tables. Tables are hashed on
+  // worker threads.
+  void getContentHashes(
+      std::vector<std::pair<const void*, uint64>>& hashes) const;
   void out(dbDiff& diff, char side, const char* field) const;
 
   dbObjectTable* getObjectTable(dbObjectType type);
+
+  void loadWires()
+  {
+    if (_deferred_wires.load(std::memory_order_acquire))
+      loadDeferredSection(_deferred_wires);
+  }
+
+  void loadParasitics()
+  {
+    if (_deferred_parasitics.load(std::memory_order_acquire))
+      loadDeferredSection(_deferred_parasitics);
+  }
+
+  void loadDeferredSection(std::atomic<dbSection*>& section);
+
+  // Store the parasitic values as 16 or 32 bit floats. Returns false,
+  // leaving the values unchanged, if a value does not fit in 16 bits.
+  bool setParasiticValuesCompact(bool compact);
+
+  // Callbacks around a move of inst. Inside a callback batch the instance
+  // is only recorded, dbBlock::commitCallBackBatch reports the moves.
+  void preMoveInst(dbInst* inst);
+  void postMoveInst(dbInst* inst);
 };
 
 dbOStream& operator<<(dbOStream& stream, const _dbBlock& block);
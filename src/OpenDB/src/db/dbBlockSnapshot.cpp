@@ -0,0 +1,287 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2019, Nefelus Inc
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "dbBlockSnapshot.h"
+
+#include "ZException.h"
+#include "db.h"
+#include "dbBlockCallBackObj.h"
+#include "dbBPin.h"
+#include "dbBTerm.h"
+#include "dbBlock.h"
+#include "dbBlockage.h"
+#include "dbBox.h"
+#include "dbCCSeg.h"
+#include "dbCapNode.h"
+#include "dbFill.h"
+#include "dbGCellGrid.h"
+#include "dbGroup.h"
+#include "dbHashTable.hpp"
+#include "dbHier.h"
+#include "dbITerm.h"
+#include "dbInst.h"
+#include "dbInstHdr.h"
+#include "dbIntHashTable.hpp"
+#include "dbModInst.h"
+#include "dbModule.h"
+#include "dbName.h"
+#include "dbNameCache.h"
+#include "dbNet.h"
+#include "dbObstruction.h"
+#include "dbParallel.h"
+#include "dbProperty.h"
+#include "dbRSeg.h"
+#include "dbRegion.h"
+#include "dbRow.h"
+#include "dbSBox.h"
+#include "dbSWire.h"
+#include "dbSpatialIndex.h"
+#include "dbTable.hpp"
+#include "dbTableSnapshot.h"
+#include "dbTechLayerRule.h"
+#include "dbTechNonDefaultRule.h"
+#include "dbTrackGrid.h"
+#include "dbVia.h"
+#include "dbWire.h"
+#include "dbWireShapeCache.h"
+
+namespace odb {
+
+// The members of _dbBlock outside of its tables.
+struct dbBlockSnapshotState
+{
+  _dbBlockFlags                  _flags;
+  int                            _def_units;
+  int                            _dbu_per_micron;
+  unsigned char                  _num_ext_corners;
+  uint                           _corners_per_block;
+  Rect                           _die_area;
+  dbId<_dbGCellGrid>             _gcell_grid;
+  dbId<_dbModule>                _top_module;
+  uint                           _maxCapNodeId;
+  uint                           _maxRSegId;
+  uint                           _maxCCSegId;
+  int                            _minExtModelIndex;
+  int                            _maxExtModelIndex;
+  uint                           _currentCcAdjOrder;
+  dbHashTable<_dbNet>            _net_hash;
+  dbHashTable<_dbInst>           _inst_hash;
+  dbHashTable<_dbModule>         _module_hash;
+  dbHashTable<_dbModInst>        _modinst_hash;
+  dbHashTable<_dbGroup>          _group_hash;
+  dbIntHashTable<_dbInstHdr>     _inst_hdr_hash;
+  dbHashTable<_dbBTerm>          _bterm_hash;
+  dbHashTable<_dbName>           _name_hash;
+  dbParasiticValues              _r_val_tbl;
+  dbParasiticValues              _c_val_tbl;
+  dbParasiticValues              _cc_val_tbl;
+
+  dbBlockSnapshotState(const _dbBlock* block)
+      : _flags(block->_flags),
+        _def_units(block->_def_units),
+        _dbu_per_micron(block->_dbu_per_micron),
+        _num_ext_corners(block->_num_ext_corners),
+        _corners_per_block(block->_corners_per_block),
+        _die_area(block->_die_area),
+        _gcell_grid(block->_gcell_grid),
+        _top_module(block->_top_module),
+        _maxCapNodeId(block->_maxCapNodeId),
+        _maxRSegId(block->_maxRSegId),
+        _maxCCSegId(block->_maxCCSegId),
+        _minExtModelIndex(block->_minExtModelIndex),
+        _maxExtModelIndex(block->_maxExtModelIndex),
+        _currentCcAdjOrder(block->_currentCcAdjOrder),
+        _net_hash(block->_net_hash),
+        _inst_hash(block->_inst_hash),
+        _module_hash(block->_module_hash),
+        _modinst_hash(block->_modinst_hash),
+        _group_hash(block->_group_hash),
+        _inst_hdr_hash(block->_inst_hdr_hash),
+        _bterm_hash(block->_bterm_hash),
+        _name_hash(block->_name_cache->_name_hash),
+        _r_val_tbl(*block->_r_val_tbl),
+        _c_val_tbl(*block->_c_val_tbl),
+        _cc_val_tbl(*block->_cc_val_tbl)
+  {
+  }
+
+  void restore(_dbBlock* block) const
+  {
+    block->_flags             = _flags;
+    block->_def_units         = _def_units;
+    block->_dbu_per_micron    = _dbu_per_micron;
+    block->_num_ext_corners   = _num_ext_corners;
+    block->_corners_per_block = _corners_per_block;
+    block->_die_area          = _die_area;
+    block->_gcell_grid        = _gcell_grid;
+    block->_top_module        = _top_module;
+    block->_maxCapNodeId      = _maxCapNodeId;
+    block->_maxRSegId         = _maxRSegId;
+    block->_maxCCSegId        = _maxCCSegId;
+    block->_minExtModelIndex  = _minExtModelIndex;
+    block->_maxExtModelIndex  = _maxExtModelIndex;
+    block->_currentCcAdjOrder = _currentCcAdjOrder;
+    restore(block->_net_hash, _net_hash);
+    restore(block->_inst_hash, _inst_hash);
+    restore(block->_module_hash, _module_hash);
+    restore(block->_modinst_hash, _modinst_hash);
+    restore(block->_group_hash, _group_hash);
+    restore(block->_inst_hdr_hash, _inst_hdr_hash);
+    restore(block->_bterm_hash, _bterm_hash);
+    restore(block->_name_cache->_name_hash, _name_hash);
+    restore(*block->_r_val_tbl, _r_val_tbl);
+    restore(*block->_c_val_tbl, _c_val_tbl);
+    restore(*block->_cc_val_tbl, _cc_val_tbl);
+  }
+
+  template <class T>
+  static void restore(T& dst, const T& src)
+  {
+    if (dst != src)
+      dst = src;
+  }
+
+  // The name index of an unchanged hash table may still hold the ids of
+  // objects created and destroyed since the snapshot, so it is dropped.
+  template <class T>
+  static void restore(dbHashTable<T>& dst, const dbHashTable<T>& src)
+  {
+    if (dst != src)
+      dst = src;
+    else
+      dst.clearIndex();
+  }
+};
+
+// deep: the objects of the table own heap memory, see dbTableSnapshot.
+template <class T>
+static void addTable(std::vector<std::unique_ptr<dbTableSnapshotBase>>& tables,
+                     dbTable<T>*                                       table,
+                     bool                                              deep)
+{
+  tables.emplace_back(new dbTableSnapshot<T>(table, deep));
+}
+
+dbBlockSnapshot::dbBlockSnapshot(dbBlock* block) : block_(block)
+{
+  _dbBlock* b = (_dbBlock*) block;
+  ZASSERT(b->_concurrent_read_cnt == 0);
+
+  // A deferred section is decoded into the tables when first accessed,
+  // which must not happen after the snapshot.
+  b->loadWires();
+  b->loadParasitics();
+
+  addTable(tables_, b->_bterm_tbl, true);
+  addTable(tables_, b->_iterm_tbl, false);
+  addTable(tables_, b->_net_tbl, true);
+  addTable(tables_, b->_inst_hdr_tbl, true);
+  addTable(tables_, b->_inst_tbl, true);
+  addTable(tables_, b->_box_tbl, false);
+  addTable(tables_, b->_via_tbl, true);
+  addTable(tables_, b->_gcell_grid_tbl, true);
+  addTable(tables_, b->_track_grid_tbl, true);
+  addTable(tables_, b->_obstruction_tbl, false);
+  addTable(tables_, b->_blockage_tbl, false);
+  addTable(tables_, b->_wire_tbl, true);
+  addTable(tables_, b->_swire_tbl, false);
+  addTable(tables_, b->_sbox_tbl, false);
+  addTable(tables_, b->_row_tbl, true);
+  addTable(tables_, b->_fill_tbl, false);
+  addTable(tables_, b->_region_tbl, true);
+  addTable(tables_, b->_hier_tbl, true);
+  addTable(tables_, b->_bpin_tbl, false);
+  addTable(tables_, b->_non_default_rule_tbl, true);
+  addTable(tables_, b->_layer_rule_tbl, false);
+  addTable(tables_, b->_prop_tbl, true);
+  addTable(tables_, b->_module_tbl, true);
+  addTable(tables_, b->_modinst_tbl, true);
+  addTable(tables_, b->_group_tbl, true);
+  addTable(tables_, b->_cap_node_tbl, false);
+  addTable(tables_, b->_r_seg_tbl, false);
+  addTable(tables_, b->_cc_seg_tbl, false);
+  addTable(tables_, b->_name_cache->_name_tbl, true);
+
+  state_.reset(new dbBlockSnapshotState(b));
+
+  for (dbBlock* child : block->getChildren())
+    children_.emplace_back(new dbBlockSnapshot(child));
+}
+
+dbBlockSnapshot::~dbBlockSnapshot()
+{
+}
+
+uint dbBlockSnapshot::rollback()
+{
+  _dbBlock* block = (_dbBlock*) block_;
+  ZASSERT(block->_concurrent_read_cnt == 0);
+
+  // Only the pages found here are touched by the rollback.
+  runParallel(tables_.size(), 0, [&](uint i) { tables_[i]->findChanges(); });
+
+  uint pages = 0;
+  for (auto& table : tables_)
+    pages += table->rollback();
+
+  state_->restore(block);
+
+  // Child blocks created since the snapshot.
+  std::vector<dbBlock*> created;
+  for (dbBlock* child : block_->getChildren()) {
+    bool found = false;
+    for (auto& snapshot : children_)
+      found |= snapshot->getBlock() == child;
+    if (!found)
+      created.push_back(child);
+  }
+  for (dbBlock* child : created)
+    dbBlock::destroy(child);
+
+  for (auto& child : children_)
+    pages += child->rollback();
+
+  delete block->_spatial_index;
+  block->_spatial_index = NULL;
+
+  if (block->_wire_shape_cache)
+    block->_wire_shape_cache->clear();
+
+  std::list<dbBlockCallBackObj*>::const_iterator cbitr;
+  for (cbitr = block->_callbacks.begin(); cbitr != block->_callbacks.end();
+       ++cbitr)
+    (**cbitr)().inDbBlockRollback(block_);
+
+  return pages;
+}
+
+}  // namespace odb
@@ -111,7 +111,7 @@ void dbCCSeg::adjustCapacitance(float factor, int corner)
   _dbCCSeg* seg   = (_dbCCSeg*) this;
   _dbBlock* block = (_dbBlock*) seg->getOwner();
 
-  float& value
+  dbParasiticValues::reference value
       = (*block->_cc_val_tbl)[(seg->getOID() - 1) * block->_corners_per_block
                               + 1 + corner];
   float prev_value = value;
@@ -208,7 +208,7 @@ void dbCCSeg::setCapacitance(double cap, int corner)
   uint      cornerCnt = block->_corners_per_block;
   ZASSERT((corner >= 0) && ((uint) corner < cornerCnt));
 
-  float& value
+  dbParasiticValues::reference value
       = (*block->_cc_val_tbl)[(seg->getOID() - 1) * cornerCnt + 1 + corner];
   float prev_value = value;
   value            = (float) cap;
@@ -217,7 +217,7 @@ void dbCCSeg::setCapacitance(double cap, int corner)
     debugPrint(getImpl()->getLogger(), utl::ODB, "DB_ECO", 1,
           "ECO: dbCCSeg {}, setCapacitance {}, corner {}",
           seg->getId(),
-          value,
+          (float) value,
           corner);
     block->_journal->beginAction(dbJournal::UPDATE_FIELD);
     block->_journal->pushParam(dbCCSegObj);
@@ -237,7 +237,7 @@ void dbCCSeg::addCapacitance(double cap, int corner)
   uint      cornerCnt = block->_corners_per_block;
   ZASSERT((corner >= 0) && ((uint) corner < cornerCnt));
 
-  float& value
+  dbParasiticValues::reference value
       = (*block->_cc_val_tbl)[(seg->getOID() - 1) * cornerCnt + 1 + corner];
   float prev_value = value;
   value += (float) cap;
@@ -246,7 +246,7 @@ void dbCCSeg::addCapacitance(double cap, int corner)
     debugPrint(getImpl()->getLogger(), utl::ODB, "DB_ECO", 1,
           "ECO: dbCCSeg {}, addCapacitance {}, corner {}",
           seg->getId(),
-          value,
+          (float) value,
           corner);
     block->_journal->beginAction(dbJournal::UPDATE_FIELD);
     block->_journal->pushParam(dbCCSegObj);
@@ -267,9 +267,9 @@ void dbCCSeg::addCcCapacitance(dbCCSeg* other)
   uint      cornerCnt = block->_corners_per_block;
 
   for (uint ii = 0; ii < cornerCnt; ii++) {
-    float& value
+    dbParasiticValues::reference value
         = (*block->_cc_val_tbl)[(seg->getOID() - 1) * cornerCnt + 1 + ii];
-    float& ovalue
+    dbParasiticValues::reference ovalue
         = (*block->_cc_val_tbl)[(oseg->getOID() - 1) * cornerCnt + 1 + ii];
     value += ovalue;
   }
@@ -749,6 +749,7 @@ dbCapNode* dbCCSeg::getTheOtherCapn(dbCapNode* oneCap, uint& cid)
 dbCCSeg* dbCCSeg::getCCSeg(dbBlock* block_, uint dbid_)
 {
   _dbBlock* block = (_dbBlock*) block_;
+  block->loadParasitics();
   return (dbCCSeg*) block->_cc_seg_tbl->getPtr(dbid_);
 }
 
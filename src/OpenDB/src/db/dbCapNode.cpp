@@ -232,7 +232,7 @@ void dbCapNode::adjustCapacitance(float factor, uint corner)
 
   ZASSERT(seg->_flags._foreign > 0);
   ZASSERT(corner < cornerCnt);
-  float& value
+  dbParasiticValues::reference value
       = (*block->_c_val_tbl)[(seg->getOID() - 1) * cornerCnt + 1 + corner];
   float prev_value = value;
   value *= factor;
@@ -361,9 +361,9 @@ void dbCapNode::addCapnCapacitance(dbCapNode* other)
   _dbBlock*   block     = (_dbBlock*) seg->getOwner();
   uint        cornerCnt = block->_corners_per_block;
   for (uint corner = 0; corner < cornerCnt; corner++) {
-    float& value
+    dbParasiticValues::reference value
         = (*block->_c_val_tbl)[(seg->getOID() - 1) * cornerCnt + 1 + corner];
-    float& ovalue
+    dbParasiticValues::reference ovalue
         = (*block->_c_val_tbl)[(oseg->getOID() - 1) * cornerCnt + 1 + corner];
     value += ovalue;
   }
@@ -388,7 +388,7 @@ void dbCapNode::setCapacitance(double cap, int corner)
   _dbBlock*   block     = (_dbBlock*) seg->getOwner();
   uint        cornerCnt = block->_corners_per_block;
   ZASSERT((corner >= 0) && ((uint) corner < cornerCnt));
-  float& value
+  dbParasiticValues::reference value
       = (*block->_c_val_tbl)[(seg->getOID() - 1) * cornerCnt + 1 + corner];
   float prev_value = value;
   value            = (float) cap;
@@ -417,7 +417,7 @@ void dbCapNode::addCapacitance(double cap, int corner)
   _dbBlock*   block     = (_dbBlock*) seg->getOwner();
   uint        cornerCnt = block->_corners_per_block;
   ZASSERT((corner >= 0) && ((uint) corner < cornerCnt));
-  float& value
+  dbParasiticValues::reference value
       = (*block->_c_val_tbl)[(seg->getOID() - 1) * cornerCnt + 1 + corner];
   float prev_value = value;
   value += (float) cap;
@@ -879,8 +879,9 @@ dbCapNode::getNext(dbBlock *block_)
 
 dbCapNode* dbCapNode::create(dbNet* net_, uint node, bool foreign)
 {
-  _dbNet*     net       = (_dbNet*) net_;
-  _dbBlock*   block     = (_dbBlock*) net->getOwner();
+  _dbNet*   net   = (_dbNet*) net_;
+  _dbBlock* block = (_dbBlock*) net->getOwner();
+  block->loadParasitics();
   uint        cornerCnt = block->_corners_per_block;
   _dbCapNode* seg       = block->_cap_node_tbl->create();
 
@@ -1015,6 +1016,7 @@ bool dbCapNode::checkCC()
 dbCapNode* dbCapNode::getCapNode(dbBlock* block_, uint dbid_)
 {
   _dbBlock* block = (_dbBlock*) block_;
+  block->loadParasitics();
   return (dbCapNode*) block->_cap_node_tbl->getPtr(dbid_);
 }
 }  // namespace odb
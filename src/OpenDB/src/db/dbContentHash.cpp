@@ -0,0 +1,77 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2019, Nefelus Inc
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "dbContentHash.h"
+
+#include "ZException.h"
+
+namespace odb {
+
+static const uint64 fnv_offset_basis = 0xcbf29ce484222325ULL;
+static const uint64 fnv_prime        = 0x100000001b3ULL;
+
+dbContentHash::dbContentHash() : _hash(fnv_offset_basis)
+{
+  cookie_io_functions_t io = {NULL, write, NULL, NULL};
+  _file                    = fopencookie(this, "w", io);
+  ZALLOCATED(_file);
+}
+
+dbContentHash::~dbContentHash()
+{
+  fclose(_file);
+}
+
+uint64 dbContentHash::take(dbOStream& stream)
+{
+  stream.flush();
+  fflush(_file);
+  uint64 hash = _hash;
+  _hash       = fnv_offset_basis;
+  return hash;
+}
+
+ssize_t dbContentHash::write(void* cookie, const char* data, size_t size)
+{
+  dbContentHash* content = (dbContentHash*) cookie;
+  uint64         hash    = content->_hash;
+
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= (unsigned char) data[i];
+    hash *= fnv_prime;
+  }
+
+  content->_hash = hash;
+  return size;
+}
+
+}  // namespace odb
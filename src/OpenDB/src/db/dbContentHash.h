@@ -0,0 +1,85 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2019, Nefelus Inc
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <stdio.h>
+
+#include "dbStream.h"
+#include "odb.h"
+
+namespace odb {
+
+class _dbDatabase;
+
+//
+// dbContentHash - A 64 bit FNV-1a hash of the bytes written to a dbOStream.
+// Two objects that stream the same bytes have the same content hash, so
+// comparing the hashes of two tables stands in for comparing their objects.
+//
+class dbContentHash
+{
+ public:
+  dbContentHash();
+  ~dbContentHash();
+
+  // The file to build the dbOStream on.
+  FILE* getFile() const { return _file; }
+
+  // The hash of the bytes written to stream since the last call.
+  uint64 take(dbOStream& stream);
+
+  // Fold the hash of a part into the hash of the whole.
+  static uint64 combine(uint64 seed, uint64 value)
+  {
+    return seed
+           ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+  }
+
+  // The hash of what write(stream) writes.
+  template <typename Fn>
+  static uint64 hash(_dbDatabase* db, Fn write)
+  {
+    dbContentHash hash;
+    dbOStream     stream(db, hash.getFile());
+    write(stream);
+    return hash.take(stream);
+  }
+
+ private:
+  static ssize_t write(void* cookie, const char* data, size_t size);
+
+  FILE*  _file;
+  uint64 _hash;
+};
+
+}  // namespace odb
@@ -83,6 +83,8 @@ class _dbObject : public dbObject
   friend class dbTable;
   template <class T>
   friend class dbArrayTable;
+  template <class T>
+  friend class dbTableSnapshot;
 };
 
 ///////////////////////////////////////////////////////////////
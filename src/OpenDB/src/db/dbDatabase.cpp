@@ -32,9 +32,15 @@
 
 #include "dbDatabase.h"
 
+#include <zlib.h>
+
 #include <algorithm>
+#include <atomic>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include "db.h"
 #include "dbArrayTable.h"
@@ -48,8 +54,10 @@
 #include "dbITerm.h"
 #include "dbJournal.h"
 #include "dbLib.h"
+#include "dbMaster.h"
 #include "dbNameCache.h"
 #include "dbNet.h"
+#include "dbParallel.h"
 #include "dbProperty.h"
 #include "dbPropertyItr.h"
 #include "dbRSeg.h"
@@ -58,6 +66,7 @@
 #include "dbTable.hpp"
 #include "dbTech.h"
 #include "dbWire.h"
+#include "dbWireShapeCache.h"
 #include "utility/Logger.h"
 
 namespace odb {
@@ -68,6 +77,12 @@ namespace odb {
 #define ADS_DB_MAGIC1 0x41544845  // ATHE
 #define ADS_DB_MAGIC2 0x4E414442  // NADB
 
+//
+// Compressed databases use ATHENADZ. The header is followed by a table of
+// contents and the independently compressed sections.
+//
+#define ADS_DB_COMPRESSED_MAGIC2 0x4E41445A  // NADZ
+
 template class dbTable<_dbDatabase>;
 
 static dbTable<_dbDatabase>* db_tbl       = NULL;
@@ -301,8 +316,10 @@ dbOStream& operator<<(dbOStream& stream, const _dbDatabase& db)
   stream << db._master_id;
   stream << db._chip;
   stream << db._tech;
-  stream << *db._tech_tbl;
-  stream << *db._lib_tbl;
+  if (!stream.isSectioned()) {
+    stream << *db._tech_tbl;
+    stream << *db._lib_tbl;
+  }
   stream << *db._chip_tbl;
   stream << *db._prop_tbl;
   stream << *db._name_cache;
@@ -331,13 +348,20 @@ dbIStream& operator>>(dbIStream& stream, _dbDatabase& db)
   if (db._schema_minor < db_schema_initial)
     throw ZException("incompatible database schema revision");
 
+  if (db._schema_minor > db_schema_minor)
+    throw ZException("database schema revision %u is newer than %u",
+                     db._schema_minor,
+                     db_schema_minor);
+
   stream >> db._master_id;
 
 
   stream >> db._chip;
   stream >> db._tech;
-  stream >> *db._tech_tbl;
-  stream >> *db._lib_tbl;
+  if (!stream.isSectioned()) {
+    stream >> *db._tech_tbl;
+    stream >> *db._lib_tbl;
+  }
   stream >> *db._chip_tbl;
   stream >> *db._prop_tbl;
   stream >> *db._name_cache;
@@ -430,10 +454,378 @@ dbTech* dbDatabase::getTech()
   return (dbTech*) db->_tech_tbl->getPtr(db->_tech);
 }
 
-void dbDatabase::read(FILE* file)
+static void readBlockParasitics(dbIStream& stream, _dbBlock* block)
+{
+  stream >> block->_num_ext_corners;
+  stream >> block->_corner_name_list;
+  stream >> *block->_r_val_tbl;
+  stream >> *block->_c_val_tbl;
+  stream >> *block->_cc_val_tbl;
+  stream >> *block->_cap_node_tbl;
+  stream >> *block->_r_seg_tbl;
+  stream >> *block->_cc_seg_tbl;
+  stream >> *block->_extControl;
+
+  block->_corners_per_block = block->_num_ext_corners;
+}
+
+static void writeBlockParasitics(dbOStream& stream, const _dbBlock* block)
+{
+  stream << block->_num_ext_corners;
+  stream << block->_corner_name_list;
+  stream << *block->_r_val_tbl;
+  stream << *block->_c_val_tbl;
+  stream << *block->_cc_val_tbl;
+  stream << *block->_cap_node_tbl;
+  stream << *block->_r_seg_tbl;
+  stream << *block->_cc_seg_tbl;
+  stream << *block->_extControl;
+}
+
+////////////////////////////////////////////////////////////////////
+//
+// Compressed database sections
+//
+////////////////////////////////////////////////////////////////////
+
+namespace {
+
+enum dbSectionType
+{
+  TECH_SECTION,
+  LIBS_SECTION,
+  CORE_SECTION,
+  NETS_SECTION,
+  WIRES_SECTION,
+  PARASITICS_SECTION
+};
+
+}  // namespace
+
+static _dbBlock* getSectionBlock(_dbDatabase* db, const dbSection& section)
+{
+  _dbChip* chip = (_dbChip*) ((dbDatabase*) db)->getChip();
+
+  if ((chip == NULL) || !chip->_block_tbl->validId(section._block))
+    throw ZException("database section refers to an unknown block");
+
+  return chip->_block_tbl->getPtr(section._block);
+}
+
+static dbSection* getDeferredSection(_dbBlock* block, uint type)
+{
+  switch (type) {
+    case WIRES_SECTION:
+      return block->_deferred_wires;
+    case PARASITICS_SECTION:
+      return block->_deferred_parasitics;
+  }
+
+  return NULL;
+}
+
+static void writeSection(_dbDatabase* db, dbSection& section)
+{
+  if ((section._type == WIRES_SECTION)
+      || (section._type == PARASITICS_SECTION)) {
+    // A section that was never decoded is written as it was read.
+    dbSection* deferred
+        = getDeferredSection(getSectionBlock(db, section), section._type);
+
+    if (deferred) {
+      section._size = deferred->_size;
+      section._data = deferred->_data;
+      return;
+    }
+  }
+
+  char*  buffer = NULL;
+  size_t size   = 0;
+  FILE*  file   = open_memstream(&buffer, &size);
+
+  if (file == NULL)
+    throw ZIOError(errno, "cannot create database section buffer: ");
+
+  {
+    dbOStream stream(db, file);
+    stream.setSectioned(true);
+
+    switch (section._type) {
+      case TECH_SECTION:
+        stream << *db->_tech_tbl;
+        break;
+      case LIBS_SECTION:
+        stream << *db->_lib_tbl;
+        break;
+      case CORE_SECTION:
+        stream << *db;
+        break;
+      case NETS_SECTION:
+        stream << *getSectionBlock(db, section)->_net_tbl;
+        break;
+      case WIRES_SECTION:
+        stream << *getSectionBlock(db, section)->_wire_tbl;
+        break;
+      case PARASITICS_SECTION:
+        writeBlockParasitics(stream, getSectionBlock(db, section));
+        break;
+    }
+
+    stream.flush();
+  }
+
+  fclose(file);
+
+  uLongf zsize = compressBound(size);
+  section._size = size;
+  section._data.resize(zsize);
+  int status    = compress2((Bytef*) section._data.data(),
+                         &zsize,
+                         (const Bytef*) buffer,
+                         size,
+                         Z_BEST_SPEED);
+  free(buffer);
+
+  if (status != Z_OK)
+    throw ZException("compression of database section failed");
+
+  section._data.resize(zsize);
+}
+
+static void readSection(_dbDatabase*             db,
+                        const dbSection&         section,
+                        const std::vector<char>& data)
+{
+  dbIStream stream(db, data.data(), data.size());
+  stream.setSectioned(true);
+
+  // The section is decoded at the revision of the file it came from; the
+  // database is at the current revision once it is read.
+  db->_schema_minor = section._schema_minor;
+
+  switch (section._type) {
+    case TECH_SECTION:
+      stream >> *db->_tech_tbl;
+      break;
+    case LIBS_SECTION:
+      stream >> *db->_lib_tbl;
+      break;
+    case CORE_SECTION:
+      stream >> *db;
+      break;
+    case NETS_SECTION:
+      stream >> *getSectionBlock(db, section)->_net_tbl;
+      break;
+    case WIRES_SECTION:
+      stream >> *getSectionBlock(db, section)->_wire_tbl;
+      break;
+    case PARASITICS_SECTION:
+      readBlockParasitics(stream, getSectionBlock(db, section));
+      break;
+    default:
+      throw ZException("unknown database section");
+  }
+
+  db->_schema_minor = db_schema_minor;
+}
+
+static void uncompressSection(const dbSection& section, std::vector<char>& data)
+{
+  uLongf size = section._size;
+  data.resize(size);
+  int status = uncompress((Bytef*) data.data(),
+                          &size,
+                          (const Bytef*) section._data.data(),
+                          section._data.size());
+
+  if ((status != Z_OK) || (size != section._size))
+    throw ZException("decompression of database section failed");
+}
+
+static bool isDeferred(const dbSection& section,
+                       dbDatabase::LoadProfile profile)
+{
+  switch (section._type) {
+    case WIRES_SECTION:
+      return profile == dbDatabase::LOAD_PLACEMENT;
+    case PARASITICS_SECTION:
+      return profile != dbDatabase::LOAD_ALL;
+  }
+
+  return false;
+}
+
+// Deferred sections are decoded under one lock for all databases: readers
+// in dbBlock concurrent read mode may need a section at the same time, and
+// decoding sets the schema revision of the database. The sections being
+// decoded by the thread holding the lock are listed, as their accessors
+// lead back to loadDeferredSection.
+static std::recursive_mutex                  deferred_load_lock;
+static std::vector<std::atomic<dbSection*>*> deferred_loading;
+
+void _dbBlock::loadDeferredSection(std::atomic<dbSection*>& section)
+{
+  std::lock_guard<std::recursive_mutex> guard(deferred_load_lock);
+
+  if ((section.load() == NULL)
+      || (std::find(deferred_loading.begin(), deferred_loading.end(), &section)
+          != deferred_loading.end()))
+    return;
+
+  std::unique_ptr<dbSection> deferred(section.load());
+  deferred_loading.push_back(&section);
+
+  try {
+    std::vector<char> data;
+    uncompressSection(*deferred, data);
+    deferred->_block = getOID();
+    readSection(getDatabase(), *deferred, data);
+  } catch (...) {
+    deferred_loading.pop_back();
+    section.store(NULL, std::memory_order_release);
+    throw;
+  }
+
+  // Readers that find the reference cleared see the decoded objects.
+  deferred_loading.pop_back();
+  section.store(NULL, std::memory_order_release);
+}
+
+static void loadDeferredSections(_dbDatabase* db)
+{
+  _dbChip* chip = (_dbChip*) ((dbDatabase*) db)->getChip();
+
+  if (chip == NULL)
+    return;
+
+  dbSet<_dbBlock>           blocks(chip, chip->_block_tbl);
+  dbSet<_dbBlock>::iterator itr;
+
+  for (itr = blocks.begin(); itr != blocks.end(); ++itr) {
+    itr->loadWires();
+    itr->loadParasitics();
+  }
+}
+
+static bool isCompressed(FILE* file)
+{
+  long pos = ftell(file);
+
+  // Can't look ahead on a stream that isn't seekable.
+  if (pos < 0)
+    return false;
+
+  uint   magic[2];
+  size_t n = fread(magic, sizeof(uint), 2, file);
+  fseek(file, pos, SEEK_SET);
+
+  return (n == 2) && (magic[0] == ADS_DB_MAGIC1)
+         && (magic[1] == ADS_DB_COMPRESSED_MAGIC2);
+}
+
+static void readCompressed(_dbDatabase*            db,
+                           FILE*                   file,
+                           int                     num_threads,
+                           dbDatabase::LoadProfile profile)
+{
+  std::vector<dbSection> sections;
+
+  {
+    dbIStream stream(db, file);
+    uint      magic1;
+    uint      magic2;
+    uint      schema_major;
+    uint      schema_minor;
+    uint      section_cnt;
+    stream >> magic1;
+    stream >> magic2;
+    stream >> schema_major;
+    stream >> schema_minor;
+
+    if ((magic1 != ADS_DB_MAGIC1) || (magic2 != ADS_DB_COMPRESSED_MAGIC2))
+      throw ZException("database file is not a compressed OpenDB Database");
+
+    if (schema_major != db_schema_major)
+      throw ZException("Incompatible database schema revision");
+
+    if (schema_minor < db_schema_initial)
+      throw ZException("incompatible database schema revision");
+
+    if (schema_minor > db_schema_minor)
+      throw ZException("database schema revision %u is newer than %u",
+                       schema_minor,
+                       db_schema_minor);
+
+    stream >> section_cnt;
+    sections.resize(section_cnt);
+
+    for (dbSection& section : sections) {
+      uint64_t zsize;
+      section._schema_minor = schema_minor;
+      stream >> section._type;
+      stream >> section._block;
+      stream >> section._size;
+      stream >> zsize;
+      section._data.resize(zsize);
+    }
+  }
+
+  for (dbSection& section : sections) {
+    if (section._data.empty())
+      continue;
+
+    if (fread(section._data.data(), section._data.size(), 1, file) != 1) {
+      if (feof(file))
+        throw ZException(
+            "read failed on database stream (unexpected end-of-file "
+            "encounted).");
+      throw ZIOError(ferror(file),
+                     "read failed on database stream; system io error: ");
+    }
+  }
+
+  std::vector<std::vector<char>> data(sections.size());
+
+  runParallel(sections.size(), num_threads, [&](uint i) {
+    dbSection& section = sections[i];
+
+    if (isDeferred(section, profile))
+      return;
+
+    uncompressSection(section, data[i]);
+    std::vector<char>().swap(section._data);
+  });
+
+  // Decoding creates objects in the database and is done in file order.
+  for (uint i = 0; i < sections.size(); ++i) {
+    dbSection& section = sections[i];
+
+    if (isDeferred(section, profile)) {
+      _dbBlock*                block    = getSectionBlock(db, section);
+      std::atomic<dbSection*>& deferred = (section._type == WIRES_SECTION)
+                                              ? block->_deferred_wires
+                                              : block->_deferred_parasitics;
+      delete deferred.load();
+      deferred = new dbSection(std::move(section));
+      ZALLOCATED(deferred.load());
+      continue;
+    }
+
+    readSection(db, section, data[i]);
+    std::vector<char>().swap(data[i]);
+  }
+}
+
+void dbDatabase::read(FILE* file, LoadProfile profile)
 {
   _dbDatabase* db = (_dbDatabase*) this;
-  dbIStream    stream(db, file);
+
+  if (isCompressed(file)) {
+    readCompressed(db, file, 0, profile);
+    return;
+  }
+
+  dbIStream stream(db, file);
   stream >> *db;
 }
 
@@ -463,6 +855,9 @@ void dbDatabase::readLib(FILE* file, dbLib* lib)
 
   dbIStream stream(db, file);
   stream >> *l;
+
+  for (dbMaster* master : lib->getMasters())
+    ((_dbMaster*) master)->_id = db->_master_id++;
 }
 
 void dbDatabase::readLibs(FILE* file)
@@ -499,26 +894,23 @@ void dbDatabase::readNets(FILE* file, dbBlock* block)
 void dbDatabase::readWires(FILE* file, dbBlock* block)
 {
   _dbDatabase* db = (_dbDatabase*) this;
-  dbIStream    stream(db, file);
-  stream >> *((_dbBlock*) block)->_wire_tbl;
+  _dbBlock*    b  = (_dbBlock*) block;
+  delete b->_deferred_wires.load();
+  b->_deferred_wires = NULL;
+  if (b->_wire_shape_cache)
+    b->_wire_shape_cache->clear();
+  dbIStream stream(db, file);
+  stream >> *b->_wire_tbl;
 }
 
 void dbDatabase::readParasitics(FILE* file, dbBlock* block)
 {
   _dbDatabase* db = (_dbDatabase*) this;
-  dbIStream    stream(db, file);
-  stream >> ((_dbBlock*) block)->_num_ext_corners;
-  stream >> ((_dbBlock*) block)->_corner_name_list;
-  stream >> *((_dbBlock*) block)->_r_val_tbl;
-  stream >> *((_dbBlock*) block)->_c_val_tbl;
-  stream >> *((_dbBlock*) block)->_cc_val_tbl;
-  stream >> *((_dbBlock*) block)->_cap_node_tbl;
-  stream >> *((_dbBlock*) block)->_r_seg_tbl;
-  stream >> *((_dbBlock*) block)->_cc_seg_tbl;
-  stream >> *((_dbBlock*) block)->_extControl;
-
-  ((_dbBlock*) block)->_corners_per_block
-      = ((_dbBlock*) block)->_num_ext_corners;
+  _dbBlock*    b  = (_dbBlock*) block;
+  delete b->_deferred_parasitics.load();
+  b->_deferred_parasitics = NULL;
+  dbIStream stream(db, file);
+  readBlockParasitics(stream, b);
 }
 
 void dbDatabase::readChip(FILE* file)
@@ -534,11 +926,83 @@ void dbDatabase::readChip(FILE* file)
 void dbDatabase::write(FILE* file)
 {
   _dbDatabase* db = (_dbDatabase*) this;
-  dbOStream    stream(db, file);
+  loadDeferredSections(db);
+  dbOStream stream(db, file);
   stream << *db;
+  stream.flush();
   fflush(file);
 }
 
+void dbDatabase::writeCompressed(FILE* file, int num_threads)
+{
+  _dbDatabase*           db = (_dbDatabase*) this;
+  std::vector<dbSection> sections;
+  sections.push_back({TECH_SECTION, 0});
+  sections.push_back({LIBS_SECTION, 0});
+  sections.push_back({CORE_SECTION, 0});
+
+  _dbChip* chip = (_dbChip*) getChip();
+
+  if (chip) {
+    dbSet<_dbBlock>           blocks(chip, chip->_block_tbl);
+    dbSet<_dbBlock>::iterator itr;
+
+    for (itr = blocks.begin(); itr != blocks.end(); ++itr) {
+      // A deferred section is copied as it was read, which only holds for
+      // a section at the current revision.
+      dbSection* wires = itr->_deferred_wires;
+      if (wires && wires->_schema_minor != db_schema_minor)
+        itr->loadWires();
+      dbSection* parasitics = itr->_deferred_parasitics;
+      if (parasitics && parasitics->_schema_minor != db_schema_minor)
+        itr->loadParasitics();
+
+      uint block_id = itr->getOID();
+      sections.push_back({NETS_SECTION, block_id});
+      sections.push_back({WIRES_SECTION, block_id});
+      sections.push_back({PARASITICS_SECTION, block_id});
+    }
+  }
+
+  // Serialization only reads the database, so the sections are
+  // independent of each other.
+  runParallel(sections.size(), num_threads, [&](uint i) {
+    writeSection(db, sections[i]);
+  });
+
+  dbOStream stream(db, file);
+  stream << (uint) ADS_DB_MAGIC1;
+  stream << (uint) ADS_DB_COMPRESSED_MAGIC2;
+  stream << (uint) db_schema_major;
+  stream << (uint) db_schema_minor;
+  stream << (uint) sections.size();
+
+  for (const dbSection& section : sections) {
+    stream << section._type;
+    stream << section._block;
+    stream << section._size;
+    stream << (uint64_t) section._data.size();
+  }
+
+  stream.flush();
+
+  for (const dbSection& section : sections) {
+    if (section._data.empty())
+      continue;
+
+    if (fwrite(section._data.data(), section._data.size(), 1, file) != 1)
+      throw ZIOError(ferror(file),
+                     "write failed on database stream; system io error: ");
+  }
+
+  fflush(file);
+}
+
+uint dbDatabase::getSchemaRevision()
+{
+  return db_schema_minor;
+}
+
 void dbDatabase::writeTech(FILE* file)
 {
   _dbDatabase* db   = (_dbDatabase*) this;
@@ -549,6 +1013,7 @@ void dbDatabase::writeTech(FILE* file)
 
   dbOStream stream(db, file);
   stream << *tech;
+  stream.flush();
   fflush(file);
 }
 
@@ -557,6 +1022,7 @@ void dbDatabase::writeLib(FILE* file, dbLib* lib)
   _dbDatabase* db = (_dbDatabase*) this;
   dbOStream    stream(db, file);
   stream << *(_dbLib*) lib;
+  stream.flush();
   fflush(file);
 }
 
@@ -565,14 +1031,19 @@ void dbDatabase::writeLibs(FILE* file)
   _dbDatabase* db = (_dbDatabase*) this;
   dbOStream    stream(db, file);
   stream << *db->_lib_tbl;
+  stream.flush();
   fflush(file);
 }
 
 void dbDatabase::writeBlock(FILE* file, dbBlock* block)
 {
   _dbDatabase* db = (_dbDatabase*) this;
-  dbOStream    stream(db, file);
-  stream << *(_dbBlock*) block;
+  _dbBlock*    b  = (_dbBlock*) block;
+  b->loadWires();
+  b->loadParasitics();
+  dbOStream stream(db, file);
+  stream << *b;
+  stream.flush();
   fflush(file);
 }
 
@@ -581,30 +1052,29 @@ void dbDatabase::writeNets(FILE* file, dbBlock* block)
   _dbDatabase* db = (_dbDatabase*) this;
   dbOStream    stream(db, file);
   stream << *((_dbBlock*) block)->_net_tbl;
+  stream.flush();
   fflush(file);
 }
 
 void dbDatabase::writeWires(FILE* file, dbBlock* block)
 {
   _dbDatabase* db = (_dbDatabase*) this;
-  dbOStream    stream(db, file);
-  stream << *((_dbBlock*) block)->_wire_tbl;
+  _dbBlock*    b  = (_dbBlock*) block;
+  b->loadWires();
+  dbOStream stream(db, file);
+  stream << *b->_wire_tbl;
+  stream.flush();
   fflush(file);
 }
 
 void dbDatabase::writeParasitics(FILE* file, dbBlock* block)
 {
   _dbDatabase* db = (_dbDatabase*) this;
-  dbOStream    stream(db, file);
-  stream << ((_dbBlock*) block)->_num_ext_corners;
-  stream << ((_dbBlock*) block)->_corner_name_list;
-  stream << *((_dbBlock*) block)->_r_val_tbl;
-  stream << *((_dbBlock*) block)->_c_val_tbl;
-  stream << *((_dbBlock*) block)->_cc_val_tbl;
-  stream << *((_dbBlock*) block)->_cap_node_tbl;
-  stream << *((_dbBlock*) block)->_r_seg_tbl;
-  stream << *((_dbBlock*) block)->_cc_seg_tbl;
-  stream << *((_dbBlock*) block)->_extControl;
+  _dbBlock*    b  = (_dbBlock*) block;
+  b->loadParasitics();
+  dbOStream stream(db, file);
+  writeBlockParasitics(stream, b);
+  stream.flush();
   fflush(file);
 }
 
@@ -612,8 +1082,10 @@ void dbDatabase::writeChip(FILE* file)
 {
   _dbDatabase* db   = (_dbDatabase*) this;
   _dbChip*     chip = (_dbChip*) getChip();
-  dbOStream    stream(db, file);
+  loadDeferredSections(db);
+  dbOStream stream(db, file);
   stream << *chip;
+  stream.flush();
   fflush(file);
 }
 
@@ -626,6 +1098,7 @@ void dbDatabase::beginEco(dbBlock* block_)
 
   block->_journal = new dbJournal(block_);
   assert(block->_journal);
+  block->_journal->watchUnrecordedEdits();
 }
 
 void dbDatabase::endEco(dbBlock* block_)
@@ -634,6 +1107,9 @@ void dbDatabase::endEco(dbBlock* block_)
   dbJournal* eco   = block->_journal;
   block->_journal  = NULL;
 
+  if (eco)
+    eco->stopWatching();
+
   if (block->_journal_pending)
     delete block->_journal_pending;
 
@@ -682,6 +1158,30 @@ void dbDatabase::writeEco(dbBlock* block_, FILE* file)
   if (block->_journal_pending) {
     dbOStream stream(block->getDatabase(), file);
     stream << *block->_journal_pending;
+    stream.flush();
+  }
+}
+
+bool dbDatabase::ecoInProgress(dbBlock* block_)
+{
+  _dbBlock* block = (_dbBlock*) block_;
+  return block->_journal != NULL;
+}
+
+bool dbDatabase::ecoHasUnrecordedEdits(dbBlock* block_)
+{
+  _dbBlock* block = (_dbBlock*) block_;
+  return block->_journal && block->_journal->hasUnrecordedEdits();
+}
+
+void dbDatabase::writeEcoDelta(dbBlock* block_, FILE* file)
+{
+  _dbBlock* block = (_dbBlock*) block_;
+
+  if (block->_journal) {
+    dbOStream stream(block->getDatabase(), file);
+    stream << *block->_journal;
+    stream.flush();
   }
 }
 
@@ -711,6 +1211,10 @@ dbDatabase* dbDatabase::create()
     db_tbl = new dbTable<_dbDatabase>(
         NULL, NULL, (GetObjTbl_t) NULL, dbDatabaseObj);
     ZALLOCATED(db_tbl);
+
+    // The table lives as long as the process, an installed allocator
+    // does not.
+    db_tbl->_allocator = getMallocPageAllocator();
   }
 
   _dbDatabase* db = db_tbl->create();
@@ -760,7 +1264,9 @@ bool dbDatabase::diff(dbDatabase* db0_,
 {
   _dbDatabase* db0 = (_dbDatabase*) db0_;
   _dbDatabase* db1 = (_dbDatabase*) db1_;
-  dbDiff       diff(file);
+  loadDeferredSections(db0);
+  loadDeferredSections(db1);
+  dbDiff diff(file);
   diff.setIndentPerLevel(indent);
   db0->differences(diff, NULL, *db1);
   return diff.hasDifferences();
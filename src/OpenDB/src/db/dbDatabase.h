@@ -32,6 +32,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "dbCore.h"
 #include "odb.h"
 
@@ -81,6 +83,19 @@ class dbOStream;
 class dbIStream;
 class dbDiff;
 
+//
+// An independently compressed section of a database written by
+// dbDatabase::writeCompressed().
+//
+struct dbSection
+{
+  uint              _type;
+  uint              _block;  // block-id of the net, wire and parasitic sections
+  uint64_t          _size;   // uncompressed size
+  std::vector<char> _data;   // compressed data
+  uint              _schema_minor = db_schema_minor;  // revision of the file
+};
+
 class _dbDatabase : public _dbObject
 {
  public:
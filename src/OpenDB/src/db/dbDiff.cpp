@@ -51,6 +51,16 @@ dbDiff::~dbDiff()
     fflush(_f);
 }
 
+bool dbDiff::sameContent(const void* lhs, const void* rhs) const
+{
+  auto l = _content_hashes.find(lhs);
+  if (l == _content_hashes.end())
+    return false;
+
+  auto r = _content_hashes.find(rhs);
+  return r != _content_hashes.end() && l->second == r->second;
+}
+
 void dbDiff::indent()
 {
   int  i;
@@ -180,6 +180,8 @@ void dbFill::destroy(dbFill* fill_)
 {
   _dbFill*  fill  = (_dbFill*) fill_;
   _dbBlock* block = (_dbBlock*) fill->getOwner();
+  for (auto callback : block->_callbacks)
+    callback->inDbFillDestroy(fill_);
   dbProperty::destroyProperties(fill);
   block->_fill_tbl->destroy(fill);
 }
@@ -30,12 +30,16 @@
 // ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
 // POSSIBILITY OF SUCH DAMAGE.
 
+#include <utility>
+#include <vector>
+
 #include "db.h"
 #include "dbCapNode.h"
 #include "dbFlatten.h"
 #include "dbInst.h"
 #include "dbNet.h"
 #include "dbObstruction.h"
+#include "dbParallel.h"
 #include "dbSWire.h"
 #include "dbShape.h"
 #include "dbTransform.h"
@@ -52,7 +56,8 @@ dbFlatten::dbFlatten()
       _create_bterm_map(false),
       _copy_parasitics(false),
       _hier_d(0),
-      _next_bterm_map_id(0)
+      _next_bterm_map_id(0),
+      _num_threads(0)
 {
 
 }
@@ -77,19 +82,20 @@ bool dbFlatten::flatten(dbBlock* block, int level)
     bterm_map = dbStringProperty::create(block, "_ADS_BTERM_MAP", name.c_str());
   }
 
-  bool                    error = false;
   dbSet<dbInst>           insts = block->getInsts();
   dbSet<dbInst>::iterator itr;
+  std::vector<dbBlock*>   children;
 
   for (itr = insts.begin(); itr != insts.end(); ++itr) {
     dbInst*  inst  = *itr;
     dbBlock* child = inst->getChild();
 
     if (child)
-      if (!flatten(block, child, level, bterm_map))
-        error = true;
+      children.push_back(child);
   }
 
+  bool error = !flatten(block, children, level, bterm_map);
+
   for (itr = insts.begin(); itr != insts.end();) {
     dbInst*  inst  = *itr;
     dbBlock* child = inst->getChild();
@@ -105,7 +111,7 @@ bool dbFlatten::flatten(dbBlock* block, int level)
   return !error;
 }
 
-/* // flatten = flatten child block into parent
+/* // flatten = flatten child blocks into parent
 //
 //           ..........o Parent (inst/block)
 //           .        / \
@@ -118,17 +124,70 @@ bool dbFlatten::flatten(dbBlock* block, int level)
 //           . / ... \
 //           ./
 //           o Grandchild (inst)
+//
+// The children are copied in three passes. The objects of each child are
+// created in the parent one child at a time, as the tables of the parent
+// take one writer. Then the wires of all children, which hold most of the
+// data of routed blocks, are translated to the parent concurrently, one
+// child per thread, while the database is only read. Last the translated
+// wires are stitched onto the parent nets, and the special wires,
+// obstructions, blockages and regions are copied, in child order, so the
+// result does not depend on the number of threads.
 // */
-bool dbFlatten::flatten(dbBlock*    parent,
-                        dbBlock*    child,
-                        int         level,
-                        dbProperty* bterm_map)
+bool dbFlatten::flatten(dbBlock*                     parent,
+                        const std::vector<dbBlock*>& children,
+                        int                          level,
+                        dbProperty*                  bterm_map)
 {
   bool error = false;
 
   if (level == 0)
     return true;
 
+  std::vector<ChildCopy> copies(children.size());
+
+  for (uint i = 0; i < children.size(); ++i) {
+    if (!copyObjects(parent, children[i], level, bterm_map, copies[i]))
+      error = true;
+  }
+
+  {
+    dbConcurrentReadScope concurrent_read(parent);
+    runParallel(copies.size(), _num_threads, [&](uint i) {
+      dbFlatten worker(*this);
+      worker.swapMaps(copies[i]);
+      worker.translateWires(copies[i]);
+      worker.swapMaps(copies[i]);
+    });
+  }
+
+  for (ChildCopy& copy : copies)
+    finishCopy(parent, copy);
+
+  return !error;
+}
+
+void dbFlatten::swapMaps(ChildCopy& copy)
+{
+  std::swap(_net_map, copy.net_map);
+  std::swap(_via_map, copy.via_map);
+  std::swap(_inst_map, copy.inst_map);
+  std::swap(_layer_rule_map, copy.layer_rule_map);
+  std::swap(_transform, copy.transform);
+}
+
+//
+// copyObjects - Create the vias, non-default rules, nets and instances of the
+// child in the parent, after flattening the grandchildren into the child.
+//
+bool dbFlatten::copyObjects(dbBlock*    parent,
+                            dbBlock*    child,
+                            int         level,
+                            dbProperty* bterm_map,
+                            ChildCopy&  copy)
+{
+  bool error = false;
+
   if (bterm_map) {
     std::string name = child->getName();
     std::string propName("_ADS_BTERM_MAP");
@@ -138,18 +197,25 @@ bool dbFlatten::flatten(dbBlock*    parent,
         = dbStringProperty::create(bterm_map, propName.c_str(), name.c_str());
   }
 
+  copy.child     = child;
+  copy.level     = level;
+  copy.bterm_map = bterm_map;
+
   // Descend hierarchy and flatten
   dbSet<dbInst>           insts = child->getInsts();
   dbSet<dbInst>::iterator itr;
+  std::vector<dbBlock*>   grandchildren;
 
   for (itr = insts.begin(); itr != insts.end(); ++itr) {
     dbInst*  inst       = *itr;
     dbBlock* grandchild = inst->getChild();
 
     if (grandchild)
-      flatten(child, grandchild, level - 1, bterm_map);
+      grandchildren.push_back(grandchild);
   }
 
+  flatten(child, grandchildren, level - 1, bterm_map);
+
   child->getParentInst()->getTransform(_transform);
 
   ////////////////////////////
@@ -198,6 +264,12 @@ bool dbFlatten::flatten(dbBlock*    parent,
       error = true;
 
     _net_map[src] = dst;
+
+    // The old shape ids are set here as the wires are translated while the
+    // database is only read.
+    if (dst && _copy_parasitics && src->getWire()
+        && canCopyWire(src->getWire(), src->getSigType()))
+      setOldShapeIds(src->getWire());
   }
 
   ////////////////////////////
@@ -219,17 +291,79 @@ bool dbFlatten::flatten(dbBlock*    parent,
     }
   }
 
+  swapMaps(copy);
+  return !error;
+}
+
+//
+// translateWires - Translate the wires of the child nets to the parent. Only
+// reads the database.
+//
+void dbFlatten::translateWires(ChildCopy& copy)
+{
+  dbSet<dbNet>           nets = copy.child->getNets();
+  dbSet<dbNet>::iterator nitr;
+
+  for (nitr = nets.begin(); nitr != nets.end(); ++nitr) {
+    dbNet* src = *nitr;
+
+    if (_net_map[src] == NULL)
+      continue;
+
+    if (src->getWire())
+      translateWire(copy, src, src->getWire(), false);
+
+    if (src->getGlobalWire())
+      translateWire(copy, src, src->getGlobalWire(), true);
+  }
+}
+
+void dbFlatten::translateWire(ChildCopy& copy,
+                              dbNet*     src,
+                              dbWire*    wire_,
+                              bool       global)
+{
+  _dbWire* wire = (_dbWire*) wire_;
+
+  if (!canCopyWire(wire_, src->getSigType()))
+    return;
+
+  copy.wires.emplace_back();
+  WireCopy& dst = copy.wires.back();
+  dst.src       = src;
+  dst.global    = global;
+  dst.opcodes   = wire->_opcodes;
+  dst.data      = wire->_data;
+  fixWire(dst.opcodes, dst.data, copy.child, copy.level, copy.bterm_map);
+}
+
+//
+// finishCopy - Stitch the translated wires onto the parent nets and copy the
+// remaining child objects.
+//
+void dbFlatten::finishCopy(dbBlock* parent, ChildCopy& copy)
+{
+  swapMaps(copy);
+
+  dbBlock* child = copy.child;
+
   ////////////////////////////
   // Copy the wires seperately
   ////////////////////////////
+  dbSet<dbNet>           nets = child->getNets();
+  dbSet<dbNet>::iterator nitr;
+  uint                   next = 0;
+
   for (nitr = nets.begin(); nitr != nets.end(); ++nitr) {
     dbNet* src = *nitr;
     dbNet* dst = _net_map[src];
 
     if (dst)
-      copyNetWires(dst, src, level, bterm_map);
+      copyNetWires(dst, src, copy.wires, next);
   }
 
+  copy.wires.clear();
+
   ////////////////////////////
   // Copy obstructions
   ////////////////////////////
@@ -282,6 +416,9 @@ bool dbFlatten::flatten(dbBlock*    parent,
         block_region->addChild(_reg_map[rg]);
     }
 
+    dbSet<dbInst>           insts = child->getInsts();
+    dbSet<dbInst>::iterator itr;
+
     for (itr = insts.begin(); itr != insts.end(); ++itr) {
       dbInst* inst = *itr;
 
@@ -296,7 +433,6 @@ bool dbFlatten::flatten(dbBlock*    parent,
   _layer_rule_map.clear();
   _reg_map.clear();
   _node_map.clear();
-  return !error;
 }
 
 /*
@@ -566,16 +702,18 @@ FILE* dbFlatten::debugNetWires(FILE*       fp,
   }
   return fp;
 }
-void dbFlatten::copyNetWires(dbNet*      dst,
-                             dbNet*      src,
-                             int         level,
-                             dbProperty* bterm_map)
+void dbFlatten::copyNetWires(dbNet*                 dst,
+                             dbNet*                 src,
+                             std::vector<WireCopy>& wires,
+                             uint&                  next)
 {
   FILE* fp = NULL;
   if (isDebug("FLATTEN", "R"))
     fp = debugNetWires(NULL, dst, src, "Before CopyWires");
 
-  copyWires(dst, src, level, bterm_map, _copy_parasitics);
+  for (; next < wires.size() && wires[next].src == src; ++next)
+    copyWire(dst, wires[next]);
+
   copySWires(dst, src);
 
   if (fp != NULL) {
@@ -631,79 +769,16 @@ void dbFlatten::copyAttrs(dbNet* dst_, dbNet* src_)
   dst->_non_default_rule       = src->_non_default_rule;
 }
 
-void dbFlatten::copyWires(dbNet*      dst_,
-                          dbNet*      src_,
-                          int         level,
-                          dbProperty* bterm_map,
-                          bool        copyParasitics)
+void dbFlatten::copyWire(dbNet* dst_, WireCopy& wire)
 {
-  //_dbNet * dst = (_dbNet *) dst_;
-  _dbNet* src = (_dbNet*) src_;
-
-  if (src->_wire) {
-    _dbWire* src_wire = (_dbWire*) src_->getWire();
-
-    if (canCopyWire((dbWire*) src_wire, src->_flags._sig_type)) {
-      if (copyParasitics)
-        setOldShapeIds(src_->getWire());
-
-      if (dst_->getWire()) {
-        dbVector<unsigned char> opcodes;
-        dbVector<int>           data;
-        opcodes.reserve(src_wire->_opcodes.size());
-        opcodes = src_wire->_opcodes;
-        data.reserve(src_wire->_data.size());
-        data = src_wire->_data;
-        fixWire(opcodes, data, src_->getBlock(), level, bterm_map);
-        appendWire(opcodes, data, dst_->getWire());
-      } else {
-        _dbWire* dst_wire = (_dbWire*) dbWire::create(dst_);
-        dst_wire->_opcodes.reserve(src_wire->_opcodes.size());
-        dst_wire->_opcodes = src_wire->_opcodes;
-        dst_wire->_data.reserve(src_wire->_data.size());
-        dst_wire->_data = src_wire->_data;
-        fixWire(dst_wire->_opcodes,
-                dst_wire->_data,
-                src_->getBlock(),
-                level,
-                bterm_map);
-      }
-      if (copyParasitics) {
-        dbSet<dbRSeg> rSet = dst_->getRSegs();
-        rSet.reverse();
-
-        rSet = dst_->getRSegs();
-        rSet.reverse();
-      }
-    }
-  }
-
-  if (src->_global_wire) {
-    _dbWire* src_wire = (_dbWire*) src_->getGlobalWire();
-
-    if (canCopyWire((dbWire*) src_wire, src->_flags._sig_type)) {
-      if (dst_->getGlobalWire()) {
-        dbVector<unsigned char> opcodes;
-        dbVector<int>           data;
-        opcodes.reserve(src_wire->_opcodes.size());
-        opcodes = src_wire->_opcodes;
-        data.reserve(src_wire->_data.size());
-        data = src_wire->_data;
-        fixWire(opcodes, data, src_->getBlock(), level, bterm_map);
-        appendWire(opcodes, data, dst_->getGlobalWire());
-      } else {
-        _dbWire* dst_wire = (_dbWire*) dbWire::create(dst_, true);
-        dst_wire->_opcodes.reserve(src_wire->_opcodes.size());
-        dst_wire->_opcodes = src_wire->_opcodes;
-        dst_wire->_data.reserve(src_wire->_data.size());
-        dst_wire->_data = src_wire->_data;
-        fixWire(dst_wire->_opcodes,
-                dst_wire->_data,
-                src_->getBlock(),
-                level,
-                bterm_map);
-      }
-    }
+  dbWire* dst_wire = wire.global ? dst_->getGlobalWire() : dst_->getWire();
+
+  if (dst_wire) {
+    appendWire(wire.opcodes, wire.data, dst_wire);
+  } else {
+    _dbWire* dst = (_dbWire*) dbWire::create(dst_, wire.global);
+    dst->_opcodes.swap(wire.opcodes);
+    dst->_data.swap(wire.data);
   }
 }
 
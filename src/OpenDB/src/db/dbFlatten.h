@@ -33,6 +33,7 @@
 #pragma once
 
 #include <map>
+#include <vector>
 
 #include "dbFlatten.h"
 #include "dbTransform.h"
@@ -58,6 +59,30 @@ class dbCapNode;
 
 class dbFlatten
 {
+  // A wire of a child net translated to the parent.
+  struct WireCopy
+  {
+    dbNet*                  src;
+    bool                    global;
+    dbVector<unsigned char> opcodes;
+    dbVector<int>           data;
+  };
+
+  // The state of copying a child block into its parent: the maps from its
+  // objects to their copies, and its wires translated to the parent.
+  struct ChildCopy
+  {
+    dbBlock*                                     child     = NULL;
+    int                                          level     = 0;
+    dbProperty*                                  bterm_map = NULL;
+    std::map<dbNet*, dbNet*>                     net_map;
+    std::map<dbVia*, dbVia*>                     via_map;
+    std::map<dbInst*, dbInst*>                   inst_map;
+    std::map<dbTechLayerRule*, dbTechLayerRule*> layer_rule_map;
+    dbTransform                                  transform;
+    std::vector<WireCopy>                        wires;
+  };
+
   bool                                         _do_not_copy_power_wires;
   bool                                         _copy_shields;
   bool                                         _create_boundary_regions;
@@ -73,25 +98,34 @@ class dbFlatten
   dbTransform                                  _transform;
   char                                         _hier_d;
   int                                          _next_bterm_map_id;
+  int                                          _num_threads;
 
   bool canCopyWire(dbWire* wire, dbSigType::Value sig_type);
   bool canCopySWire(dbSWire* wire, dbSigType::Value sig_type);
   void copySWire(dbNet* dst, dbNet* src, dbSWire* src_swire);
-  void copyNetWires(dbNet* dst_, dbNet* src_, int level, dbProperty* bterm_map);
-  void copyWires(dbNet*      dst_,
-                 dbNet*      src_,
-                 int         level,
-                 dbProperty* bterm_map,
-                 bool        copyParasitics);
+  void copyNetWires(dbNet*                 dst,
+                    dbNet*                 src,
+                    std::vector<WireCopy>& wires,
+                    uint&                  next);
+  void translateWire(ChildCopy& copy, dbNet* src, dbWire* wire, bool global);
+  void copyWire(dbNet* dst, WireCopy& wire);
   void copySWires(dbNet* dst_, dbNet* src_);
   void copyAttrs(dbNet* dst, dbNet* src);
   void copyAttrs(dbInst* dst, dbInst* src);
   dbNet* getParentNet(dbBlock* parent_block, dbNet* child_net);
   bool   copyInst(dbBlock* parent, dbInst* child, dbInst* grandchild);
-  bool   flatten(dbBlock*    parent,
-                 dbBlock*    child,
-                 int         level,
-                 dbProperty* bterm_map);
+  bool   flatten(dbBlock*                     parent,
+                 const std::vector<dbBlock*>& children,
+                 int                          level,
+                 dbProperty*                  bterm_map);
+  bool   copyObjects(dbBlock*    parent,
+                     dbBlock*    child,
+                     int         level,
+                     dbProperty* bterm_map,
+                     ChildCopy&  copy);
+  void   translateWires(ChildCopy& copy);
+  void   finishCopy(dbBlock* parent, ChildCopy& copy);
+  void   swapMaps(ChildCopy& copy);
   dbNet* copyNet(dbBlock* parent_block, dbNet* child_net);
   dbTechNonDefaultRule* copyNonDefaultRule(dbBlock*              parent,
                                            dbInst*               child,
@@ -134,6 +168,9 @@ class dbFlatten
   }
   void setCreateBTermMap(bool value) { _create_bterm_map = value; }
   void setCopyParasitics(bool value) { _copy_parasitics = value; }
+  // The wires of the child blocks are translated on up to num_threads
+  // threads (0 uses all hardware threads).
+  void setThreads(int num_threads) { _num_threads = num_threads; }
   bool flatten(dbBlock* block, int level);
   void printShapes(FILE* fp, dbWire* wire, bool skipRCs = false);
 };
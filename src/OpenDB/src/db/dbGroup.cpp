@@ -65,7 +65,10 @@ bool _dbGroup::operator==(const _dbGroup& rhs) const
   if (_flags._box != rhs._flags._box)
     return false;
 
-  if (_name != rhs._name)
+  if (_name && rhs._name) {
+    if (strcmp(_name, rhs._name) != 0)
+      return false;
+  } else if (_name || rhs._name)
     return false;
 
   if (_box != rhs._box)
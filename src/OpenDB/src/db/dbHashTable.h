@@ -32,6 +32,10 @@
 
 #pragma once
 
+#include <atomic>
+#include <string>
+#include <vector>
+
 #include "dbPagedVector.h"
 #include "odb.h"
 
@@ -42,6 +46,8 @@ class dbOStream;
 class dbDiff;
 template <class T>
 class dbTable;
+template <class T>
+class dbNameIndex;
 
 //////////////////////////////////////////////////////////
 ///
@@ -52,6 +58,10 @@ class dbTable;
 ///     char *        _name
 ///     dbId<T>       _next_entry
 ///
+/// Lookups go through a dbNameIndex that is built on the first lookup and
+/// then kept current by insert and remove. The first lookup may come from
+/// several threads at once.
+///
 //////////////////////////////////////////////////////////
 template <class T>
 class dbHashTable
@@ -67,14 +77,18 @@ class dbHashTable
   uint                           _num_entries;
 
   // NON-PERSISTANT-MEMBERS
-  dbTable<T>* _obj_tbl;
+  dbTable<T>*                  _obj_tbl;
+  std::atomic<dbNameIndex<T>*> _index;
 
-  void growTable();
-  void shrinkTable();
+  void            growTable();
+  void            shrinkTable();
+  dbNameIndex<T>* getIndex();
+  void            clearIndex();
 
   dbHashTable();
   dbHashTable(const dbHashTable<T>& table);
   ~dbHashTable();
+  dbHashTable<T>& operator=(const dbHashTable<T>& table);
   bool operator==(const dbHashTable<T>& rhs) const;
   bool operator!=(const dbHashTable<T>& rhs) const { return !operator==(rhs); }
   void differences(dbDiff&               diff,
@@ -87,6 +101,11 @@ class dbHashTable
   int  hasMember(const char* name);
   void insert(T* object);
   void remove(T* object);
+
+  // Find the objects of names; objects[i] is NULL if names[i] is not found.
+  void find(const std::vector<std::string>& names, std::vector<T*>& objects);
+
+  void getIndexMemoryUsage(uint64& used, uint64& wasted) const;
 };
 
 template <class T>
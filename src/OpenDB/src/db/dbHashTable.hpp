@@ -32,8 +32,12 @@
 
 #pragma once
 
+#include <algorithm>
+#include <mutex>
+
 #include "dbHashTable.h"
 #include "dbCore.h"
+#include "dbNameIndex.h"
 
 namespace odb {
 
@@ -48,8 +52,15 @@ inline unsigned int hash_string(const char* str)
   return hash;
 }
 
+// Serializes the first lookups of all hash tables.
+inline std::mutex& nameIndexMutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
 template <class T>
-dbHashTable<T>::dbHashTable()
+dbHashTable<T>::dbHashTable() : _index(NULL)
 {
   _obj_tbl     = NULL;
   _num_entries = 0;
@@ -57,13 +68,62 @@ dbHashTable<T>::dbHashTable()
 
 template <class T>
 dbHashTable<T>::dbHashTable(const dbHashTable<T>& t)
-    : _hash_tbl(t._hash_tbl), _num_entries(t._num_entries), _obj_tbl(t._obj_tbl)
+    : _hash_tbl(t._hash_tbl),
+      _num_entries(t._num_entries),
+      _obj_tbl(t._obj_tbl),
+      _index(NULL)
 {
 }
 
 template <class T>
 dbHashTable<T>::~dbHashTable()
 {
+  clearIndex();
+}
+
+template <class T>
+dbHashTable<T>& dbHashTable<T>::operator=(const dbHashTable<T>& t)
+{
+  _hash_tbl    = t._hash_tbl;
+  _num_entries = t._num_entries;
+  clearIndex();
+  return *this;
+}
+
+template <class T>
+dbNameIndex<T>* dbHashTable<T>::getIndex()
+{
+  dbNameIndex<T>* index = _index.load(std::memory_order_acquire);
+
+  if (index)
+    return index;
+
+  std::lock_guard<std::mutex> lock(nameIndexMutex());
+  index = _index.load(std::memory_order_relaxed);
+
+  if (index == NULL) {
+    index   = new dbNameIndex<T>(_obj_tbl, _num_entries);
+    uint sz = _hash_tbl.size();
+
+    for (uint i = 0; i < sz; ++i) {
+      for (dbId<T> cur = _hash_tbl[i]; cur != 0;) {
+        T* entry = _obj_tbl->getPtr(cur);
+        index->insert(entry, hash_string(entry->_name));
+        cur = entry->_next_entry;
+      }
+    }
+
+    _index.store(index, std::memory_order_release);
+  }
+
+  return index;
+}
+
+template <class T>
+void dbHashTable<T>::clearIndex()
+{
+  delete _index.load(std::memory_order_relaxed);
+  _index.store(NULL, std::memory_order_relaxed);
 }
 
 template <class T>
@@ -183,64 +243,81 @@ void dbHashTable<T>::insert(T* object)
     }
   }
 
-  uint     hid        = hash_string(object->_name) & (sz - 1);
+  uint     hash       = hash_string(object->_name);
+  uint     hid        = hash & (sz - 1);
   dbId<T>& e          = _hash_tbl[hid];
   object->_next_entry = e;
   e                   = object->getOID();
+
+  dbNameIndex<T>* index = _index.load(std::memory_order_relaxed);
+
+  if (index)
+    index->insert(object, hash);
 }
 
 template <class T>
 T* dbHashTable<T>::find(const char* name)
 {
-  uint sz = _hash_tbl.size();
+  if (_num_entries == 0)
+    return NULL;
 
-  if (sz == 0)
-    return 0;
+  return getIndex()->find(name, hash_string(name));
+}
 
-  uint    hid = hash_string(name) & (sz - 1);
-  dbId<T> cur = _hash_tbl[hid];
+template <class T>
+void dbHashTable<T>::find(const std::vector<std::string>& names,
+                          std::vector<T*>&                objects)
+{
+  objects.assign(names.size(), NULL);
 
-  while (cur != 0) {
-    T* entry = _obj_tbl->getPtr(cur);
+  if (_num_entries == 0)
+    return;
 
-    if (strcmp(entry->_name, name) == 0)
-      return entry;
+  dbNameIndex<T>* index = getIndex();
 
-    cur = entry->_next_entry;
-  }
+  // Hash a group of names and prefetch their slots before probing any of
+  // them, so the cache misses of the group overlap.
+  const size_t group = 16;
+  uint         hashes[group];
+
+  for (size_t begin = 0; begin < names.size(); begin += group) {
+    size_t n = std::min(group, names.size() - begin);
+
+    for (size_t i = 0; i < n; ++i) {
+      hashes[i] = hash_string(names[begin + i].c_str());
+      index->prefetch(hashes[i]);
+    }
 
-  return NULL;
+    for (size_t i = 0; i < n; ++i)
+      objects[begin + i] = index->find(names[begin + i].c_str(), hashes[i]);
+  }
 }
 
 template <class T>
 int dbHashTable<T>::hasMember(const char* name)
 {
-  uint sz = _hash_tbl.size();
-
-  if (sz == 0)
-    return false;
-
-  uint    hid = hash_string(name) & (sz - 1);
-  dbId<T> cur = _hash_tbl[hid];
-
-  while (cur != 0) {
-    T* entry = _obj_tbl->getPtr(cur);
+  return find(name) != NULL;
+}
 
-    if (strcmp(entry->_name, name) == 0)
-      return true;
+template <class T>
+void dbHashTable<T>::getIndexMemoryUsage(uint64& used, uint64& wasted) const
+{
+  used   = 0;
+  wasted = 0;
 
-    cur = entry->_next_entry;
-  }
+  dbNameIndex<T>* index = _index.load(std::memory_order_acquire);
 
-  return false;
+  if (index)
+    index->getMemoryUsage(used, wasted);
 }
 
 template <class T>
 void dbHashTable<T>::remove(T* object)
 {
-  uint    sz  = _hash_tbl.size();
-  uint    hid = hash_string(object->_name) & (sz - 1);
-  dbId<T> cur = _hash_tbl[hid];
+  uint    sz   = _hash_tbl.size();
+  uint    hash = hash_string(object->_name);
+  uint    hid  = hash & (sz - 1);
+  dbId<T> cur  = _hash_tbl[hid];
   dbId<T> prev;
 
   while (cur != 0) {
@@ -256,6 +333,11 @@ void dbHashTable<T>::remove(T* object)
 
       --_num_entries;
 
+      dbNameIndex<T>* index = _index.load(std::memory_order_relaxed);
+
+      if (index)
+        index->remove(object, hash);
+
       uint r = (_num_entries + _num_entries / 10) / sz;
 
       if ((r < (CHAIN_LENGTH >> 1)) && (sz > 1))
@@ -282,6 +364,7 @@ dbIStream& operator>>(dbIStream& stream, dbHashTable<T>& table)
 {
   stream >> table._hash_tbl;
   stream >> table._num_entries;
+  table.clearIndex();
   return stream;
 }
 
@@ -465,8 +465,7 @@ void dbInst::setOrigin(int x, int y)
   //Do Nothin if same origin, But What if uninitialized and x=y=0
   if(prev_x==x&&prev_y==y)
     return;
-  for(auto callback:block->_callbacks)
-    callback->inDbPreMoveInst(this);
+  block->preMoveInst(this);
 
   inst->_x = x;
   inst->_y = y;
@@ -486,8 +485,39 @@ void dbInst::setOrigin(int x, int y)
   }
   
   block->_flags._valid_bbox=0;
-  for(auto callback:block->_callbacks)
-    callback->inDbPostMoveInst(this);  
+  block->postMoveInst(this);
+}
+
+void _dbInst::setPlacement(int x, int y, dbOrientType::Value orient)
+{
+  _dbBlock* block      = (_dbBlock*) getOwner();
+  int       prev_x     = _x;
+  int       prev_y     = _y;
+  uint      prev_flags = flagsToUInt(this);
+
+  _x              = x;
+  _y              = y;
+  _flags._orient  = orient;
+  setInstBBox(this);
+
+  if (block->_journal) {
+    debugPrint(getLogger(), utl::ODB, "DB_ECO", 1, "ECO: setPlacement {}, {}", x, y);
+    // Only the fields that changed are journaled, as setOrient and
+    // setOrigin would.
+    if (flagsToUInt(this) != prev_flags)
+      block->_journal->updateField((dbInst*) this, _dbInst::FLAGS, prev_flags, flagsToUInt(this));
+    if ((_x != prev_x) || (_y != prev_y)) {
+      block->_journal->beginAction(dbJournal::UPDATE_FIELD);
+      block->_journal->pushParam(getObjectType());
+      block->_journal->pushParam(getId());
+      block->_journal->pushParam(_dbInst::ORIGIN);
+      block->_journal->pushParam(prev_x);
+      block->_journal->pushParam(prev_y);
+      block->_journal->pushParam(_x);
+      block->_journal->pushParam(_y);
+      block->_journal->endAction();
+    }
+  }
 }
 
 void dbInst::setLocationOrient(dbOrientType orient)
@@ -537,24 +567,18 @@ void dbInst::setOrient(dbOrientType orient)
     return;
   _dbInst*  inst  = (_dbInst*) this;
   _dbBlock* block = (_dbBlock*) inst->getOwner();
-  for(auto callback:block->_callbacks)
-    callback->inDbPreMoveInst(this);  
-#ifdef FULL_ECO
+  block->preMoveInst(this);
   uint prev_flags = flagsToUInt(inst);
-#endif
   inst->_flags._orient = orient.getValue();
   setInstBBox(inst);
 
-#ifdef FULL_ECO
   if (block->_journal) {
     debugPrint(getImpl()->getLogger(), utl::ODB, "DB_ECO", 1, "ECO: setOrient {}", orient.getValue());
     block->_journal->updateField(this, _dbInst::FLAGS, prev_flags, flagsToUInt(inst));
   }
-#endif
   
   block->_flags._valid_bbox = 0;
-  for(auto callback:block->_callbacks)
-    callback->inDbPostMoveInst(this); 
+  block->postMoveInst(this);
 
 }
 
@@ -568,16 +592,14 @@ void dbInst::setPlacementStatus(dbPlacementStatus status)
 {
   _dbInst* inst = (_dbInst*) this;
   //_dbBlock * block = (_dbBlock *) getOwner();
-  // uint prev_flags = flagsToUInt(inst);
+  uint prev_flags = flagsToUInt(inst);
   inst->_flags._status = status.getValue();
   _dbBlock*  block =(_dbBlock*) getBlock();
   block->_flags._valid_bbox = 0;
-#ifdef FULL_ECO
   if (block->_journal) {
     debugPrint(getImpl()->getLogger(), utl::ODB, "DB_ECO", 1, "ECO: setPlacementStatus {}", status.getValue());
     block->_journal->updateField(this, _dbInst::FLAGS, prev_flags, flagsToUInt(inst));
   }
-#endif
 }
 
 void dbInst::getTransform(dbTransform& t)
@@ -1428,6 +1450,10 @@ void dbInst::destroy(dbInst* inst_)
        ++cbitr)
     (**cbitr)().inDbInstDestroy(inst_);  // client ECO optimization - payam
 
+  // a destroyed instance is not reported by an open callback batch
+  if (block->_callback_batch_cnt > 0)
+    block->_batch_moved_ids.erase(inst->getId());
+
   _dbMaster*  master   = (_dbMaster*) inst_->getMaster();
   _dbInstHdr* inst_hdr = block->_inst_hdr_hash.find(master->_id);
   inst_hdr->_inst_cnt--;
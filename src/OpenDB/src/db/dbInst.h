@@ -111,6 +111,10 @@ class _dbInst : public _dbObject
   bool operator<(const _dbInst& rhs) const;
   void differences(dbDiff& diff, const char* field, const _dbInst& rhs) const;
   void out(dbDiff& diff, char side, const char* field) const;
+
+  // Set the origin and orientation without invoking the block callbacks
+  // (see dbBlock::setInstPlacement).
+  void setPlacement(int x, int y, dbOrientType::Value orient);
 };
 
 dbOStream& operator<<(dbOStream& stream, const _dbInst& inst);
@@ -75,6 +75,7 @@ class dbIntHashTable
   dbIntHashTable();
   dbIntHashTable(const dbIntHashTable<T>& t);
   ~dbIntHashTable();
+  dbIntHashTable<T>& operator=(const dbIntHashTable<T>& t);
   bool operator==(const dbIntHashTable<T>& rhs) const;
   bool operator!=(const dbIntHashTable<T>& rhs) const
   {
@@ -67,6 +67,14 @@ dbIntHashTable<T>::~dbIntHashTable()
 {
 }
 
+template <class T>
+dbIntHashTable<T>& dbIntHashTable<T>::operator=(const dbIntHashTable<T>& t)
+{
+  _hash_tbl    = t._hash_tbl;
+  _num_entries = t._num_entries;
+  return *this;
+}
+
 template <class T>
 bool dbIntHashTable<T>::operator==(const dbIntHashTable<T>& rhs) const
 {
@@ -48,15 +48,37 @@ void invalidateTiming(dbInst* inst);
 void invalidateTiming(dbNet* net);
 
 dbJournal::dbJournal(dbBlock* block)
-    : _block(block), _logger(block->getImpl()->getLogger()), _start_action(false), _action_idx(0), _cur_action(0)
+    : _block(block), _logger(block->getImpl()->getLogger()), _start_action(false), _action_idx(0), _cur_action(0),
+      _watcher(NULL)
 {
 }
 
 dbJournal::~dbJournal()
 {
+  stopWatching();
   clear();
 }
 
+void dbJournal::watchUnrecordedEdits()
+{
+  if (_watcher == NULL) {
+    _watcher = new dbJournalWatcher;
+    _watcher->addOwner(_block);
+  }
+}
+
+void dbJournal::stopWatching()
+{
+  // The destructor detaches the watcher from the block.
+  delete _watcher;
+  _watcher = NULL;
+}
+
+bool dbJournal::hasUnrecordedEdits() const
+{
+  return _watcher && _watcher->edited();
+}
+
 void dbJournal::clear()
 {
   _log.clear();
@@ -741,6 +763,7 @@ void dbJournal::redo_updateInstField()
     case _dbInst::FLAGS: {
       uint prev_flags;
       _log.pop(prev_flags);
+      dbOrientType orient(inst->_flags._orient);
       uint* flags = (uint*) &inst->_flags;
       _log.pop(*flags);
       debugPrint(_logger, utl::ODB, "DB_ECO", 2,
@@ -748,6 +771,12 @@ void dbJournal::redo_updateInstField()
             inst_id,
             prev_flags,
             *flags);
+      // The instance bbox follows the orientation.
+      dbOrientType new_orient(inst->_flags._orient);
+      if (new_orient != orient) {
+        inst->_flags._orient = orient.getValue();
+        ((dbInst*) inst)->setOrient(new_orient);
+      }
       break;
     }
 
@@ -756,15 +785,19 @@ void dbJournal::redo_updateInstField()
       _log.pop(prev_x);
       int prev_y;
       _log.pop(prev_y);
-      _log.pop(inst->_x);
-      _log.pop(inst->_y);
+      int x;
+      _log.pop(x);
+      int y;
+      _log.pop(y);
       debugPrint(_logger, utl::ODB, "DB_ECO", 2,
             "REDO ECO: dbInst {}, origin: {},{} to {},{}",
             inst_id,
             prev_x,
             prev_y,
-            inst->_x,
-            inst->_y);
+            x,
+            y);
+      // setOrigin updates the instance bbox.
+      ((dbInst*) inst)->setOrigin(x, y);
       break;
     }
 
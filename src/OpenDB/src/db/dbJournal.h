@@ -34,6 +34,7 @@
 
 #include "dbJournalLog.h"
 #include "odb.h"
+#include "opendb/dbBlockCallBackObj.h"
 
 namespace utl {
   class Logger;
@@ -49,14 +50,61 @@ class dbNet;
 class dbInst;
 class dbITerm;
 
+//
+// dbJournalWatcher - Notes the block edits the journal cannot record
+// (wires, special wires, bterms, pins, obstructions, rows, fills,
+// regions and snapshot rollbacks), so that a delta written from the
+// journal is known to be incomplete.
+//
+class dbJournalWatcher : public dbBlockCallBackObj
+{
+  bool _edited;
+
+  void edit() { _edited = true; }
+
+ public:
+  dbJournalWatcher() : _edited(false) {}
+
+  bool edited() const { return _edited; }
+
+  void inDbBTermCreate(dbBTerm*) override { edit(); }
+  void inDbBTermDestroy(dbBTerm*) override { edit(); }
+  void inDbBTermPostConnect(dbBTerm*) override { edit(); }
+  void inDbBTermPostDisConnect(dbBTerm*, dbNet*) override { edit(); }
+  void inDbBPinCreate(dbBPin*) override { edit(); }
+  void inDbBPinDestroy(dbBPin*) override { edit(); }
+  void inDbBlockageCreate(dbBlockage*) override { edit(); }
+  void inDbObstructionCreate(dbObstruction*) override { edit(); }
+  void inDbObstructionDestroy(dbObstruction*) override { edit(); }
+  void inDbRegionCreate(dbRegion*) override { edit(); }
+  void inDbRegionDestroy(dbRegion*) override { edit(); }
+  void inDbRowCreate(dbRow*) override { edit(); }
+  void inDbRowDestroy(dbRow*) override { edit(); }
+  void inDbWireCreate(dbWire*) override { edit(); }
+  void inDbWireDestroy(dbWire*) override { edit(); }
+  void inDbWirePostAttach(dbWire*) override { edit(); }
+  void inDbWirePostDetach(dbWire*, dbNet*) override { edit(); }
+  void inDbWirePostAppend(dbWire*, dbWire*) override { edit(); }
+  void inDbWirePostCopy(dbWire*, dbWire*) override { edit(); }
+  void inDbWirePostModify(dbWire*) override { edit(); }
+  void inDbSWireCreate(dbSWire*) override { edit(); }
+  void inDbSWireDestroy(dbSWire*) override { edit(); }
+  void inDbSWirePostDestroySBoxes(dbSWire*) override { edit(); }
+  void inDbSBoxCreate(dbSBox*) override { edit(); }
+  void inDbFillCreate(dbFill*) override { edit(); }
+  void inDbFillDestroy(dbFill*) override { edit(); }
+  void inDbBlockRollback(dbBlock*) override { edit(); }
+};
+
 class dbJournal
 {
-  dbJournalLog  _log;
-  dbBlock*      _block;
-  utl::Logger*  _logger;
-  bool          _start_action;
-  uint          _action_idx;
-  unsigned char _cur_action;
+  dbJournalLog      _log;
+  dbBlock*          _block;
+  utl::Logger*      _logger;
+  bool              _start_action;
+  uint              _action_idx;
+  unsigned char     _cur_action;
+  dbJournalWatcher* _watcher;
 
   void redo_createObject();
   void redo_deleteObject();
@@ -176,6 +224,11 @@ class dbJournal
 
   bool empty() { return _log.empty(); }
 
+  // Watch the block for edits the journal does not record.
+  void watchUnrecordedEdits();
+  void stopWatching();
+  bool hasUnrecordedEdits() const;
+
   friend dbIStream& operator>>(dbIStream& stream, dbJournal& jrnl);
   friend dbOStream& operator<<(dbOStream& stream, const dbJournal& jrnl);
   friend class dbDatabase;
@@ -43,6 +43,9 @@
 namespace odb {
 static char _ath_logbuffer[1024 * 8];
 
+// Where the calling thread's messages go while captureMessages is active.
+static thread_local std::vector<dbLogMessage>* _ath_capture = NULL;
+
 typedef struct deb_rec
 {
   char* mod;
@@ -260,11 +263,50 @@ int ade(int code, const char* msg, ...)
     return TCL_ERROR;
 }
 
+static void captureMessage(dbLogMessage::Type type,
+                           int               code,
+                           const char*       msg,
+                           va_list           args)
+{
+  char buffer[1024 * 8];
+  vsnprintf(buffer, sizeof(buffer), msg, args);
+  _ath_capture->push_back({type, code, msg, buffer});
+}
+
+void captureMessages(std::vector<dbLogMessage>* messages)
+{
+  _ath_capture = messages;
+}
+
+void replayMessages(const std::vector<dbLogMessage>& messages)
+{
+  for (const dbLogMessage& m : messages) {
+    switch (m._type) {
+      case dbLogMessage::NOTICE_MSG:
+        fprintf(stderr, "Notice %d: %s", m._code, m._text.c_str());
+        break;
+      case dbLogMessage::WARNING_MSG:
+        if (checkWarning(m._format) != 1)
+          fprintf(stderr, "Warning %d: %s", m._code, m._text.c_str());
+        break;
+      case dbLogMessage::ERROR_MSG:
+        fprintf(stderr, "Error %d: %s", m._code, m._text.c_str());
+        break;
+    }
+  }
+}
+
 int notice(int code, const char* msg, ...)
 {
   va_list args;
   va_start(args, msg);
 
+  if (_ath_capture) {
+    captureMessage(dbLogMessage::NOTICE_MSG, code, msg, args);
+    va_end(args);
+    return TCL_OK;
+  }
+
   vsnprintf(_ath_logbuffer, sizeof(_ath_logbuffer), msg, args);
   va_end(args);
 
@@ -307,10 +349,18 @@ int info(int code, const char* msg, ...)
 
 int warning(int code, const char* msg, ...)
 {
+  va_list args;
+
+  if (_ath_capture) {
+    va_start(args, msg);
+    captureMessage(dbLogMessage::WARNING_MSG, code, msg, args);
+    va_end(args);
+    return TCL_OK;
+  }
+
   if (checkWarning(msg) == 1)
     return TCL_OK;
 
-  va_list args;
   va_start(args, msg);
 
   vsnprintf(_ath_logbuffer, sizeof(_ath_logbuffer), msg, args);
@@ -327,6 +377,12 @@ void error(int code, const char* msg, ...)
   va_list args;
   va_start(args, msg);
 
+  if (_ath_capture) {
+    captureMessage(dbLogMessage::ERROR_MSG, code, msg, args);
+    va_end(args);
+    return;
+  }
+
   vsnprintf(_ath_logbuffer, sizeof(_ath_logbuffer), msg, args);
   va_end(args);
 
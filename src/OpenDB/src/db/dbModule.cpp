@@ -56,7 +56,10 @@ template class dbTable<_dbModule>;
 
 bool _dbModule::operator==(const _dbModule& rhs) const
 {
-  if (_name != rhs._name)
+  if (_name && rhs._name) {
+    if (strcmp(_name, rhs._name) != 0)
+      return false;
+  } else if (_name || rhs._name)
     return false;
 
   if (_next_entry != rhs._next_entry)
@@ -0,0 +1,196 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2019, Nefelus Inc
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <string.h>
+
+#include <vector>
+
+#include "dbTable.h"
+#include "odb.h"
+
+namespace odb {
+
+//////////////////////////////////////////////////////////
+///
+/// dbNameIndex - open addressing index of named-objects.
+///
+/// A flat table of (name hash, object id) slots with linear probing, kept
+/// at most half full. A lookup walks adjacent slots and only fetches an
+/// object to compare its name when the full hash matches. Removal shifts
+/// the following slots back, so there are no tombstones.
+///
+/// The index is not persistent; dbHashTable builds it from its chains on
+/// the first lookup.
+///
+//////////////////////////////////////////////////////////
+template <class T>
+class dbNameIndex
+{
+ public:
+  dbNameIndex(dbTable<T>* table, uint num_entries);
+
+  T*   find(const char* name, uint hash) const;
+  void insert(T* object, uint hash);
+  void remove(T* object, uint hash);
+
+  // Start loading the first slot probed for hash.
+  void prefetch(uint hash) const { __builtin_prefetch(&_slots[home(hash)]); }
+
+  void getMemoryUsage(uint64& used, uint64& wasted) const;
+
+ private:
+  struct Slot
+  {
+    uint _hash;
+    uint _id;  // zero if the slot is empty
+  };
+
+  // Fibonacci hashing spreads the low-entropy bits of the string hash.
+  uint home(uint hash) const { return (hash * 2654435769U) >> _shift; }
+  void resize(uint capacity);
+
+  dbTable<T>*       _obj_tbl;
+  std::vector<Slot> _slots;
+  uint              _mask;
+  uint              _shift;
+  uint              _size;
+};
+
+template <class T>
+inline dbNameIndex<T>::dbNameIndex(dbTable<T>* table, uint num_entries)
+    : _obj_tbl(table), _mask(0), _shift(32), _size(0)
+{
+  uint capacity = 16;
+
+  while (capacity < 2 * num_entries)
+    capacity <<= 1;
+
+  resize(capacity);
+}
+
+template <class T>
+inline void dbNameIndex<T>::resize(uint capacity)
+{
+  std::vector<Slot> slots(capacity, Slot{0, 0});
+  _slots.swap(slots);
+  _mask  = capacity - 1;
+  _shift = 32;
+
+  for (uint c = capacity; c > 1; c >>= 1)
+    --_shift;
+
+  for (const Slot& slot : slots) {
+    if (slot._id == 0)
+      continue;
+
+    uint i = home(slot._hash);
+
+    while (_slots[i]._id != 0)
+      i = (i + 1) & _mask;
+
+    _slots[i] = slot;
+  }
+}
+
+template <class T>
+inline T* dbNameIndex<T>::find(const char* name, uint hash) const
+{
+  for (uint i = home(hash);; i = (i + 1) & _mask) {
+    const Slot& slot = _slots[i];
+
+    if (slot._id == 0)
+      return NULL;
+
+    if (slot._hash == hash) {
+      T* entry = _obj_tbl->getPtr(slot._id);
+
+      if (strcmp(entry->_name, name) == 0)
+        return entry;
+    }
+  }
+}
+
+template <class T>
+inline void dbNameIndex<T>::insert(T* object, uint hash)
+{
+  if (2 * (_size + 1) > _slots.size())
+    resize(2 * _slots.size());
+
+  uint i = home(hash);
+
+  while (_slots[i]._id != 0)
+    i = (i + 1) & _mask;
+
+  _slots[i]._hash = hash;
+  _slots[i]._id   = object->getOID();
+  ++_size;
+}
+
+template <class T>
+inline void dbNameIndex<T>::remove(T* object, uint hash)
+{
+  uint id = object->getOID();
+  uint i  = home(hash);
+
+  for (;; i = (i + 1) & _mask) {
+    if (_slots[i]._id == 0)
+      return;
+
+    if (_slots[i]._id == id)
+      break;
+  }
+
+  // Move back every following slot of the run that may live in the hole,
+  // i.e. whose home is not cyclically in (hole, slot].
+  for (uint j = (i + 1) & _mask; _slots[j]._id != 0; j = (j + 1) & _mask) {
+    uint k = home(_slots[j]._hash);
+
+    if (((j - k) & _mask) >= ((j - i) & _mask)) {
+      _slots[i] = _slots[j];
+      i         = j;
+    }
+  }
+
+  _slots[i] = Slot{0, 0};
+  --_size;
+}
+
+template <class T>
+inline void dbNameIndex<T>::getMemoryUsage(uint64& used, uint64& wasted) const
+{
+  used   = _size * sizeof(Slot);
+  wasted = (_slots.capacity() - _size) * sizeof(Slot);
+}
+
+}  // namespace odb
@@ -1585,6 +1585,7 @@ dbWire* dbNet::getWire()
   if (net->_wire == 0)
     return NULL;
 
+  block->loadWires();
   return (dbWire*) block->_wire_tbl->getPtr(net->_wire);
 }
 
@@ -1596,6 +1597,7 @@ dbWire* dbNet::getGlobalWire()
   if (net->_global_wire == 0)
     return NULL;
 
+  block->loadWires();
   return (dbWire*) block->_wire_tbl->getPtr(net->_global_wire);
 }
 
@@ -1781,6 +1783,7 @@ dbSet<dbRSeg> dbNet::getRSegs()
 {
   _dbNet*   net   = (_dbNet*) this;
   _dbBlock* block = (_dbBlock*) net->getOwner();
+  block->loadParasitics();
   return dbSet<dbRSeg>(net, block->_r_seg_itr);
 }
 
@@ -2168,6 +2171,7 @@ dbSet<dbCapNode> dbNet::getCapNodes()
 {
   _dbNet*   net   = (_dbNet*) this;
   _dbBlock* block = (_dbBlock*) net->getOwner();
+  block->loadParasitics();
   return dbSet<dbCapNode>(net, block->_cap_node_itr);
 }
 
@@ -2768,6 +2772,7 @@ void dbNet::destroy(dbNet* net_)
     sitr = dbSWire::destroy(sitr);
 
   if (net->_wire != 0) {
+    block->loadWires();
     dbWire* wire = (dbWire*) block->_wire_tbl->getPtr(net->_wire);
     dbWire::destroy(wire);
   }
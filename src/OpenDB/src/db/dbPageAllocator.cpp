@@ -0,0 +1,190 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2019, Nefelus Inc
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "dbPageAllocator.h"
+
+#include <stdlib.h>
+#include <sys/mman.h>
+
+#include <algorithm>
+#include <atomic>
+
+#include "ZException.h"
+
+namespace odb {
+
+namespace {
+
+class dbMallocPageAllocator : public dbPageAllocator
+{
+ public:
+  void* allocate(size_t size) override
+  {
+    void* page = malloc(size);
+    ZALLOCATED(page);
+    return page;
+  }
+
+  void deallocate(void* page, size_t size) override { free(page); }
+};
+
+dbMallocPageAllocator         malloc_allocator;
+std::atomic<dbPageAllocator*> page_allocator(&malloc_allocator);
+
+const size_t huge_page_size = 2 << 20;
+const size_t page_alignment = 64;
+
+}  // namespace
+
+dbPageAllocator* getMallocPageAllocator()
+{
+  return &malloc_allocator;
+}
+
+dbPageAllocator* getPageAllocator()
+{
+  return page_allocator;
+}
+
+void setPageAllocator(dbPageAllocator* allocator)
+{
+  page_allocator = allocator ? allocator : &malloc_allocator;
+}
+
+////////////////////////////////////////////////////////////////////
+//
+// dbHugePageArena
+//
+////////////////////////////////////////////////////////////////////
+
+dbHugePageArena::dbHugePageArena(size_t chunk_size)
+    : _next(NULL), _end(NULL), _allocated(0)
+{
+  chunk_size  = std::max(chunk_size, huge_page_size);
+  _chunk_size = (chunk_size + huge_page_size - 1) & ~(huge_page_size - 1);
+}
+
+dbHugePageArena::~dbHugePageArena()
+{
+  for (char* chunk : _chunks)
+    munmap(chunk, _chunk_size);
+}
+
+size_t dbHugePageArena::roundSize(size_t size)
+{
+  return (size + page_alignment - 1) & ~(page_alignment - 1);
+}
+
+void* dbHugePageArena::allocate(size_t size)
+{
+  size = roundSize(size);
+
+  if (size > _chunk_size / 4) {
+    void* page = malloc(size);
+    ZALLOCATED(page);
+    std::lock_guard<std::mutex> lock(_mutex);
+    _allocated += size;
+    return page;
+  }
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  _allocated += size;
+
+  // Recycle a freed page of this size
+  auto free_list = _free_lists.find(size);
+  if (free_list != _free_lists.end() && free_list->second) {
+    void* page        = free_list->second;
+    free_list->second = *(void**) page;
+    return page;
+  }
+
+  if ((size_t) (_end - _next) < size) {
+    // Map one huge page more than needed so the chunk can start on a huge
+    // page boundary, then give back the ends.
+    size_t map_size = _chunk_size + huge_page_size;
+    char*  map      = (char*) mmap(NULL,
+                             map_size,
+                             PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS,
+                             -1,
+                             0);
+    if (map == MAP_FAILED) {
+      _allocated -= size;
+      throw ZOutOfMemory();
+    }
+
+    char* chunk = (char*) (((uintptr_t) map + huge_page_size - 1)
+                           & ~(uintptr_t) (huge_page_size - 1));
+    if (chunk > map)
+      munmap(map, chunk - map);
+    if (map + map_size > chunk + _chunk_size)
+      munmap(chunk + _chunk_size, map + map_size - (chunk + _chunk_size));
+#ifdef MADV_HUGEPAGE
+    madvise(chunk, _chunk_size, MADV_HUGEPAGE);
+#endif
+
+    _chunks.push_back(chunk);
+    _next = chunk;
+    _end  = chunk + _chunk_size;
+  }
+
+  void* page = _next;
+  _next += size;
+  return page;
+}
+
+void dbHugePageArena::deallocate(void* page, size_t size)
+{
+  size = roundSize(size);
+
+  if (size > _chunk_size / 4) {
+    free(page);
+    std::lock_guard<std::mutex> lock(_mutex);
+    _allocated -= size;
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  _allocated -= size;
+  void*& free_list = _free_lists[size];
+  *(void**) page   = free_list;
+  free_list        = page;
+}
+
+void dbHugePageArena::getUsage(uint64& mapped, uint64& allocated) const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  mapped    = (uint64) _chunks.size() * _chunk_size;
+  allocated = _allocated;
+}
+
+}  // namespace odb
@@ -32,8 +32,11 @@
 
 #pragma once
 
+#include <memory>
+
 #include "ZException.h"
 #include "dbDiff.h"
+#include "dbPageAllocator.h"
 #include "dbStream.h"
 #include "odb.h"
 namespace odb {
@@ -54,10 +57,11 @@ template <class T, const uint page_size = 128, const uint page_shift = 7>
 class dbPagedVector
 {
  private:
-  T**          _pages;
-  unsigned int _page_cnt;
-  unsigned int _page_tbl_size;
-  unsigned int _next_idx;
+  T**              _pages;
+  dbPageAllocator* _allocator;  // source of the pages
+  unsigned int     _page_cnt;
+  unsigned int     _page_tbl_size;
+  unsigned int     _next_idx;
 
   int _freedIdxHead;  // DKF - to delete
   int _freedIdxTail;  // DKF - to delete
@@ -70,6 +74,9 @@ class dbPagedVector
   dbPagedVector(const dbPagedVector<T, page_size, page_shift>& V);
   ~dbPagedVector();
 
+  dbPagedVector<T, page_size, page_shift>& operator=(
+      const dbPagedVector<T, page_size, page_shift>& V);
+
   void push_back(const T& item);
 
   uint push_back(int cnt, const T& item)
@@ -82,6 +89,16 @@ class dbPagedVector
   }
 
   unsigned int size() const { return _next_idx; }
+
+  // Bytes held by the elements, and by the unused part of the pages and of
+  // the page-table.
+  void getMemoryUsage(uint64& used, uint64& wasted) const
+  {
+    used   = (uint64) _next_idx * sizeof(T) + (uint64) _page_cnt * sizeof(T*);
+    wasted = ((uint64) _page_cnt * page_size - _next_idx) * sizeof(T)
+             + (uint64) (_page_tbl_size - _page_cnt) * sizeof(T*);
+  }
+
   unsigned int getIdx(uint chunkSize, const T& ival);  // DKF - to delete
   void         freeIdx(uint idx);                      // DKF - to delete
   void         clear();
@@ -163,6 +180,7 @@ template <class T, const uint P, const uint S>
 dbPagedVector<T, P, S>::dbPagedVector()
 {
   _pages         = NULL;
+  _allocator     = getPageAllocator();
   _page_cnt      = 0;
   _page_tbl_size = 0;
   _next_idx      = 0;
@@ -173,6 +191,7 @@ template <class T, const uint P, const uint S>
 dbPagedVector<T, P, S>::dbPagedVector(const dbPagedVector<T, P, S>& V)
 {
   _pages         = NULL;
+  _allocator     = getPageAllocator();
   _page_cnt      = 0;
   _page_tbl_size = 0;
   _next_idx      = 0;
@@ -185,14 +204,32 @@ dbPagedVector<T, P, S>::dbPagedVector(const dbPagedVector<T, P, S>& V)
   }
 }
 
+template <class T, const uint P, const uint S>
+dbPagedVector<T, P, S>& dbPagedVector<T, P, S>::operator=(
+    const dbPagedVector<T, P, S>& V)
+{
+  if (this == &V)
+    return *this;
+
+  clear();
+  uint sz = V.size();
+
+  for (uint i = 0; i < sz; ++i)
+    push_back(V[i]);
+
+  return *this;
+}
+
 template <class T, const uint P, const uint S>
 void dbPagedVector<T, P, S>::clear()
 {
   if (_pages) {
     unsigned int i;
 
-    for (i = 0; i < _page_cnt; ++i)
-      delete[] _pages[i];
+    for (i = 0; i < _page_cnt; ++i) {
+      std::destroy_n(_pages[i], P);
+      _allocator->deallocate(_pages[i], P * sizeof(T));
+    }
 
     delete[] _pages;
   }
@@ -238,8 +275,8 @@ void dbPagedVector<T, P, S>::resizePageTbl()
 template <class T, const uint P, const uint S>
 void dbPagedVector<T, P, S>::newPage()
 {
-  T* page = new T[P];
-  ZALLOCATED(page);
+  T* page = (T*) _allocator->allocate(P * sizeof(T));
+  std::uninitialized_default_construct_n(page, P);
 
   if (_page_tbl_size == 0) {
     _pages = new T*[1];
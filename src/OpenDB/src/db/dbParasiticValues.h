@@ -0,0 +1,422 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2019, Nefelus Inc
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+#include "dbPagedVector.h"
+#include "odb.h"
+
+namespace odb {
+
+//
+// dbParasiticValues - The per-corner resistance and capacitance values of
+// the parasitic objects of a block. The values are kept in one column per
+// kind (see _dbBlock::_r_val_tbl, _c_val_tbl, _cc_val_tbl), either as
+// 32 bit floats, or, when compact, as IEEE 754 16 bit floats.
+//
+// A compact column is scaled by a power of two, chosen in the middle of
+// the scales that keep the magnitudes of its nonzero values between the
+// smallest normal 16 bit float, 2^-14, and the largest one. The scale is
+// changed, and the column rescaled, when a value falls outside of them.
+// Only a column whose values span more than 2^28 goes back to 32 bit
+// floats.
+//
+class dbParasiticValues
+{
+ public:
+  // Proxy returned by the non-const operator[], so that the values can be
+  // used as floats whatever their storage.
+  class reference
+  {
+   public:
+    reference(dbParasiticValues* values, uint id) : _values(values), _id(id)
+    {
+    }
+    operator float() const { return _values->get(_id); }
+    reference& operator=(float value)
+    {
+      _values->set(_id, value);
+      return *this;
+    }
+    reference& operator=(const reference& r) { return *this = (float) r; }
+    reference& operator+=(float value) { return *this = (float) *this + value; }
+    reference& operator-=(float value) { return *this = (float) *this - value; }
+    reference& operator*=(float value) { return *this = (float) *this * value; }
+
+   private:
+    dbParasiticValues* _values;
+    uint               _id;
+  };
+
+  dbParasiticValues()
+      : _compact(false), _scale(0), _min_exp(INT_MAX), _max_exp(INT_MIN)
+  {
+  }
+
+  bool isCompact() const { return _compact; }
+
+  // Convert the values to 16 or 32 bit floats. Returns false, leaving the
+  // values unchanged, if they span too many powers of two for a scaled
+  // 16 bit float.
+  bool setCompact(bool compact)
+  {
+    if (compact == _compact)
+      return true;
+
+    if (compact) {
+      int  min_exp = INT_MAX;
+      int  max_exp = INT_MIN;
+      uint sz      = _values.size();
+      for (uint i = 0; i < sz; ++i) {
+        int exp;
+        if (getExp(_values[i], exp)) {
+          min_exp = std::min(min_exp, exp);
+          max_exp = std::max(max_exp, exp);
+        }
+      }
+      if (!setRange(min_exp, max_exp))
+        return false;
+      for (uint i = 0; i < sz; ++i)
+        _half.push_back(toHalf(_values[i]));
+      _values.clear();
+    } else {
+      uint sz = _half.size();
+      for (uint i = 0; i < sz; ++i)
+        _values.push_back(fromHalf(_half[i]));
+      _half.clear();
+    }
+
+    _compact = compact;
+    return true;
+  }
+
+  void push_back(float value)
+  {
+    if (_compact)
+      fit(value);
+
+    if (_compact)
+      _half.push_back(toHalf(value));
+    else
+      _values.push_back(value);
+  }
+
+  uint getIdx(uint chunkSize, float ival)
+  {
+    if (_compact)
+      fit(ival);
+
+    if (_compact)
+      return _half.getIdx(chunkSize, toHalf(ival));
+    return _values.getIdx(chunkSize, ival);
+  }
+
+  uint size() const { return _compact ? _half.size() : _values.size(); }
+
+  void clear()
+  {
+    _values.clear();
+    _half.clear();
+    _scale   = 0;
+    _min_exp = INT_MAX;
+    _max_exp = INT_MIN;
+  }
+
+  float get(uint id) const
+  {
+    return _compact ? fromHalf(_half[id]) : _values[id];
+  }
+
+  void set(uint id, float value)
+  {
+    if (_compact)
+      fit(value);
+
+    if (_compact)
+      _half[id] = toHalf(value);
+    else
+      _values[id] = value;
+  }
+
+  float     operator[](uint id) const { return get(id); }
+  reference operator[](uint id) { return reference(this, id); }
+
+  void getMemoryUsage(uint64& used, uint64& wasted) const
+  {
+    if (_compact)
+      _half.getMemoryUsage(used, wasted);
+    else
+      _values.getMemoryUsage(used, wasted);
+  }
+
+  bool operator==(const dbParasiticValues& rhs) const
+  {
+    uint sz = size();
+
+    if (sz != rhs.size())
+      return false;
+
+    for (uint i = 0; i < sz; ++i)
+      if (get(i) != rhs.get(i))
+        return false;
+
+    return true;
+  }
+  bool operator!=(const dbParasiticValues& rhs) const
+  {
+    return !operator==(rhs);
+  }
+
+  void differences(dbDiff&                  diff,
+                   const char*              field,
+                   const dbParasiticValues& rhs) const
+  {
+    uint sz1 = size();
+    uint sz2 = rhs.size();
+    uint i   = 0;
+
+    for (; i < sz1 && i < sz2; ++i) {
+      float o1 = get(i);
+      float o2 = rhs.get(i);
+
+      if (o1 != o2) {
+        diff.report("< %s[%d] = ", field, i);
+        diff << o1;
+        diff << "\n";
+        diff.report("> %s[%d] = ", field, i);
+        diff << o2;
+        diff << "\n";
+      }
+    }
+
+    for (; i < sz1; ++i) {
+      diff.report("< %s[%d] = ", field, i);
+      diff << get(i);
+      diff << "\n";
+    }
+
+    for (; i < sz2; ++i) {
+      diff.report("> %s[%d] = ", field, i);
+      diff << rhs.get(i);
+      diff << "\n";
+    }
+  }
+
+  void out(dbDiff& diff, char side, const char* field) const
+  {
+    uint sz = size();
+
+    for (uint i = 0; i < sz; ++i) {
+      diff.report("%c %s[%d] = ", side, field, i);
+      diff << get(i);
+      diff << "\n";
+    }
+  }
+
+  // Round to nearest even, as the IEEE 754 conversion does.
+  static uint16_t floatToHalf(float value)
+  {
+    uint32_t x;
+    memcpy(&x, &value, sizeof(x));
+    uint16_t sign = (x >> 16) & 0x8000;
+    uint32_t mag  = x & 0x7fffffff;
+
+    // Inf and NaN
+    if (mag >= 0x7f800000)
+      return sign | 0x7c00 | (mag > 0x7f800000 ? 0x200 : 0);
+
+    // Rounds to 65520 or more
+    if (mag >= 0x477ff000)
+      return sign | 0x7c00;
+
+    // Subnormal, or 2^-25 or less
+    if (mag < 0x38800000) {
+      if (mag <= 0x33000000)
+        return sign;
+      uint32_t exp     = mag >> 23;
+      uint32_t man     = (mag & 0x7fffff) | 0x800000;
+      uint32_t shift   = 126 - exp;
+      uint32_t half    = man >> shift;
+      uint32_t rem     = man & ((1u << shift) - 1);
+      uint32_t halfway = 1u << (shift - 1);
+      if (rem > halfway || (rem == halfway && (half & 1)))
+        ++half;
+      return sign | half;
+    }
+
+    uint32_t half = (mag - 0x38000000) >> 13;
+    uint32_t rem  = mag & 0x1fff;
+    if (rem > 0x1000 || (rem == 0x1000 && (half & 1)))
+      ++half;
+    return sign | half;
+  }
+
+  static float halfToFloat(uint16_t half)
+  {
+    uint32_t sign = (uint32_t) (half & 0x8000) << 16;
+    uint32_t exp  = (half >> 10) & 0x1f;
+    uint32_t man  = half & 0x3ff;
+    uint32_t x;
+
+    if (exp == 0) {
+      float value = std::ldexp((float) man, -24);
+      return sign ? -value : value;
+    }
+
+    if (exp == 31)
+      x = sign | 0x7f800000 | (man << 13);
+    else
+      x = sign | ((exp + 112) << 23) | (man << 13);
+
+    float value;
+    memcpy(&value, &x, sizeof(value));
+    return value;
+  }
+
+ private:
+  // Exponents of frexp: the magnitude of a value with exponent e is in
+  // [2^(e-1), 2^e). Scaled by 2^s it is a normal 16 bit float, that does
+  // not round up to Inf, for s in [-13 - e, 15 - e].
+  static const int kMaxExpSpan = 28;
+
+  // Sets the exponent of a finite nonzero value.
+  static bool getExp(float value, int& exp)
+  {
+    if (!std::isfinite(value) || value == 0.0f)
+      return false;
+
+    std::frexp(value, &exp);
+    return true;
+  }
+
+  // Scale for the values with exponents in [min_exp, max_exp], or false if
+  // there is none.
+  bool setRange(int min_exp, int max_exp)
+  {
+    if (min_exp > max_exp) {
+      _scale   = 0;
+      _min_exp = INT_MAX;
+      _max_exp = INT_MIN;
+      return true;
+    }
+
+    if (max_exp - min_exp > kMaxExpSpan)
+      return false;
+
+    _scale   = (2 - min_exp - max_exp) / 2;
+    _min_exp = min_exp;
+    _max_exp = max_exp;
+    return true;
+  }
+
+  // Rescale the compact column, or widen it to 32 bit floats, if value is
+  // outside the exponents it holds.
+  void fit(float value)
+  {
+    int exp;
+    if (!getExp(value, exp) || (exp >= _min_exp && exp <= _max_exp))
+      return;
+
+    int min_exp = std::min(exp, _min_exp);
+    int max_exp = std::max(exp, _max_exp);
+    if (_scale >= -13 - min_exp && _scale <= 15 - max_exp) {
+      _min_exp = min_exp;
+      _max_exp = max_exp;
+      return;
+    }
+
+    int scale = _scale;
+    if (!setRange(min_exp, max_exp)) {
+      setCompact(false);
+      return;
+    }
+
+    // Both scales give normal 16 bit floats, so only the exponents change.
+    uint sz = _half.size();
+    for (uint i = 0; i < sz; ++i)
+      _half[i] = floatToHalf(std::ldexp(halfToFloat(_half[i]), _scale - scale));
+  }
+
+  uint16_t toHalf(float value) const
+  {
+    return floatToHalf(std::ldexp(value, _scale));
+  }
+
+  float fromHalf(uint16_t half) const
+  {
+    return std::ldexp(halfToFloat(half), -_scale);
+  }
+
+  dbPagedVector<float, 4096, 12>    _values;
+  dbPagedVector<uint16_t, 4096, 12> _half;
+  bool                              _compact;
+  int                               _scale;
+  int                               _min_exp;
+  int                               _max_exp;
+};
+
+// The values are streamed as 32 bit floats whatever their storage.
+inline dbOStream& operator<<(dbOStream& stream, const dbParasiticValues& v)
+{
+  uint sz = v.size();
+  stream << sz;
+
+  for (uint i = 0; i < sz; ++i)
+    stream << v.get(i);
+
+  return stream;
+}
+
+inline dbIStream& operator>>(dbIStream& stream, dbParasiticValues& v)
+{
+  v.clear();
+
+  uint sz;
+  stream >> sz;
+
+  for (uint i = 0; i < sz; ++i) {
+    float value;
+    stream >> value;
+    v.push_back(value);
+  }
+
+  return stream;
+}
+
+}  // namespace odb
@@ -167,9 +167,9 @@ void dbRSeg::addRSegCapacitance(dbRSeg* other)
   uint      cornerCnt = ((dbBlock*) block)->getCornerCount();
 
   for (uint corner = 0; corner < cornerCnt; corner++) {
-    float& value
+    dbParasiticValues::reference value
         = (*block->_c_val_tbl)[(seg->getOID() - 1) * cornerCnt + 1 + corner];
-    float& ovalue
+    dbParasiticValues::reference ovalue
         = (*block->_c_val_tbl)[(oseg->getOID() - 1) * cornerCnt + 1 + corner];
     value += ovalue;
   }
@@ -193,9 +193,9 @@ void dbRSeg::addRSegResistance(dbRSeg* other)
   uint      cornerCnt = block->_corners_per_block;
 
   for (uint corner = 0; corner < cornerCnt; corner++) {
-    float& value
+    dbParasiticValues::reference value
         = (*block->_r_val_tbl)[(seg->getOID() - 1) * cornerCnt + 1 + corner];
-    float& ovalue
+    dbParasiticValues::reference ovalue
         = (*block->_r_val_tbl)[(oseg->getOID() - 1) * cornerCnt + 1 + corner];
     value += ovalue;
   }
@@ -218,7 +218,7 @@ void dbRSeg::setResistance(double res, int corner)
   uint      cornerCnt = block->_corners_per_block;
   ZASSERT((corner >= 0) && ((uint) corner < cornerCnt));
 
-  float& value
+  dbParasiticValues::reference value
       = (*block->_r_val_tbl)[(seg->getOID() - 1) * cornerCnt + 1 + corner];
   float prev_value = value;
   value            = (float) res;
@@ -243,7 +243,7 @@ void dbRSeg::adjustResistance(float factor, int corner)
   uint      cornerCnt = block->_corners_per_block;
   ZASSERT((corner >= 0) && ((uint) corner < cornerCnt));
 
-  float& value
+  dbParasiticValues::reference value
       = (*block->_r_val_tbl)[(seg->getOID() - 1) * cornerCnt + 1 + corner];
   float prev_value = value;
   value *= factor;
@@ -285,7 +285,7 @@ void dbRSeg::setCapacitance(double cap, int corner)
     seg->_flags._update_cap = 0;
 
   ZASSERT((corner >= 0) && ((uint) corner < cornerCnt));
-  float& value
+  dbParasiticValues::reference value
       = (*block->_c_val_tbl)[(seg->getOID() - 1) * cornerCnt + 1 + corner];
   float prev_value = value;
   value            = (float) cap;
@@ -325,13 +325,13 @@ void dbRSeg::adjustCapacitance(float factor, uint corner)
     dbCapNode* node  = dbCapNode::getCapNode((dbBlock*) block, seg->_target);
     node->adjustCapacitance(factor, corner);
   } else {
-    float& value
+    dbParasiticValues::reference value
         = (*block->_c_val_tbl)[(seg->getOID() - 1) * cornerCnt + 1 + corner];
     float prev_value = value;
     value *= factor;
 
     if (block->_journal) {
-      debugPrint(getImpl()->getLogger(), utl::ODB, "DB_ECO", 1, "ECO: dbRSeg {}, adjustCapacitance {}, corner {}",seg->getId(),value,0);
+      debugPrint(getImpl()->getLogger(), utl::ODB, "DB_ECO", 1, "ECO: dbRSeg {}, adjustCapacitance {}, corner {}",seg->getId(),(float) value,0);
       block->_journal->beginAction(dbJournal::UPDATE_FIELD);
       block->_journal->pushParam(dbRSegObj);
       block->_journal->pushParam(seg->getId());
@@ -675,9 +675,10 @@ dbRSeg* dbRSeg::create(dbNet* net_,
                        uint   path_dir,
                        bool   allocate_cap)
 {
-  _dbNet*   net       = (_dbNet*) net_;
-  _dbBlock* block     = (_dbBlock*) net->getOwner();
-  uint      cornerCnt = block->_corners_per_block;
+  _dbNet*   net   = (_dbNet*) net_;
+  _dbBlock* block = (_dbBlock*) net->getOwner();
+  block->loadParasitics();
+  uint cornerCnt = block->_corners_per_block;
 
   if (block->_journal) {
     debugPrint(net_->getImpl()->getLogger(), utl::ODB, "DB_ECO", 1, "ECO: dbRSeg create 2, net id {}, x: {}, y: {}, path_dir: {}, ""allocate_cap: {}",net->getId(),x,y,path_dir,allocate_cap);
@@ -868,6 +869,7 @@ dbSet<dbRSeg>::iterator dbRSeg::destroy(dbSet<dbRSeg>::iterator& itr)
 dbRSeg* dbRSeg::getRSeg(dbBlock* block_, uint dbid_)
 {
   _dbBlock* block = (_dbBlock*) block_;
+  block->loadParasitics();
   return (dbRSeg*) block->_r_seg_tbl->getPtr(dbid_);
 }
 
@@ -34,6 +34,7 @@
 
 #include "db.h"
 #include "dbBlock.h"
+#include "dbBlockCallBackObj.h"
 #include "dbBox.h"
 #include "dbDatabase.h"
 #include "dbSWire.h"
@@ -254,7 +255,10 @@ dbSBox* dbSBox::create(dbSWire*        wire_,
   wire->_wires   = box->getOID();
 
   block->add_geom_shape(_geomshape); 
-  
+
+  for (auto callback : block->_callbacks)
+    callback->inDbSBoxCreate((dbSBox*) box);
+
   return (dbSBox*) box;
 }
 
@@ -289,6 +293,10 @@ dbSBox* dbSBox::create(dbSWire*        wire_,
   wire->_wires   = box->getOID();
 
   block->add_rect(box->_shape._rect);
+
+  for (auto callback : block->_callbacks)
+    callback->inDbSBoxCreate((dbSBox*) box);
+
   return (dbSBox*) box;
 }
 
@@ -324,6 +332,10 @@ dbSBox* dbSBox::create(dbSWire*        wire_,
   wire->_wires   = box->getOID();
 
   block->add_rect(box->_shape._rect);
+
+  for (auto callback : block->_callbacks)
+    callback->inDbSBoxCreate((dbSBox*) box);
+
   return (dbSBox*) box;
 }
 
@@ -0,0 +1,345 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, OpenRoad Project
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "dbSpatialIndex.h"
+
+#include "db.h"
+#include "dbShape.h"
+
+namespace odb {
+
+namespace bgi = boost::geometry::index;
+
+dbSpatialIndex::dbSpatialIndex(dbBlock* block)
+{
+  // Collect everything first so each tree is bulk loaded (packed) in one go
+  // rather than built by repeated insertion.
+  std::vector<std::pair<Box, dbInst*>> insts;
+  for (dbInst* inst : block->getInsts()) {
+    Rect rect;
+    inst->getBBox()->getBox(rect);
+    Box box           = makeBox(rect);
+    inst_boxes_[inst] = box;
+    insts.emplace_back(box, inst);
+  }
+  insts_ = Rtree<dbInst*>(insts.begin(), insts.end());
+
+  std::map<dbTechLayer*, std::vector<std::pair<Box, dbNet*>>> shapes;
+  for (dbNet* net : block->getNets()) {
+    Shapes& net_shapes = net_shapes_[net];
+    getNetShapes(net, net_shapes);
+    for (auto& [layer, box] : net_shapes)
+      shapes[layer].emplace_back(box, net);
+  }
+  for (auto& [layer, values] : shapes)
+    shapes_.emplace(layer, Rtree<dbNet*>(values.begin(), values.end()));
+
+  std::map<dbTechLayer*, std::vector<std::pair<Box, dbFill*>>> fills;
+  for (dbFill* fill : block->getFills()) {
+    Rect rect;
+    fill->getRect(rect);
+    fills[fill->getTechLayer()].emplace_back(makeBox(rect), fill);
+  }
+  for (auto& [layer, values] : fills)
+    fills_.emplace(layer, Rtree<dbFill*>(values.begin(), values.end()));
+
+  addOwner(block);
+}
+
+void dbSpatialIndex::searchInsts(const Rect& area, std::vector<dbInst*>& insts)
+{
+  insts.clear();
+  for (auto itr = insts_.qbegin(bgi::intersects(makeBox(area)));
+       itr != insts_.qend();
+       ++itr)
+    insts.push_back(itr->second);
+}
+
+void dbSpatialIndex::searchShapes(dbTechLayer*                          layer,
+                                  const Rect&                           area,
+                                  std::vector<std::pair<Rect, dbNet*>>& shapes)
+{
+  update();
+  shapes.clear();
+  auto rtree = shapes_.find(layer);
+  if (rtree == shapes_.end())
+    return;
+  for (auto itr = rtree->second.qbegin(bgi::intersects(makeBox(area)));
+       itr != rtree->second.qend();
+       ++itr)
+    shapes.emplace_back(makeRect(itr->first), itr->second);
+}
+
+void dbSpatialIndex::searchFills(dbTechLayer*          layer,
+                                 const Rect&           area,
+                                 std::vector<dbFill*>& fills)
+{
+  fills.clear();
+  auto rtree = fills_.find(layer);
+  if (rtree == fills_.end())
+    return;
+  for (auto itr = rtree->second.qbegin(bgi::intersects(makeBox(area)));
+       itr != rtree->second.qend();
+       ++itr)
+    fills.push_back(itr->second);
+}
+
+void dbSpatialIndex::update()
+{
+  if (dirty_nets_.empty())
+    return;
+
+  for (dbNet* net : dirty_nets_) {
+    removeNet(net);
+    Shapes& net_shapes = net_shapes_[net];
+    getNetShapes(net, net_shapes);
+    for (auto& [layer, box] : net_shapes)
+      shapes_[layer].insert(std::make_pair(box, net));
+  }
+  dirty_nets_.clear();
+}
+
+void dbSpatialIndex::addInst(dbInst* inst)
+{
+  Rect rect;
+  inst->getBBox()->getBox(rect);
+  Box box           = makeBox(rect);
+  inst_boxes_[inst] = box;
+  insts_.insert(std::make_pair(box, inst));
+}
+
+void dbSpatialIndex::removeInst(dbInst* inst)
+{
+  auto itr = inst_boxes_.find(inst);
+  if (itr == inst_boxes_.end())
+    return;
+  insts_.remove(std::make_pair(itr->second, inst));
+  inst_boxes_.erase(itr);
+}
+
+void dbSpatialIndex::markNet(dbNet* net)
+{
+  if (net)
+    dirty_nets_.insert(net);
+}
+
+void dbSpatialIndex::removeNet(dbNet* net)
+{
+  auto itr = net_shapes_.find(net);
+  if (itr == net_shapes_.end())
+    return;
+  for (auto& [layer, box] : itr->second)
+    shapes_[layer].remove(std::make_pair(box, net));
+  net_shapes_.erase(itr);
+}
+
+void dbSpatialIndex::getNetShapes(dbNet* net, Shapes& shapes)
+{
+  shapes.clear();
+  std::vector<dbShape> via_boxes;
+
+  dbWire* wire = net->getWire();
+  if (wire) {
+    dbWireShapeItr itr;
+    dbShape        shape;
+    for (itr.begin(wire); itr.next(shape);) {
+      if (shape.isVia()) {
+        dbShape::getViaBoxes(shape, via_boxes);
+        for (dbShape& via_box : via_boxes) {
+          Rect rect;
+          via_box.getBox(rect);
+          shapes.emplace_back(via_box.getTechLayer(), makeBox(rect));
+        }
+      } else {
+        Rect rect;
+        shape.getBox(rect);
+        shapes.emplace_back(shape.getTechLayer(), makeBox(rect));
+      }
+    }
+  }
+
+  for (dbSWire* swire : net->getSWires()) {
+    for (dbSBox* sbox : swire->getWires()) {
+      if (sbox->isVia()) {
+        sbox->getViaBoxes(via_boxes);
+        for (dbShape& via_box : via_boxes) {
+          Rect rect;
+          via_box.getBox(rect);
+          shapes.emplace_back(via_box.getTechLayer(), makeBox(rect));
+        }
+      } else {
+        Rect rect;
+        sbox->getBox(rect);
+        shapes.emplace_back(sbox->getTechLayer(), makeBox(rect));
+      }
+    }
+  }
+}
+
+dbSpatialIndex::Box dbSpatialIndex::makeBox(const Rect& rect)
+{
+  return Box(Point(rect.xMin(), rect.yMin()), Point(rect.xMax(), rect.yMax()));
+}
+
+Rect dbSpatialIndex::makeRect(const Box& box)
+{
+  return Rect(box.min_corner().x(),
+              box.min_corner().y(),
+              box.max_corner().x(),
+              box.max_corner().y());
+}
+
+////////////////////////////////////////////////////////////////////
+//
+// Callbacks
+//
+////////////////////////////////////////////////////////////////////
+
+void dbSpatialIndex::inDbInstCreate(dbInst* inst)
+{
+  addInst(inst);
+}
+
+void dbSpatialIndex::inDbInstCreate(dbInst* inst, dbRegion* /* region */)
+{
+  addInst(inst);
+}
+
+void dbSpatialIndex::inDbInstDestroy(dbInst* inst)
+{
+  removeInst(inst);
+}
+
+void dbSpatialIndex::inDbInstSwapMasterBefore(dbInst* inst,
+                                              dbMaster* /* master */)
+{
+  removeInst(inst);
+}
+
+void dbSpatialIndex::inDbInstSwapMasterAfter(dbInst* inst)
+{
+  addInst(inst);
+}
+
+void dbSpatialIndex::inDbPreMoveInst(dbInst* inst)
+{
+  removeInst(inst);
+}
+
+void dbSpatialIndex::inDbPostMoveInst(dbInst* inst)
+{
+  // Moves inside a callback batch have no pre-move callback.
+  removeInst(inst);
+  addInst(inst);
+}
+
+void dbSpatialIndex::inDbNetDestroy(dbNet* net)
+{
+  removeNet(net);
+  dirty_nets_.erase(net);
+}
+
+void dbSpatialIndex::inDbWireCreate(dbWire* wire)
+{
+  markNet(wire->getNet());
+}
+
+void dbSpatialIndex::inDbWireDestroy(dbWire* wire)
+{
+  markNet(wire->getNet());
+}
+
+void dbSpatialIndex::inDbWirePostModify(dbWire* wire)
+{
+  markNet(wire->getNet());
+}
+
+void dbSpatialIndex::inDbWirePreAttach(dbWire* wire, dbNet* /* net */)
+{
+  markNet(wire->getNet());
+}
+
+void dbSpatialIndex::inDbWirePostAttach(dbWire* wire)
+{
+  markNet(wire->getNet());
+}
+
+void dbSpatialIndex::inDbWirePreDetach(dbWire* wire)
+{
+  markNet(wire->getNet());
+}
+
+void dbSpatialIndex::inDbWirePostAppend(dbWire* /* src */, dbWire* dst)
+{
+  markNet(dst->getNet());
+}
+
+void dbSpatialIndex::inDbWirePostCopy(dbWire* /* src */, dbWire* dst)
+{
+  markNet(dst->getNet());
+}
+
+void dbSpatialIndex::inDbSWireCreate(dbSWire* swire)
+{
+  markNet(swire->getNet());
+}
+
+void dbSpatialIndex::inDbSWireDestroy(dbSWire* swire)
+{
+  markNet(swire->getNet());
+}
+
+void dbSpatialIndex::inDbSWirePostDestroySBoxes(dbSWire* swire)
+{
+  markNet(swire->getNet());
+}
+
+void dbSpatialIndex::inDbSBoxCreate(dbSBox* sbox)
+{
+  markNet(sbox->getSWire()->getNet());
+}
+
+void dbSpatialIndex::inDbFillCreate(dbFill* fill)
+{
+  Rect rect;
+  fill->getRect(rect);
+  fills_[fill->getTechLayer()].insert(std::make_pair(makeBox(rect), fill));
+}
+
+void dbSpatialIndex::inDbFillDestroy(dbFill* fill)
+{
+  Rect rect;
+  fill->getRect(rect);
+  fills_[fill->getTechLayer()].remove(std::make_pair(makeBox(rect), fill));
+}
+
+}  // namespace odb
@@ -32,6 +32,9 @@
 
 #include "dbStream.h"
 
+#include <sys/mman.h>
+#include <sys/stat.h>
+
 #include "db.h"
 
 namespace odb {
@@ -88,8 +91,12 @@ dbOStream::dbOStream(_dbDatabase* db, FILE* f)
 {
   _db              = db;
   _f               = f;
+  _buffer          = (char*) malloc(BUFFER_SIZE);
+  _buffer_cnt      = 0;
+  _sectioned       = false;
   _lef_dist_factor = 0.001;
   _lef_area_factor = 0.000001;
+  ZALLOCATED(_buffer);
 
   dbTech* tech = ((dbDatabase*) db)->getTech();
 
@@ -99,10 +106,50 @@ dbOStream::dbOStream(_dbDatabase* db, FILE* f)
   }
 }
 
+dbOStream::~dbOStream()
+{
+  // Unflushed data is dropped: a stream destroyed by an exception must
+  // not write a partial database, and write errors can't be reported here.
+  free(_buffer);
+}
+
+void dbOStream::flush()
+{
+  if (_buffer_cnt == 0)
+    return;
+
+  size_t n    = _buffer_cnt;
+  _buffer_cnt = 0;
+
+  if (fwrite(_buffer, n, 1, _f) != 1)
+    write_error();
+}
+
 dbIStream::dbIStream(_dbDatabase* db, FILE* f)
 {
-  _db = db;
-  _f  = f;
+  _db        = db;
+  _f         = f;
+  _map       = NULL;
+  _map_size  = 0;
+  _map_pos   = 0;
+  _sectioned = false;
+
+  // Map the whole file and decode from the current file position. If the
+  // file can't be mapped, the stream reads through the FILE instead.
+  struct stat st;
+  long        pos = ftell(f);
+
+  if ((pos >= 0) && (fstat(fileno(f), &st) == 0) && S_ISREG(st.st_mode)
+      && (st.st_size > pos)) {
+    void* map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fileno(f), 0);
+
+    if (map != MAP_FAILED) {
+      madvise(map, st.st_size, MADV_SEQUENTIAL);
+      _map      = (const char*) map;
+      _map_size = st.st_size;
+      _map_pos  = pos;
+    }
+  }
 
   _lef_dist_factor = 0.001;
   _lef_area_factor = 0.000001;
@@ -115,4 +162,33 @@ dbIStream::dbIStream(_dbDatabase* db, FILE* f)
   }
 }
 
+dbIStream::dbIStream(_dbDatabase* db, const char* data, size_t size)
+{
+  _db        = db;
+  _f         = NULL;
+  _map       = data;
+  _map_size  = size;
+  _map_pos   = 0;
+  _sectioned = false;
+
+  _lef_dist_factor = 0.001;
+  _lef_area_factor = 0.000001;
+
+  dbTech* tech = ((dbDatabase*) db)->getTech();
+
+  if (tech && tech->getLefUnits() == 2000) {
+    _lef_dist_factor = 0.0005;
+    _lef_area_factor = 0.00000025;
+  }
+}
+
+dbIStream::~dbIStream()
+{
+  if (_map && _f) {
+    munmap((void*) _map, _map_size);
+    // Leave the file positioned after the data consumed by this stream.
+    fseek(_f, _map_pos, SEEK_SET);
+  }
+}
+
 }  // namespace odb
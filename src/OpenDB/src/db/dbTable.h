@@ -37,6 +37,7 @@
 #include "ZException.h"
 #include "dbCore.h"
 #include "dbIterator.h"
+#include "dbPageAllocator.h"
 #include "dbVector.h"
 #include "odb.h"
 
@@ -66,7 +67,8 @@ class dbTable : public dbObjectTable, public dbIterator
   uint _free_list;      // objects on freelist
 
   // NON-PERSISTANT-DATA
-  dbTablePage** _pages;  // page-table
+  dbTablePage**    _pages;      // page-table
+  dbPageAllocator* _allocator;  // source of the pages
 
   void           resizePageTbl();
   void           newPage();
@@ -105,6 +107,15 @@ class dbTable : public dbObjectTable, public dbIterator
 
   uint page_size() const { return _page_mask + 1; }
 
+  // Bytes held by the allocated objects, and by the free slots and the
+  // unused part of the page-table.
+  void getMemoryUsage(uint64& used, uint64& wasted) const;
+
+  // Hash of the persistent content of the table: the hashes of the pages
+  // folded together. Tables that would stream the same objects, ids and
+  // free-lists have the same hash.
+  uint64 getContentHash() const;
+
   // Get the object of this id
   T* getPtr(dbId<T> id) const
   {
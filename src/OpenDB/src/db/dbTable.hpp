@@ -37,6 +37,7 @@
 
 #include "dbDiff.h"
 #include "ZException.h"
+#include "dbContentHash.h"
 #include "dbTable.h"
 #include "dbStream.h"
 #include "dbDatabase.h"
@@ -114,7 +115,8 @@ void dbTable<T>::clear()
         t->~T();
     }
 
-    free((void*) page);
+    _allocator->deallocate(page,
+                           page_size() * sizeof(T) + sizeof(dbObjectPage));
   }
 
   if (_pages)
@@ -147,6 +149,7 @@ dbTable<T>::dbTable(_dbDatabase* db,
   _alloc_cnt     = 0;
   _free_list     = 0;
   _pages         = NULL;
+  _allocator     = getPageAllocator();
 }
 
 template <class T>
@@ -160,7 +163,8 @@ dbTable<T>::dbTable(_dbDatabase* db, dbObject* owner, const dbTable<T>& t)
       _page_tbl_size(t._page_tbl_size),
       _alloc_cnt(t._alloc_cnt),
       _free_list(t._free_list),
-      _pages(NULL)
+      _pages(NULL),
+      _allocator(getPageAllocator())
 {
   copy_pages(t);
 }
@@ -171,6 +175,43 @@ dbTable<T>::~dbTable()
   clear();
 }
 
+template <class T>
+void dbTable<T>::getMemoryUsage(uint64& used, uint64& wasted) const
+{
+  uint64 slots = (uint64) _page_cnt * page_size();
+  uint64 pages = (uint64) _page_cnt * sizeof(dbObjectPage);
+
+  used   = (uint64) _alloc_cnt * sizeof(T) + pages
+         + (uint64) _page_cnt * sizeof(dbTablePage*);
+  wasted = (slots - _alloc_cnt) * sizeof(T)
+           + (uint64) (_page_tbl_size - _page_cnt) * sizeof(dbTablePage*);
+}
+
+template <class T>
+uint64 dbTable<T>::getContentHash() const
+{
+  dbContentHash hash;
+  dbOStream     stream(_db, hash.getFile());
+
+  // The size of the page table is left out, it does not change the objects.
+  stream << _page_mask;
+  stream << _page_shift;
+  stream << _top_idx;
+  stream << _bottom_idx;
+  stream << _page_cnt;
+  stream << _alloc_cnt;
+  stream << _free_list;
+  stream << _prop_list;
+  uint64 result = hash.take(stream);
+
+  for (uint i = 0; i < _page_cnt; ++i) {
+    writePage(stream, _pages[i]);
+    result = dbContentHash::combine(result, hash.take(stream));
+  }
+
+  return result;
+}
+
 template <class T>
 void dbTable<T>::resizePageTbl()
 {
@@ -195,7 +236,7 @@ template <class T>
 void dbTable<T>::newPage()
 {
   uint         size = page_size() * sizeof(T) + sizeof(dbObjectPage);
-  dbTablePage* page = (dbTablePage*) malloc(size);
+  dbTablePage* page = (dbTablePage*) _allocator->allocate(size);
   ZALLOCATED(page);
   memset(page, 0, size);
 
@@ -589,7 +630,7 @@ template <class T>
 void dbTable<T>::copy_page(uint page_id, dbTablePage* page)
 {
   uint         size = page_size() * sizeof(T) + sizeof(dbObjectPage);
-  dbTablePage* p    = (dbTablePage*) malloc(size);
+  dbTablePage* p    = (dbTablePage*) _allocator->allocate(size);
   ZALLOCATED(p);
   memset(p, 0, size);
   p->_table       = this;
@@ -667,7 +708,7 @@ dbIStream& operator>>(dbIStream& stream, dbTable<T>& table)
   uint i;
   for (i = 0; i < table._page_cnt; ++i) {
     uint         size = table.page_size() * sizeof(T) + sizeof(dbObjectPage);
-    dbTablePage* page = (dbTablePage*) malloc(size);
+    dbTablePage* page = (dbTablePage*) table._allocator->allocate(size);
     ZALLOCATED(page);
     memset(page, 0, size);
     page->_page_addr = i << table._page_shift;
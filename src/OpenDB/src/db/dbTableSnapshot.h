@@ -0,0 +1,366 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2019, Nefelus Inc
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "ZException.h"
+#include "dbCore.h"
+#include "dbStream.h"
+#include "dbTable.h"
+#include "odb.h"
+
+namespace odb {
+
+class dbTableSnapshotBase
+{
+ public:
+  virtual ~dbTableSnapshotBase() {}
+
+  // Find the pages that changed since the snapshot. The table is only
+  // read, so the tables of a block can be compared in parallel.
+  virtual void findChanges() = 0;
+
+  // Restore the table from the pages found by findChanges(), returns the
+  // number of pages restored.
+  virtual uint rollback() = 0;
+};
+
+//////////////////////////////////////////////////////////
+///
+/// dbTableSnapshot - the state of a dbTable, page by page.
+///
+/// Each page is kept as a byte image. A page of a table whose objects own
+/// heap memory (names, vectors) is also kept as a copy made by writing
+/// the page to a database stream and reading it back, so the copy owns
+/// its names and vectors and carries every persistent field.
+///
+/// A rollback compares every page of the table to its image, and the
+/// objects of a page whose bytes match to the copy with operator==, as a
+/// name freed after the snapshot may be reallocated at the same address.
+/// A page that differs is copied back from its image, or read back in
+/// place from its copy; the other pages and their objects are not
+/// touched.
+///
+//////////////////////////////////////////////////////////
+template <class T>
+class dbTableSnapshot : public dbTableSnapshotBase
+{
+ public:
+  // deep: the objects own heap memory.
+  dbTableSnapshot(dbTable<T>* table, bool deep);
+  ~dbTableSnapshot();
+
+  void findChanges() override;
+  uint rollback() override;
+
+ private:
+  struct Page
+  {
+    dbTablePage* _image;
+    dbTablePage* _copy;  // NULL unless deep
+  };
+
+  uint         pageBytes() const;
+  dbTablePage* newPage(uint page_id);
+  void         destroyObjects(dbTablePage* page);
+  void         copyPage(const dbTablePage* src, dbTablePage* dst);
+  void         restorePage(dbTablePage* page, const Page& p);
+  bool         changed(const dbTablePage* page, const Page& p) const;
+  bool         propsChanged() const;
+  void         restoreProps();
+
+  dbTable<T>*                    _table;
+  bool                           _deep;
+  uint                           _top_idx;
+  uint                           _bottom_idx;
+  uint                           _alloc_cnt;
+  uint                           _free_list;
+  uint                           _page_tbl_size;
+  std::vector<Page>              _pages;
+
+  // Set by findChanges().
+  std::vector<bool> _changed;
+  bool              _props_changed;
+
+  // The pages of the property lists of the table objects, an empty page
+  // stands for a page that is not allocated.
+  std::vector<std::vector<dbId<_dbProperty>>> _prop_pages;
+};
+
+template <class T>
+inline uint dbTableSnapshot<T>::pageBytes() const
+{
+  return _table->page_size() * sizeof(T) + sizeof(dbObjectPage);
+}
+
+template <class T>
+dbTablePage* dbTableSnapshot<T>::newPage(uint page_id)
+{
+  dbTablePage* page = (dbTablePage*) _table->_allocator->allocate(pageBytes());
+  ZALLOCATED(page);
+  memset(page, 0, pageBytes());
+  page->_table     = _table;
+  page->_page_addr = page_id << _table->_page_shift;
+  return page;
+}
+
+template <class T>
+void dbTableSnapshot<T>::destroyObjects(dbTablePage* page)
+{
+  T* t = (T*) page->_objects;
+  T* e = &t[_table->page_size()];
+
+  for (; t < e; t++) {
+    if (t->_oid & DB_ALLOC_BIT)
+      t->~T();
+  }
+}
+
+template <class T>
+void dbTableSnapshot<T>::copyPage(const dbTablePage* src, dbTablePage* dst)
+{
+  char*  data;
+  size_t size;
+  FILE*  file = open_memstream(&data, &size);
+  ZALLOCATED(file);
+
+  {
+    dbOStream stream(_table->_db, file);
+    _table->writePage(stream, src);
+    stream.flush();
+  }
+
+  fclose(file);
+
+  dbIStream stream(_table->_db, data, size);
+  _table->readPage(stream, dst);
+  free(data);
+}
+
+template <class T>
+void dbTableSnapshot<T>::restorePage(dbTablePage* page, const Page& p)
+{
+  destroyObjects(page);
+
+  if (_deep)
+    copyPage(p._copy, page);
+  else
+    memcpy((void*) page, p._image, pageBytes());
+}
+
+template <class T>
+bool dbTableSnapshot<T>::changed(const dbTablePage* page, const Page& p) const
+{
+  if (memcmp((const void*) page, p._image, pageBytes()) != 0)
+    return true;
+
+  if (!_deep)
+    return false;
+
+  const T* t    = (const T*) page->_objects;
+  const T* e    = &t[_table->page_size()];
+  const T* copy = (const T*) p._copy->_objects;
+
+  for (; t < e; t++, copy++) {
+    if ((t->_oid & DB_ALLOC_BIT) && *t != *copy)
+      return true;
+  }
+
+  return false;
+}
+
+template <class T>
+bool dbTableSnapshot<T>::propsChanged() const
+{
+  const dbAttrTable<dbId<_dbProperty>>& props = _table->_prop_list;
+
+  if (props._page_cnt != _prop_pages.size())
+    return true;
+
+  for (uint i = 0; i < _prop_pages.size(); ++i) {
+    const dbId<_dbProperty>* page = props._pages[i];
+
+    if ((page == NULL) != _prop_pages[i].empty())
+      return true;
+
+    if (page
+        && !std::equal(_prop_pages[i].begin(), _prop_pages[i].end(), page))
+      return true;
+  }
+
+  return false;
+}
+
+template <class T>
+void dbTableSnapshot<T>::restoreProps()
+{
+  dbAttrTable<dbId<_dbProperty>>& props = _table->_prop_list;
+  props.clear();
+
+  if (_prop_pages.empty())
+    return;
+
+  props.resizePageTable(_prop_pages.size() - 1);
+
+  for (uint i = 0; i < _prop_pages.size(); ++i) {
+    if (!_prop_pages[i].empty())
+      std::copy(_prop_pages[i].begin(),
+                _prop_pages[i].end(),
+                props.getPage(i));
+  }
+}
+
+template <class T>
+dbTableSnapshot<T>::dbTableSnapshot(dbTable<T>* table, bool deep)
+    : _table(table),
+      _deep(deep),
+      _top_idx(table->_top_idx),
+      _bottom_idx(table->_bottom_idx),
+      _alloc_cnt(table->_alloc_cnt),
+      _free_list(table->_free_list),
+      _page_tbl_size(table->_page_tbl_size),
+      _props_changed(false)
+{
+  _pages.resize(table->_page_cnt);
+
+  for (uint i = 0; i < table->_page_cnt; ++i) {
+    const dbTablePage* page = table->_pages[i];
+    Page&              p    = _pages[i];
+
+    p._image = (dbTablePage*) malloc(pageBytes());
+    ZALLOCATED(p._image);
+    memcpy((void*) p._image, page, pageBytes());
+
+    p._copy = NULL;
+    if (deep) {
+      p._copy = newPage(i);
+      copyPage(page, p._copy);
+    }
+  }
+
+  const dbAttrTable<dbId<_dbProperty>>& props = table->_prop_list;
+  _prop_pages.resize(props._page_cnt);
+
+  for (uint i = 0; i < props._page_cnt; ++i) {
+    if (props._pages[i])
+      _prop_pages[i].assign(props._pages[i], props._pages[i] + props.page_size);
+  }
+}
+
+template <class T>
+dbTableSnapshot<T>::~dbTableSnapshot()
+{
+  for (Page& p : _pages) {
+    free((void*) p._image);
+    if (p._copy) {
+      destroyObjects(p._copy);
+      _table->_allocator->deallocate(p._copy, pageBytes());
+    }
+  }
+}
+
+template <class T>
+void dbTableSnapshot<T>::findChanges()
+{
+  // Pages dropped since the snapshot, by dbTable::clear, are restored too.
+  _changed.assign(_pages.size(), true);
+
+  uint n = std::min((uint) _pages.size(), _table->_page_cnt);
+  for (uint i = 0; i < n; ++i)
+    _changed[i] = changed(_table->_pages[i], _pages[i]);
+
+  _props_changed = propsChanged();
+}
+
+template <class T>
+uint dbTableSnapshot<T>::rollback()
+{
+  dbTable<T>* table    = _table;
+  uint        restored = 0;
+
+  // Pages created since the snapshot.
+  for (uint i = _pages.size(); i < table->_page_cnt; ++i) {
+    destroyObjects(table->_pages[i]);
+    table->_allocator->deallocate(table->_pages[i], pageBytes());
+    table->_pages[i] = NULL;
+    ++restored;
+  }
+
+  if (table->_page_tbl_size != _page_tbl_size) {
+    dbTablePage** pages = NULL;
+
+    if (_page_tbl_size) {
+      pages = new dbTablePage*[_page_tbl_size];
+      ZALLOCATED(pages);
+
+      for (uint i = 0; i < _page_tbl_size; ++i)
+        pages[i] = i < table->_page_cnt && i < _pages.size() ? table->_pages[i]
+                                                             : NULL;
+    }
+
+    delete[] table->_pages;
+    table->_pages         = pages;
+    table->_page_tbl_size = _page_tbl_size;
+  }
+
+  // Pages dropped since the snapshot, by dbTable::clear.
+  for (uint i = table->_page_cnt; i < _pages.size(); ++i)
+    table->_pages[i] = newPage(i);
+
+  table->_page_cnt   = _pages.size();
+  table->_top_idx    = _top_idx;
+  table->_bottom_idx = _bottom_idx;
+  table->_alloc_cnt  = _alloc_cnt;
+  table->_free_list  = _free_list;
+
+  for (uint i = 0; i < _pages.size(); ++i) {
+    if (!_changed[i])
+      continue;
+
+    restorePage(table->_pages[i], _pages[i]);
+    ++restored;
+  }
+
+  if (_props_changed)
+    restoreProps();
+
+  return restored;
+}
+
+}  // namespace odb
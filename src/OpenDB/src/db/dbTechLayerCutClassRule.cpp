@@ -58,7 +58,10 @@ bool _dbTechLayerCutClassRule::operator==(
   if (_flags._cuts_valid != rhs._flags._cuts_valid)
     return false;
 
-  if (_name != rhs._name)
+  if (_name && rhs._name) {
+    if (strcmp(_name, rhs._name) != 0)
+      return false;
+  } else if (_name || rhs._name)
     return false;
 
   if (_width != rhs._width)
@@ -31,6 +31,7 @@
 // POSSIBILITY OF SUCH DAMAGE.
 
 #include <algorithm>
+#include <set>
 
 #include "db.h"
 #include "dbBlock.h"
@@ -420,6 +421,9 @@ void dbWire::donateWireSeg(dbWire* w1, dbRSeg** new_rsegs)
     }
     w1->addOneSeg(opcode, data, jj, destid, new_rsegs);
   }
+
+  for (auto callback : ((_dbBlock*) getBlock())->_callbacks)
+    callback->inDbWirePostModify(w1);
 }
 
 void dbWire::shuffleWireSeg(dbNet** newNets, dbRSeg** new_rsegs)
@@ -461,6 +465,8 @@ void dbWire::shuffleWireSeg(dbNet** newNets, dbRSeg** new_rsegs)
   dbWire* fwire   = NULL;
   bool    newWire = false;
 
+  std::set<dbWire*> modified;
+
   if (twire == this) {
     newWire = true;
     rwire   = dbWire::create(getBlock());
@@ -547,6 +553,7 @@ void dbWire::shuffleWireSeg(dbNet** newNets, dbRSeg** new_rsegs)
       }
       twire = newNets[jj]->getWire();
       fwire = twire == this ? rwire : twire;
+      modified.insert(fwire);
       fwire->addOneSeg(WOP_PATH | wwtype, data, jj, destid, new_rsegs);
       continue;
     } else if (opcd == WOP_PATH
@@ -558,11 +565,13 @@ void dbWire::shuffleWireSeg(dbNet** newNets, dbRSeg** new_rsegs)
       if (twire == NULL)
         twire = dbWire::create(newNets[jj]);
       fwire = twire == this ? rwire : twire;
+      modified.insert(fwire);
       fwire->addOneSeg(opcode, data, jj, destid, new_rsegs);
       continue;
     }
     if (jj != 0 && newNets[jj] != NULL) {
       fwire = twire == this ? rwire : twire;
+      modified.insert(fwire);
       fwire->addOneSeg(opcode, data, jj, destid, new_rsegs);
       j1 = jj + 1;
       // bool extension = false;
@@ -580,6 +589,7 @@ void dbWire::shuffleWireSeg(dbNet** newNets, dbRSeg** new_rsegs)
       if (twire == NULL)
         twire = dbWire::create(newNets[jj]);
       fwire = twire == this ? rwire : twire;
+      modified.insert(fwire);
       fwire->addOneSeg(WOP_PATH | wwtype, llayer->getImpl()->getOID());
       bool extension = false;
       if ((wire->_opcodes[jj + 1] & WOP_OPCODE_MASK) == WOP_OPERAND)
@@ -612,6 +622,7 @@ void dbWire::shuffleWireSeg(dbNet** newNets, dbRSeg** new_rsegs)
       continue;
     }
     fwire = twire == this ? rwire : twire;
+    modified.insert(fwire);
     fwire->addOneSeg(opcode, data, jj, destid, new_rsegs);
     jxx[jj]    = xx;
     jyy[jj]    = yy;
@@ -622,6 +633,10 @@ void dbWire::shuffleWireSeg(dbNet** newNets, dbRSeg** new_rsegs)
 
   if (newWire)
     rwire->attach(leadNewNet);
+
+  for (auto callback : ((_dbBlock*) getBlock())->_callbacks)
+    for (dbWire* w : modified)
+      callback->inDbWirePostModify(w);
 }
 
 bool dbWire::getBBox(Rect& bbox)
@@ -1825,7 +1840,8 @@ dbWire* dbWire::create(dbNet* net_, bool global_wire)
   }
 
   _dbBlock* block = (_dbBlock*) net->getOwner();
-  _dbWire*  wire  = block->_wire_tbl->create();
+  block->loadWires();
+  _dbWire* wire = block->_wire_tbl->create();
   wire->_net      = net->getOID();
 
   if (global_wire) {
@@ -1844,7 +1860,8 @@ dbWire* dbWire::create(dbNet* net_, bool global_wire)
 dbWire* dbWire::create(dbBlock* block_, bool /* unused: global_wire */)
 {
   _dbBlock* block = (_dbBlock*) block_;
-  _dbWire*  wire  = block->_wire_tbl->create();
+  block->loadWires();
+  _dbWire* wire = block->_wire_tbl->create();
   for(auto callback:block->_callbacks)
     callback->inDbWireCreate((dbWire*)wire);
   return (dbWire*) wire;
@@ -1853,6 +1870,7 @@ dbWire* dbWire::create(dbBlock* block_, bool /* unused: global_wire */)
 dbWire* dbWire::getWire(dbBlock* block_, uint dbid_)
 {
   _dbBlock* block = (_dbBlock*) block_;
+  block->loadWires();
   return (dbWire*) block->_wire_tbl->getPtr(dbid_);
 }
 
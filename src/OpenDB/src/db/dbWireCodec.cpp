@@ -34,6 +34,7 @@
 
 #include "db.h"
 #include "dbBlock.h"
+#include "dbBlockCallBackObj.h"
 #include "dbNet.h"
 #include "dbTable.h"
 #include "dbTech.h"
@@ -598,8 +599,12 @@ void dbWireEncoder::end()
   _wire->_opcodes = _opcodes;
 
   // Should we calculate the bbox???
-  ((_dbBlock*) _block)->_flags._valid_bbox = 0;
-  _point_cnt                               = 0;
+  _dbBlock* block           = (_dbBlock*) _block;
+  block->_flags._valid_bbox = 0;
+  _point_cnt                = 0;
+
+  for (auto callback : block->_callbacks)
+    callback->inDbWirePostModify((dbWire*) _wire);
 }
 
 //////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,158 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, OpenRoad Project
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "dbWireShapeCache.h"
+
+#include <utility>
+
+#include "db.h"
+#include "dbParallel.h"
+
+namespace odb {
+
+dbWireShapeCache::dbWireShapeCache(dbBlock* block) : block_(block)
+{
+  addOwner(block);
+}
+
+const dbWireShapeCache::Shapes& dbWireShapeCache::getShapes(dbWire* wire)
+{
+  uint id = wire->getId();
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (id < shapes_.size() && shapes_[id])
+      return *shapes_[id];
+  }
+
+  // Decode outside the lock so concurrent readers don't serialize on it.
+  std::unique_ptr<Shapes> shapes(new Shapes);
+  decode(wire, *shapes);
+
+  // If another reader got here first its copy is kept; they are the same.
+  std::lock_guard<std::mutex> guard(lock_);
+  return *insert(id, std::move(shapes));
+}
+
+void dbWireShapeCache::decodeAll(int num_threads)
+{
+  std::vector<dbWire*>                 wires;
+  std::vector<std::unique_ptr<Shapes>> decoded;
+  {
+    dbConcurrentReadScope concurrent_read(block_);
+    {
+      std::lock_guard<std::mutex> guard(lock_);
+      for (dbNet* net : block_->getNets()) {
+        dbWire* wire = net->getWire();
+        if (wire
+            && (wire->getId() >= shapes_.size() || !shapes_[wire->getId()]))
+          wires.push_back(wire);
+      }
+    }
+
+    decoded.resize(wires.size());
+    runParallel(wires.size(), num_threads, [&](uint i) {
+      decoded[i].reset(new Shapes);
+      decode(wires[i], *decoded[i]);
+    });
+  }
+
+  std::lock_guard<std::mutex> guard(lock_);
+  for (size_t i = 0; i < wires.size(); ++i)
+    insert(wires[i]->getId(), std::move(decoded[i]));
+}
+
+void dbWireShapeCache::clear()
+{
+  std::lock_guard<std::mutex> guard(lock_);
+  shapes_.clear();
+}
+
+void dbWireShapeCache::decode(dbWire* wire, Shapes& shapes)
+{
+  shapes.shapes.clear();
+  shapes.shape_ids.clear();
+  shapes.points.clear();
+
+  dbWireShapeItr itr;
+  dbShape        shape;
+
+  for (itr.beginDecode(wire); itr.decodeNext(shape);) {
+    shapes.shapes.push_back(shape);
+    shapes.shape_ids.push_back(itr._shape_id);
+    shapes.points.push_back(Point(itr._prev_x, itr._prev_y));
+  }
+
+  shapes.shapes.shrink_to_fit();
+  shapes.shape_ids.shrink_to_fit();
+  shapes.points.shrink_to_fit();
+}
+
+dbWireShapeCache::Shapes* dbWireShapeCache::insert(
+    uint                    id,
+    std::unique_ptr<Shapes> shapes)
+{
+  if (id >= shapes_.size())
+    shapes_.resize(id + 1);
+  if (!shapes_[id])
+    shapes_[id] = std::move(shapes);
+  return shapes_[id].get();
+}
+
+void dbWireShapeCache::remove(dbWire* wire)
+{
+  std::lock_guard<std::mutex> guard(lock_);
+  uint                        id = wire->getId();
+  if (id < shapes_.size())
+    shapes_[id].reset();
+}
+
+void dbWireShapeCache::inDbWireDestroy(dbWire* wire)
+{
+  remove(wire);
+}
+
+void dbWireShapeCache::inDbWirePostModify(dbWire* wire)
+{
+  remove(wire);
+}
+
+void dbWireShapeCache::inDbWirePostAppend(dbWire* /* src */, dbWire* dst)
+{
+  remove(dst);
+}
+
+void dbWireShapeCache::inDbWirePostCopy(dbWire* /* src */, dbWire* dst)
+{
+  remove(dst);
+}
+
+}  // namespace odb
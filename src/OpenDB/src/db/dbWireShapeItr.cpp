@@ -38,6 +38,7 @@
 #include "dbWire.h"
 #include "dbWireCodec.h"
 #include "dbWireOpcode.h"
+#include "dbWireShapeCache.h"
 
 namespace odb {
 
@@ -50,9 +51,12 @@ namespace odb {
 //////////////////////////////////////////////////////////////////////////////////
 dbWireShapeItr::dbWireShapeItr()
 {
-  _wire  = NULL;
-  _block = NULL;
-  _tech  = NULL;
+  _wire          = NULL;
+  _block         = NULL;
+  _tech          = NULL;
+  _cached_shapes = NULL;
+  _cached_ids    = NULL;
+  _cached_idx    = 0;
 }
 
 dbWireShapeItr::~dbWireShapeItr()
@@ -73,6 +77,40 @@ inline unsigned char dbWireShapeItr::peekOp()
 }
 
 void dbWireShapeItr::begin(dbWire* wire)
+{
+  beginDecode(wire);
+
+  _dbBlock* block = (_dbBlock*) _block;
+
+  if (block->_wire_shape_cache) {
+    const dbWireShapeCache::Shapes& shapes
+        = block->_wire_shape_cache->getShapes(wire);
+    _cached_shapes = &shapes.shapes;
+    _cached_ids    = &shapes.shape_ids;
+    _cached_points = &shapes.points;
+    _cached_idx    = 0;
+  }
+}
+
+bool dbWireShapeItr::next(dbShape& shape)
+{
+  if (_cached_shapes == NULL)
+    return decodeNext(shape);
+
+  if (_cached_idx == (int) _cached_shapes->size()) {
+    _shape_id = _wire->_opcodes.size();
+    return false;
+  }
+
+  const Point& prev = (*_cached_points)[_cached_idx];
+  _prev_x           = prev.x();
+  _prev_y           = prev.y();
+  shape             = (*_cached_shapes)[_cached_idx];
+  _shape_id         = (*_cached_ids)[_cached_idx++];
+  return true;
+}
+
+void dbWireShapeItr::beginDecode(dbWire* wire)
 {
   _wire         = (_dbWire*) wire;
   _block        = wire->getBlock();
@@ -87,9 +125,13 @@ void dbWireShapeItr::begin(dbWire* wire)
   _dw           = 0;
   _point_cnt    = 0;
   _has_width    = false;
+
+  _cached_shapes = NULL;
+  _cached_ids    = NULL;
+  _cached_points = NULL;
 }
 
-bool dbWireShapeItr::next(dbShape& shape)
+bool dbWireShapeItr::decodeNext(dbShape& shape)
 {
   ZASSERT(_wire);
   int operand;
@@ -35,6 +35,9 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include <utility>
+
+#include "ZException.h"
 #include "db.h"
 #include "dbShape.h"
 #include "dbWireCodec.h"
@@ -115,8 +118,10 @@ tmg_conn::tmg_conn()
   _need_short_wire_id = 0;
   _first_for_clear    = NULL;
   _preserveSWire      = false;
+  _hasSWire           = false;
   _swireNetCnt        = 0;
   _gVerbose           = false;
+  _deferred           = NULL;
 }
 
 int tmg_conn::ptDist(int fr, int to)
@@ -1732,8 +1737,7 @@ void tmg_conn::analyzeNet(dbNet* net,
       loadWire(net->getWire());
     if (!_ptN) {
       // ignoring this net
-      net->setDisconnected(false);
-      net->setWireOrdered(false);
+      setNetFlags(false, false);
       return;
     }
     findConnections(verbose);
@@ -1751,8 +1755,7 @@ void tmg_conn::analyzeNet(dbNet* net,
     relocateShorts();
     treeReorder(verbose, quiet, noConvert);
   }
-  net->setDisconnected(!_connected);
-  net->setWireOrdered(true);  // 090606
+  setNetFlags(!_connected, true);  // 090606
   if (!_connected) {
     if (!quiet)
       notice(0,
@@ -1768,18 +1771,16 @@ void tmg_conn::analyzeLoadedNet(bool verbose, bool no_convert)
 {
   if (!_ptN) {
     // ignoring this net
-    _net->setDisconnected(false);
-    _net->setWireOrdered(false);
+    setNetFlags(false, false);
     return;
   }
   findConnections(verbose);
   if (!no_convert)
     adjustShapes();
   treeReorder(verbose, false, no_convert);
-  _net->setDisconnected(!_connected);
-  _net->setWireOrdered(
-      _connected);  // this will change,
-                    // we should wire-order the disconnected nets
+  setNetFlags(!_connected,
+              _connected);  // this will change,
+                            // we should wire-order the disconnected nets
   if (!_connected) {
     notice(0,
            "\ndisconnected net %d  %s\n",
@@ -1790,6 +1791,56 @@ void tmg_conn::analyzeLoadedNet(bool verbose, bool no_convert)
   }
 }
 
+void tmg_conn::analyzeNetDeferred(dbNet*           net,
+                                  bool             force,
+                                  bool             quiet,
+                                  int              cutLength,
+                                  int              maxLength,
+                                  tmg_conn_result& result)
+{
+  result._net          = net;
+  result._disconnected = net->isDisconnected();
+  result._ordered      = net->isWireOrdered();
+  result._encoded      = false;
+  result._messages.clear();
+
+  _deferred = &result;
+  captureMessages(&result._messages);
+  try {
+    analyzeNet(net, force, false, quiet, false, cutLength, maxLength);
+  } catch (...) {
+    captureMessages(NULL);
+    _deferred = NULL;
+    throw;
+  }
+  captureMessages(NULL);
+  _deferred = NULL;
+}
+
+void tmg_conn::setNetFlags(bool disconnected, bool ordered)
+{
+  if (_deferred) {
+    _deferred->_disconnected = disconnected;
+    _deferred->_ordered      = ordered;
+    return;
+  }
+  _net->setDisconnected(disconnected);
+  _net->setWireOrdered(ordered);
+}
+
+void tmg_conn_result::commit()
+{
+  replayMessages(_messages);
+  if (_encoded) {
+    // moved out so the encoded copy is released once it is written
+    dbWireEncoder encoder(std::move(_encoder));
+    encoder.end();
+    _encoded = false;
+  }
+  _net->setDisconnected(_disconnected);
+  _net->setWireOrdered(_ordered);
+}
+
 bool tmg_conn::checkConnected()
 {
   int         j;
@@ -1890,8 +1941,11 @@ void tmg_conn::treeReorder(bool verbose, bool quiet, bool no_convert)
   int j;
   if (!no_convert) {
     _newWire = _net->getWire();
-    if (!_newWire)
+    if (!_newWire) {
+      // only reached through loadSWire, which deferred analysis excludes
+      ZASSERT(!_deferred);
       _newWire = dbWire::create(_net);
+    }
     _encoder.begin(_newWire);
     for (j = 0; j < _ptN; j++)
       _ptV[j]._dbwire_id = -1;
@@ -2052,7 +2106,11 @@ void tmg_conn::treeReorder(bool verbose, bool quiet, bool no_convert)
     printConnections();
   checkVisited();
   if (!no_convert) {
-    _encoder.end();
+    if (_deferred) {
+      _deferred->_encoder = std::move(_encoder);
+      _deferred->_encoded = true;
+    } else
+      _encoder.end();
   }
 }
 
@@ -32,8 +32,11 @@
 
 #pragma once
 
+#include <vector>
+
 #include "db.h"
 #include "geom.h"
+#include "dbLogger.h"
 #include "dbWireCodec.h"
 
 namespace odb {
@@ -122,6 +125,21 @@ struct tmg_rcshort
 
 class tmg_conn_search;
 class tmg_conn_graph;
+
+// The block edits and messages of one tmg_conn::analyzeNetDeferred call,
+// applied by commit().
+struct tmg_conn_result
+{
+  dbNet*                    _net;
+  bool                      _disconnected;
+  bool                      _ordered;
+  bool                      _encoded;  // _encoder holds the reordered wire
+  dbWireEncoder             _encoder;
+  std::vector<dbLogMessage> _messages;
+
+  void commit();
+};
+
 struct tmg_connect_shape
 {
   int  k;
@@ -169,6 +187,7 @@ class tmg_conn
   int*                  _csNV;
   int                   _csN;
   tmg_rcpt*             _first_for_clear;
+  tmg_conn_result*      _deferred;
 
  private:
   int _ptNmax;
@@ -181,6 +200,7 @@ class tmg_conn
 
  public:
   tmg_conn();
+  ~tmg_conn();
   void analyzeNet(dbNet* net,
                   bool   force,
                   bool   verbose,
@@ -189,6 +209,15 @@ class tmg_conn
                   int    cutLength = 0,
                   int    maxLength = 0,
                   bool   no_patch  = true);
+  // analyzeNet(net, force, false, quiet, false, cutLength, maxLength)
+  // without touching the block, so several tmg_conn may analyze nets of
+  // one block concurrently. The net must not have special wires.
+  void analyzeNetDeferred(dbNet*           net,
+                          bool             force,
+                          bool             quiet,
+                          int              cutLength,
+                          int              maxLength,
+                          tmg_conn_result& result);
   void loadNet(dbNet* net);
   void loadWire(dbWire* wire);
   void loadSWire(dbNet* net);
@@ -209,6 +238,7 @@ class tmg_conn
   void set_gv(bool verbose);
 
  private:
+  void setNetFlags(bool disconnected, bool ordered);
   void splitTtop(bool verbose);
   void splitBySj(bool       verbose,
                  int        j,
@@ -79,6 +79,7 @@ class tmg_conn_graph
 
  public:
   tmg_conn_graph();
+  ~tmg_conn_graph();
   void      init(int ptN, int shortN);
   tcg_edge* newEdge(tmg_conn* conn, int fr, int to)
   {
@@ -161,6 +162,29 @@ tmg_conn_graph::tmg_conn_graph()
   _stackV    = (tcg_edge**) malloc(_shortNmax * sizeof(tcg_edge*));
 }
 
+tmg_conn_graph::~tmg_conn_graph()
+{
+  free(_ptV);
+  free(_path_vis);
+  free(_eV);
+  free(_stackV);
+}
+
+// Here rather than in tmg_conn.cpp, where tmg_conn_graph is incomplete.
+tmg_conn::~tmg_conn()
+{
+  free(_ptV);
+  free(_termV);
+  free(_tstackV);
+  for (int j = 0; j < _termNmax; j++)
+    free(_csVV[j]);
+  free(_csVV);
+  free(_csNV);
+  free(_shortV);
+  delete _search;
+  delete _graph;
+}
+
 void tmg_conn_graph::init(int ptN, int shortN)
 {
   if (ptN > _ptNmax) {
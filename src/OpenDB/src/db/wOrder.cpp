@@ -35,8 +35,12 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include <algorithm>
+#include <vector>
+
 #include "db.h"
 #include "dbMap.h"
+#include "dbParallel.h"
 #include "dbShape.h"
 #include "dbWireCodec.h"
 #include "dbLogger.h"
@@ -44,58 +48,122 @@
 
 namespace odb {
 
-//
-// not including tmg_db.h, only need tmg_findNet
-//
+// Nets per parallel work item; each item sets up its own tmg_conn.
+static const uint _netChunkSize = 256;
+// Nets analyzed before they are committed. This is fixed, rather than
+// scaled by the thread count, so the result does not depend on it.
+static const uint _netBatchSize = 64 * _netChunkSize;
 
-static tmg_conn* _conn = NULL;
-
-void orderWires(dbBlock* block,
-                bool     force,
-                int      cutLength,
-                int      maxLength,
-                bool     quiet)
+static void orderNets(dbBlock* block,
+                      bool     force,
+                      int      cutLength,
+                      int      maxLength,
+                      bool     quiet,
+                      bool     gverbose,
+                      int      num_threads)
 {
-  bool no_patch = true;
-  if (_conn == NULL)
-    _conn = new tmg_conn();
-  _conn->resetSplitCnt();
-  bool                   verbose    = false;
-  bool                   no_convert = false;
-  dbSet<dbNet>           nets       = block->getNets();
+  bool no_patch   = true;
+  bool verbose    = false;
+  bool no_convert = false;
+
+  std::vector<dbNet*>    nets;
+  dbSet<dbNet>           block_nets = block->getNets();
   dbSet<dbNet>::iterator net_itr;
-  dbNet*                 net;
-  for (net_itr = nets.begin(); net_itr != nets.end(); ++net_itr) {
-    net = *net_itr;
+  for (net_itr = block_nets.begin(); net_itr != block_nets.end(); ++net_itr) {
+    dbNet* net = *net_itr;
     if (net->getSigType() == dbSigType::POWER
         || net->getSigType() == dbSigType::GROUND)
       continue;
     if (!force && net->isWireOrdered())
       continue;
-    _conn->analyzeNet(
-        net, force, verbose, quiet, no_convert, cutLength, maxLength, no_patch);
+    nets.push_back(net);
   }
-  if (_conn->_swireNetCnt)
-    notice(0, "Set dont_touch on %d swire nets.\n", _conn->_swireNetCnt);
-  int splitcnt = _conn->getSplitCnt();
+
+  // Analyze the nets in parallel without modifying the block, a batch of
+  // chunks at a time, and commit each batch before analyzing the next, so
+  // only one batch of re-encoded wires is held at once. Nets with special
+  // wires may have them destroyed or converted to a new wire, so they are
+  // left to the serial commit.
+  std::vector<tmg_conn_result> results(
+      std::min(_netBatchSize, (uint) nets.size()));
+  int                          splitcnt = 0;
+  tmg_conn                     conn;
+  conn.set_gv(gverbose);
+  conn.resetSplitCnt();
+
+  for (uint begin = 0; begin < nets.size(); begin += _netBatchSize) {
+    uint end    = std::min(begin + _netBatchSize, (uint) nets.size());
+    uint chunks = (end - begin + _netChunkSize - 1) / _netChunkSize;
+    std::vector<int> split_cnts(chunks, 0);
+
+    {
+      dbConcurrentReadScope concurrent_read(block);
+      runParallel(chunks, num_threads, [&](uint chunk) {
+        tmg_conn chunk_conn;
+        chunk_conn.set_gv(gverbose);
+        chunk_conn.resetSplitCnt();
+        uint chunk_begin = begin + chunk * _netChunkSize;
+        uint chunk_end   = std::min(chunk_begin + _netChunkSize, end);
+        for (uint i = chunk_begin; i < chunk_end; i++) {
+          tmg_conn_result& result = results[i - begin];
+          result._net             = NULL;
+          if (nets[i]->getSWires().size() == 0)
+            chunk_conn.analyzeNetDeferred(
+                nets[i], force, quiet, cutLength, maxLength, result);
+        }
+        split_cnts[chunk] = chunk_conn.getSplitCnt();
+      });
+    }
+
+    // Commit in net order, so the result does not depend on the thread
+    // count.
+    for (uint i = begin; i < end; i++) {
+      tmg_conn_result& result = results[i - begin];
+      if (result._net)
+        result.commit();
+      else
+        conn.analyzeNet(nets[i],
+                        force,
+                        verbose,
+                        quiet,
+                        no_convert,
+                        cutLength,
+                        maxLength,
+                        no_patch);
+    }
+    for (int cnt : split_cnts)
+      splitcnt += cnt;
+  }
+
+  if (conn._swireNetCnt)
+    notice(0, "Set dont_touch on %d swire nets.\n", conn._swireNetCnt);
+  splitcnt += conn.getSplitCnt();
   if (splitcnt != 0)
     notice(0, "Split top of %d T shapes.\n", splitcnt);
 }
 
+void orderWires(dbBlock* block,
+                bool     force,
+                int      cutLength,
+                int      maxLength,
+                bool     quiet,
+                int      num_threads)
+{
+  orderNets(block, force, cutLength, maxLength, quiet, false, num_threads);
+}
+
 void orderWires(dbBlock*    block,
                 const char* net_name_or_id,
                 bool        force,
                 bool        verbose,
                 bool        quiet,
                 int         cutLength,
-                int         maxLength)
+                int         maxLength,
+                int         num_threads)
 {
   bool no_patch = true;
-  if (_conn == NULL)
-    _conn = new tmg_conn();
-  _conn->set_gv(verbose);
   if (!net_name_or_id || !net_name_or_id[0]) {
-    orderWires(block, force, cutLength, maxLength, quiet);
+    orderNets(block, force, cutLength, maxLength, quiet, verbose, num_threads);
     return;
   }
   bool no_convert = false;
@@ -110,27 +178,36 @@ void orderWires(dbBlock*    block,
     notice(0, "skipping power net\n");
     return;
   }
-  _conn->resetSplitCnt();
-  _conn->analyzeNet(
+  tmg_conn conn;
+  conn.set_gv(verbose);
+  conn.resetSplitCnt();
+  conn.analyzeNet(
       net, force, verbose, false, no_convert, cutLength, maxLength, no_patch);
-  int splitcnt = _conn->getSplitCnt();
+  int splitcnt = conn.getSplitCnt();
   if (splitcnt != 0)
     notice(0, "Split top of %d T shapes.\n", splitcnt);
 }
 
+// Single nets are ordered one call at a time (e.g. by antenna repair), so
+// each thread keeps its tmg_conn and its buffers between calls.
+static tmg_conn& threadConn()
+{
+  static thread_local tmg_conn conn;
+  return conn;
+}
+
 void orderWires(dbNet* net, bool force, bool verbose)
 {
-  if (_conn == NULL)
-    _conn = new tmg_conn();
-  bool no_convert = false;
+  tmg_conn& conn       = threadConn();
+  bool      no_convert = false;
   if (net->getSigType() == dbSigType::POWER
       || net->getSigType() == dbSigType::GROUND) {
     notice(0, "skipping power net\n");
     return;
   }
-  _conn->resetSplitCnt();
-  _conn->analyzeNet(net, force, verbose, false, no_convert);
-  int splitcnt = _conn->getSplitCnt();
+  conn.resetSplitCnt();
+  conn.analyzeNet(net, force, verbose, false, no_convert);
+  int splitcnt = conn.getSplitCnt();
   if (splitcnt != 0)
     notice(0, "Split top of %d T shapes.\n", splitcnt);
 }
@@ -139,8 +216,7 @@ void orderWires(dbNet* net, bool force, bool verbose)
 
 void findDisconnects(dbBlock* block, bool verbose)
 {
-  if (_conn == NULL)
-    _conn = new tmg_conn();
+  tmg_conn               conn;
   uint                   disc = 0;
   dbSet<dbNet>           nets = block->getNets();
   dbSet<dbNet>::iterator net_itr;
@@ -151,8 +227,8 @@ void findDisconnects(dbBlock* block, bool verbose)
         || net->getSigType() == dbSigType::GROUND)
       continue;
     if (net->isWireOrdered()) {
-      _conn->_net = net;
-      _conn->checkConnected(verbose);
+      conn._net = net;
+      conn.checkConnected(verbose);
     }
     if (net->isDisconnected()) {
       if (verbose)
@@ -294,8 +370,7 @@ void orderWiresTableRun(dbNet* one_net, bool verbose)
 {
   if (_wtab == NULL)
     return;
-  if (_conn == NULL)
-    _conn = new tmg_conn();
+  tmg_conn&                     conn = threadConn();
   dbMap<dbNet, tmg_wire_link*>& V    = (*_wtab->_t);
   dbSet<dbNet>                  nets = _wtab->_block->getNets();
   dbSet<dbNet>::iterator        it;
@@ -317,12 +392,12 @@ void orderWiresTableRun(dbNet* one_net, bool verbose)
       notice(0, "\n");
     }
 
-    _conn->loadNet(net);
+    conn.loadNet(net);
     for (wl = V[net]; wl; wl = wl->next)
-      _conn->loadWire(wl->wire);
+      conn.loadWire(wl->wire);
     if (net->getWire())
-      _conn->loadWire(net->getWire());
-    _conn->analyzeLoadedNet(verbose, false);
+      conn.loadWire(net->getWire());
+    conn.analyzeLoadedNet(verbose, false);
   }
 }
 
@@ -1269,6 +1269,43 @@ defrRead(FILE           *f,
     return status;
 }
 
+int
+defrReadNets(FILE             *f,
+             const char       *fName,
+             defiUserData     uData,
+             int              case_sensitive,
+             defrNetCbkFnType netCbk,
+             defrNetCbkFnType snetCbk,
+             long long        lineOffset)
+{
+    defrCallbacks callbacks;
+    defrSession   session;
+
+    callbacks.NetCbk = netCbk;
+    callbacks.SNetCbk = snetCbk;
+
+    defrData defData(&callbacks, defContext.settings, &session);
+
+    if (defData.settings->reader_case_sensitive_set) {
+        defData.names_case_sensitive = case_sensitive;
+    } else if (defData.VersionNum > 5.5) {
+        defData.names_case_sensitive = true;
+    }
+
+    session.FileName = (char*) fName;
+    session.UserData = uData;
+    session.reader_case_sensitive = case_sensitive;
+    defData.File = f;
+    defData.nlines += lineOffset;
+
+    defData.NeedPathData = defData.settings->AddPathToNet;
+    if (defData.NeedPathData) {
+        defData.PathObj.Init();
+    }
+
+    return defyyparse(&defData);
+}
+
 void
 defrSetUserData(defiUserData ud)
 {
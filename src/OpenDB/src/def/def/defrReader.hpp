@@ -347,6 +347,19 @@ extern int defrRead (FILE *file,
                     defiUserData userData,
                     int case_sensitive);
 
+// A reentrant reader that only reports nets and special nets.  It uses
+// its own callbacks and session and shares the current settings, which
+// must not change while it runs, so several files can be read at the
+// same time on different threads.  Line numbers in messages are offset
+// by lineOffset.
+extern int defrReadNets (FILE *file,
+                         const char *fileName,
+                         defiUserData userData,
+                         int case_sensitive,
+                         defrNetCbkFnType netCbk,
+                         defrNetCbkFnType snetCbk,
+                         long long lineOffset);
+
 // Set/get the client-provided user data.  defi doesn't look at
 // this data at all, it simply passes the opaque defiUserData pointer
 // back to the application with each callback.  The client can
@@ -81,6 +81,11 @@ void defin::continueOnErrors()
   _reader->continueOnErrors();
 }
 
+void defin::setNumThreads(int num_threads)
+{
+  _reader->setNumThreads(num_threads);
+}
+
 void defin::namesAreDBIDs()
 {
   _reader->namesAreDBIDs();
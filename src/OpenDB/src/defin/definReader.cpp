@@ -33,10 +33,14 @@
 #include <ctype.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
+#include <algorithm>
 #include <string>
+#include <thread>
 
 #include "db.h"
+#include "dbParallel.h"
 #include "dbShape.h"
 #include "definBlockage.h"
 #include "definComponent.h"
@@ -99,6 +103,7 @@ definReader::definReader(dbDatabase* db, utl::Logger* logger)
   _db                 = db;
   _block_name         = NULL;
   _continue_on_errors = false;
+  _num_threads        = 1;
 
   definBase::setLogger(logger);
 
@@ -216,6 +221,11 @@ void definReader::setAssemblyMode()
   _netR->setAssemblyMode();
 }
 
+void definReader::setNumThreads(int num_threads)
+{
+  _num_threads = num_threads;
+}
+
 void definReader::useBlockName(const char* name)
 {
   if (_block_name)
@@ -581,13 +591,11 @@ int definReader::historyCallback(defrCallbackType_e /* unused: type */,
   return PARSE_OK;
 }
 
-int definReader::netCallback(defrCallbackType_e /* unused: type */,
-                             defiNet*     net,
-                             defiUserData data)
+// Translate a parsed net into definNet calls. NET is the reader's definNet,
+// or a definRecorder when the net was parsed on a worker thread.
+template <typename READER, typename NET>
+int definReader::translateNet(READER* reader, NET* netR, defiNet* net)
 {
-  definReader* reader = (definReader*) data;
-  definNet*    netR   = reader->_netR;
-
   if (net->numShieldNets() > 0) {
     UNSUPPORTED("SHIELDNET on net is unsupported");
   }
@@ -753,6 +761,30 @@ int definReader::netCallback(defrCallbackType_e /* unused: type */,
   return PARSE_OK;
 }
 
+int definReader::netCallback(defrCallbackType_e /* unused: type */,
+                             defiNet*     net,
+                             defiUserData data)
+{
+  definReader* reader = (definReader*) data;
+  return translateNet(reader, reader->_netR, net);
+}
+
+int definReader::recordNetCallback(defrCallbackType_e /* unused: type */,
+                                   defiNet*     net,
+                                   defiUserData data)
+{
+  definRecorder* recorder = (definRecorder*) data;
+  return translateNet(recorder, recorder, net);
+}
+
+int definReader::netsEndCallback(defrCallbackType_e /* unused: type */,
+                                 void* /* unused: v */,
+                                 defiUserData data)
+{
+  definReader* reader = (definReader*) data;
+  return reader->replayNets(false);
+}
+
 int definReader::nonDefaultRuleCallback(defrCallbackType_e /* unused: type */,
                                         defiNonDefault* rule,
                                         defiUserData    data)
@@ -1317,13 +1349,12 @@ int definReader::viaCallback(defrCallbackType_e /* unused: type */,
   return PARSE_OK;
 }
 
-int definReader::specialNetCallback(defrCallbackType_e /* unused: type */,
-                                    defiNet*     net,
-                                    defiUserData data)
+// Translate a parsed special net into definSNet calls (see translateNet).
+template <typename READER, typename SNET>
+int definReader::translateSpecialNet(READER*  reader,
+                                     SNET*    snetR,
+                                     defiNet* net)
 {
-  definReader* reader = (definReader*) data;
-  definSNet*   snetR  = reader->_snetR;
-
   if (net->hasCap()) {
     UNSUPPORTED("ESTCAP on special net is unsupported");
   }
@@ -1471,6 +1502,30 @@ int definReader::specialNetCallback(defrCallbackType_e /* unused: type */,
   return PARSE_OK;
 }
 
+int definReader::specialNetCallback(defrCallbackType_e /* unused: type */,
+                                    defiNet*     net,
+                                    defiUserData data)
+{
+  definReader* reader = (definReader*) data;
+  return translateSpecialNet(reader, reader->_snetR, net);
+}
+
+int definReader::recordSpecialNetCallback(defrCallbackType_e /* unused: type */,
+                                          defiNet*     net,
+                                          defiUserData data)
+{
+  definRecorder* recorder = (definRecorder*) data;
+  return translateSpecialNet(recorder, recorder, net);
+}
+
+int definReader::specialNetsEndCallback(defrCallbackType_e /* unused: type */,
+                                        void* /* unused: v */,
+                                        defiUserData data)
+{
+  definReader* reader = (definReader*) data;
+  return reader->replayNets(true);
+}
+
 void definReader::line(int line_num)
 {
   _logger->info(utl::ODB, 125,  "lines processed: {}", line_num);
@@ -1776,6 +1831,311 @@ bool definReader::replaceWires(dbBlock* block, const char* def_file)
   return errors() == 0;
 }
 
+// The smallest piece of a NETS or SPECIALNETS section given to a worker.
+static const size_t MIN_NET_CHUNK_SIZE = 64 * 1024;
+
+static const char* skipBlanks(const char* p, const char* end)
+{
+  while (p < end && (*p == ' ' || *p == '\t' || *p == '\r'))
+    ++p;
+  return p;
+}
+
+// True if the line at p (ending at end) starts with token.
+static bool startsWith(const char* p, const char* end, const char* token)
+{
+  size_t len = strlen(token);
+  if ((size_t) (end - p) < len || strncmp(p, token, len) != 0)
+    return false;
+  return p + len == end || isspace(p[len]);
+}
+
+static bool contains(const char* p, const char* end, const char* str)
+{
+  return std::search(p, end, str, str + strlen(str)) != end;
+}
+
+//
+// Split the bodies of the NETS and SPECIALNETS sections of f into chunks
+// that start at a net, reading f a line at a time. header gets the
+// statements a chunk needs to be parsed on its own and main_text gets the
+// file with the section bodies blanked out (keeping the line count).
+// Sections and header statements are expected to start a line, as every
+// DEF writer does. Anything else is left to the main parse. Returns false
+// if the file cannot be split.
+//
+bool definReader::splitNets(FILE*        f,
+                            size_t       size,
+                            int          num_threads,
+                            std::string& header,
+                            std::string& main_text)
+{
+  enum Section
+  {
+    TOP,
+    PROPERTYDEFINITIONS,
+    EXTENSION,
+    HISTORY,
+    NETS,
+    SPECIALNETS
+  };
+
+  const size_t chunk_size
+      = std::max(MIN_NET_CHUNK_SIZE, size / (8 * num_threads));
+
+  static const char* header_statements[] = {"VERSION",
+                                            "NAMESCASESENSITIVE",
+                                            "DIVIDERCHAR",
+                                            "BUSBITCHARS",
+                                            "DESIGN",
+                                            "UNITS"};
+
+  Section section  = TOP;
+  bool    found[2] = {false, false};
+  bool    ok       = true;
+  char*   buf      = NULL;
+  size_t  buf_size = 0;
+  ssize_t len;
+
+  for (int line = 1; ok && (len = getline(&buf, &buf_size, f)) != -1;
+       ++line) {
+    const char* p     = buf;
+    const char* next  = buf + len;
+    const char* eol   = (len > 0 && next[-1] == '\n') ? next - 1 : next;
+    const char* token = skipBlanks(p, eol);
+
+    switch (section) {
+      case TOP:
+        main_text.append(p, next);
+        for (const char* statement : header_statements) {
+          if (startsWith(token, eol, statement)) {
+            if (!contains(token, eol, ";"))
+              ok = false;
+            header.append(p, next);
+          }
+        }
+        if (startsWith(token, eol, "PROPERTYDEFINITIONS")) {
+          header.append(p, next);
+          section = PROPERTYDEFINITIONS;
+        } else if (startsWith(token, eol, "BEGINEXT")) {
+          if (!contains(token, eol, "ENDEXT"))
+            section = EXTENSION;
+        } else if (startsWith(token, eol, "HISTORY")) {
+          if (!contains(token, eol, ";"))
+            section = HISTORY;
+        } else if (startsWith(token, eol, "NETS")
+                   || startsWith(token, eol, "SPECIALNETS")) {
+          bool special = *token == 'S';
+          if (!contains(token, eol, ";") || found[special]) {
+            ok = false;
+            break;
+          }
+          found[special] = true;
+          section        = special ? SPECIALNETS : NETS;
+          _net_chunks.emplace_back();
+          NetChunk& chunk = _net_chunks.back();
+          chunk._line     = line + 1;
+          chunk._special  = special;
+          chunk._status   = 0;
+          chunk._parsed   = false;
+        }
+        break;
+
+      case PROPERTYDEFINITIONS:
+        main_text.append(p, next);
+        header.append(p, next);
+        if (startsWith(token, eol, "END"))
+          section = TOP;
+        break;
+
+      case EXTENSION:
+        main_text.append(p, next);
+        if (contains(token, eol, "ENDEXT"))
+          section = TOP;
+        break;
+
+      case HISTORY:
+        main_text.append(p, next);
+        if (contains(token, eol, ";"))
+          section = TOP;
+        break;
+
+      case NETS:
+      case SPECIALNETS: {
+        NetChunk* chunk = &_net_chunks.back();
+        if (startsWith(token, eol, "END")) {
+          if (chunk->_text.empty())
+            _net_chunks.pop_back();
+          main_text.append(p, next);
+          section = TOP;
+          break;
+        }
+        if (startsWith(token, eol, "-") && chunk->_text.size() >= chunk_size) {
+          NetChunk next_chunk;
+          next_chunk._line    = line;
+          next_chunk._special = chunk->_special;
+          next_chunk._status  = 0;
+          next_chunk._parsed  = false;
+          _net_chunks.push_back(std::move(next_chunk));
+          chunk = &_net_chunks.back();
+        }
+        chunk->_text.append(p, next);
+        main_text += '\n';
+        break;
+      }
+    }
+  }
+  free(buf);
+
+  return ok && section != NETS && section != SPECIALNETS;
+}
+
+void definReader::parseNetChunk(NetChunk&          chunk,
+                                const std::string& header,
+                                const char*        file)
+{
+  const char* section = chunk._special ? "SPECIALNETS" : "NETS";
+
+  std::string text = header;
+  text += std::string(section) + " 0 ;\n";
+  long long line_offset
+      = chunk._line - 1 - std::count(text.begin(), text.end(), '\n');
+  text.append(chunk._text);
+  text += std::string("END ") + section + "\nEND DESIGN\n";
+  std::string().swap(chunk._text);
+
+  definRecorder& recorder       = chunk._recorder;
+  recorder._continue_on_errors = _continue_on_errors;
+
+  FILE* f = fmemopen((void*) text.data(), text.size(), "r");
+  if (f == NULL) {
+    recorder.error("cannot parse nets on a worker thread");
+    chunk._status = PARSE_ERROR;
+    return;
+  }
+
+  chunk._status = defrReadNets(f,
+                               file,
+                               (defiUserData) &recorder,
+                               /* case sensitive */ 1,
+                               chunk._special ? NULL : recordNetCallback,
+                               chunk._special ? recordSpecialNetCallback : NULL,
+                               line_offset);
+  fclose(f);
+}
+
+void definReader::setNetChunkParsed(NetChunk& chunk)
+{
+  {
+    std::lock_guard<std::mutex> lock(_net_chunks_lock);
+    chunk._parsed = true;
+  }
+  _net_chunk_parsed.notify_all();
+}
+
+void definReader::waitForNetChunk(NetChunk& chunk)
+{
+  std::unique_lock<std::mutex> lock(_net_chunks_lock);
+  _net_chunk_parsed.wait(lock, [&chunk]() { return chunk._parsed; });
+}
+
+// Create the nets recorded by the workers for a NETS or SPECIALNETS
+// section, in file order. Each chunk is replayed as soon as it is parsed
+// and its recorder is freed, while the workers parse the chunks after it.
+int definReader::replayNets(bool special)
+{
+  for (NetChunk& chunk : _net_chunks) {
+    if (chunk._special != special)
+      continue;
+
+    waitForNetChunk(chunk);
+
+    if (special)
+      chunk._recorder.replay(_snetR, this);
+    else
+      chunk._recorder.replay(_netR, this);
+
+    chunk._recorder.clear();
+
+    if (chunk._status != 0 && !_continue_on_errors)
+      return PARSE_ERROR;
+  }
+
+  return PARSE_OK;
+}
+
+//
+// Parse f with the callbacks that are set. With more than one thread the
+// NETS and SPECIALNETS sections are cut into chunks that are parsed on
+// worker threads while the main parse reads the rest of the file. The
+// recorded nets are created at the end of each section, so the block is
+// the same as the one a serial read creates.
+//
+int definReader::read(FILE* f, const char* file)
+{
+  defrSetNetEndCbk(netsEndCallback);
+  defrSetSNetEndCbk(specialNetsEndCallback);
+
+  int num_threads = _num_threads;
+  if (num_threads <= 0)
+    num_threads = std::thread::hardware_concurrency();
+
+  if (num_threads <= 1)
+    return defrRead(f, file, (defiUserData) this, /* case sensitive */ 1);
+
+  long size = -1;
+  if (fseek(f, 0, SEEK_END) == 0)
+    size = ftell(f);
+  rewind(f);
+
+  std::string header;
+  std::string main_text;
+  bool        split
+      = size > 0 && splitNets(f, size, num_threads, header, main_text);
+  rewind(f);
+  if (!split || _net_chunks.empty()) {
+    _net_chunks.clear();
+    return defrRead(f, file, (defiUserData) this, /* case sensitive */ 1);
+  }
+
+  FILE* main_file = fmemopen((void*) main_text.data(), main_text.size(), "r");
+  if (main_file == NULL) {
+    _net_chunks.clear();
+    return defrRead(f, file, (defiUserData) this, /* case sensitive */ 1);
+  }
+
+  // A chunk is marked parsed also when its parse throws, so the replay
+  // never waits for it forever; the exception is rethrown below.
+  _net_chunks_parsed = std::async(std::launch::async, [&]() {
+    runParallel(_net_chunks.size(), num_threads, [&](uint i) {
+      NetChunk& chunk = _net_chunks[i];
+      try {
+        parseNetChunk(chunk, header, file);
+      } catch (...) {
+        chunk._status = PARSE_ERROR;
+        setNetChunkParsed(chunk);
+        throw;
+      }
+      setNetChunkParsed(chunk);
+    });
+  });
+
+  int res = defrRead(main_file, file, (defiUserData) this, /* case sensitive */ 1);
+  fclose(main_file);
+
+  // The main parse may have stopped before the end of a net section.
+  if (_net_chunks_parsed.valid())
+    _net_chunks_parsed.get();
+
+  for (NetChunk& chunk : _net_chunks) {
+    if (res == 0)
+      res = chunk._status;
+  }
+  _net_chunks.clear();
+
+  return res;
+}
+
 bool definReader::createBlock(const char* file)
 {
   FILE* f = fopen(file, "r");
@@ -1824,7 +2184,7 @@ bool definReader::createBlock(const char* file)
 
   defrSetAddPathToNet();
 
-  int res = defrRead(f, file, (defiUserData) this, /* case sensitive */ 1);
+  int res = read(f, file);
   if (res != 0 || _errors != 0) {
     _logger->warn(utl::ODB, 149,  "DEF parser returns an error!");
     if (!_continue_on_errors) {
@@ -1859,7 +2219,7 @@ bool definReader::replaceWires(const char* file)
 
   defrSetAddPathToNet();
 
-  int res = defrRead(f, file, (defiUserData) this, /* case sensitive */ 1);
+  int res = read(f, file);
   if (res != 0) {
     _logger->warn(utl::ODB, 151,  "DEF parser returns an error!");
     if (!_continue_on_errors) {
@@ -32,8 +32,15 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <string>
+#include <vector>
+
 #include "odb.h"
 #include "definBase.h"
+#include "definRecorder.h"
 #include "defrReader.hpp"
 
 namespace utl
@@ -60,6 +67,17 @@ class definPinProps;
 
 class definReader : public definBase
 {
+  // A piece of a NETS or SPECIALNETS section parsed on a worker thread.
+  struct NetChunk
+  {
+    std::string   _text;  // freed once parsed
+    int           _line;  // line number of the start of _text in the file
+    bool          _special;
+    int           _status;
+    bool          _parsed;  // guarded by _net_chunks_lock
+    definRecorder _recorder;
+  };
+
   dbDatabase*             _db;
   definBlockage*          _blockageR;
   definComponent*         _componentR;
@@ -79,6 +97,11 @@ class definReader : public definBase
   bool                    _update;
   bool                    _continue_on_errors;
   const char*             _block_name;
+  int                     _num_threads;
+  std::vector<NetChunk>   _net_chunks;
+  std::future<void>       _net_chunks_parsed;
+  std::mutex              _net_chunks_lock;
+  std::condition_variable _net_chunk_parsed;
 
   void init();
   void setLibs(std::vector<dbLib*>& lib_names);
@@ -95,6 +118,24 @@ class definReader : public definBase
   void replaceWires();
   int  errors();
 
+  int  read(FILE* f, const char* file);
+  bool splitNets(FILE*        f,
+                 size_t       size,
+                 int          num_threads,
+                 std::string& header,
+                 std::string& main_text);
+  void parseNetChunk(NetChunk&          chunk,
+                     const std::string& header,
+                     const char*        file);
+  void setNetChunkParsed(NetChunk& chunk);
+  void waitForNetChunk(NetChunk& chunk);
+  int  replayNets(bool special);
+
+  template <typename READER, typename NET>
+  static int translateNet(READER* reader, NET* netR, defiNet* net);
+  template <typename READER, typename SNET>
+  static int translateSpecialNet(READER* reader, SNET* snetR, defiNet* net);
+
   // Parser callbacks
   static int blockageCallback(defrCallbackType_e type,
                               defiBlockage*      blockage,
@@ -148,6 +189,14 @@ class definReader : public definBase
                          defiNet*           net,
                          defiUserData       data);
 
+  static int netsEndCallback(defrCallbackType_e type,
+                             void*              v,
+                             defiUserData       data);
+
+  static int recordNetCallback(defrCallbackType_e type,
+                               defiNet*           net,
+                               defiUserData       data);
+
   static int nonDefaultRuleCallback(defrCallbackType_e type,
                                     defiNonDefault*    rule,
                                     defiUserData       data);
@@ -198,6 +247,14 @@ class definReader : public definBase
                                 defiNet*           net,
                                 defiUserData       data);
 
+  static int specialNetsEndCallback(defrCallbackType_e type,
+                                    void*              v,
+                                    defiUserData       data);
+
+  static int recordSpecialNetCallback(defrCallbackType_e type,
+                                      defiNet*           net,
+                                      defiUserData       data);
+
   static int stylesCallback(defrCallbackType_e type,
                             int                count,
                             defiUserData       data);
@@ -232,12 +289,15 @@ class definReader : public definBase
   void useBlockName(const char* name);
   void namesAreDBIDs();
   void setAssemblyMode();
+  void setNumThreads(int num_threads);
 
   dbChip*  createChip(std::vector<dbLib*>& search_libs, const char* def_file);
   dbBlock* createBlock(dbBlock*             parent,
                        std::vector<dbLib*>& search_libs,
                        const char*          def_file);
   bool     replaceWires(dbBlock* block, const char* def_file);
+
+  friend class definRecorder;
 };
 
 }  // namespace odb
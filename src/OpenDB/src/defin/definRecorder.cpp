@@ -0,0 +1,453 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2019, Nefelus Inc
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "definRecorder.h"
+
+#include <assert.h>
+#include <string.h>
+
+#include "db.h"
+#include "definNet.h"
+#include "definReader.h"
+#include "definSNet.h"
+
+namespace odb {
+
+static const uint NO_STRING = (uint) -1;
+
+definRecorder::definRecorder() : _continue_on_errors(false)
+{
+}
+
+void definRecorder::clear()
+{
+  std::vector<Op>().swap(_ops);
+  std::vector<char>().swap(_strings);
+}
+
+definRecorder::Op& definRecorder::add(OpType type)
+{
+  _ops.emplace_back();
+  Op& op     = _ops.back();
+  op._type   = type;
+  op._str[0] = NO_STRING;
+  op._str[1] = NO_STRING;
+  op._dvalue = 0.0;
+  memset(op._value, 0, sizeof(op._value));
+  return op;
+}
+
+uint definRecorder::addString(const char* str)
+{
+  if (str == NULL)
+    return NO_STRING;
+
+  uint offset = _strings.size();
+  _strings.insert(_strings.end(), str, str + strlen(str) + 1);
+  return offset;
+}
+
+const char* definRecorder::getString(uint offset) const
+{
+  if (offset == NO_STRING)
+    return NULL;
+
+  return &_strings[offset];
+}
+
+void definRecorder::begin(const char* name)
+{
+  uint str = addString(name);
+  add(BEGIN)._str[0] = str;
+}
+
+void definRecorder::beginMustjoin(const char* iname, const char* pname)
+{
+  uint s0    = addString(iname);
+  uint s1    = addString(pname);
+  Op&  op    = add(BEGIN_MUSTJOIN);
+  op._str[0] = s0;
+  op._str[1] = s1;
+}
+
+void definRecorder::connection(const char* iname, const char* pname)
+{
+  uint s0    = addString(iname);
+  uint s1    = addString(pname);
+  Op&  op    = add(CONNECTION);
+  op._str[0] = s0;
+  op._str[1] = s1;
+}
+
+void definRecorder::connection(const char* iname,
+                               const char* pname,
+                               bool        synthesized)
+{
+  uint s0      = addString(iname);
+  uint s1      = addString(pname);
+  Op&  op      = add(SNET_CONNECTION);
+  op._str[0]   = s0;
+  op._str[1]   = s1;
+  op._value[0] = synthesized;
+}
+
+void definRecorder::nonDefaultRule(const char* rule)
+{
+  uint str = addString(rule);
+  add(NON_DEFAULT_RULE)._str[0] = str;
+}
+
+void definRecorder::use(dbSigType type)
+{
+  add(USE)._value[0] = type.getValue();
+}
+
+void definRecorder::wire(dbWireType type)
+{
+  add(WIRE)._value[0] = type.getValue();
+}
+
+void definRecorder::wire(dbWireType type, const char* shield)
+{
+  uint str     = addString(shield);
+  Op&  op      = add(SNET_WIRE);
+  op._str[0]   = str;
+  op._value[0] = type.getValue();
+}
+
+void definRecorder::path(const char* layer)
+{
+  uint str = addString(layer);
+  add(PATH)._str[0] = str;
+}
+
+void definRecorder::path(const char* layer, int width)
+{
+  uint str     = addString(layer);
+  Op&  op      = add(SNET_PATH);
+  op._str[0]   = str;
+  op._value[0] = width;
+}
+
+void definRecorder::pathTaper(const char* layer)
+{
+  uint str = addString(layer);
+  add(PATH_TAPER)._str[0] = str;
+}
+
+void definRecorder::pathTaperRule(const char* layer, const char* rule)
+{
+  uint s0    = addString(layer);
+  uint s1    = addString(rule);
+  Op&  op    = add(PATH_TAPER_RULE);
+  op._str[0] = s0;
+  op._str[1] = s1;
+}
+
+void definRecorder::pathShape(const char* type)
+{
+  uint str = addString(type);
+  add(PATH_SHAPE)._str[0] = str;
+}
+
+void definRecorder::pathPoint(int x, int y)
+{
+  Op& op       = add(PATH_POINT);
+  op._value[0] = x;
+  op._value[1] = y;
+}
+
+void definRecorder::pathPoint(int x, int y, int ext)
+{
+  Op& op       = add(PATH_POINT_EXT);
+  op._value[0] = x;
+  op._value[1] = y;
+  op._value[2] = ext;
+}
+
+void definRecorder::pathVia(const char* via)
+{
+  uint str = addString(via);
+  add(PATH_VIA)._str[0] = str;
+}
+
+void definRecorder::pathVia(const char* via, dbOrientType orient)
+{
+  uint str     = addString(via);
+  Op&  op      = add(PATH_VIA_ORIENT);
+  op._str[0]   = str;
+  op._value[0] = orient.getValue();
+}
+
+void definRecorder::pathRect(int deltaX1, int deltaY1, int deltaX2, int deltaY2)
+{
+  Op& op       = add(PATH_RECT);
+  op._value[0] = deltaX1;
+  op._value[1] = deltaY1;
+  op._value[2] = deltaX2;
+  op._value[3] = deltaY2;
+}
+
+void definRecorder::rect(const char* layer, int x1, int y1, int x2, int y2)
+{
+  uint str     = addString(layer);
+  Op&  op      = add(RECT);
+  op._str[0]   = str;
+  op._value[0] = x1;
+  op._value[1] = y1;
+  op._value[2] = x2;
+  op._value[3] = y2;
+}
+
+void definRecorder::pathEnd()
+{
+  add(PATH_END);
+}
+
+void definRecorder::wireEnd()
+{
+  add(WIRE_END);
+}
+
+void definRecorder::source(dbSourceType source)
+{
+  add(SOURCE)._value[0] = source.getValue();
+}
+
+void definRecorder::weight(int weight)
+{
+  add(WEIGHT)._value[0] = weight;
+}
+
+void definRecorder::fixedbump()
+{
+  add(FIXEDBUMP);
+}
+
+void definRecorder::property(const char* name, const char* value)
+{
+  uint s0    = addString(name);
+  uint s1    = addString(value);
+  Op&  op    = add(STRING_PROPERTY);
+  op._str[0] = s0;
+  op._str[1] = s1;
+}
+
+void definRecorder::property(const char* name, int value)
+{
+  uint str     = addString(name);
+  Op&  op      = add(INT_PROPERTY);
+  op._str[0]   = str;
+  op._value[0] = value;
+}
+
+void definRecorder::property(const char* name, double value)
+{
+  uint str   = addString(name);
+  Op&  op    = add(DOUBLE_PROPERTY);
+  op._str[0] = str;
+  op._dvalue = value;
+}
+
+void definRecorder::end()
+{
+  add(END);
+}
+
+void definRecorder::error(const char* msg)
+{
+  uint str = addString(msg);
+  add(ERROR)._str[0] = str;
+}
+
+void definRecorder::replay(definNet* netR, definReader* reader) const
+{
+  for (const Op& op : _ops) {
+    const char* s0 = getString(op._str[0]);
+    const char* s1 = getString(op._str[1]);
+
+    switch (op._type) {
+      case BEGIN:
+        netR->begin(s0);
+        break;
+      case BEGIN_MUSTJOIN:
+        netR->beginMustjoin(s0, s1);
+        break;
+      case CONNECTION:
+        netR->connection(s0, s1);
+        break;
+      case NON_DEFAULT_RULE:
+        netR->nonDefaultRule(s0);
+        break;
+      case USE:
+        netR->use(dbSigType((dbSigType::Value) op._value[0]));
+        break;
+      case WIRE:
+        netR->wire(dbWireType((dbWireType::Value) op._value[0]));
+        break;
+      case PATH:
+        netR->path(s0);
+        break;
+      case PATH_TAPER:
+        netR->pathTaper(s0);
+        break;
+      case PATH_TAPER_RULE:
+        netR->pathTaperRule(s0, s1);
+        break;
+      case PATH_POINT:
+        netR->pathPoint(op._value[0], op._value[1]);
+        break;
+      case PATH_POINT_EXT:
+        netR->pathPoint(op._value[0], op._value[1], op._value[2]);
+        break;
+      case PATH_VIA:
+        netR->pathVia(s0);
+        break;
+      case PATH_VIA_ORIENT:
+        netR->pathVia(s0, dbOrientType((dbOrientType::Value) op._value[0]));
+        break;
+      case PATH_RECT:
+        netR->pathRect(
+            op._value[0], op._value[1], op._value[2], op._value[3]);
+        break;
+      case PATH_END:
+        netR->pathEnd();
+        break;
+      case WIRE_END:
+        netR->wireEnd();
+        break;
+      case SOURCE:
+        netR->source(dbSourceType((dbSourceType::Value) op._value[0]));
+        break;
+      case WEIGHT:
+        netR->weight(op._value[0]);
+        break;
+      case FIXEDBUMP:
+        netR->fixedbump();
+        break;
+      case STRING_PROPERTY:
+        netR->property(s0, s1);
+        break;
+      case INT_PROPERTY:
+        netR->property(s0, op._value[0]);
+        break;
+      case DOUBLE_PROPERTY:
+        netR->property(s0, op._dvalue);
+        break;
+      case END:
+        netR->end();
+        break;
+      case ERROR:
+        reader->error(s0);
+        break;
+      default:
+        assert(0);  // special net operation
+        break;
+    }
+  }
+}
+
+void definRecorder::replay(definSNet* snetR, definReader* reader) const
+{
+  for (const Op& op : _ops) {
+    const char* s0 = getString(op._str[0]);
+    const char* s1 = getString(op._str[1]);
+
+    switch (op._type) {
+      case BEGIN:
+        snetR->begin(s0);
+        break;
+      case SNET_CONNECTION:
+        snetR->connection(s0, s1, op._value[0]);
+        break;
+      case USE:
+        snetR->use(dbSigType((dbSigType::Value) op._value[0]));
+        break;
+      case SNET_WIRE:
+        snetR->wire(dbWireType((dbWireType::Value) op._value[0]), s0);
+        break;
+      case SNET_PATH:
+        snetR->path(s0, op._value[0]);
+        break;
+      case PATH_SHAPE:
+        snetR->pathShape(s0);
+        break;
+      case PATH_POINT:
+        snetR->pathPoint(op._value[0], op._value[1]);
+        break;
+      case PATH_POINT_EXT:
+        snetR->pathPoint(op._value[0], op._value[1], op._value[2]);
+        break;
+      case PATH_VIA:
+        snetR->pathVia(s0);
+        break;
+      case RECT:
+        snetR->rect(s0, op._value[0], op._value[1], op._value[2], op._value[3]);
+        break;
+      case PATH_END:
+        snetR->pathEnd();
+        break;
+      case WIRE_END:
+        snetR->wireEnd();
+        break;
+      case SOURCE:
+        snetR->source(dbSourceType((dbSourceType::Value) op._value[0]));
+        break;
+      case WEIGHT:
+        snetR->weight(op._value[0]);
+        break;
+      case FIXEDBUMP:
+        snetR->fixedbump();
+        break;
+      case STRING_PROPERTY:
+        snetR->property(s0, s1);
+        break;
+      case INT_PROPERTY:
+        snetR->property(s0, op._value[0]);
+        break;
+      case DOUBLE_PROPERTY:
+        snetR->property(s0, op._dvalue);
+        break;
+      case END:
+        snetR->end();
+        break;
+      case ERROR:
+        reader->error(s0);
+        break;
+      default:
+        assert(0);  // net operation
+        break;
+    }
+  }
+}
+
+}  // namespace odb
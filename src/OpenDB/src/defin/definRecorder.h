@@ -0,0 +1,146 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2019, Nefelus Inc
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "dbTypes.h"
+#include "odb.h"
+
+namespace odb {
+
+class definNet;
+class definReader;
+class definSNet;
+
+//
+// definRecorder records the definNet and definSNet calls made for a piece
+// of a NETS or SPECIALNETS section so the piece can be parsed on a worker
+// thread and its objects created later on the main thread, in file order.
+//
+class definRecorder
+{
+  enum OpType
+  {
+    BEGIN,
+    BEGIN_MUSTJOIN,
+    CONNECTION,
+    SNET_CONNECTION,
+    NON_DEFAULT_RULE,
+    USE,
+    WIRE,
+    SNET_WIRE,
+    PATH,
+    SNET_PATH,
+    PATH_TAPER,
+    PATH_TAPER_RULE,
+    PATH_SHAPE,
+    PATH_POINT,
+    PATH_POINT_EXT,
+    PATH_VIA,
+    PATH_VIA_ORIENT,
+    PATH_RECT,
+    RECT,
+    PATH_END,
+    WIRE_END,
+    SOURCE,
+    WEIGHT,
+    FIXEDBUMP,
+    STRING_PROPERTY,
+    INT_PROPERTY,
+    DOUBLE_PROPERTY,
+    END,
+    ERROR
+  };
+
+  struct Op
+  {
+    OpType _type;
+    uint   _str[2];  // offsets into _strings
+    int    _value[4];
+    double _dvalue;
+  };
+
+  std::vector<Op>   _ops;
+  std::vector<char> _strings;
+
+  Op&         add(OpType type);
+  uint        addString(const char* str);
+  const char* getString(uint offset) const;
+
+ public:
+  bool _continue_on_errors;
+
+  definRecorder();
+
+  /// Net and special net interface methods
+  void begin(const char* name);
+  void beginMustjoin(const char* iname, const char* pname);
+  void connection(const char* iname, const char* pname);
+  void connection(const char* iname, const char* pname, bool synthesized);
+  void nonDefaultRule(const char* rule);
+  void use(dbSigType type);
+  void wire(dbWireType type);
+  void wire(dbWireType type, const char* shield);
+  void path(const char* layer);
+  void path(const char* layer, int width);
+  void pathTaper(const char* layer);
+  void pathTaperRule(const char* layer, const char* rule);
+  void pathShape(const char* type);
+  void pathPoint(int x, int y);
+  void pathPoint(int x, int y, int ext);
+  void pathVia(const char* via);
+  void pathVia(const char* via, dbOrientType orient);
+  void pathRect(int deltaX1, int deltaY1, int deltaX2, int deltaY2);
+  void rect(const char* layer, int x1, int y1, int x2, int y2);
+  void pathEnd();
+  void wireEnd();
+  void source(dbSourceType source);
+  void weight(int weight);
+  void fixedbump();
+  void property(const char* name, const char* value);
+  void property(const char* name, int value);
+  void property(const char* name, double value);
+  void end();
+  void error(const char* msg);
+
+  /// Replay the recorded calls. Errors are reported to reader.
+  void replay(definNet* netR, definReader* reader) const;
+  void replay(definSNet* snetR, definReader* reader) const;
+
+  /// Drop the recorded calls and release their memory.
+  void clear();
+};
+
+}  // namespace odb
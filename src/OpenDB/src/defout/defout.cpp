@@ -73,6 +73,11 @@ void defout::setVersion(Version v)
   _writer->setVersion(v);
 }
 
+void defout::setNumThreads(int num_threads)
+{
+  _writer->setNumThreads(num_threads);
+}
+
 bool defout::writeBlock(dbBlock* block, const char* def_file)
 {
   return _writer->writeBlock(block, def_file);
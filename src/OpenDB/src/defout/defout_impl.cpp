@@ -33,11 +33,13 @@
 #include <stdio.h>
 
 #include <limits>
+#include <memory>
 #include <set>
 #include <string>
 
 #include "db.h"
 #include "dbMap.h"
+#include "dbParallel.h"
 #include "dbWireCodec.h"
 #include "defout_impl.h"
 
@@ -95,6 +97,89 @@ static const char* defIoType(dbIoType type)
   return type.getString();
 }
 
+defout_impl::defout_impl(const defout_impl& writer, FILE* out)
+    : _dist_factor(writer._dist_factor),
+      _out(out),
+      _use_net_inst_ids(writer._use_net_inst_ids),
+      _use_master_ids(writer._use_master_ids),
+      _use_alias(writer._use_alias),
+      _select_net_map(writer._select_net_map),
+      _select_inst_map(writer._select_inst_map),
+      _non_default_rule(NULL),
+      _version(writer._version),
+      _prop_defs(writer._prop_defs),
+      _logger(writer._logger),
+      _num_threads(1)
+{
+}
+
+// Write the objects in order. With several threads the objects are split
+// in chunks that are formatted into memory by their own writer, a batch of
+// chunks at a time, and then copied to the file in order.
+template <typename T>
+void defout_impl::writeChunked(const std::vector<T*>& objects,
+                               void (defout_impl::*write)(T*))
+{
+  const uint chunk_size = 256;
+  uint       num_chunks = (objects.size() + chunk_size - 1) / chunk_size;
+  int        num_threads = _num_threads;
+
+  if (num_threads <= 0)
+    num_threads = std::thread::hardware_concurrency();
+
+  if (num_threads <= 1 || num_chunks <= 1) {
+    for (T* object : objects)
+      (this->*write)(object);
+    return;
+  }
+
+  // The text of a chunk, freed by the next batch or on an exception.
+  struct Chunk
+  {
+    char*  _text = NULL;
+    size_t _size = 0;
+
+    void clear()
+    {
+      free(_text);
+      _text = NULL;
+      _size = 0;
+    }
+
+    ~Chunk() { free(_text); }
+  };
+
+  uint               batch_size = num_threads * 4;
+  std::vector<Chunk> chunks(batch_size);
+
+  for (uint batch = 0; batch < num_chunks; batch += batch_size) {
+    uint n = std::min(batch_size, num_chunks - batch);
+
+    runParallel(n, num_threads, [&](uint i) {
+      Chunk& chunk = chunks[i];
+      chunk.clear();
+      FILE* out = open_memstream(&chunk._text, &chunk._size);
+      if (out == NULL)
+        throw ZOutOfMemory();
+
+      // Closing the stream finalizes the chunk's text.
+      std::unique_ptr<FILE, int (*)(FILE*)> closer(out, fclose);
+
+      defout_impl writer(*this, out);
+      size_t      begin = (size_t) (batch + i) * chunk_size;
+      size_t      end   = std::min(begin + chunk_size, objects.size());
+
+      for (size_t j = begin; j < end; ++j)
+        (writer.*write)(objects[j]);
+    });
+
+    for (uint i = 0; i < n; ++i) {
+      fwrite(chunks[i]._text, 1, chunks[i]._size, _out);
+      chunks[i].clear();
+    }
+  }
+}
+
 void defout_impl::selectNet(dbNet* net)
 {
   if (!net)
@@ -199,6 +284,9 @@ bool defout_impl::writeBlock(dbBlock* block, const char* def_file)
   if ((x1 != 0) || (y1 != 0) || (x2 != 0) || (y2 != 0))
     fprintf(_out, "DIEAREA ( %d %d ) ( %d %d ) ;\n", x1, y1, x2, y2);
 
+  // The components and nets are read by several threads.
+  dbConcurrentReadScope concurrent_read(_num_threads != 1 ? block : NULL);
+
   writeRows(block);
   writeTracks(block);
   writeGCells(block);
@@ -460,12 +548,15 @@ void defout_impl::writeInsts(dbBlock* block)
   fprintf(_out, "COMPONENTS %u ;\n", insts.size());
 
   // Sort the components for consistent output
+  std::vector<dbInst*> selected;
   for (dbInst* inst : sortedSet(insts)) {
     if (_select_inst_map && !(*_select_inst_map)[inst])
       continue;
-    writeInst(inst);
+    selected.push_back(inst);
   }
 
+  writeChunked(selected, &defout_impl::writeInst);
+
   fprintf(_out, "END COMPONENTS\n");
 }
 
@@ -1258,26 +1349,32 @@ void defout_impl::writeNets(dbBlock* block)
   if (snet_cnt > 0) {
     fprintf(_out, "SPECIALNETS %d ;\n", snet_cnt);
 
+    std::vector<dbNet*> snets;
     for (dbNet* net : sorted_nets) {
       if (_select_net_map && !(*_select_net_map)[net])
         continue;
       if (net->isSpecial())
-        writeSNet(net);
+        snets.push_back(net);
     }
 
+    writeChunked(snets, &defout_impl::writeSNet);
+
     fprintf(_out, "END SPECIALNETS\n");
   }
 
   fprintf(_out, "NETS %d ;\n", net_cnt);
 
+  std::vector<dbNet*> nets_to_write;
   for (dbNet* net : sorted_nets) {
     if (_select_net_map && !(*_select_net_map)[net])
       continue;
 
     if (regular_net[net] == 1)
-      writeNet(net);
+      nets_to_write.push_back(net);
   }
 
+  writeChunked(nets_to_write, &defout_impl::writeNet);
+
   fprintf(_out, "END NETS\n");
 }
 
@@ -39,6 +39,7 @@
 #include <list>
 #include <map>
 #include <string>
+#include <vector>
 #include "defout.h"
 namespace utl
 {
@@ -68,19 +69,23 @@ class defout_impl
     SPECIALNET
   };
 
-  double                      _dist_factor;
-  FILE*                       _out;
-  bool                        _use_net_inst_ids;
-  bool                        _use_master_ids;
-  bool                        _use_alias;
-  std::list<dbNet*>           _select_net_list;
-  std::list<dbInst*>          _select_inst_list;
-  dbMap<dbNet, char>*         _select_net_map;
-  dbMap<dbInst, char>*        _select_inst_map;
-  dbTechNonDefaultRule*       _non_default_rule;
-  int                         _version;
-  std::map<std::string, bool> _prop_defs[9];
-  utl::Logger*                _logger;
+  double                       _dist_factor;
+  FILE*                        _out;
+  bool                         _use_net_inst_ids;
+  bool                         _use_master_ids;
+  bool                         _use_alias;
+  std::list<dbNet*>            _select_net_list;
+  std::list<dbInst*>           _select_inst_list;
+  dbMap<dbNet, char>*          _select_net_map;
+  dbMap<dbInst, char>*         _select_inst_map;
+  dbTechNonDefaultRule*        _non_default_rule;
+  int                          _version;
+  std::map<std::string, bool>  _own_prop_defs[9];
+  // _own_prop_defs, or those of the writer a chunk writer formats for,
+  // which only reads them.
+  std::map<std::string, bool>* _prop_defs;
+  utl::Logger*                 _logger;
+  int                          _num_threads;
 
   int defdist(int value) { return (int) (((double) value) * _dist_factor); }
 
@@ -115,6 +120,13 @@ class defout_impl
   void writePinProperties(dbBlock* block);
   bool hasProperties(dbObject* object, ObjType type);
 
+  // A writer that formats into out with the settings of writer.
+  defout_impl(const defout_impl& writer, FILE* out);
+
+  template <typename T>
+  void writeChunked(const std::vector<T*>& objects,
+                    void (defout_impl::*write)(T*));
+
  public:
   defout_impl(utl::Logger* logger)
   {
@@ -124,7 +136,9 @@ class defout_impl
     _select_net_map   = NULL;
     _select_inst_map  = NULL;
     _version          = defout::DEF_5_8;
+    _prop_defs        = _own_prop_defs;
     _logger           = logger;
+    _num_threads      = 1;
   }
 
   ~defout_impl() {}
@@ -140,6 +154,8 @@ class defout_impl
   void selectInst(dbInst* inst);
   void setVersion(int v) { _version = v; }
 
+  void setNumThreads(int num_threads) { _num_threads = num_threads; }
+
   bool writeBlock(dbBlock* block, const char* def_file);
 };
 
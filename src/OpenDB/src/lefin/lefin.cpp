@@ -80,7 +80,8 @@ lefin::lefin(dbDatabase*  db,
       _area_factor(1000000.0),
       _dbu_per_micron(1000),
       _override_lef_dbu(false),
-      _ignore_non_routing_layers(ignore_non_routing_layers)
+      _ignore_non_routing_layers(ignore_non_routing_layers),
+      _cache_tech_hash(0)
 {
 }
 
@@ -1963,6 +1964,11 @@ dbTech* lefin::createTech(const char* lef_file)
     return NULL;
   };
 
+  std::string cache_file = cacheFile('T', NULL, lef_file);
+
+  if (!cache_file.empty() && readCache(cache_file, NULL, lef_file))
+    return _tech;
+
   _tech        = dbTech::create(_db, _dbu_per_micron);
   _create_tech = true;
 
@@ -1976,6 +1982,9 @@ dbTech* lefin::createTech(const char* lef_file)
     return NULL;
   }
 
+  if (!cache_file.empty())
+    writeCache(cache_file, true, false);
+
   return _tech;
 }
 
@@ -1997,6 +2006,12 @@ dbLib* lefin::createLib(const char* name, const char* lef_file)
   };
 
   setDBUPerMicron(_tech->getDbUnitsPerMicron());
+
+  std::string cache_file = cacheFile('L', name, lef_file);
+
+  if (!cache_file.empty() && readCache(cache_file, name, lef_file))
+    return _lib;
+
   _lib_name   = name;
   _create_lib = true;
 
@@ -2012,6 +2027,12 @@ dbLib* lefin::createLib(const char* name, const char* lef_file)
     return NULL;
   }
 
+  // A library LEF may also set technology attributes, such as the
+  // manufacturing grid. The cache can't replay them into the existing
+  // technology, so such a library is not cached.
+  if (!cache_file.empty() && _lib && techHash() == _cache_tech_hash)
+    writeCache(cache_file, false, true);
+
   return _lib;
 }
 
@@ -2032,6 +2053,11 @@ dbLib* lefin::createTechAndLib(const char* lib_name, const char* lef_file)
     return NULL;
   };
 
+  std::string cache_file = cacheFile('B', lib_name, lef_file);
+
+  if (!cache_file.empty() && readCache(cache_file, lib_name, lef_file))
+    return _lib;
+
   _tech        = dbTech::create(_db, _dbu_per_micron);
   _lib_name    = lib_name;
   _create_lib  = true;
@@ -2056,6 +2082,9 @@ dbLib* lefin::createTechAndLib(const char* lib_name, const char* lef_file)
   if (rules.orderReversed())
     rules.reverse();
 
+  if (!cache_file.empty())
+    writeCache(cache_file, true, _lib != NULL);
+
   return _lib;
 }
 
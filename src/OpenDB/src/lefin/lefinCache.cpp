@@ -0,0 +1,257 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2019, Nefelus Inc
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Binary cache of the technologies and libraries created by lefin.
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+#include "ZException.h"
+#include "db.h"
+#include "lefin.h"
+#include "utility/Logger.h"
+
+namespace odb {
+
+namespace {
+
+enum CacheFlags
+{
+  CACHE_TECH = 1,
+  CACHE_LIB  = 2
+};
+
+struct CacheHeader
+{
+  char     _magic[8];
+  uint32_t _schema;
+  uint32_t _flags;
+  uint64_t _size;  // bytes following the header
+};
+
+const char cache_magic[8] = {'O', 'D', 'B', 'L', 'E', 'F', 'C', '1'};
+
+// 64-bit FNV-1a
+const uint64_t hash_offset = 14695981039346656037ULL;
+const uint64_t hash_prime  = 1099511628211ULL;
+
+void hashBytes(uint64_t& hash, const void* data, size_t size)
+{
+  const unsigned char* p = (const unsigned char*) data;
+
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= p[i];
+    hash *= hash_prime;
+  }
+}
+
+template <typename T>
+void hashValue(uint64_t& hash, T value)
+{
+  hashBytes(hash, &value, sizeof(value));
+}
+
+}  // namespace
+
+void lefin::setCacheDir(const char* dir)
+{
+  _cache_dir = dir ? dir : "";
+
+  if (_cache_dir.empty())
+    return;
+
+  if (mkdir(dir, 0777) != 0 && errno != EEXIST) {
+    _logger->warn(
+        utl::ODB, 249, "Unable to create LEF cache directory {}", dir);
+    _cache_dir.clear();
+  }
+}
+
+uint64_t lefin::techHash()
+{
+  char*  data = NULL;
+  size_t size = 0;
+  FILE*  file = open_memstream(&data, &size);
+
+  if (file == NULL)
+    return 0;
+
+  _db->writeTech(file);
+  fclose(file);
+
+  uint64_t hash = hash_offset;
+  hashBytes(hash, data, size);
+  free(data);
+  return hash;
+}
+
+std::string lefin::cacheFile(char        kind,
+                             const char* lib_name,
+                             const char* lef_file)
+{
+  if (_cache_dir.empty())
+    return std::string();
+
+  FILE* file = fopen(lef_file, "r");
+
+  // The parser reports unreadable files.
+  if (file == NULL)
+    return std::string();
+
+  uint64_t hash = hash_offset;
+  hashValue(hash, kind);
+  hashValue(hash, dbDatabase::getSchemaRevision());
+  hashValue(hash, _ignore_non_routing_layers);
+  hashValue(hash, _skip_obstructions);
+  hashValue(hash, _override_lef_dbu ? _dbu_per_micron : 0);
+
+  if (lib_name)
+    hashBytes(hash, lib_name, strlen(lib_name) + 1);
+
+  // A library refers to the layers and sites of its technology.
+  if (kind == 'L') {
+    _cache_tech_hash = techHash();
+    hashValue(hash, _cache_tech_hash);
+  }
+
+  std::vector<char> buffer(1 << 16);
+  size_t            n;
+
+  while ((n = fread(buffer.data(), 1, buffer.size(), file)) > 0)
+    hashBytes(hash, buffer.data(), n);
+
+  fclose(file);
+
+  char name[32];
+  snprintf(name, sizeof(name), "%016llx.lefdb", (unsigned long long) hash);
+  return _cache_dir + "/" + name;
+}
+
+bool lefin::readCache(const std::string& cache_file,
+                      const char*        lib_name,
+                      const char*        lef_file)
+{
+  FILE* file = fopen(cache_file.c_str(), "r");
+
+  if (file == NULL)
+    return false;
+
+  CacheHeader header;
+  struct stat st;
+
+  // Copies are only renamed into place once complete, so a mismatch here is
+  // a stale or foreign file that is simply rebuilt.
+  if (fread(&header, sizeof(header), 1, file) != 1
+      || memcmp(header._magic, cache_magic, sizeof(cache_magic)) != 0
+      || header._schema != dbDatabase::getSchemaRevision()
+      || fstat(fileno(file), &st) != 0
+      || (uint64_t) st.st_size != sizeof(header) + header._size
+      || ((header._flags & CACHE_LIB) && lib_name == NULL)) {
+    fclose(file);
+    return false;
+  }
+
+  // dbDatabase::readTech rebuilds an existing technology in place, under
+  // the layers, vias and sites its libraries and blocks point to, so a
+  // technology is only loaded into a database that has none.
+  if ((header._flags & CACHE_TECH) && _db->getTech()) {
+    fclose(file);
+    return false;
+  }
+
+  _logger->info(
+      utl::ODB, 250, "Reading LEF file: {} (cached {})", lef_file, cache_file);
+
+  if (header._flags & CACHE_TECH)
+    _db->readTech(file);
+
+  _tech = _db->getTech();
+  _lib  = NULL;
+
+  if (header._flags & CACHE_LIB) {
+    _lib = dbLib::create(_db, lib_name, 0);
+    _db->readLib(file, _lib);
+  }
+
+  fclose(file);
+  return true;
+}
+
+void lefin::writeCache(const std::string& cache_file, bool tech, bool lib)
+{
+  std::string tmp_file  = cache_file + "." + std::to_string(getpid());
+  FILE*       file      = fopen(tmp_file.c_str(), "w");
+  bool        succeeded = false;
+
+  if (file) {
+    CacheHeader header;
+    memcpy(header._magic, cache_magic, sizeof(cache_magic));
+    header._schema = dbDatabase::getSchemaRevision();
+    header._flags  = (tech ? CACHE_TECH : 0) | (lib ? CACHE_LIB : 0);
+    header._size   = 0;
+
+    try {
+      fwrite(&header, sizeof(header), 1, file);
+
+      if (tech)
+        _db->writeTech(file);
+
+      if (lib)
+        _db->writeLib(file, _lib);
+
+      header._size = ftell(file) - sizeof(header);
+      succeeded    = fseek(file, 0, SEEK_SET) == 0
+                  && fwrite(&header, sizeof(header), 1, file) == 1;
+    } catch (ZIOError&) {
+      succeeded = false;
+    }
+
+    succeeded = (fclose(file) == 0) && succeeded;
+  }
+
+  // Readers only ever see a complete copy.
+  if (succeeded)
+    succeeded = rename(tmp_file.c_str(), cache_file.c_str()) == 0;
+
+  if (!succeeded) {
+    unlink(tmp_file.c_str());
+    _logger->warn(utl::ODB, 251, "Unable to write LEF cache {}", cache_file);
+  }
+}
+
+}  // namespace odb
@@ -9,6 +9,8 @@
 #include "dbRtEdge.h"
 #include "dbWireCodec.h"
 #include "dbBlockCallBackObj.h"
+#include "dbBlockSnapshot.h"
+#include "dbWireShapeCache.h"
 #include "dbIterator.h"
 #include "dbRtNode.h"
 #include "dbTransform.h"
@@ -60,6 +62,11 @@ using namespace odb;
 %include "dbRtEdge.h"
 %include "dbWireCodec.h"
 %include "dbBlockCallBackObj.h"
+%include "dbBlockSnapshot.h"
+%ignore odb::dbWireShapeCache::Shapes;
+%ignore odb::dbWireShapeCache::getShapes;
+%ignore odb::dbWireShapeCache::decode;
+%include "dbWireShapeCache.h"
 %include "dbIterator.h"
 %include "dbRtNode.h"
 %include "dbTransform.h"
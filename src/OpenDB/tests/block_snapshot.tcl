@@ -0,0 +1,30 @@
+source "helpers.tcl"
+
+
+read_lef "data/gscl45nm.lef"
+read_def "data/design.def"
+set db [ord::get_db]
+set block [ord::get_db_block]
+
+set db_file [make_result_file "snapshot_before.db"]
+odb::write_db $db $db_file
+set saved_db [odb::dbDatabase_create]
+odb::read_db $saved_db $db_file
+
+set snapshot [odb::new_dbBlockSnapshot $block]
+
+# A trial that moves, adds and removes objects.
+[$block findInst "_g0_"] setLocation 4000 1000
+odb::dbInst_create $block [$db findMaster "INVX1"] "trial_inv"
+odb::dbNet_create $block "trial_net"
+odb::dbInst_destroy [$block findInst "_g1_"]
+$snapshot rollback
+
+if { [odb::db_diff $db $saved_db] } {
+  puts "FAIL: Differences found after the snapshot rollback"
+  exit 1
+}
+odb::delete_dbBlockSnapshot $snapshot
+
+puts "pass"
+exit 0
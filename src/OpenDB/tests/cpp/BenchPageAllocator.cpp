@@ -0,0 +1,147 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2019, Nefelus Inc
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Times building and sweeping a large block with the table pages taken
+// from malloc and from a dbHugePageArena, and reports the resident set
+// size of each.
+//
+//   BenchPageAllocator [malloc|arena] [instances]
+//
+// Without a mode both allocators are measured, each in its own process.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <string>
+
+#include "db.h"
+#include "dbPageAllocator.h"
+#include "helper.cpp"
+
+using namespace odb;
+using namespace std;
+
+static double seconds(chrono::steady_clock::time_point start)
+{
+  return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+static double residentMB()
+{
+  long  pages = 0, resident = 0;
+  FILE* statm = fopen("/proc/self/statm", "r");
+  if (statm) {
+    if (fscanf(statm, "%ld %ld", &pages, &resident) != 2)
+      resident = 0;
+    fclose(statm);
+  }
+  return resident * (double) sysconf(_SC_PAGESIZE) / (1 << 20);
+}
+
+static void run(const char* mode, int n)
+{
+  dbHugePageArena arena;
+  if (strcmp(mode, "arena") == 0)
+    setPageAllocator(&arena);
+
+  double      rss0  = residentMB();
+  auto        start = chrono::steady_clock::now();
+  dbDatabase* db    = createSimpleDB();
+  dbBlock*    block = db->getChip()->getBlock();
+  dbMaster*   and2  = db->findMaster("and2");
+
+  // Interleave creation with destruction so the pages of the different
+  // tables are allocated in an order a real flow would produce.
+  for (int i = 0; i < n; i++) {
+    string  name = to_string(i);
+    dbInst* inst = dbInst::create(block, and2, ("i" + name).c_str());
+    dbNet*  net  = dbNet::create(block, ("n" + name).c_str());
+    dbITerm::connect(inst->findITerm("o"), net);
+    inst->setOrigin(i, i);
+    if (i % 4 == 3)
+      dbInst::destroy(block->findInst(("i" + to_string(i - 2)).c_str()));
+  }
+  double build = seconds(start);
+
+  const int passes = 20;
+  long long sum    = 0;
+  start            = chrono::steady_clock::now();
+  for (int pass = 0; pass < passes; pass++) {
+    for (dbInst* inst : block->getInsts()) {
+      int x, y;
+      inst->getOrigin(x, y);
+      sum += x;
+    }
+    for (dbNet* net : block->getNets())
+      for (dbITerm* iterm : net->getITerms())
+        sum += iterm->getId();
+  }
+  double sweep = seconds(start);
+  double rss   = residentMB() - rss0;
+
+  start = chrono::steady_clock::now();
+  dbDatabase::destroy(db);
+  double destroy = seconds(start);
+
+  printf("%-6s build %6.3fs sweep %6.3fs destroy %6.3fs rss %7.1fMB (%lld)\n",
+         mode,
+         build,
+         sweep / passes,
+         destroy,
+         rss,
+         sum);
+  fflush(stdout);
+  setPageAllocator(NULL);
+}
+
+int main(int argc, char* argv[])
+{
+  int n = argc > 2 ? atoi(argv[2]) : 1000000;
+  if (argc > 1) {
+    run(argv[1], n);
+    return 0;
+  }
+
+  for (const char* mode : {"malloc", "arena"}) {
+    pid_t pid = fork();
+    if (pid == 0) {
+      run(mode, n);
+      _exit(0);
+    }
+    waitpid(pid, NULL, 0);
+  }
+  return 0;
+}
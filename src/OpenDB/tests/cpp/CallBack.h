@@ -295,6 +295,14 @@ class CallBack : public dbBlockCallBackObj
   }
   // dbSWire End
 
+  // dbSBox Start
+  void inDbSBoxCreate(dbSBox*) override
+  {
+    if (!_pause)
+      events.push_back("Create sbox");
+  }
+  // dbSBox End
+
   void pause() { _pause = true; }
   void unpause() { _pause = false; }
   void clearEvents() { events.clear(); }
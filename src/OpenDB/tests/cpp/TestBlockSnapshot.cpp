@@ -0,0 +1,178 @@
+#define BOOST_TEST_MODULE TestBlockSnapshot
+#include <boost/test/included/unit_test.hpp>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+#include "db.h"
+#include "dbBlockCallBackObj.h"
+#include "dbBlockSnapshot.h"
+#include "dbWireCodec.h"
+#include "helper.cpp"
+
+using namespace odb;
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+// The block as written to a database file.
+string writeBlock(dbDatabase* db, dbBlock* block)
+{
+  char*  buf;
+  size_t size;
+  FILE*  out = open_memstream(&buf, &size);
+  db->writeBlock(out, block);
+  fclose(out);
+  string data(buf, size);
+  free(buf);
+  return data;
+}
+
+void createNets(dbBlock*      block,
+                dbTechLayer*  layer,
+                const string& prefix,
+                int           n)
+{
+  ChainSpec spec;
+  spec.prefix = prefix;
+  spec.inputs = {{"a", 1}};
+  spec.route  = [&](dbNet* net, int i) {
+    dbWireEncoder encoder;
+    encoder.begin(dbWire::create(net));
+    encoder.newPath(layer, dbWireType::ROUTED);
+    encoder.addPoint(i * 1000, 0);
+    encoder.addPoint(i * 1000 + 2000, 0);
+    encoder.end();
+  };
+  createChain(block, n, spec);
+}
+
+// Move, resize, rename, destroy and create some of the objects.
+void edit(dbBlock* block, dbTechLayer* layer)
+{
+  dbMaster* or2 = block->getDb()->findMaster("or2");
+  block->findInst("i1")->setOrigin(-5000, 7000);
+  block->findInst("i2")->swapMaster(or2);
+  block->findInst("i3")->rename("renamed");
+  dbInst::destroy(block->findInst("i4"));
+  dbNet::destroy(block->findNet("n5"));
+  dbITerm::disconnect(block->findInst("i7")->findITerm("a"));
+  dbIntProperty::create(block->findNet("n7"), "weight", 3);
+  createNets(block, layer, "x", 300);
+  dbInst::create(block, or2, "new");
+}
+
+BOOST_AUTO_TEST_CASE(test_rollback)
+{
+  dbDatabase*  db    = createSimpleDB();
+  dbBlock*     block = db->getChip()->getBlock();
+  dbTechLayer* m1
+      = dbTechLayer::create(db->getTech(), "M1", dbTechLayerType::ROUTING);
+  createNets(block, m1, "", 250);
+  for (int i = 200; i < 250; i++)
+    dbInst::destroy(block->findInst(("i" + to_string(i)).c_str()));
+
+  dbInst* i0     = block->findInst("i0");
+  string  before = writeBlock(db, block);
+
+  {
+    // The snapshot is deleted before its block.
+    dbBlockSnapshot snapshot(block);
+    BOOST_TEST(snapshot.rollback() == 0);
+    BOOST_CHECK(writeBlock(db, block) == before);
+
+    for (int trial = 0; trial < 2; trial++) {
+      edit(block, m1);
+      BOOST_CHECK(writeBlock(db, block) != before);
+      BOOST_TEST(snapshot.rollback() > 0);
+      BOOST_CHECK(writeBlock(db, block) == before);
+
+      // Objects that did not change stay where they were.
+      BOOST_TEST(block->findInst("i0") == i0);
+      BOOST_TEST(block->findInst("i3") != nullptr);
+      BOOST_TEST(block->findInst("renamed") == nullptr);
+      BOOST_TEST(block->findInst("new") == nullptr);
+      BOOST_TEST(block->findInst("i4")->getMaster()->getName() == "and2");
+      BOOST_TEST(block->findInst("i2")->getMaster()->getName() == "and2");
+      BOOST_TEST(block->findNet("n5")->getITerms().size() == 2);
+      BOOST_TEST(dbIntProperty::find(block->findNet("n7"), "weight") == nullptr);
+      BOOST_TEST(block->getInsts().size() == 200);
+    }
+  }
+
+  dbDatabase::destroy(db);
+}
+
+BOOST_AUTO_TEST_CASE(test_rollback_children)
+{
+  dbDatabase*  db    = createSimpleDB();
+  dbBlock*     block = db->getChip()->getBlock();
+  dbTechLayer* m1
+      = dbTechLayer::create(db->getTech(), "M1", dbTechLayerType::ROUTING);
+  dbBlock* child = dbBlock::create(block, "child");
+  createNets(child, m1, "", 50);
+
+  string before       = writeBlock(db, block);
+  string child_before = writeBlock(db, child);
+
+  {
+    // The snapshot is deleted before its block.
+    dbBlockSnapshot snapshot(block);
+    edit(child, m1);
+    dbBlock* created = dbBlock::create(block, "created");
+    createNets(created, m1, "", 10);
+    BOOST_TEST(block->getChildren().size() == 2);
+
+    BOOST_TEST(snapshot.rollback() > 0);
+    BOOST_TEST(block->getChildren().size() == 1);
+    BOOST_TEST(block->findChild("created") == nullptr);
+    BOOST_TEST(block->findChild("child") == child);
+    BOOST_CHECK(writeBlock(db, child) == child_before);
+    BOOST_CHECK(writeBlock(db, block) == before);
+  }
+
+  dbDatabase::destroy(db);
+}
+
+class RollbackCallBack : public dbBlockCallBackObj
+{
+ public:
+  int rollbacks = 0;
+  int creates   = 0;
+  void inDbBlockRollback(dbBlock*) override { rollbacks++; }
+  void inDbInstCreate(dbInst*) override { creates++; }
+};
+
+BOOST_AUTO_TEST_CASE(test_rollback_callback)
+{
+  dbDatabase*  db    = createSimpleDB();
+  dbBlock*     block = db->getChip()->getBlock();
+  dbTechLayer* m1
+      = dbTechLayer::create(db->getTech(), "M1", dbTechLayerType::ROUTING);
+  createNets(block, m1, "", 20);
+
+  RollbackCallBack cb;
+  cb.addOwner(block);
+  {
+    // The snapshot is deleted before its block.
+    dbBlockSnapshot snapshot(block);
+    edit(block, m1);
+    int creates = cb.creates;
+    snapshot.rollback();
+    BOOST_TEST(cb.rollbacks == 1);
+    BOOST_TEST(cb.creates == creates);
+
+    // The journal cannot replay a rollback.
+    dbDatabase::beginEco(block);
+    block->findInst("i1")->setOrigin(-5000, 7000);
+    BOOST_TEST(!dbDatabase::ecoHasUnrecordedEdits(block));
+    snapshot.rollback();
+    BOOST_TEST(cb.rollbacks == 2);
+    BOOST_TEST(dbDatabase::ecoHasUnrecordedEdits(block));
+  }
+
+  dbDatabase::destroy(db);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -261,6 +261,10 @@ BOOST_AUTO_TEST_CASE(test_swire)
                                100,
                                dbWireShapeType::IOWIRE,
                                dbSBox::Direction::HORIZONTAL);
+  BOOST_TEST(box != nullptr);
+  BOOST_TEST(cb->events.size() == 1);
+  BOOST_TEST(cb->events[0] == "Create sbox");
+  cb->clearEvents();
 
   dbSWire::destroy(wire);
   BOOST_TEST(cb->events.size() == 3);
@@ -268,4 +272,76 @@ BOOST_AUTO_TEST_CASE(test_swire)
   BOOST_TEST(cb->events[1] == "PostDestroySBoxes");
   BOOST_TEST(cb->events[2] == "Destroy swire");
 }
+BOOST_AUTO_TEST_CASE(test_inst_placement)
+{
+  setup();
+  db    = create2LevetDbNoBTerms();
+  block = db->getChip()->getBlock();
+  cb->addOwner(block);
+  vector<dbInst*>      insts;
+  vector<int>          xs;
+  vector<int>          ys;
+  vector<dbOrientType> orients;
+  vector<int>          master_ids;
+  block->getInstPlacement(insts, xs, ys, orients, master_ids);
+  BOOST_TEST(insts.size() == 3);
+  BOOST_TEST(insts[2] == block->findInst("i3"));
+  BOOST_TEST(master_ids[2] == db->findMaster("or2")->getMasterId());
+  xs[0]      = 100;
+  ys[0]      = 200;
+  xs[2]      = 300;
+  orients[2] = dbOrientType::R90;
+  block->setInstPlacement(insts, xs, ys, orients);
+  BOOST_TEST(cb->events.size() == 4);
+  BOOST_TEST(cb->events[0] == "PreMove inst i1");
+  BOOST_TEST(cb->events[1] == "PreMove inst i3");
+  BOOST_TEST(cb->events[2] == "PostMove inst i1");
+  BOOST_TEST(cb->events[3] == "PostMove inst i3");
+  int x, y;
+  insts[2]->getLocation(x, y);
+  BOOST_TEST(x == 300);
+  BOOST_TEST(y == 0);
+  BOOST_TEST(insts[2]->getOrient() == dbOrientType::R90);
+  cb->clearEvents();
+  block->setInstPlacement(insts, xs, ys, {});
+  BOOST_TEST(cb->events.size() == 0);
+}
+BOOST_AUTO_TEST_CASE(test_callback_batch)
+{
+  setup();
+  db    = create2LevetDbNoBTerms();
+  block = db->getChip()->getBlock();
+  cb->addOwner(block);
+  dbInst* i1 = block->findInst("i1");
+  dbInst* i2 = block->findInst("i2");
+  dbInst* i3 = block->findInst("i3");
+  {
+    dbCallBackBatchScope batch(block);
+    BOOST_TEST(block->inCallBackBatch());
+    i1->setOrigin(100, 100);
+    i1->setOrigin(200, 100);
+    i1->setOrient(dbOrientType::R90);
+    {
+      dbCallBackBatchScope nested(block);
+      i2->setLocation(500, 500);
+      block->setInstPlacement({i1, i3}, {300, 700}, {300, 700}, {});
+    }
+    BOOST_TEST(block->inCallBackBatch());
+    BOOST_TEST(cb->events.size() == 0);
+  }
+  BOOST_TEST(!block->inCallBackBatch());
+  BOOST_TEST(cb->events.size() == 3);
+  BOOST_TEST(cb->events[0] == "PostMove inst i1");
+  BOOST_TEST(cb->events[1] == "PostMove inst i2");
+  BOOST_TEST(cb->events[2] == "PostMove inst i3");
+  cb->clearEvents();
+  block->beginCallBackBatch();
+  i1->setOrigin(0, 0);
+  cb->pause();
+  dbInst::destroy(i1);
+  cb->unpause();
+  block->commitCallBackBatch();
+  BOOST_TEST(cb->events.size() == 0);
+  tearDown();
+}
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -0,0 +1,197 @@
+#define BOOST_TEST_MODULE TestCompactParasitics
+#include <boost/test/included/unit_test.hpp>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#include "db.h"
+#include "helper.cpp"
+
+using namespace odb;
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+// Bytes held by the RC values of the block.
+uint64 valueMemory(dbBlock* block)
+{
+  vector<dbMemoryUsage> usage;
+  block->getMemoryUsage(usage);
+  uint64 used = 0;
+  for (dbMemoryUsage& entry : usage)
+    if (entry._name.find("capacitances") != string::npos
+        || entry._name.find("resistances") != string::npos)
+      used += entry._used;
+  return used;
+}
+
+// A chain of rsegs with a coupling cap between neighbouring nodes.
+vector<dbRSeg*> createParasitics(dbBlock*          block,
+                                 int               n,
+                                 vector<dbCCSeg*>& ccsegs)
+{
+  block->setCornerCount(2);
+  dbNet*          net  = dbNet::create(block, "n");
+  dbCapNode*      prev = dbCapNode::create(net, 0, false);
+  vector<dbRSeg*> rsegs;
+  for (int i = 1; i <= n; i++) {
+    dbCapNode* node = dbCapNode::create(net, i, false);
+    dbRSeg* rseg = dbRSeg::create(net, i, 0, 0, true);
+    rseg->setSourceNode(prev->getId());
+    rseg->setTargetNode(node->getId());
+    rseg->setResistance(1.5 + i, 0);
+    rseg->setResistance(3.0 + i, 1);
+    rseg->setCapacitance(0.125 * i, 0);
+    rseg->setCapacitance(0.375 * i, 1);
+    dbCCSeg* ccseg = dbCCSeg::create(prev, node);
+    ccseg->setCapacitance(0.001 * i, 0);
+    ccseg->setCapacitance(0.002 * i, 1);
+    rsegs.push_back(rseg);
+    ccsegs.push_back(ccseg);
+    prev = node;
+  }
+  return rsegs;
+}
+
+// The values keep about three significant digits.
+BOOST_AUTO_TEST_CASE(test_compact, *boost::unit_test::tolerance(1e-3))
+{
+  dbDatabase*      db    = createSimpleDB();
+  dbBlock*         block = db->getChip()->getBlock();
+  vector<dbCCSeg*> ccsegs;
+  vector<dbRSeg*>  rsegs = createParasitics(block, 1000, ccsegs);
+
+  uint64 full = valueMemory(block);
+  BOOST_TEST(!block->hasCompactParasitics());
+  BOOST_TEST(block->setCompactParasitics(true));
+  BOOST_TEST(block->hasCompactParasitics());
+  BOOST_TEST(valueMemory(block) < full * 0.51);
+
+  for (int i = 1; i <= 1000; i++) {
+    dbRSeg* rseg = rsegs[i - 1];
+    BOOST_TEST(rseg->getResistance(0) == 1.5 + i);
+    BOOST_TEST(rseg->getResistance(1) == 3.0 + i);
+    BOOST_TEST(rseg->getCapacitance(1) == 0.375 * i);
+    dbCCSeg* ccseg = ccsegs[i - 1];
+    BOOST_TEST(ccseg->getCapacitance(0) == 0.001 * i);
+    BOOST_TEST(ccseg->getCapacitance(1) == 0.002 * i);
+  }
+
+  // Values added while compact are compact too.
+  rsegs[0]->setResistance(12.5, 1);
+  ccsegs[0]->addCapacitance(0.75, 0);
+  BOOST_TEST(rsegs[0]->getResistance(1) == 12.5);
+  BOOST_TEST(ccsegs[0]->getCapacitance(0) == 0.751);
+  BOOST_TEST(block->hasCompactParasitics());
+
+  BOOST_TEST(block->setCompactParasitics(false));
+  BOOST_TEST(!block->hasCompactParasitics());
+  BOOST_TEST(valueMemory(block) == full);
+  BOOST_TEST(rsegs[0]->getResistance(1) == 12.5);
+
+  dbDatabase::destroy(db);
+}
+
+BOOST_AUTO_TEST_CASE(test_out_of_range, *boost::unit_test::tolerance(1e-3))
+{
+  dbDatabase*      db    = createSimpleDB();
+  dbBlock*         block = db->getChip()->getBlock();
+  vector<dbCCSeg*> ccsegs;
+  vector<dbRSeg*>  rsegs = createParasitics(block, 10, ccsegs);
+
+  // A resistance too large for 16 bits is scaled with the others.
+  rsegs[3]->setResistance(1e6, 0);
+  BOOST_TEST(block->setCompactParasitics(true));
+  BOOST_TEST(rsegs[3]->getResistance(0) == 1e6);
+  BOOST_TEST(rsegs[5]->getResistance(0) == 7.5);
+
+  // One too far from the others keeps the block at 32 bits.
+  BOOST_TEST(block->setCompactParasitics(false));
+  rsegs[3]->setResistance(1e12, 0);
+  BOOST_TEST(!block->setCompactParasitics(true));
+  BOOST_TEST(!block->hasCompactParasitics());
+  BOOST_TEST(rsegs[3]->getResistance(0) == 1e12f);
+
+  // Setting one while compact rescales the resistances, or returns them
+  // to 32 bits.
+  rsegs[3]->setResistance(4.0, 0);
+  BOOST_TEST(block->setCompactParasitics(true));
+  rsegs[5]->setResistance(2e5, 1);
+  BOOST_TEST(block->hasCompactParasitics());
+  BOOST_TEST(rsegs[5]->getResistance(1) == 2e5);
+  BOOST_TEST(rsegs[5]->getResistance(0) == 7.5);
+  rsegs[6]->setResistance(1e12, 1);
+  BOOST_TEST(!block->hasCompactParasitics());
+  BOOST_TEST(rsegs[6]->getResistance(1) == 1e12f);
+  BOOST_TEST(rsegs[5]->getResistance(1) == 2e5);
+  BOOST_TEST(rsegs[5]->getResistance(0) == 7.5);
+
+  dbDatabase::destroy(db);
+}
+
+BOOST_AUTO_TEST_CASE(test_too_small, *boost::unit_test::tolerance(1e-3))
+{
+  dbDatabase*      db    = createSimpleDB();
+  dbBlock*         block = db->getChip()->getBlock();
+  vector<dbCCSeg*> ccsegs;
+  createParasitics(block, 10, ccsegs);
+
+  // Capacitances below the smallest normal 16 bit float, as small as the
+  // couplings extracted for gcd, are scaled with the others.
+  ccsegs[2]->setCapacitance(3e-5, 0);
+  ccsegs[4]->setCapacitance(4.6e-6, 1);
+  BOOST_TEST(block->setCompactParasitics(true));
+  BOOST_TEST(ccsegs[2]->getCapacitance(0) == 3e-5);
+  BOOST_TEST(ccsegs[4]->getCapacitance(1) == 4.6e-6);
+  BOOST_TEST(ccsegs[9]->getCapacitance(1) == 0.02);
+
+  // Zero fits any scale.
+  ccsegs[2]->setCapacitance(0.0, 0);
+  BOOST_TEST(ccsegs[2]->getCapacitance(0) == 0.0);
+
+  // Setting one while compact rescales the capacitances, or returns them
+  // to 32 bits.
+  ccsegs[6]->setCapacitance(2e-7, 1);
+  BOOST_TEST(block->hasCompactParasitics());
+  BOOST_TEST(ccsegs[6]->getCapacitance(1) == 2e-7);
+  BOOST_TEST(ccsegs[4]->getCapacitance(1) == 4.6e-6);
+  ccsegs[7]->setCapacitance(1e-15, 1);
+  BOOST_TEST(!block->hasCompactParasitics());
+  BOOST_TEST(ccsegs[7]->getCapacitance(1) == 1e-15f);
+  BOOST_TEST(ccsegs[6]->getCapacitance(1) == 2e-7);
+  BOOST_TEST(ccsegs[9]->getCapacitance(1) == 0.02);
+  BOOST_TEST(!block->setCompactParasitics(true));
+
+  dbDatabase::destroy(db);
+}
+
+BOOST_AUTO_TEST_CASE(test_stream)
+{
+  dbDatabase*      db    = createSimpleDB();
+  dbBlock*         block = db->getChip()->getBlock();
+  vector<dbCCSeg*> ccsegs;
+  createParasitics(block, 100, ccsegs);
+  BOOST_TEST(block->setCompactParasitics(true));
+
+  FILE* file = tmpfile();
+  db->writeBlock(file, block);
+  rewind(file);
+  dbBlock* copy = dbBlock::create(block, "copy");
+  db->readBlock(file, copy);
+  fclose(file);
+
+  // The values are read back as 32 bit floats.
+  BOOST_TEST(!copy->hasCompactParasitics());
+  dbSet<dbRSeg>           rsegs1 = block->findNet("n")->getRSegs();
+  dbSet<dbRSeg>           rsegs2 = copy->findNet("n")->getRSegs();
+  dbSet<dbRSeg>::iterator r1     = rsegs1.begin();
+  dbSet<dbRSeg>::iterator r2     = rsegs2.begin();
+  BOOST_TEST(rsegs1.size() == rsegs2.size());
+  for (; r1 != rsegs1.end(); ++r1, ++r2)
+    BOOST_TEST((*r1)->getResistance(1) == (*r2)->getResistance(1));
+  BOOST_TEST(copy->setCompactParasitics(true));
+
+  dbDatabase::destroy(db);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
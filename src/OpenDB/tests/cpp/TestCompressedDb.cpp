@@ -0,0 +1,134 @@
+#define BOOST_TEST_MODULE TestCompressedDb
+#include <boost/test/included/unit_test.hpp>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+
+#include "ZException.h"
+#include "db.h"
+#include "dbWireCodec.h"
+#include "helper.cpp"
+
+using namespace odb;
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+string writeCompressed(dbDatabase* db)
+{
+  char*  buf;
+  size_t size;
+  FILE*  out = open_memstream(&buf, &size);
+  db->writeCompressed(out);
+  fclose(out);
+  string data(buf, size);
+  free(buf);
+  return data;
+}
+
+dbDatabase* readCompressed(const string& data, dbDatabase::LoadProfile profile)
+{
+  FILE* in = tmpfile();
+  fwrite(data.data(), data.size(), 1, in);
+  rewind(in);
+  dbDatabase* db = dbDatabase::create();
+  db->setLogger(new utl::Logger());
+  try {
+    db->read(in, profile);
+  } catch (ZException&) {
+    fclose(in);
+    dbDatabase::destroy(db);
+    throw;
+  }
+  fclose(in);
+  return db;
+}
+
+BOOST_AUTO_TEST_CASE(test_round_trip)
+{
+  dbDatabase* db   = create2LevetDbNoBTerms();
+  string      data = writeCompressed(db);
+
+  for (auto profile : {dbDatabase::LOAD_ALL,
+                       dbDatabase::LOAD_NO_PARASITICS,
+                       dbDatabase::LOAD_PLACEMENT}) {
+    dbDatabase* db2 = readCompressed(data, profile);
+    BOOST_TEST(!dbDatabase::diff(db, db2, nullptr, 2));
+    BOOST_TEST(writeCompressed(db2) == data);
+    dbDatabase::destroy(db2);
+  }
+  dbDatabase::destroy(db);
+}
+
+BOOST_AUTO_TEST_CASE(test_deferred_sections)
+{
+  dbDatabase*  db = createSimpleDB();
+  dbTechLayer* m1
+      = dbTechLayer::create(db->getTech(), "M1", dbTechLayerType::ROUTING);
+  ChainSpec spec;
+  spec.route = [&](dbNet* net, int i) {
+    dbWireEncoder encoder;
+    encoder.begin(dbWire::create(net));
+    encoder.newPath(m1, dbWireType::ROUTED);
+    encoder.addPoint(i * 1000, 0);
+    encoder.addPoint(i * 1000 + 2000, 0);
+    encoder.end();
+  };
+  createChain(db->getChip()->getBlock(), 4, spec);
+  string data = writeCompressed(db);
+
+  dbDatabase* db2   = readCompressed(data, dbDatabase::LOAD_ALL);
+  dbBlock*    block = db2->getChip()->getBlock();
+  BOOST_TEST(!block->hasDeferredWires());
+  BOOST_TEST(!block->hasDeferredParasitics());
+  dbDatabase::destroy(db2);
+
+  db2   = readCompressed(data, dbDatabase::LOAD_NO_PARASITICS);
+  block = db2->getChip()->getBlock();
+  BOOST_TEST(!block->hasDeferredWires());
+  BOOST_TEST(block->hasDeferredParasitics());
+  dbDatabase::destroy(db2);
+
+  // Each section is decoded by the first access to it.
+  db2   = readCompressed(data, dbDatabase::LOAD_PLACEMENT);
+  block = db2->getChip()->getBlock();
+  BOOST_TEST(block->hasDeferredWires());
+  BOOST_TEST(block->hasDeferredParasitics());
+  BOOST_TEST(block->findNet("n2")->getWire() != nullptr);
+  BOOST_TEST(!block->hasDeferredWires());
+  BOOST_TEST(block->hasDeferredParasitics());
+  BOOST_TEST(block->getRSegs().size() == 0);
+  BOOST_TEST(!block->hasDeferredParasitics());
+  BOOST_TEST(!dbDatabase::diff(db, db2, nullptr, 2));
+  dbDatabase::destroy(db2);
+
+  dbDatabase::destroy(db);
+}
+
+BOOST_AUTO_TEST_CASE(test_schema_revision)
+{
+  dbDatabase* db = create2LevetDbNoBTerms();
+  char*       buf;
+  size_t      size;
+  FILE*       out = open_memstream(&buf, &size);
+  db->write(out);
+  fclose(out);
+  string uncompressed(buf, size);
+  free(buf);
+  string compressed = writeCompressed(db);
+  dbDatabase::destroy(db);
+
+  // Both headers are the magic numbers, then the major and minor
+  // revisions. Older and newer minor revisions are rejected.
+  for (string data : {uncompressed, compressed}) {
+    for (uint schema_minor : {dbDatabase::getSchemaRevision() - 1,
+                              dbDatabase::getSchemaRevision() + 1}) {
+      data.replace(3 * sizeof(uint), sizeof(uint), (char*) &schema_minor,
+                   sizeof(uint));
+      BOOST_CHECK_THROW(readCompressed(data, dbDatabase::LOAD_ALL),
+                        ZException);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,178 @@
+#define BOOST_TEST_MODULE TestConcurrentRead
+#include <boost/test/included/unit_test.hpp>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "db.h"
+#include "dbWireCodec.h"
+#include "helper.cpp"
+
+using namespace odb;
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+// A chain of and2 instances, each output driving the next instance, with
+// a wire on every net.
+dbDatabase* createChainDB(int n)
+{
+  dbDatabase*  db = createSimpleDB();
+  dbTechLayer* m1
+      = dbTechLayer::create(db->getTech(), "M1", dbTechLayerType::ROUTING);
+  ChainSpec spec;
+  spec.rows  = 10;
+  spec.route = [&](dbNet* net, int i) {
+    dbWireEncoder encoder;
+    encoder.begin(dbWire::create(net));
+    encoder.newPath(m1, dbWireType::ROUTED);
+    encoder.addPoint(i * 1000, 0);
+    encoder.addPoint(i * 1000 + 2000, 0);
+    encoder.addPoint(i * 1000 + 2000, 3000);
+    encoder.end();
+  };
+  createChain(db->getChip()->getBlock(), n, spec);
+  return db;
+}
+
+// Everything a reader can see of the block, folded into one number.
+long long readBlock(dbBlock* block)
+{
+  long long sum = 0;
+  Rect      bbox;
+  block->getBBox()->getBox(bbox);
+  sum += bbox.xMax() + bbox.yMax();
+  for (dbInst* inst : block->getInsts()) {
+    if (block->findInst(inst->getConstName()) != inst)
+      return -1;
+    int x, y;
+    inst->getLocation(x, y);
+    sum += x + y + inst->getMaster()->getMasterId();
+    for (dbITerm* iterm : inst->getITerms()) {
+      dbNet* net = iterm->getNet();
+      if (net)
+        sum += net->getId();
+    }
+  }
+  for (dbNet* net : block->getNets()) {
+    if (block->findNet(net->getConstName()) != net)
+      return -1;
+    sum += net->getITerms().size();
+    dbWireDecoder decoder;
+    decoder.begin(net->getWire());
+    for (auto op = decoder.next(); op != dbWireDecoder::END_DECODE;
+         op      = decoder.next()) {
+      if (op == dbWireDecoder::POINT) {
+        int x, y;
+        decoder.getPoint(x, y);
+        sum += x + y;
+      }
+    }
+  }
+  return sum;
+}
+
+// The sums that threads reading block concurrently compute.
+vector<long long> readConcurrently(dbBlock* block, int num_threads)
+{
+  vector<long long> sums(num_threads);
+  vector<thread>    threads;
+  block->beginConcurrentRead();
+  for (int i = 0; i < num_threads; i++)
+    threads.emplace_back([&, i]() { sums[i] = readBlock(block); });
+  for (thread& t : threads)
+    t.join();
+  block->endConcurrentRead();
+  return sums;
+}
+
+BOOST_AUTO_TEST_CASE(test_concurrent_read)
+{
+  dbDatabase* db    = createChainDB(2000);
+  dbBlock*    block = db->getChip()->getBlock();
+  long long   sum   = readBlock(block);
+  BOOST_TEST(sum > 0);
+
+  // Moving an instance invalidates the block bbox.
+  block->findInst("i0")->setOrigin(-500, -500);
+  sum = readBlock(block);
+
+  block->beginConcurrentRead();
+  BOOST_TEST(block->inConcurrentRead());
+  vector<long long> sums(8);
+  vector<thread>    threads;
+  for (int i = 0; i < (int) sums.size(); i++)
+    threads.emplace_back([&, i]() { sums[i] = readBlock(block); });
+  for (thread& t : threads)
+    t.join();
+  block->endConcurrentRead();
+  BOOST_TEST(!block->inConcurrentRead());
+
+  for (long long s : sums)
+    BOOST_TEST(s == sum);
+
+  dbDatabase::destroy(db);
+}
+
+BOOST_AUTO_TEST_CASE(test_invalid_bbox)
+{
+  dbDatabase* db    = createChainDB(2000);
+  dbBlock*    block = db->getChip()->getBlock();
+
+  // The bbox is not valid when the concurrent read begins.
+  block->findInst("i0")->setOrigin(-500, -500);
+  vector<long long> sums = readConcurrently(block, 8);
+
+  Rect bbox;
+  block->getBBox()->getBox(bbox);
+  BOOST_TEST(bbox.xMin() == -500);
+  long long sum = readBlock(block);
+  for (long long s : sums)
+    BOOST_TEST(s == sum);
+
+  dbDatabase::destroy(db);
+}
+
+BOOST_AUTO_TEST_CASE(test_deferred_parasitics)
+{
+  dbDatabase* db  = createChainDB(2000);
+  long long   sum = readBlock(db->getChip()->getBlock());
+  char*       buf;
+  size_t      size;
+  FILE*       out = open_memstream(&buf, &size);
+  db->writeCompressed(out);
+  fclose(out);
+  dbDatabase::destroy(db);
+
+  FILE* in = fmemopen(buf, size, "r");
+  db       = dbDatabase::create();
+  db->setLogger(new utl::Logger());
+  db->read(in, dbDatabase::LOAD_PLACEMENT);
+  fclose(in);
+  free(buf);
+
+  // The parasitics are decoded by the first reader that needs them, the
+  // others wait for it.
+  dbBlock* block = db->getChip()->getBlock();
+  block->beginConcurrentRead();
+  BOOST_TEST(block->hasDeferredParasitics());
+  vector<long long> sums(8);
+  vector<thread>    threads;
+  for (int i = 0; i < (int) sums.size(); i++)
+    threads.emplace_back([&, i]() {
+      sums[i] = readBlock(block) + block->getRSegs().size();
+    });
+  for (thread& t : threads)
+    t.join();
+  block->endConcurrentRead();
+  BOOST_TEST(!block->hasDeferredParasitics());
+
+  for (long long s : sums)
+    BOOST_TEST(s == sum);
+
+  dbDatabase::destroy(db);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,70 @@
+#define BOOST_TEST_MODULE TestContentHash
+#include <boost/test/included/unit_test.hpp>
+#include <stdio.h>
+#include <string>
+
+#include "db.h"
+#include "helper.cpp"
+
+using namespace odb;
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+// What dbDatabase::diff reports.
+string diff(dbDatabase* db0, dbDatabase* db1)
+{
+  FILE* file = tmpfile();
+  dbDatabase::diff(db0, db1, file, 2);
+  string report(ftell(file), '\0');
+  rewind(file);
+  fread(&report[0], 1, report.size(), file);
+  fclose(file);
+  return report;
+}
+
+BOOST_AUTO_TEST_CASE(test_equal_blocks)
+{
+  dbDatabase* db0    = create2LevetDbNoBTerms();
+  dbDatabase* db1    = create2LevetDbNoBTerms();
+  dbBlock*    block0 = db0->getChip()->getBlock();
+  dbBlock*    block1 = db1->getChip()->getBlock();
+
+  BOOST_TEST(block0->getContentHash() == block1->getContentHash());
+  BOOST_TEST(block0->getContentHash() == block0->getContentHash());
+  BOOST_TEST(!dbDatabase::diff(db0, db1, NULL, 2));
+  BOOST_TEST(!dbBlock::differences(block0, block1, NULL));
+
+  dbDatabase::destroy(db0);
+  dbDatabase::destroy(db1);
+}
+
+BOOST_AUTO_TEST_CASE(test_changed_blocks)
+{
+  dbDatabase* db0    = create2LevetDbNoBTerms();
+  dbDatabase* db1    = create2LevetDbNoBTerms();
+  dbBlock*    block0 = db0->getChip()->getBlock();
+  dbBlock*    block1 = db1->getChip()->getBlock();
+  uint64      hash   = block1->getContentHash();
+
+  // Only the instance that moved is reported.
+  block1->findInst("i2")->setOrigin(100, 200);
+  BOOST_TEST(block1->getContentHash() != hash);
+  string report = diff(db0, db1);
+  BOOST_TEST(report.find("_x") != string::npos);
+  BOOST_TEST(report.find("dbNet") == string::npos);
+  BOOST_TEST(dbBlock::differences(block0, block1, NULL));
+
+  block1->findInst("i2")->setOrigin(0, 0);
+  BOOST_TEST(block1->getContentHash() == hash);
+  BOOST_TEST(!dbDatabase::diff(db0, db1, NULL, 2));
+
+  block1->findNet("n1")->rename("renamed");
+  BOOST_TEST(block1->getContentHash() != hash);
+  BOOST_TEST(dbBlock::differences(block0, block1, NULL));
+
+  dbDatabase::destroy(db0);
+  dbDatabase::destroy(db1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
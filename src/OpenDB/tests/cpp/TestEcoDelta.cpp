@@ -0,0 +1,110 @@
+#define BOOST_TEST_MODULE TestEcoDelta
+#include <boost/test/included/unit_test.hpp>
+
+#include "db.h"
+#include "helper.cpp"
+
+using namespace odb;
+
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+BOOST_AUTO_TEST_CASE(test_delta_replays_resize)
+{
+  dbDatabase* db    = create2LevetDbNoBTerms();
+  dbBlock*    block = db->getChip()->getBlock();
+  FILE*       base  = tmpfile();
+  db->write(base);
+  dbDatabase::beginEco(block);
+
+  dbInst* i1 = block->findInst("i1");
+  i1->swapMaster(db->findMaster("or2"));
+  i1->setOrigin(3000, 4000);
+  FILE* delta = tmpfile();
+  BOOST_TEST(!dbDatabase::ecoHasUnrecordedEdits(block));
+  dbDatabase::writeEcoDelta(block, delta);
+
+  rewind(base);
+  rewind(delta);
+  dbDatabase* db2 = dbDatabase::create();
+  db2->setLogger(new utl::Logger());
+  db2->read(base);
+  dbBlock* block2 = db2->getChip()->getBlock();
+  BOOST_TEST(block2->findInst("i1")->getMaster()->getName() == "and2");
+  dbDatabase::readEco(block2, delta);
+  dbDatabase::commitEco(block2);
+
+  dbInst* i1_2 = block2->findInst("i1");
+  int     x, y;
+  i1_2->getOrigin(x, y);
+  BOOST_TEST(i1_2->getMaster()->getName() == "or2");
+  BOOST_TEST(x == 3000);
+  BOOST_TEST(y == 4000);
+  BOOST_TEST(!dbDatabase::ecoInProgress(block2));
+
+  fclose(base);
+  fclose(delta);
+  dbDatabase::destroy(db2);
+  dbDatabase::destroy(db);
+}
+
+BOOST_AUTO_TEST_CASE(test_unrecorded_edits)
+{
+  dbDatabase* db    = create2LevetDbNoBTerms();
+  dbBlock*    block = db->getChip()->getBlock();
+  BOOST_TEST(!dbDatabase::ecoHasUnrecordedEdits(block));
+
+  dbDatabase::beginEco(block);
+  dbNet::create(block, "n8");
+  BOOST_TEST(!dbDatabase::ecoHasUnrecordedEdits(block));
+  dbBTerm::create(block->findNet("n1"), "n1");
+  BOOST_TEST(dbDatabase::ecoHasUnrecordedEdits(block));
+
+  // A new eco starts from a clean slate.
+  dbDatabase::beginEco(block);
+  BOOST_TEST(!dbDatabase::ecoHasUnrecordedEdits(block));
+  dbWire::create(block->findNet("n5"));
+  BOOST_TEST(dbDatabase::ecoHasUnrecordedEdits(block));
+
+  dbDatabase::endEco(block);
+  BOOST_TEST(!dbDatabase::ecoHasUnrecordedEdits(block));
+  dbDatabase::destroy(db);
+}
+
+// The size of the eco of a move of i1 to (x, y) with orientation orient.
+long placementEcoSize(bool bulk, int x, int y, dbOrientType orient)
+{
+  dbDatabase* db    = create2LevetDbNoBTerms();
+  dbBlock*    block = db->getChip()->getBlock();
+  dbInst*     i1    = block->findInst("i1");
+  dbDatabase::beginEco(block);
+
+  if (bulk)
+    block->setInstPlacement({i1}, {x}, {y}, {orient});
+  else {
+    if (i1->getOrient() != orient)
+      i1->setOrient(orient);
+    i1->setLocation(x, y);
+  }
+
+  dbDatabase::endEco(block);
+  FILE* eco = tmpfile();
+  dbDatabase::writeEco(block, eco);
+  long size = ftell(eco);
+  fclose(eco);
+  dbDatabase::destroy(db);
+  return size;
+}
+
+BOOST_AUTO_TEST_CASE(test_placement_journal)
+{
+  // setInstPlacement journals the same changes as setOrient and
+  // setLocation: a move without a new orientation has no FLAGS entry.
+  BOOST_TEST(placementEcoSize(true, 3000, 4000, dbOrientType::R0)
+             == placementEcoSize(false, 3000, 4000, dbOrientType::R0));
+  BOOST_TEST(placementEcoSize(true, 3000, 4000, dbOrientType::R90)
+             == placementEcoSize(false, 3000, 4000, dbOrientType::R90));
+  BOOST_TEST(placementEcoSize(true, 3000, 4000, dbOrientType::R0)
+             < placementEcoSize(true, 3000, 4000, dbOrientType::R90));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
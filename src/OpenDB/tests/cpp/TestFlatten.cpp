@@ -0,0 +1,143 @@
+#define BOOST_TEST_MODULE TestFlatten
+#include <boost/test/included/unit_test.hpp>
+#include <string>
+
+#include "db.h"
+#include "dbWireCodec.h"
+#include "helper.cpp"
+
+using namespace odb;
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+// Route net from the left of instance i to its input a.
+void encodeInput(dbBlock* block, dbNet* net, dbTechLayer* layer, int i)
+{
+  dbWireEncoder encoder;
+  encoder.begin(dbWire::create(net));
+  encoder.newPath(layer, dbWireType::ROUTED);
+  encoder.addPoint(i * 2000 - 1000, 500);
+  encoder.addPoint(i * 2000, 500);
+  encoder.addITerm(block->findInst(("i" + to_string(i)).c_str())->findITerm("a"));
+  encoder.end();
+}
+
+// A top block with a row of hierarchical instances, each bound to its own
+// child block holding a routed chain of and2 instances from in to out.
+dbDatabase* createHierDB(int children, int cells)
+{
+  utl::Logger* logger = new utl::Logger();
+  dbDatabase*  db     = dbDatabase::create();
+  db->setLogger(logger);
+  dbTech*      tech = dbTech::create(db);
+  dbTechLayer* m1
+      = dbTechLayer::create(tech, "M1", dbTechLayerType::ROUTING);
+  dbLib*    lib  = dbLib::create(db, "lib1", ',');
+  createMaster2X1(lib, "and2", 1000, 1000, "a", "b", "o");
+  dbMaster* blk  = dbMaster::create(lib, "blk");
+  blk->setWidth(100000);
+  blk->setHeight(10000);
+  blk->setType(dbMasterType::BLOCK);
+  dbMTerm::create(blk, "in", dbIoType::INPUT, dbSigType::SIGNAL);
+  dbMTerm::create(blk, "out", dbIoType::OUTPUT, dbSigType::SIGNAL);
+  blk->setFrozen();
+
+  dbChip*  chip = dbChip::create(db);
+  dbBlock* top  = dbBlock::create(chip, "top", '/');
+  dbNet*   prev = dbNet::create(top, "t0");
+  for (int c = 0; c < children; c++) {
+    string  name = "u" + to_string(c);
+    dbInst* inst = dbInst::create(top, blk, name.c_str());
+    inst->setOrigin(c * 100000, 0);
+    inst->setPlacementStatus(dbPlacementStatus::PLACED);
+    dbNet* next = dbNet::create(top, ("t" + to_string(c + 1)).c_str());
+    dbITerm::connect(inst->findITerm("in"), prev);
+    dbITerm::connect(inst->findITerm("out"), next);
+    prev = next;
+
+    dbBlock* child = dbBlock::create(top, ("blk_" + name).c_str(), '/');
+    ChainSpec spec;
+    spec.pitch  = 2000;
+    spec.inputs = {{"a", 1}};
+    spec.route  = [&](dbNet* net, int i) {
+      if (i + 1 < cells)
+        encodeInput(child, net, m1, i + 1);
+    };
+    vector<dbNet*> nets = createChain(child, cells, spec);
+
+    dbNet* in = dbNet::create(child, "in");
+    dbBTerm::create(in, "in")->setIoType(dbIoType::INPUT);
+    dbITerm::connect(child->findInst("i0")->findITerm("a"), in);
+    encodeInput(child, in, m1, 0);
+    dbNet* out = nets.back();
+    out->rename("out");
+    dbBTerm::create(out, "out")->setIoType(dbIoType::OUTPUT);
+    inst->bindBlock(child);
+  }
+  return db;
+}
+
+BOOST_AUTO_TEST_CASE(test_flatten)
+{
+  dbDatabase* db  = createHierDB(16, 20);
+  dbBlock*    top = db->getChip()->getBlock();
+
+  BOOST_TEST(top->findInst("u3")->getChild() != nullptr);
+  BOOST_TEST(top->flatten(1, 4));
+
+  BOOST_TEST(top->getChildren().size() == 0);
+  BOOST_TEST(top->getInsts().size() == 16 * 20);
+  BOOST_TEST(top->findInst("u3") == nullptr);
+
+  // Internal nets get the instance name as prefix, ports map to the nets
+  // of the parent.
+  dbInst* cell = top->findInst("u3/i5");
+  BOOST_TEST(cell != nullptr);
+  int x, y;
+  cell->getOrigin(x, y);
+  BOOST_TEST(x == 3 * 100000 + 5 * 2000);
+  BOOST_TEST(cell->findITerm("a")->getNet() == top->findNet("u3/n4"));
+  BOOST_TEST(top->findInst("u3/i0")->findITerm("a")->getNet()
+             == top->findNet("t3"));
+  BOOST_TEST(top->findInst("u2/i19")->findITerm("o")->getNet()
+             == top->findNet("t3"));
+
+  // The wires are moved with their instance and point at the copied
+  // iterms. t3 holds the wire of the input net of u3.
+  dbWireDecoder decoder;
+  decoder.begin(top->findNet("u3/n4")->getWire());
+  BOOST_TEST(decoder.next() == dbWireDecoder::PATH);
+  BOOST_TEST(decoder.next() == dbWireDecoder::POINT);
+  decoder.getPoint(x, y);
+  BOOST_TEST(x == 3 * 100000 + 5 * 2000 - 1000);
+  BOOST_TEST(y == 500);
+  BOOST_TEST(decoder.next() == dbWireDecoder::POINT);
+  BOOST_TEST(decoder.next() == dbWireDecoder::ITERM);
+  BOOST_TEST(decoder.getITerm() == cell->findITerm("a"));
+
+  decoder.begin(top->findNet("t3")->getWire());
+  BOOST_TEST(decoder.next() == dbWireDecoder::PATH);
+  BOOST_TEST(decoder.next() == dbWireDecoder::POINT);
+  decoder.getPoint(x, y);
+  BOOST_TEST(x == 3 * 100000 - 1000);
+
+  dbDatabase::destroy(db);
+}
+
+BOOST_AUTO_TEST_CASE(test_threads_do_not_change_result)
+{
+  dbDatabase* db0  = createHierDB(24, 30);
+  dbDatabase* db1  = createHierDB(24, 30);
+  dbBlock*    top0 = db0->getChip()->getBlock();
+  dbBlock*    top1 = db1->getChip()->getBlock();
+
+  BOOST_TEST(top0->flatten(1, 1));
+  BOOST_TEST(top1->flatten(1, 8));
+  BOOST_TEST(top0->getContentHash() == top1->getContentHash());
+
+  dbDatabase::destroy(db0);
+  dbDatabase::destroy(db1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,113 @@
+#define BOOST_TEST_MODULE TestLefCache
+#include <boost/test/included/unit_test.hpp>
+#include <dirent.h>
+#include <stdlib.h>
+
+#include <cstdlib>
+#include <string>
+
+#include "db.h"
+#include "lefin.h"
+#include "utility/Logger.h"
+
+using namespace odb;
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+// The number of cache entries in dir.
+int countEntries(const string& dir)
+{
+  int  count = 0;
+  DIR* d     = opendir(dir.c_str());
+  while (dirent* entry = readdir(d))
+    if (string(entry->d_name).find(".lefdb") != string::npos)
+      count++;
+  closedir(d);
+  return count;
+}
+
+// Read the technology and then the library of gscl45nm.lef, and the
+// combined technology and library of the Nangate45 LEF, into two databases.
+void readLefs(utl::Logger*  logger,
+              const string& cache_dir,
+              dbDatabase*&  db1,
+              dbDatabase*&  db2)
+{
+  string base = std::getenv("BASE_DIR");
+  string gscl = base + "/data/gscl45nm.lef";
+  string ng45 = base + "/data/Nangate45/NangateOpenCellLibrary.mod.lef";
+
+  db1 = dbDatabase::create();
+  db1->setLogger(logger);
+  lefin reader1(db1, logger, false);
+  reader1.setCacheDir(cache_dir.c_str());
+  BOOST_REQUIRE(reader1.createTech(gscl.c_str()));
+  BOOST_REQUIRE(reader1.createLib("gscl45nm", gscl.c_str()));
+
+  db2 = dbDatabase::create();
+  db2->setLogger(logger);
+  lefin reader2(db2, logger, false);
+  reader2.setCacheDir(cache_dir.c_str());
+  BOOST_REQUIRE(reader2.createTechAndLib("ng45", ng45.c_str()));
+}
+
+BOOST_AUTO_TEST_CASE(test_cache)
+{
+  utl::Logger* logger = new utl::Logger();
+  string cache_dir = string(std::getenv("BASE_DIR")) + "/results/lefcacheXXXXXX";
+  BOOST_REQUIRE(mkdtemp(&cache_dir[0]));
+
+  dbDatabase *parsed1, *parsed2;
+  readLefs(logger, "", parsed1, parsed2);
+
+  // The first read fills the cache, the second one loads from it.
+  dbDatabase *cold1, *cold2;
+  readLefs(logger, cache_dir, cold1, cold2);
+  BOOST_TEST(countEntries(cache_dir) == 3);
+
+  dbDatabase *warm1, *warm2;
+  readLefs(logger, cache_dir, warm1, warm2);
+  BOOST_TEST(countEntries(cache_dir) == 3);
+
+  BOOST_TEST(!dbDatabase::diff(parsed1, cold1, stdout, 2));
+  BOOST_TEST(!dbDatabase::diff(parsed2, cold2, stdout, 2));
+  BOOST_TEST(!dbDatabase::diff(parsed1, warm1, stdout, 2));
+  BOOST_TEST(!dbDatabase::diff(parsed2, warm2, stdout, 2));
+
+  // Loaded masters get fresh ids, like parsed ones.
+  dbLib* lib = warm1->findLib("gscl45nm");
+  BOOST_REQUIRE(lib);
+  BOOST_TEST(lib->getMasters().size() > 0);
+  int id = 0;
+  for (dbMaster* master : lib->getMasters())
+    BOOST_TEST(master->getMasterId() == id++);
+
+  // A library read into another technology is not taken from the cache.
+  // This library LEF sets the manufacturing grid back, which the cache
+  // can't replay into the existing technology, so it is not cached either.
+  string gscl = string(std::getenv("BASE_DIR")) + "/data/gscl45nm.lef";
+  dbDatabase* dbs[2];
+  for (dbDatabase*& db : dbs) {
+    db = dbDatabase::create();
+    db->setLogger(logger);
+    lefin reader(db, logger, false);
+    reader.setCacheDir(cache_dir.c_str());
+    BOOST_REQUIRE(reader.createTech(gscl.c_str()));
+    dbTech*      tech  = db->getTech();
+    dbTechLayer* layer = tech->findLayer("metal1");
+    tech->setManufacturingGrid(1);
+    BOOST_REQUIRE(reader.createLib("gscl45nm", gscl.c_str()));
+    BOOST_TEST(countEntries(cache_dir) == 3);
+    BOOST_TEST(db->getTech() == tech);
+    BOOST_TEST(tech->findLayer("metal1") == layer);
+    BOOST_TEST(tech->getManufacturingGrid() != 1);
+  }
+  BOOST_TEST(!dbDatabase::diff(parsed1, dbs[0], stdout, 2));
+
+  for (dbDatabase* d :
+       {parsed1, parsed2, cold1, cold2, warm1, warm2, dbs[0], dbs[1]})
+    dbDatabase::destroy(d);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
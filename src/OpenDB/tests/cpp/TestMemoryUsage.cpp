@@ -0,0 +1,59 @@
+#define BOOST_TEST_MODULE TestMemoryUsage
+#include <boost/test/included/unit_test.hpp>
+#include <string>
+#include <vector>
+
+#include "db.h"
+#include "helper.cpp"
+
+using namespace odb;
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+const dbMemoryUsage* findUsage(const vector<dbMemoryUsage>& usage,
+                               const string&                name)
+{
+  for (const dbMemoryUsage& entry : usage)
+    if (entry._name == name)
+      return &entry;
+  return NULL;
+}
+
+BOOST_AUTO_TEST_CASE(test_memory_usage)
+{
+  dbDatabase*           db    = createSimpleDB();
+  dbBlock*              block = db->getChip()->getBlock();
+  vector<dbMemoryUsage> usage;
+  block->getMemoryUsage(usage);
+  uint64 name_cnt = findUsage(usage, "names")->_count;
+
+  for (int i = 0; i < 1000; i++)
+    dbNet::create(block, ("net" + to_string(i)).c_str());
+
+  usage.clear();
+  block->getMemoryUsage(usage);
+  const dbMemoryUsage* nets  = findUsage(usage, "dbNet");
+  const dbMemoryUsage* names = findUsage(usage, "names");
+  BOOST_TEST(nets != nullptr);
+  BOOST_TEST(names != nullptr);
+  BOOST_TEST(nets->_count == 1000);
+  BOOST_TEST(nets->_used > 0);
+  BOOST_TEST(names->_count == name_cnt + 1000);
+  uint64 used   = nets->_used;
+  uint64 wasted = nets->_wasted;
+
+  // Destroyed nets leave free slots in the table.
+  for (int i = 0; i < 500; i++)
+    dbNet::destroy(block->findNet(("net" + to_string(i)).c_str()));
+  usage.clear();
+  block->getMemoryUsage(usage);
+  nets = findUsage(usage, "dbNet");
+  BOOST_TEST(nets->_count == 500);
+  BOOST_TEST(nets->_used < used);
+  BOOST_TEST(nets->_used + nets->_wasted == used + wasted);
+
+  dbDatabase::destroy(db);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,116 @@
+#define BOOST_TEST_MODULE TestNameIndex
+#include <boost/test/included/unit_test.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "db.h"
+#include "helper.cpp"
+
+using namespace odb;
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+BOOST_AUTO_TEST_CASE(test_find_after_edits)
+{
+  dbDatabase* db    = createSimpleDB();
+  dbBlock*    block = db->getChip()->getBlock();
+  dbMaster*   and2  = db->findMaster("and2");
+
+  BOOST_TEST(block->findInst("i0") == nullptr);
+
+  vector<dbInst*> insts;
+  for (int i = 0; i < 5000; i++)
+    insts.push_back(
+        dbInst::create(block, and2, ("i" + to_string(i)).c_str()));
+
+  // Remove every third instance and rename every seventh one.
+  for (int i = 0; i < 5000; i += 3) {
+    dbInst::destroy(insts[i]);
+    insts[i] = nullptr;
+  }
+  for (int i = 1; i < 5000; i += 7)
+    if (insts[i])
+      insts[i]->rename(("r" + to_string(i)).c_str());
+
+  for (int i = 0; i < 5000; i++) {
+    dbInst* inst = block->findInst(("i" + to_string(i)).c_str());
+    if (insts[i] == nullptr)
+      BOOST_TEST(inst == nullptr);
+    else if (i % 7 == 1) {
+      BOOST_TEST(inst == nullptr);
+      BOOST_TEST(block->findInst(("r" + to_string(i)).c_str()) == insts[i]);
+    } else
+      BOOST_TEST(inst == insts[i]);
+  }
+
+  dbNet* net = dbNet::create(block, "n0");
+  BOOST_TEST(block->findNet("n0") == net);
+  dbNet::destroy(net);
+  BOOST_TEST(block->findNet("n0") == nullptr);
+
+  dbDatabase::destroy(db);
+}
+
+BOOST_AUTO_TEST_CASE(test_bulk_find)
+{
+  dbDatabase* db    = createSimpleDB();
+  dbBlock*    block = db->getChip()->getBlock();
+  dbMaster*   and2  = db->findMaster("and2");
+
+  vector<string> names;
+  for (int i = 0; i < 1000; i++) {
+    string name = "i" + to_string(i);
+    dbInst::create(block, and2, name.c_str());
+    names.push_back(name);
+    names.push_back("missing" + to_string(i));
+  }
+
+  vector<dbInst*> insts;
+  block->findInsts(names, insts);
+  BOOST_TEST(insts.size() == names.size());
+  for (size_t i = 0; i < names.size(); i++)
+    BOOST_TEST(insts[i] == block->findInst(names[i].c_str()));
+  BOOST_TEST(insts[0] != nullptr);
+  BOOST_TEST(insts[1] == nullptr);
+
+  vector<dbNet*> nets;
+  block->findNets(names, nets);
+  BOOST_TEST(nets.size() == names.size());
+  for (dbNet* net : nets)
+    BOOST_TEST(net == nullptr);
+
+  dbDatabase::destroy(db);
+}
+
+BOOST_AUTO_TEST_CASE(test_concurrent_find)
+{
+  dbDatabase* db    = createSimpleDB();
+  dbBlock*    block = db->getChip()->getBlock();
+  for (int i = 0; i < 2000; i++)
+    dbNet::create(block, ("n" + to_string(i)).c_str());
+
+  // The first lookups, which build the index, race with each other.
+  block->beginConcurrentRead();
+  vector<int>    found(8);
+  vector<thread> threads;
+  for (int t = 0; t < (int) found.size(); t++)
+    threads.emplace_back([&, t]() {
+      for (int i = 0; i < 2000; i++) {
+        dbNet* net = block->findNet(("n" + to_string(i)).c_str());
+        if (net && net->getName() == "n" + to_string(i))
+          found[t]++;
+      }
+    });
+  for (thread& t : threads)
+    t.join();
+  block->endConcurrentRead();
+
+  for (int n : found)
+    BOOST_TEST(n == 2000);
+
+  dbDatabase::destroy(db);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,111 @@
+#define BOOST_TEST_MODULE TestOrderWires
+#include <boost/test/included/unit_test.hpp>
+#include <string>
+
+#include "db.h"
+#include "dbWireCodec.h"
+#include "helper.cpp"
+#include "wOrder.h"
+
+using namespace odb;
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+// A row of two-input cells, each driving the next two, with every wire
+// encoded starting from the far sink so orderWires has to reorder it. Every
+// tenth net leaves its far sink unrouted and is reported disconnected.
+dbDatabase* createRoutedDB(int n)
+{
+  dbDatabase*  db   = createSimpleDB();
+  dbTech*      tech = db->getTech();
+  dbTechLayer* m1 = dbTechLayer::create(tech, "M1", dbTechLayerType::ROUTING);
+  m1->setWidth(100);
+  dbMaster*    cell = dbMaster::create(db->findLib("lib1"), "cell");
+  cell->setWidth(1000);
+  cell->setHeight(1000);
+  cell->setType(dbMasterType::CORE);
+  dbMTerm* a = dbMTerm::create(cell, "a", dbIoType::INPUT, dbSigType::SIGNAL);
+  dbBox::create(dbMPin::create(a), m1, 0, 400, 100, 600);
+  dbMTerm* b = dbMTerm::create(cell, "b", dbIoType::INPUT, dbSigType::SIGNAL);
+  dbBox::create(dbMPin::create(b), m1, 200, 400, 300, 600);
+  dbMTerm* o = dbMTerm::create(cell, "o", dbIoType::OUTPUT, dbSigType::SIGNAL);
+  dbBox::create(dbMPin::create(o), m1, 900, 400, 1000, 600);
+  cell->setFrozen();
+
+  dbBlock*  block = db->getChip()->getBlock();
+  ChainSpec spec;
+  spec.master = "cell";
+  spec.pitch  = 2000;
+  spec.inputs = {{"a", 1}, {"b", 2}};
+  spec.route  = [&](dbNet* net, int i) {
+    if (i + 2 >= n)
+      return;
+    int           drv  = i * 2000 + 950;
+    int           snk1 = (i + 1) * 2000 + 50;
+    int           snk2 = (i + 2) * 2000 + 250;
+    dbWireEncoder encoder;
+    encoder.begin(dbWire::create(net));
+    if (i % 10 != 0) {
+      encoder.newPath(m1, dbWireType::ROUTED);
+      encoder.addPoint(snk2, 500);
+      encoder.addPoint(snk1, 500);
+    }
+    encoder.newPath(m1, dbWireType::ROUTED);
+    encoder.addPoint(drv, 500);
+    encoder.addPoint(snk1, 500);
+    encoder.end();
+  };
+  vector<dbNet*> nets = createChain(block, n, spec);
+
+  // The last two instances drive no sinks.
+  dbNet::destroy(nets[n - 2]);
+  dbNet::destroy(nets[n - 1]);
+  return db;
+}
+
+BOOST_AUTO_TEST_CASE(test_order_wires_threads)
+{
+  // Enough nets for more than one batch of committed nets.
+  dbDatabase* serial_db   = createRoutedDB(20000);
+  dbDatabase* parallel_db = createRoutedDB(20000);
+  dbBlock*    serial      = serial_db->getChip()->getBlock();
+  dbBlock*    parallel    = parallel_db->getChip()->getBlock();
+
+  orderWires(serial, false, 0, 0, true, 1);
+  orderWires(parallel, false, 0, 0, true, 8);
+
+  int disconnected = 0;
+  for (dbNet* net : serial->getNets()) {
+    dbNet*  other = parallel->findNet(net->getConstName());
+    dbWire* wire  = net->getWire();
+    BOOST_TEST(net->isWireOrdered());
+    BOOST_TEST(net->isWireOrdered() == other->isWireOrdered());
+    BOOST_TEST(net->isDisconnected() == other->isDisconnected());
+    if (net->isDisconnected())
+      disconnected++;
+
+    // Ordered wires start at the driver.
+    dbWireDecoder decoder;
+    decoder.begin(wire);
+    decoder.next();
+    BOOST_TEST(decoder.next() == dbWireDecoder::POINT);
+    int x, y;
+    decoder.getPoint(x, y);
+    BOOST_TEST(x % 2000 == 950);
+
+    dbWire* other_wire = other->getWire();
+    BOOST_TEST(wire->length() == other_wire->length());
+    bool same = wire->length() == other_wire->length();
+    for (uint i = 0; same && i < wire->length(); i++)
+      same = wire->getOpcode(i) == other_wire->getOpcode(i)
+             && wire->getData(i) == other_wire->getData(i);
+    BOOST_TEST(same);
+  }
+  BOOST_TEST(disconnected == 2000);
+
+  dbDatabase::destroy(serial_db);
+  dbDatabase::destroy(parallel_db);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,119 @@
+#define BOOST_TEST_MODULE TestPageAllocator
+#include <boost/test/included/unit_test.hpp>
+#include <string>
+
+#include "db.h"
+#include "dbPageAllocator.h"
+#include "helper.cpp"
+
+using namespace odb;
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+void fillBlock(dbDatabase* db, int n)
+{
+  dbBlock*  block = db->getChip()->getBlock();
+  dbMaster* and2  = db->findMaster("and2");
+  for (int i = 0; i < n; i++) {
+    string  name = to_string(i);
+    dbInst* inst = dbInst::create(block, and2, ("i" + name).c_str());
+    dbNet*  net  = dbNet::create(block, ("n" + name).c_str());
+    dbITerm::connect(inst->findITerm("o"), net);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_malloc_is_default)
+{
+  BOOST_TEST(getPageAllocator() == getMallocPageAllocator());
+}
+
+BOOST_AUTO_TEST_CASE(test_arena_recycles_pages)
+{
+  dbHugePageArena arena(4 << 20);
+  uint64          mapped, allocated;
+  arena.getUsage(mapped, allocated);
+  BOOST_TEST(mapped == 0);
+  BOOST_TEST(allocated == 0);
+
+  void* a = arena.allocate(1000);
+  void* b = arena.allocate(1000);
+  void* c = arena.allocate(3000);
+  BOOST_TEST(a != b);
+  BOOST_TEST((uintptr_t) a % 64 == 0);
+  BOOST_TEST((uintptr_t) c % 64 == 0);
+  arena.getUsage(mapped, allocated);
+  BOOST_TEST(mapped == 4 << 20);
+  BOOST_TEST(allocated == 1024 + 1024 + 3008);
+
+  // A freed page goes to the next page of its size only.
+  arena.deallocate(a, 1000);
+  BOOST_TEST(arena.allocate(3000) != a);
+  BOOST_TEST(arena.allocate(1000) == a);
+
+  // Pages too large for the chunks come from malloc.
+  void* big = arena.allocate(2 << 20);
+  arena.getUsage(mapped, allocated);
+  BOOST_TEST(mapped == 4 << 20);
+  arena.deallocate(big, 2 << 20);
+}
+
+BOOST_AUTO_TEST_CASE(test_tables_in_arena)
+{
+  dbHugePageArena arena(4 << 20);
+  setPageAllocator(&arena);
+  BOOST_TEST(getPageAllocator() == &arena);
+
+  uint64 mapped, allocated, first_mapped = 0;
+  for (int round = 0; round < 3; round++) {
+    dbDatabase* db = createSimpleDB();
+    fillBlock(db, 20000);
+    dbBlock* block = db->getChip()->getBlock();
+    BOOST_TEST(block->getInsts().size() == 20000);
+    BOOST_TEST(block->findNet("n19999")->getITerms().size() == 1);
+
+    // The pages of a destroyed database are reused by the next one.
+    arena.getUsage(mapped, allocated);
+    BOOST_TEST(allocated > 0);
+    if (round == 0)
+      first_mapped = mapped;
+    BOOST_TEST(mapped == first_mapped);
+
+    dbDatabase::destroy(db);
+    arena.getUsage(mapped, allocated);
+    BOOST_TEST(allocated == 0);
+  }
+
+  setPageAllocator(NULL);
+  BOOST_TEST(getPageAllocator() == getMallocPageAllocator());
+}
+
+BOOST_AUTO_TEST_CASE(test_switch_with_live_tables)
+{
+  dbHugePageArena arena(4 << 20);
+  uint64          mapped, allocated;
+
+  // A database created before the switch keeps taking pages from malloc.
+  dbDatabase* db0 = createSimpleDB();
+  setPageAllocator(&arena);
+  fillBlock(db0, 1000);
+  arena.getUsage(mapped, allocated);
+  BOOST_TEST(allocated == 0);
+
+  // The tables of a database created after it use the arena, also after
+  // the default is restored.
+  dbDatabase* db1 = createSimpleDB();
+  setPageAllocator(NULL);
+  fillBlock(db1, 1000);
+  arena.getUsage(mapped, allocated);
+  BOOST_TEST(allocated > 0);
+
+  BOOST_TEST(!dbDatabase::diff(db0, db1, nullptr, 2));
+
+  dbDatabase::destroy(db1);
+  arena.getUsage(mapped, allocated);
+  BOOST_TEST(allocated == 0);
+  dbDatabase::destroy(db0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,159 @@
+#define BOOST_TEST_MODULE TestParallelDef
+#include <boost/test/included/unit_test.hpp>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "db.h"
+#include "dbWireCodec.h"
+#include "defin.h"
+#include "defout.h"
+#include "helper.cpp"
+
+using namespace odb;
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+// A chain of and2 instances with a wire on every net and a special net
+// with a few stripes, big enough to be read in several chunks.
+dbDatabase* createRoutedDB(int n)
+{
+  dbDatabase*  db    = createSimpleDB();
+  dbBlock*     block = db->getChip()->getBlock();
+  dbTechLayer* m1
+      = dbTechLayer::create(db->getTech(), "M1", dbTechLayerType::ROUTING);
+  m1->setWidth(100);
+  block->setDefUnits(1000);
+  block->setDieArea(Rect(0, 0, n * 1000 + 3000, 13000));
+
+  ChainSpec spec;
+  spec.rows  = 10;
+  spec.route = [&](dbNet* net, int i) {
+    dbWireEncoder encoder;
+    encoder.begin(dbWire::create(net));
+    encoder.newPath(m1, dbWireType::ROUTED);
+    encoder.addPoint(i * 1000, 0);
+    encoder.addPoint(i * 1000 + 2000, 0);
+    encoder.addPoint(i * 1000 + 2000, 3000);
+    encoder.end();
+  };
+  createChain(block, n, spec);
+
+  dbNet* vdd = dbNet::create(block, "VDD");
+  vdd->setSpecial();
+  vdd->setSigType(dbSigType::POWER);
+  dbSWire* swire = dbSWire::create(vdd, dbWireType::ROUTED);
+  for (int i = 0; i < 10; i++) {
+    dbSBox::create(swire,
+                   m1,
+                   0,
+                   i * 1000,
+                   n * 1000,
+                   i * 1000 + 200,
+                   dbWireShapeType::STRIPE);
+  }
+  return db;
+}
+
+// Everything the DEF reader creates for the nets of a block, folded into
+// a list of strings.
+vector<string> describeNets(dbBlock* block)
+{
+  vector<string> nets;
+  for (dbNet* net : block->getNets()) {
+    string desc = net->getName() + " " + to_string(net->getId()) + " "
+                  + to_string(net->isSpecial()) + " "
+                  + net->getSigType().getString();
+    for (dbITerm* iterm : net->getITerms())
+      desc += " " + iterm->getInst()->getName() + "/"
+              + iterm->getMTerm()->getName();
+    if (net->getWire()) {
+      dbWireDecoder decoder;
+      decoder.begin(net->getWire());
+      for (auto op = decoder.next(); op != dbWireDecoder::END_DECODE;
+           op      = decoder.next()) {
+        desc += " " + to_string(op);
+        if (op == dbWireDecoder::POINT) {
+          int x, y;
+          decoder.getPoint(x, y);
+          desc += "(" + to_string(x) + "," + to_string(y) + ")";
+        }
+      }
+    }
+    for (dbSWire* swire : net->getSWires()) {
+      for (dbSBox* box : swire->getWires()) {
+        Rect rect;
+        box->getBox(rect);
+        desc += " [" + to_string(rect.xMin()) + "," + to_string(rect.yMin())
+                + "," + to_string(rect.xMax()) + ","
+                + to_string(rect.yMax()) + "]";
+      }
+    }
+    nets.push_back(desc);
+  }
+  return nets;
+}
+
+BOOST_AUTO_TEST_CASE(test_parallel_def)
+{
+  utl::Logger* logger = new utl::Logger();
+  dbDatabase*  db     = createRoutedDB(3000);
+  dbBlock*     block  = db->getChip()->getBlock();
+
+  string path
+      = string(std::getenv("BASE_DIR")) + "/results/TestParallelDef.def";
+  defout writer(logger);
+  BOOST_TEST(writer.writeBlock(block, path.c_str()));
+
+  vector<dbLib*> libs{db->findLib("lib1")};
+
+  defin serial_reader(db, logger);
+  dbBlock* serial = serial_reader.createBlock(block, libs, path.c_str());
+
+  defin parallel_reader(db, logger);
+  parallel_reader.setNumThreads(4);
+  dbBlock* parallel = parallel_reader.createBlock(block, libs, path.c_str());
+
+  BOOST_TEST(serial != nullptr);
+  BOOST_TEST(parallel != nullptr);
+  BOOST_TEST(parallel->getNets().size() == 3001);
+  BOOST_TEST(describeNets(parallel) == describeNets(serial));
+
+  dbDatabase::destroy(db);
+}
+
+string readFile(const string& path)
+{
+  ifstream          file(path);
+  std::stringstream text;
+  text << file.rdbuf();
+  return text.str();
+}
+
+BOOST_AUTO_TEST_CASE(test_parallel_def_writer)
+{
+  utl::Logger* logger = new utl::Logger();
+  dbDatabase*  db     = createRoutedDB(3000);
+  dbBlock*     block  = db->getChip()->getBlock();
+
+  string base = string(std::getenv("BASE_DIR")) + "/results/";
+  defout serial_writer(logger);
+  BOOST_TEST(serial_writer.writeBlock(block, (base + "TestSerialOut.def").c_str()));
+
+  defout parallel_writer(logger);
+  parallel_writer.setNumThreads(4);
+  BOOST_TEST(parallel_writer.writeBlock(block,
+                                        (base + "TestParallelOut.def").c_str()));
+  BOOST_TEST(!block->inConcurrentRead());
+
+  string serial = readFile(base + "TestSerialOut.def");
+  BOOST_TEST(serial.size() > 0);
+  BOOST_TEST(readFile(base + "TestParallelOut.def") == serial);
+
+  dbDatabase::destroy(db);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
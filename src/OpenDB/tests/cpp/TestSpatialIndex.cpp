@@ -0,0 +1,137 @@
+#define BOOST_TEST_MODULE TestSpatialIndex
+#include <boost/test/included/unit_test.hpp>
+#include <utility>
+#include <vector>
+
+#include "db.h"
+#include "dbSpatialIndex.h"
+#include "dbWireCodec.h"
+#include "helper.cpp"
+
+using namespace odb;
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+void encodeWire(dbNet* net, dbTechLayer* layer, int x1, int x2, int y)
+{
+  dbWire* wire = net->getWire();
+  if (!wire)
+    wire = dbWire::create(net);
+  dbWireEncoder encoder;
+  encoder.begin(wire);
+  encoder.newPath(layer, dbWireType::ROUTED);
+  encoder.addPoint(x1, y);
+  encoder.addPoint(x2, y);
+  encoder.end();
+}
+
+BOOST_AUTO_TEST_CASE(test_spatial_index)
+{
+  dbDatabase*  db    = createSimpleDB();
+  dbBlock*     block = db->getChip()->getBlock();
+  dbMaster*    and2  = db->findMaster("and2");
+  dbTechLayer* m1
+      = dbTechLayer::create(db->getTech(), "M1", dbTechLayerType::ROUTING);
+  dbTechLayer* m2
+      = dbTechLayer::create(db->getTech(), "M2", dbTechLayerType::ROUTING);
+
+  dbInst* i1 = dbInst::create(block, and2, "i1");
+  i1->setOrigin(0, 0);
+  dbInst* i2 = dbInst::create(block, and2, "i2");
+  i2->setOrigin(5000, 0);
+  dbNet* n1 = dbNet::create(block, "n1");
+  encodeWire(n1, m1, 0, 4000, 500);
+  dbFill::create(block, false, 0, m2, 0, 0, 100, 100);
+
+  dbSpatialIndex* index = block->getSpatialIndex();
+  BOOST_TEST(block->getSpatialIndex() == index);
+
+  vector<dbInst*>                insts;
+  vector<pair<Rect, dbNet*>>     shapes;
+  vector<dbFill*>                fills;
+  index->searchInsts(Rect(4000, 0, 4500, 100), insts);
+  BOOST_TEST(insts.empty());
+  index->searchInsts(Rect(5500, 0, 5600, 100), insts);
+  BOOST_TEST((insts.size() == 1 && insts[0] == i2));
+
+  index->searchShapes(m1, Rect(3900, 400, 4100, 600), shapes);
+  BOOST_TEST((shapes.size() == 1 && shapes[0].second == n1));
+  index->searchShapes(m2, Rect(3900, 400, 4100, 600), shapes);
+  BOOST_TEST(shapes.empty());
+  index->searchFills(m2, Rect(50, 50, 60, 60), fills);
+  BOOST_TEST(fills.size() == 1);
+
+  // Moves, re-routes and new objects show up without a rebuild.
+  i2->setOrigin(3500, 0);
+  index->searchInsts(Rect(4000, 0, 4500, 100), insts);
+  BOOST_TEST((insts.size() == 1 && insts[0] == i2));
+  index->searchInsts(Rect(5500, 0, 5600, 100), insts);
+  BOOST_TEST(insts.empty());
+
+  vector<dbInst*> moved = {i1};
+  block->setInstPlacement(moved, {10000}, {10000}, {});
+  index->searchInsts(Rect(10500, 10500, 10600, 10600), insts);
+  BOOST_TEST((insts.size() == 1 && insts[0] == i1));
+  index->searchInsts(Rect(100, 100, 200, 200), insts);
+  BOOST_TEST(insts.empty());
+
+  // A callback batch reports the moves only after they happened.
+  block->beginCallBackBatch();
+  i1->setOrigin(12000, 10000);
+  i1->setOrigin(14000, 10000);
+  block->commitCallBackBatch();
+  index->searchInsts(Rect(14500, 10500, 14600, 10600), insts);
+  BOOST_TEST((insts.size() == 1 && insts[0] == i1));
+  index->searchInsts(Rect(10500, 10500, 10600, 10600), insts);
+  BOOST_TEST(insts.empty());
+
+  encodeWire(n1, m2, 0, 2000, 500);
+  index->searchShapes(m1, Rect(3900, 400, 4100, 600), shapes);
+  BOOST_TEST(shapes.empty());
+  index->searchShapes(m2, Rect(1900, 400, 2100, 600), shapes);
+  BOOST_TEST((shapes.size() == 1 && shapes[0].second == n1));
+
+  dbNet* n2 = dbNet::create(block, "n2");
+  encodeWire(n2, m2, 1000, 3000, 500);
+  index->searchShapes(m2, Rect(1900, 400, 2100, 600), shapes);
+  BOOST_TEST(shapes.size() == 2);
+  dbWire::destroy(n1->getWire());
+  index->searchShapes(m2, Rect(1900, 400, 2100, 600), shapes);
+  BOOST_TEST((shapes.size() == 1 && shapes[0].second == n2));
+  dbNet::destroy(n2);
+  index->searchShapes(m2, Rect(1900, 400, 2100, 600), shapes);
+  BOOST_TEST(shapes.empty());
+
+  dbInst* i3 = dbInst::create(block, and2, "i3");
+  i3->setOrigin(20000, 0);
+  index->searchInsts(Rect(20000, 0, 20000, 0), insts);
+  BOOST_TEST((insts.size() == 1 && insts[0] == i3));
+  dbInst::destroy(i3);
+  index->searchInsts(Rect(20000, 0, 20000, 0), insts);
+  BOOST_TEST(insts.empty());
+
+  dbNet*   n3    = dbNet::create(block, "n3");
+  dbSWire* swire = dbSWire::create(n3, dbWireType::ROUTED);
+  dbSBox::create(swire,
+                 m1,
+                 0,
+                 8000,
+                 1000,
+                 8100,
+                 dbWireShapeType::STRIPE,
+                 dbSBox::Direction::HORIZONTAL);
+  index->searchShapes(m1, Rect(500, 8000, 600, 8100), shapes);
+  BOOST_TEST((shapes.size() == 1 && shapes[0].second == n3));
+
+  dbFill* fill = dbFill::create(block, false, 0, m2, 200, 200, 300, 300);
+  index->searchFills(m2, Rect(0, 0, 1000, 1000), fills);
+  BOOST_TEST(fills.size() == 2);
+  dbFill::destroy(fill);
+  index->searchFills(m2, Rect(0, 0, 1000, 1000), fills);
+  BOOST_TEST(fills.size() == 1);
+
+  dbDatabase::destroy(db);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
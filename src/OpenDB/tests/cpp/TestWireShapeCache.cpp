@@ -0,0 +1,137 @@
+#define BOOST_TEST_MODULE TestWireShapeCache
+#include <boost/test/included/unit_test.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "db.h"
+#include "dbShape.h"
+#include "dbWireCodec.h"
+#include "dbWireShapeCache.h"
+#include "helper.cpp"
+
+using namespace odb;
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+void encodeWire(dbWire* wire, dbTechLayer* m1, dbTechVia* via, int x)
+{
+  dbWireEncoder encoder;
+  encoder.begin(wire);
+  encoder.newPath(m1, dbWireType::ROUTED);
+  encoder.addPoint(x, 0);
+  encoder.addPoint(x + 2000, 0);
+  encoder.addTechVia(via);
+  encoder.addPoint(x + 2000, 3000);
+  encoder.addRect(-10, -10, 10, 10);
+  encoder.end();
+}
+
+// A net per instance, each with a wire of two segments, a via and a rect.
+dbDatabase* createWiredDB(int n)
+{
+  dbDatabase*  db    = createSimpleDB();
+  dbBlock*     block = db->getChip()->getBlock();
+  dbTech*      tech  = db->getTech();
+  dbTechLayer* m1 = dbTechLayer::create(tech, "M1", dbTechLayerType::ROUTING);
+  dbTechLayer* v1 = dbTechLayer::create(tech, "V1", dbTechLayerType::CUT);
+  dbTechLayer* m2 = dbTechLayer::create(tech, "M2", dbTechLayerType::ROUTING);
+  m1->setWidth(100);
+  m2->setWidth(100);
+  dbTechVia* via = dbTechVia::create(tech, "VIA12");
+  dbBox::create(via, m1, -60, -60, 60, 60);
+  dbBox::create(via, v1, -40, -40, 40, 40);
+  dbBox::create(via, m2, -60, -60, 60, 60);
+  ChainSpec spec;
+  spec.inputs = {};
+  spec.route  = [&](dbNet* net, int i) {
+    encodeWire(dbWire::create(net), m1, via, i * 1000);
+  };
+  createChain(block, n, spec);
+  return db;
+}
+
+// The shapes, shape ids and previous points of wire, as dbWireShapeItr
+// reports them.
+vector<string> iterateShapes(dbWire* wire)
+{
+  vector<string> shapes;
+  dbWireShapeItr itr;
+  dbShape        shape;
+  for (itr.begin(wire); itr.next(shape);) {
+    Rect rect;
+    shape.getBox(rect);
+    shapes.push_back(to_string(itr.getShapeId()) + " "
+                     + to_string(shape.getType()) + " "
+                     + to_string(rect.xMin()) + " " + to_string(rect.yMin())
+                     + " " + to_string(rect.xMax()) + " "
+                     + to_string(rect.yMax()) + " " + to_string(itr._prev_x)
+                     + " " + to_string(itr._prev_y));
+  }
+  return shapes;
+}
+
+vector<vector<string>> iterateBlock(dbBlock* block)
+{
+  vector<vector<string>> wires;
+  for (dbNet* net : block->getNets())
+    wires.push_back(iterateShapes(net->getWire()));
+  return wires;
+}
+
+BOOST_AUTO_TEST_CASE(test_wire_shape_cache)
+{
+  dbDatabase* db    = createWiredDB(500);
+  dbBlock*    block = db->getChip()->getBlock();
+
+  vector<vector<string>> decoded = iterateBlock(block);
+  BOOST_TEST(decoded[0].size() == 4);
+
+  // Shapes read through the cache are the decoded ones.
+  dbWireShapeCache* cache = block->getWireShapeCache();
+  BOOST_TEST(iterateBlock(block) == decoded);
+  BOOST_TEST(iterateBlock(block) == decoded);
+
+  // An edited wire is decoded again.
+  dbNet*       net = block->findNet("n7");
+  dbTechLayer* m1  = db->getTech()->findLayer("M1");
+  dbTechVia*   via = db->getTech()->findVia("VIA12");
+  encodeWire(net->getWire(), m1, via, 100000);
+  const dbWireShapeCache::Shapes& shapes = cache->getShapes(net->getWire());
+  Rect                            rect;
+  shapes.shapes[0].getBox(rect);
+  BOOST_TEST(shapes.shapes.size() == 4);
+  BOOST_TEST(rect.xMin() == 100000 - 50);
+  block->destroyWireShapeCache();
+  decoded = iterateBlock(block);
+
+  // Readers on several threads fill the cache together.
+  cache = block->getWireShapeCache();
+  block->beginConcurrentRead();
+  vector<vector<vector<string>>> results(4);
+  vector<thread>                 threads;
+  for (int i = 0; i < (int) results.size(); i++)
+    threads.emplace_back([&, i]() { results[i] = iterateBlock(block); });
+  for (thread& t : threads)
+    t.join();
+  block->endConcurrentRead();
+  for (auto& result : results)
+    BOOST_TEST(result == decoded);
+
+  cache->clear();
+  cache->decodeAll(4);
+  BOOST_TEST(iterateBlock(block) == decoded);
+
+  // Segments donated to another wire drop the cached shapes of that wire.
+  dbNet* target = block->findNet("n8");
+  block->findNet("n9")->donateWire(target, NULL);
+  vector<string> donated = iterateShapes(target->getWire());
+  BOOST_TEST(donated.size() == 8);
+  block->destroyWireShapeCache();
+  BOOST_TEST(iterateShapes(target->getWire()) == donated);
+
+  dbDatabase::destroy(db);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,4 +1,9 @@
 #include <stdio.h>
+
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
 #include "utility/Logger.h"
 
 #include "db.h"
@@ -94,3 +99,50 @@ dbDatabase* create2LevetDbWithBTerms()
   IN1->setIoType(dbIoType::OUTPUT);
   return db;
 }
+
+// How createChain places, connects and routes its instances.
+struct ChainSpec
+{
+  // Master of the instances; its output is "o".
+  std::string master = "and2";
+  // Instance k is "i<prefix><k>" and drives net "n<prefix><k>".
+  std::string prefix;
+  // Instance k is placed at (k * pitch, (k % rows) * pitch).
+  int pitch = 1000;
+  int rows  = 1;
+  // Inputs of instance k, each with how many instances back its driver
+  // is. An input without a driver is left unconnected.
+  std::vector<std::pair<std::string, int>> inputs = {{"a", 1}, {"b", 1}};
+  // Encodes the wire of net k, once every net is connected.
+  std::function<void(dbNet* net, int k)> route;
+};
+
+// A chain of n instances of spec.master in block, each driving a net of
+// its own. Returns the nets, net k being driven by instance k.
+std::vector<dbNet*> createChain(dbBlock* block, int n, const ChainSpec& spec)
+{
+  dbMaster*            master = block->getDb()->findMaster(spec.master.c_str());
+  std::vector<dbInst*> insts;
+  std::vector<dbNet*>  nets;
+  for (int k = 0; k < n; k++) {
+    std::string name = spec.prefix + std::to_string(k);
+    dbInst*     inst = dbInst::create(block, master, ("i" + name).c_str());
+    inst->setOrigin(k * spec.pitch, (k % spec.rows) * spec.pitch);
+    inst->setPlacementStatus(dbPlacementStatus::PLACED);
+    insts.push_back(inst);
+  }
+  for (int k = 0; k < n; k++) {
+    std::string name = spec.prefix + std::to_string(k);
+    dbNet*      net  = dbNet::create(block, ("n" + name).c_str());
+    dbITerm::connect(insts[k]->findITerm("o"), net);
+    nets.push_back(net);
+  }
+  for (int k = 0; k < n; k++)
+    for (auto& [input, back] : spec.inputs)
+      if (k >= back)
+        dbITerm::connect(insts[k]->findITerm(input.c_str()), nets[k - back]);
+  if (spec.route)
+    for (int k = 0; k < n; k++)
+      spec.route(nets[k], k);
+  return nets;
+}
@@ -0,0 +1,63 @@
+source "helpers.tcl"
+
+
+read_lef "data/gscl45nm.lef"
+read_def "data/design.def"
+set db [ord::get_db]
+set block [ord::get_db_block]
+
+set base_file [make_result_file "delta_base.db"]
+set delta_file [make_result_file "delta_resize.delta"]
+write_db -base $base_file
+
+# Add a buffer, then resize and move it and an existing instance.
+set inv [odb::dbInst_create $block [$db findMaster "INVX1"] "delta_inv"]
+$inv swapMaster [$db findMaster "INVX4"]
+$inv setLocation 2000 3000
+[$block findInst "_g0_"] setLocation 4000 1000
+write_db -delta $delta_file
+
+set resized_file [make_result_file "delta_resized.db"]
+odb::write_db $db $resized_file
+set resized_db [odb::dbDatabase_create]
+odb::read_db $resized_db $resized_file
+
+# Replaying a delta on top of the edits being recorded is refused.
+if { ![catch {read_db -delta $delta_file}] } {
+  puts "FAIL: read_db -delta replayed into a recording block"
+  exit 1
+}
+
+# compact_db folds the delta in a scratch db and leaves the session alone.
+set compact_file [make_result_file "delta_compact.db"]
+compact_db $base_file $delta_file $compact_file
+if { [odb::db_diff $db $resized_db] } {
+  puts "FAIL: compact_db changed the session db"
+  exit 1
+}
+set compact_db [odb::dbDatabase_create]
+odb::read_db $compact_db $compact_file
+if { [odb::db_diff $compact_db $resized_db] } {
+  puts "FAIL: Differences found between the compacted and resized db"
+  exit 1
+}
+
+# Reload the checkpoint.
+read_db $base_file
+read_db -delta $delta_file
+if { [odb::db_diff [ord::get_db] $resized_db] } {
+  puts "FAIL: Differences found between base plus delta and resized db"
+  exit 1
+}
+
+# Pins are not journaled, so a delta after adding one is refused.
+write_db -base $base_file
+set block [ord::get_db_block]
+odb::dbBTerm_create [$block findNet "inp1"] "delta_pin"
+if { ![catch {write_db -delta $delta_file}] } {
+  puts "FAIL: write_db -delta ignored an unrecorded pin"
+  exit 1
+}
+
+puts "pass"
+exit 0
@@ -0,0 +1,33 @@
+source "helpers.tcl"
+
+
+read_extracted_design
+
+set db_file [make_result_file "export_profile.db"]
+write_db -compress $db_file
+
+set full_db [odb::dbDatabase_create]
+odb::read_db $full_db $db_file
+
+read_db -profile placement $db_file
+set db [ord::get_db]
+set block [ord::get_db_block]
+
+# The wires and parasitics are left compressed until they are accessed.
+check "wires deferred" {$block hasDeferredWires} 1
+check "parasitics deferred" {$block hasDeferredParasitics} 1
+
+set net [$block findNet {req_msg[0]}]
+check "wire loaded" {expr {[$net getWire] != "NULL"}} 1
+check "wires decoded" {$block hasDeferredWires} 0
+check "parasitics still deferred" {$block hasDeferredParasitics} 1
+
+check "corner loaded" {$block getCornerCount} 1
+check "parasitics decoded" {$block hasDeferredParasitics} 0
+
+if { [odb::db_diff $db $full_db] } {
+  puts "FAIL: Differences found between the placement profile and full db"
+  exit 1
+}
+
+exit_summary
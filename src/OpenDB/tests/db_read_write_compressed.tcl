@@ -0,0 +1,19 @@
+source "helpers.tcl"
+
+
+set db [ord::get_db]
+read_extracted_design
+
+set db_file [make_result_file "export_compressed.db"]
+write_db -compress $db_file
+
+set new_db [odb::dbDatabase_create]
+odb::read_db $new_db $db_file
+
+if { [odb::db_diff $db $new_db] } {
+  puts "FAIL: Differences found between exported and imported db"
+  exit 1
+}
+
+puts "pass"
+exit 0
@@ -87,3 +87,14 @@ proc diff_files { file1 file2 } {
     return 0
   }
 }
+
+# Read a routed design and extract its parasitics, so that the database
+# has wires and parasitics to write.
+proc read_extracted_design {} {
+  read_lef "data/rcx/Nangate45/Nangate45.lef"
+  read_def -order_wires "data/rcx/45_gcd.def"
+  source "data/rcx/45_via_resistance.tcl"
+  define_process_corner -ext_model_index 0 X
+  extract_parasitics -ext_model_file "data/rcx/45_patterns.rules" \
+    -max_res 0 -coupling_threshold 0.1
+}
@@ -14,6 +14,10 @@ record_tests {
   edit_via_params
   row_settings
   db_read_write
+  db_read_write_compressed
+  db_read_profile
+  db_delta
+  block_snapshot
   check_routing_tracks
   polygon
   def_parser
@@ -185,6 +185,7 @@ class Ext
     bool lef_rc = false;
     bool lef_res = false;
     bool rlog = false;
+    bool compact_parasitics = false;
   };
 
   bool extract(ExtractOptions options);
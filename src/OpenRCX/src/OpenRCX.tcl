@@ -42,6 +42,7 @@ sta::define_cmd_args "extract_parasitics" {
     [-cc_model track]
     [-context_depth depth]
     [-no_merge_via_res]
+    [-compact_parasitics]
 }
 
 proc extract_parasitics { args } {
@@ -54,7 +55,7 @@ proc extract_parasitics { args } {
         -debug_net_id
         -context_depth
         -cc_model } \
-      flags { -lef_res }
+      flags { -lef_res -no_merge_via_res -compact_parasitics }
 
   set ext_model_file ''
   if { [info exists keys(-ext_model_file)] } {
@@ -83,6 +84,7 @@ proc extract_parasitics { args } {
 
   set lef_res [info exists flags(-lef_res)]
   set no_merge_via_res [info exists flags(-no_merge_via_res)]
+  set compact_parasitics [info exists flags(-compact_parasitics)]
 
   set cc_model 10
   if { [info exists keys(-cc_model)] } {
@@ -101,7 +103,8 @@ proc extract_parasitics { args } {
 
   rcx::extract $ext_model_file $corner_cnt $max_res \
       $coupling_threshold $signal_table $cc_model \
-      $depth $debug_net_id $lef_res $no_merge_via_res
+      $depth $debug_net_id $lef_res $no_merge_via_res \
+      $compact_parasitics
 }
 
 sta::define_cmd_args "write_spef" { 
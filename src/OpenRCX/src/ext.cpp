@@ -560,6 +560,10 @@ bool Ext::extract(ExtractOptions opts)
 
   uint tilingDegree = opts.tiling;
 
+  // The values are stored as 16 bit floats as they are extracted.
+  if (opts.compact_parasitics)
+    _ext->getBlock()->setCompactParasitics(true);
+
   odb::ZPtr<odb::ISdb> dbNetSdb = NULL;
   bool extSdb = false;
 
@@ -737,6 +741,27 @@ bool Ext::extract(ExtractOptions opts)
     }
   }
 
+  if (opts.compact_parasitics) {
+    odb::dbBlock* block = _ext->getBlock();
+    std::vector<odb::dbMemoryUsage> usage;
+    block->getMemoryUsage(usage);
+    uint64 count = 0;
+    uint64 used = 0;
+    for (odb::dbMemoryUsage& u : usage) {
+      if (u._name == "dbRSeg resistances" || u._name == "dbRSeg capacitances"
+          || u._name == "dbCCSeg capacitances") {
+        count += u._count;
+        used += u._used;
+      }
+    }
+    logger_->info(RCX,
+                  357,
+                  "{} RC values use {} bytes as {} bit floats.",
+                  count,
+                  used,
+                  block->hasCompactParasitics() ? 16 : 32);
+  }
+
   //    fprintf(stdout, "Finished extracting %s.\n",
   //    _ext->getBlock()->getName().c_str());
   logger_->info(
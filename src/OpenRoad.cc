@@ -35,7 +35,11 @@
 
 #include "openroad/OpenRoad.hh"
 
+#include <cstdio>
+#include <cstring>
 #include <iostream>
+#include <string>
+#include <unistd.h>
 
 #include "utility/MakeLogger.h"
 #include "utility/Logger.h"
@@ -107,6 +111,52 @@ using sta::evalTclInit;
 using sta::dbSta;
 using sta::Resizer;
 
+// Resident set size of this process in bytes, 0 if it is unknown.
+static size_t
+residentMemory()
+{
+  size_t size = 0, resident = 0;
+  FILE *stream = fopen("/proc/self/statm", "r");
+  if (stream) {
+    if (fscanf(stream, "%zu %zu", &size, &resident) != 2)
+      resident = 0;
+    fclose(stream);
+  }
+  return resident * sysconf(_SC_PAGESIZE);
+}
+
+// str as the contents of a JSON string.
+static std::string
+jsonEscape(const std::string &str)
+{
+  std::string escaped;
+  for (char c : str) {
+    switch (c) {
+    case '"':
+      escaped += "\\\"";
+      break;
+    case '\\':
+      escaped += "\\\\";
+      break;
+    case '\n':
+      escaped += "\\n";
+      break;
+    case '\t':
+      escaped += "\\t";
+      break;
+    default:
+      if (static_cast<unsigned char>(c) < 0x20) {
+        char code[7];
+        snprintf(code, sizeof(code), "\\u%04x", c);
+        escaped += code;
+      }
+      else
+        escaped += c;
+    }
+  }
+  return escaped;
+}
+
 OpenRoad::OpenRoad()
   : tcl_interp_(nullptr),
     logger_(nullptr),
@@ -126,7 +176,8 @@ OpenRoad::OpenRoad()
     antenna_checker_(nullptr),
     replace_(nullptr),
     pdnsim_(nullptr), 
-    partitionMgr_(nullptr) 
+    partitionMgr_(nullptr),
+    last_rss_(residentMemory())
 {
   db_ = dbDatabase::create();
 }
@@ -246,9 +297,12 @@ void
 OpenRoad::readLef(const char *filename,
 		  const char *lib_name,
 		  bool make_tech,
-		  bool make_library)
+		  bool make_library,
+		  const char *cache_dir)
 {
   odb::lefin lef_reader(db_, logger_, false);
+  if (cache_dir)
+    lef_reader.setCacheDir(cache_dir);
   dbLib *lib = nullptr;
   dbTech *tech = nullptr;
   if (make_tech && make_library) {
@@ -271,9 +325,11 @@ OpenRoad::readLef(const char *filename,
 void
 OpenRoad::readDef(const char *filename,
 		  bool order_wires,
-		  bool continue_on_errors)
+		  bool continue_on_errors,
+		  int num_threads)
 {
   odb::defin def_reader(db_,logger_);
+  def_reader.setNumThreads(num_threads);
   std::vector<odb::dbLib *> search_libs;
   for (odb::dbLib *lib : db_->getLibs())
     search_libs.push_back(lib);
@@ -316,7 +372,8 @@ stringToDefVersion(string version)
 
 void
 OpenRoad::writeDef(const char *filename,
-		   string version)
+		   string version,
+		   int num_threads)
 {
   odb::dbChip *chip = db_->getChip();
   if (chip) {
@@ -324,6 +381,7 @@ OpenRoad::writeDef(const char *filename,
     if (block) {
       odb::defout def_writer(logger_);
       def_writer.setVersion(stringToDefVersion(version));
+      def_writer.setNumThreads(num_threads);
       def_writer.writeBlock(block, filename);
     }
   }
@@ -343,14 +401,23 @@ OpenRoad::writeCdl(const char* filename, bool includeFillers)
 }
 
 void
-OpenRoad::readDb(const char *filename)
+OpenRoad::readDb(const char *filename,
+                 const char *profile)
 {
+  dbDatabase::LoadProfile load_profile = dbDatabase::LOAD_ALL;
+  if (strcmp(profile, "no_parasitics") == 0)
+    load_profile = dbDatabase::LOAD_NO_PARASITICS;
+  else if (strcmp(profile, "placement") == 0)
+    load_profile = dbDatabase::LOAD_PLACEMENT;
+  else if (strcmp(profile, "all") != 0)
+    logger_->error(utl::ORD, 20, "unknown load profile {}.", profile);
+
   FILE *stream = fopen(filename, "r");
   if (stream == nullptr) {
     return;
   }
 
-  db_->read(stream);
+  db_->read(stream, load_profile);
   fclose(stream);
 
   for (Observer* observer : observers_) {
@@ -359,15 +426,193 @@ OpenRoad::readDb(const char *filename)
 }
 
 void
-OpenRoad::writeDb(const char *filename)
+OpenRoad::readDbDelta(const char *filename)
+{
+  dbChip *chip = db_->getChip();
+  if (chip == nullptr || chip->getBlock() == nullptr) {
+    logger_->error(utl::ORD, 17, "no base database has been read.");
+  }
+  FILE *stream = fopen(filename, "r");
+  if (stream == nullptr) {
+    return;
+  }
+
+  dbBlock *block = chip->getBlock();
+  if (dbDatabase::ecoInProgress(block)) {
+    fclose(stream);
+    // The replayed edits would land in the active journal and a later
+    // delta would hold them twice.
+    logger_->error(utl::ORD, 22, "cannot read a delta while edits are recorded "
+                   "for write_db -delta; read the base database first.");
+  }
+  dbDatabase::readEco(block, stream);
+  fclose(stream);
+  dbDatabase::commitEco(block);
+
+  for (Observer* observer : observers_) {
+    observer->postReadDb(db_);
+  }
+}
+
+void
+OpenRoad::writeDb(const char *filename,
+                  bool compress,
+                  bool base)
+{
+  FILE *stream = fopen(filename, "w");
+  if (stream) {
+    if (compress)
+      db_->writeCompressed(stream);
+    else
+      db_->write(stream);
+    fclose(stream);
+
+    dbChip *chip = db_->getChip();
+    if (base && chip && chip->getBlock()) {
+      // Edits from here on are what writeDbDelta writes.
+      dbDatabase::beginEco(chip->getBlock());
+    }
+  }
+}
+
+void
+OpenRoad::writeDbDelta(const char *filename)
 {
+  dbChip *chip = db_->getChip();
+  dbBlock *block = chip ? chip->getBlock() : nullptr;
+  if (block == nullptr || !dbDatabase::ecoInProgress(block)) {
+    logger_->error(utl::ORD, 18, "no base database has been written with write_db -base.");
+  }
+  if (dbDatabase::ecoHasUnrecordedEdits(block)) {
+    logger_->error(utl::ORD, 23, "wires, special wires, pins or other objects "
+                   "a delta does not record changed since write_db -base; "
+                   "write a new base database instead.");
+  }
   FILE *stream = fopen(filename, "w");
   if (stream) {
-    db_->write(stream);
+    dbDatabase::writeEcoDelta(block, stream);
     fclose(stream);
   }
 }
 
+void
+OpenRoad::compactDb(const char *base_filename,
+                    const char *delta_filename,
+                    const char *new_base_filename,
+                    bool compress)
+{
+  FILE *base_stream = fopen(base_filename, "r");
+  if (base_stream == nullptr) {
+    logger_->error(utl::ORD, 24, "cannot open {}.", base_filename);
+  }
+  FILE *delta_stream = fopen(delta_filename, "r");
+  if (delta_stream == nullptr) {
+    fclose(base_stream);
+    logger_->error(utl::ORD, 26, "cannot open {}.", delta_filename);
+  }
+
+  dbDatabase *db = dbDatabase::create();
+  db->setLogger(logger_);
+  db->read(base_stream);
+  fclose(base_stream);
+
+  dbChip *chip = db->getChip();
+  if (chip == nullptr || chip->getBlock() == nullptr) {
+    fclose(delta_stream);
+    dbDatabase::destroy(db);
+    logger_->error(utl::ORD, 25, "{} has no block.", base_filename);
+  }
+  dbBlock *block = chip->getBlock();
+  dbDatabase::readEco(block, delta_stream);
+  fclose(delta_stream);
+  dbDatabase::commitEco(block);
+
+  FILE *stream = fopen(new_base_filename, "w");
+  if (stream) {
+    if (compress)
+      db->writeCompressed(stream);
+    else
+      db->write(stream);
+    fclose(stream);
+  }
+  dbDatabase::destroy(db);
+  if (stream == nullptr) {
+    logger_->error(utl::ORD, 27, "cannot open {}.", new_base_filename);
+  }
+}
+
+static void
+getBlocks(dbBlock *block,
+          std::vector<dbBlock*> &blocks)
+{
+  blocks.push_back(block);
+  for (dbBlock *child : block->getChildren())
+    getBlocks(child, blocks);
+}
+
+void
+OpenRoad::reportDbMemory(const char *json_filename)
+{
+  const double mb = 1024.0 * 1024.0;
+  std::vector<dbBlock*> blocks;
+  dbChip *chip = db_->getChip();
+  if (chip && chip->getBlock())
+    getBlocks(chip->getBlock(), blocks);
+
+  FILE *json = nullptr;
+  if (json_filename) {
+    json = fopen(json_filename, "w");
+    if (json == nullptr)
+      logger_->error(utl::ORD, 21, "cannot open {}.", json_filename);
+    fprintf(json, "{\n  \"blocks\" : [");
+  }
+
+  for (size_t b = 0; b < blocks.size(); b++) {
+    dbBlock *block = blocks[b];
+    std::vector<odb::dbMemoryUsage> usage;
+    block->getMemoryUsage(usage);
+
+    logger_->report("Block {}", block->getName());
+    logger_->report("{:<24} {:>12} {:>12} {:>12}",
+                    "Objects", "Count", "Used (MB)", "Wasted (MB)");
+    uint64_t used = 0, wasted = 0;
+    for (const odb::dbMemoryUsage &entry : usage) {
+      used += entry._used;
+      wasted += entry._wasted;
+      if (entry._used != 0 || entry._wasted != 0)
+        logger_->report("{:<24} {:>12} {:>12.2f} {:>12.2f}",
+                        entry._name, entry._count,
+                        entry._used / mb, entry._wasted / mb);
+    }
+    logger_->report("{:<24} {:>12} {:>12.2f} {:>12.2f}",
+                    "Total", "", used / mb, wasted / mb);
+
+    if (json) {
+      fprintf(json, "%s\n    {\n      \"name\" : \"%s\",\n      \"objects\" : [",
+              b ? "," : "", jsonEscape(block->getName()).c_str());
+      for (size_t i = 0; i < usage.size(); i++) {
+        const odb::dbMemoryUsage &entry = usage[i];
+        fprintf(json, "%s\n        {\"name\" : \"%s\", \"count\" : %llu, "
+                "\"used\" : %llu, \"wasted\" : %llu}",
+                i ? "," : "", jsonEscape(entry._name).c_str(), entry._count,
+                entry._used, entry._wasted);
+      }
+      fprintf(json, "\n      ]\n    }");
+    }
+  }
+
+  size_t rss = residentMemory();
+  double delta = (static_cast<double>(rss) - last_rss_) / mb;
+  logger_->report("Resident memory {:.1f} MB ({:+.1f} MB since the previous report)",
+                  rss / mb, delta);
+  if (json) {
+    fprintf(json, "\n  ],\n  \"rss\" : %zu,\n  \"rss_delta\" : %lld\n}\n",
+            rss, static_cast<long long>(rss) - static_cast<long long>(last_rss_));
+    fclose(json);
+  }
+  last_rss_ = rss;
+}
+
 void
 OpenRoad::readVerilog(const char *filename)
 {
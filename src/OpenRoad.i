@@ -246,25 +246,30 @@ void
 read_lef_cmd(const char *filename,
 	     const char *lib_name,
 	     bool make_tech,
-	     bool make_library)
+	     bool make_library,
+	     const char *cache_dir)
 {
   OpenRoad *ord = getOpenRoad();
-  ord->readLef(filename, lib_name, make_tech, make_library);
+  ord->readLef(filename, lib_name, make_tech, make_library, cache_dir);
 }
 
 void
-read_def_cmd(const char *filename, bool order_wires, bool continue_on_errors)
+read_def_cmd(const char *filename,
+	     bool order_wires,
+	     bool continue_on_errors,
+	     int num_threads)
 {
   OpenRoad *ord = getOpenRoad();
-  ord->readDef(filename, order_wires, continue_on_errors);
+  ord->readDef(filename, order_wires, continue_on_errors, num_threads);
 }
 
 void
 write_def_cmd(const char *filename,
-	      const char *version)
+	      const char *version,
+	      int num_threads)
 {
   OpenRoad *ord = getOpenRoad();
-  ord->writeDef(filename, version);
+  ord->writeDef(filename, version, num_threads);
 }
 
 
@@ -277,17 +282,51 @@ write_cdl_cmd(const char *filename,
 }
 
 void
-read_db_cmd(const char *filename)
+read_db_cmd(const char *filename,
+            const char *profile)
 {
   OpenRoad *ord = getOpenRoad();
-  ord->readDb(filename);
+  ord->readDb(filename, profile);
 }
 
 void
-write_db_cmd(const char *filename)
+report_db_memory_cmd(const char *json_filename)
 {
   OpenRoad *ord = getOpenRoad();
-  ord->writeDb(filename);
+  ord->reportDbMemory(json_filename[0] ? json_filename : nullptr);
+}
+
+void
+read_db_delta_cmd(const char *filename)
+{
+  OpenRoad *ord = getOpenRoad();
+  ord->readDbDelta(filename);
+}
+
+void
+write_db_cmd(const char *filename,
+             bool compress,
+             bool base)
+{
+  OpenRoad *ord = getOpenRoad();
+  ord->writeDb(filename, compress, base);
+}
+
+void
+write_db_delta_cmd(const char *filename)
+{
+  OpenRoad *ord = getOpenRoad();
+  ord->writeDbDelta(filename);
+}
+
+void
+compact_db_cmd(const char *base_filename,
+               const char *delta_filename,
+               const char *new_base_filename,
+               bool compress)
+{
+  OpenRoad *ord = getOpenRoad();
+  ord->compactDb(base_filename, delta_filename, new_base_filename, compress);
 }
 
 void
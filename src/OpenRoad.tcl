@@ -34,10 +34,10 @@
 ############################################################################
 
 # -library is the default
-sta::define_cmd_args "read_lef" {[-tech] [-library] filename}
+sta::define_cmd_args "read_lef" {[-tech] [-library] [-cache dir] filename}
 
 proc read_lef { args } {
-  sta::parse_key_args "read_lef" args keys {} flags {-tech -library}
+  sta::parse_key_args "read_lef" args keys {-cache} flags {-tech -library}
   sta::check_argc_eq1 "read_lef" $args
 
   set filename [file nativename [lindex $args 0]]
@@ -55,13 +55,19 @@ proc read_lef { args } {
     set make_tech [expr ![ord::db_has_tech]]
   }
   set lib_name [file rootname [file tail $filename]]
-  ord::read_lef_cmd $filename $lib_name $make_tech $make_lib
+  set cache_dir ""
+  if { [info exists keys(-cache)] } {
+    set cache_dir [file nativename $keys(-cache)]
+  }
+  ord::read_lef_cmd $filename $lib_name $make_tech $make_lib $cache_dir
 }
 
-sta::define_cmd_args "read_def" {[-order_wires] [-continue_on_errors] filename}
+sta::define_cmd_args "read_def" {[-order_wires] [-continue_on_errors]\
+                                   [-threads count] filename}
 
 proc read_def { args } {
-  sta::parse_key_args "read_def" args keys {} flags {-order_wires -continue_on_errors}
+  sta::parse_key_args "read_def" args keys {-threads} \
+    flags {-order_wires -continue_on_errors}
   sta::check_argc_eq1 "read_def" $args
   set filename [file nativename [lindex $args 0]]
   if { ![file exists $filename] } {
@@ -75,13 +81,19 @@ proc read_def { args } {
   }
   set order_wires [info exists flags(-order_wires)]
   set continue_on_errors [info exists flags(-continue_on_errors)]
-  ord::read_def_cmd $filename $order_wires $continue_on_errors
+  set threads 1
+  if { [info exists keys(-threads)] } {
+    set threads $keys(-threads)
+    sta::check_positive_integer "-threads" $threads
+  }
+  ord::read_def_cmd $filename $order_wires $continue_on_errors $threads
 }
 
-sta::define_cmd_args "write_def" {[-version version] filename}
+sta::define_cmd_args "write_def" {[-version version] [-threads count]\
+                                    filename}
 
 proc write_def { args } {
-  sta::parse_key_args "write_def" args keys {-version} flags {}
+  sta::parse_key_args "write_def" args keys {-version -threads} flags {}
 
   set version "5.8"
   if { [info exists keys(-version)] } {
@@ -95,9 +107,15 @@ proc write_def { args } {
     }
   }
 
+  set threads 1
+  if { [info exists keys(-threads)] } {
+    set threads $keys(-threads)
+    sta::check_positive_integer "-threads" $threads
+  }
+
   sta::check_argc_eq1 "write_def" $args
   set filename [file nativename [lindex $args 0]]
-  ord::write_def_cmd $filename $version
+  ord::write_def_cmd $filename $version $threads
 }
 
 
@@ -113,9 +131,11 @@ proc write_cdl { args } {
 }
 
 
-sta::define_cmd_args "read_db" {filename}
+sta::define_cmd_args "read_db" {[-profile all|no_parasitics|placement]\
+                                  [-delta] filename}
 
 proc read_db { args } {
+  sta::parse_key_args "read_db" args keys {-profile} flags {-delta}
   sta::check_argc_eq1 "read_db" $args
   set filename [file nativename [lindex $args 0]]
   if { ![file exists $filename] } {
@@ -124,15 +144,65 @@ proc read_db { args } {
   if { ![file readable $filename] } {
     utl::error ORD 8 "$filename is not readable."
   }
-  ord::read_db_cmd $filename
+  if { [info exists flags(-delta)] } {
+    ord::read_db_delta_cmd $filename
+  } else {
+    set profile "all"
+    if { [info exists keys(-profile)] } {
+      set profile $keys(-profile)
+    }
+    ord::read_db_cmd $filename $profile
+  }
 }
 
-sta::define_cmd_args "write_db" {filename}
+sta::define_cmd_args "write_db" {[-compress] [-base|-delta] filename}
 
 proc write_db { args } {
+  sta::parse_key_args "write_db" args keys {} flags {-compress -base -delta}
   sta::check_argc_eq1 "write_db" $args
   set filename [file nativename [lindex $args 0]]
-  ord::write_db_cmd $filename
+  if { [info exists flags(-delta)] } {
+    if { [info exists flags(-base)] || [info exists flags(-compress)] } {
+      utl::error ORD 19 "-delta cannot be used with -base or -compress."
+    }
+    ord::write_db_delta_cmd $filename
+  } else {
+    set compress [info exists flags(-compress)]
+    set base [info exists flags(-base)]
+    ord::write_db_cmd $filename $compress $base
+  }
+}
+
+sta::define_cmd_args "compact_db" {[-compress] base_db delta_db new_base_db}
+
+# Fold a delta into its base, writing the result as a new base.
+# The design loaded in the session is not changed.
+proc compact_db { args } {
+  sta::parse_key_args "compact_db" args keys {} flags {-compress}
+  sta::check_argc_eq3 "compact_db" $args
+  lassign $args base_db delta_db new_base_db
+  foreach filename [list $base_db $delta_db] {
+    if { ![file readable $filename] } {
+      utl::error ORD 28 "$filename is not readable."
+    }
+  }
+  ord::compact_db_cmd [file nativename $base_db] [file nativename $delta_db] \
+    [file nativename $new_base_db] [info exists flags(-compress)]
+}
+
+sta::define_cmd_args "report_db_memory" {[-json filename]}
+
+# Memory of the db tables per block and the process resident set size.
+# The change in resident size since the previous report_db_memory gives
+# the cost of the flow steps run in between.
+proc report_db_memory { args } {
+  sta::parse_key_args "report_db_memory" args keys {-json} flags {}
+  sta::check_argc_eq0 "report_db_memory" $args
+  set json_filename ""
+  if { [info exists keys(-json)] } {
+    set json_filename [file nativename $keys(-json)]
+  }
+  ord::report_db_memory_cmd $json_filename
 }
 
 # Units are from OpenSTA (ie Liberty file or set_cmd_units).
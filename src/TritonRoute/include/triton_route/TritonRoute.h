@@ -40,6 +40,9 @@ namespace fr {
 namespace odb {
   class dbDatabase;
 }
+namespace grt {
+  class GlobalRouter;
+}
 namespace utl {
   class Logger;
 }
@@ -48,7 +51,10 @@ namespace triton_route {
   public:
     TritonRoute();
     ~TritonRoute();
-    void init(Tcl_Interp* tcl_interp, odb::dbDatabase* db, utl::Logger* logger);
+    void init(Tcl_Interp* tcl_interp,
+              odb::dbDatabase* db,
+              utl::Logger* logger,
+              grt::GlobalRouter* grouter);
 
     fr::frDesign* getDesign() const {
       return design_.get();
@@ -75,9 +81,11 @@ namespace triton_route {
     std::unique_ptr<fr::frDebugSettings> debug_;
     odb::dbDatabase *db_;
     utl::Logger *logger_;
+    grt::GlobalRouter *grouter_;
     int num_drvs_;
     
     void init();
+    bool useGlobalRouteGuides() const;
     void prep();
     void gr();
     void ta();
@@ -51,7 +51,8 @@ void initTritonRoute(OpenRoad* openroad)
 {
   openroad->getTritonRoute()->init(openroad->tclInterp(),
                                    openroad->getDb(),
-                                   openroad->getLogger());
+                                   openroad->getLogger(),
+                                   openroad->getFastRoute());
 }
 
 }  // namespace ord
@@ -40,6 +40,8 @@
 #include "sta/StaMain.hh"
 #include "db/tech/frTechObject.h"
 #include "frDesign.h"
+#include "fastroute/GlobalRouter.h"
+#include "opendb/db.h"
 
 using namespace std;
 using namespace fr;
@@ -56,6 +58,7 @@ extern int Triton_route_Init(Tcl_Interp* interp);
 
 TritonRoute::TritonRoute()
   : debug_(std::make_unique<frDebugSettings>()),
+    grouter_(nullptr),
     num_drvs_(-1)
 {
 }
@@ -113,10 +116,14 @@ int TritonRoute::getNumDRVs() const
   return num_drvs_;
 }
 
-void TritonRoute::init(Tcl_Interp* tcl_interp, odb::dbDatabase* db, Logger* logger)
+void TritonRoute::init(Tcl_Interp* tcl_interp,
+                       odb::dbDatabase* db,
+                       Logger* logger,
+                       grt::GlobalRouter* grouter)
 {
   db_ = db;
   logger_ = logger;
+  grouter_ = grouter;
   design_ = std::make_unique<frDesign>(logger_);
   // Define swig TCL commands.
   Triton_route_Init(tcl_interp);
@@ -135,22 +142,34 @@ void TritonRoute::init() {
 
   io::Parser parser(getDesign(),logger_);
   parser.readDb(db_);
+  bool haveGuides = true;
   if (GUIDE_FILE != string("")) {
     parser.readGuide();
+  } else if (useGlobalRouteGuides()) {
+    parser.setGuides(grouter_, db_->getTech());
   } else {
     ENABLE_VIA_GEN = false;
+    haveGuides = false;
   }
   parser.postProcess();
   FlexPA pa(getDesign(), logger_);
   pa.setDebug(debug_.get(), db_);
   pa.main();
-  if (GUIDE_FILE != string("")) {
+  if (haveGuides) {
     parser.postProcessGuide();
   }
   // GR-related
   parser.initRPin();
 }
 
+// Without a guide file, the guides come from the routes of global_route,
+// handed over in memory, when there are any.
+bool TritonRoute::useGlobalRouteGuides() const
+{
+  return GUIDE_FILE == string("") && grouter_ != nullptr
+         && grouter_->haveRoutes();
+}
+
 void TritonRoute::prep() {
   FlexRP rp(getDesign(), getDesign()->getTech(), logger_);
   rp.main();
@@ -188,7 +207,7 @@ void TritonRoute::reportConstraints()
 
 int TritonRoute::main() {
   init();
-  if (GUIDE_FILE == string("")) {
+  if (GUIDE_FILE == string("") && !useGlobalRouteGuides()) {
     gr();
     io::Parser parser(getDesign(), logger_);
     GUIDE_FILE = OUTGUIDE_FILE;
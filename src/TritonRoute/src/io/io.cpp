@@ -36,6 +36,7 @@
 #include "io/io.h"
 #include "db/tech/frConstraint.h"
 
+#include "fastroute/GlobalRouter.h"
 #include "opendb/db.h"
 #include "opendb/dbWireCodec.h"
 #include "utility/Logger.h"
@@ -4244,26 +4245,8 @@ void io::Parser::readGuide() {
         }
         layerNum = tech->name2layer[vLine[4]]->getLayerNum();
 
-        if (layerNum < (BOTTOM_ROUTING_LAYER && layerNum != VIA_ACCESS_LAYERNUM)
-            || layerNum > TOP_ROUTING_LAYER)
-            logger->error(DRT,
-                        155,
-                        "guide in net {} uses layer {} ({})"
-                        " that is outside the allowed routing range "
-                        "[{} ({}), ({})]",
-                        netName,
-                        vLine[4],
-                        layerNum,
-                        tech->getLayer(BOTTOM_ROUTING_LAYER)->getName(),
-                        BOTTOM_ROUTING_LAYER,
-                        tech->getLayer(TOP_ROUTING_LAYER)->getName(),
-                        TOP_ROUTING_LAYER);
-
         box.set(stoi(vLine[0]), stoi(vLine[1]), stoi(vLine[2]), stoi(vLine[3]));
-        frRect rect;
-        rect.setBBox(box);
-        rect.setLayerNum(layerNum);
-        tmpGuides[net].push_back(rect);
+        addGuide(net, layerNum, box);
         ++numGuides;
         if (numGuides < 1000000) {
           if (numGuides % 100000 == 0) {
@@ -4293,6 +4276,81 @@ void io::Parser::readGuide() {
 
 }
 
+// Guides of the nets routed by global_route, without the guide file
+void io::Parser::setGuides(grt::GlobalRouter* grouter, odb::dbTech* dbTech) {
+  ProfileTask profile("IO:setGuides");
+
+  if (VERBOSE > 0) {
+    logger->info(DRT, 201, "Reading Guide from global routing");
+  }
+
+  vector<frLayerNum> layerNums = getGuideLayerNums(dbTech);
+  int numGuides = 0;
+  vector<grt::GGuide> guides;
+  for (auto& [dbNet, route]: grouter->getRoutes()) {
+    grouter->getGuides(dbNet, guides);
+    if (guides.empty()) {
+      continue;
+    }
+    addGuides(dbNet->getName(), guides, layerNums);
+    numGuides += guides.size();
+  }
+
+  if (VERBOSE > 0) {
+    logger->report("");
+    logger->report("#guides:     {}", numGuides);
+    logger->report("");
+  }
+}
+
+// layer number of each global routing layer level, -1 when there is none
+vector<frLayerNum> io::Parser::getGuideLayerNums(odb::dbTech* dbTech) {
+  vector<frLayerNum> layerNums(dbTech->getRoutingLayerCount() + 1, -1);
+  for (int level = 1; level <= dbTech->getRoutingLayerCount(); level++) {
+    auto layerName = dbTech->findRoutingLayer(level)->getName();
+    if (tech->name2layer.find(layerName) != tech->name2layer.end()) {
+      layerNums[level] = tech->name2layer[layerName]->getLayerNum();
+    }
+  }
+  return layerNums;
+}
+
+void io::Parser::addGuides(const string& netName,
+                           const vector<grt::GGuide>& guides,
+                           const vector<frLayerNum>& layerNums) {
+  if (design->topBlock_->name2net_.find(netName) == design->topBlock_->name2net_.end()) {
+    logger->error(DRT, 153, "cannot find net {}", netName);
+  }
+  frNet* net = design->topBlock_->name2net_[netName];
+  for (auto& guide: guides) {
+    if (guide.layer < 1 || guide.layer >= (int)layerNums.size()
+        || layerNums[guide.layer] == -1) {
+      logger->error(DRT, 154, "cannot find layer {}", guide.layer);
+    }
+    frBox box(guide.box.xMin(), guide.box.yMin(), guide.box.xMax(), guide.box.yMax());
+    addGuide(net, layerNums[guide.layer], box);
+  }
+}
+
+void io::Parser::addGuide(frNet* net, frLayerNum layerNum, const frBox& box) {
+  if ((layerNum < BOTTOM_ROUTING_LAYER && layerNum != VIA_ACCESS_LAYERNUM)
+      || layerNum > TOP_ROUTING_LAYER)
+      logger->error(DRT,
+                  155,
+                  "guide in net {} uses layer {}"
+                  " that is outside the allowed routing range "
+                  "[{}, {}]",
+                  net->getName(),
+                  layerNum,
+                  BOTTOM_ROUTING_LAYER,
+                  TOP_ROUTING_LAYER);
+
+  frRect rect;
+  rect.setBBox(box);
+  rect.setLayerNum(layerNum);
+  tmpGuides[net].push_back(rect);
+}
+
 void io::Writer::fillConnFigs_net(frNet* net, bool isTA) {
   //bool enableOutput = true;
   bool enableOutput = false;
@@ -44,6 +44,10 @@ namespace odb {
 namespace utl{
   class Logger;
 }
+namespace grt {
+  class GlobalRouter;
+  struct GGuide;
+}
 
 namespace fr {
   namespace io {
@@ -59,6 +63,7 @@ namespace fr {
       // others
       void readDb(odb::dbDatabase* db);
       void readGuide();
+      void setGuides(grt::GlobalRouter* grouter, odb::dbTech* dbTech);
       void postProcess();
       void postProcessGuide();
       void initDefaultVias();
@@ -98,6 +103,11 @@ namespace fr {
       void addCutLayer(odb::dbTechLayer*);
       void addMasterSliceLayer(odb::dbTechLayer*);
       void setNDRs(odb::dbDatabase* db);
+      std::vector<frLayerNum> getGuideLayerNums(odb::dbTech* dbTech);
+      void addGuides(const std::string& netName,
+                     const std::vector<grt::GGuide>& guides,
+                     const std::vector<frLayerNum>& layerNums);
+      void addGuide(frNet* net, frLayerNum layerNum, const frBox& box);
       
       frDesign*       design;
       frTechObject*   tech;
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2020, The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the University nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE REGENTS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifdef HAS_BOOST_UNIT_TEST_LIBRARY
+#define BOOST_TEST_DYN_LINK
+#endif
+#include <boost/test/unit_test.hpp>
+
+#include <cstdio>
+#include <fstream>
+
+#include "fastroute/GRoute.h"
+#include "fixture.h"
+#include "frDesign.h"
+#include "global.h"
+#include "io/io.h"
+#include "opendb/db.h"
+
+using namespace fr;
+
+// Exposes the guides the parser collects before postProcessGuide.
+class GuideParser : public io::Parser
+{
+ public:
+  using io::Parser::Parser;
+  using io::Parser::addGuides;
+  using io::Parser::getGuideLayerNums;
+  using io::Parser::tmpGuides;
+};
+
+// Fixture for guide tests: routing layers m1 and m2 in both the TR tech
+// and an OpenDB tech, the way readDb leaves them.
+struct GuideFixture : public Fixture
+{
+  GuideFixture() : db(odb::dbDatabase::create())
+  {
+    addLayer(design->getTech(), "v1", frLayerTypeEnum::CUT);
+    addLayer(design->getTech(), "m2", frLayerTypeEnum::ROUTING);
+
+    odb::dbTech* dbTech = odb::dbTech::create(db);
+    odb::dbTechLayer::create(dbTech, "m1", odb::dbTechLayerType::ROUTING);
+    odb::dbTechLayer::create(dbTech, "v1", odb::dbTechLayerType::CUT);
+    odb::dbTechLayer::create(dbTech, "m2", odb::dbTechLayerType::ROUTING);
+  }
+
+  ~GuideFixture() { odb::dbDatabase::destroy(db); }
+
+  odb::dbDatabase* db;
+};
+
+BOOST_FIXTURE_TEST_SUITE(guide, GuideFixture);
+
+// Guides handed over from global routing in memory match the same guides
+// read from a guide file.
+BOOST_AUTO_TEST_CASE(in_memory_matches_file)
+{
+  frNet* n1 = makeNet("n1");
+  frNet* n2 = makeNet("n2");
+
+  std::vector<grt::GGuide> guides1 = {{1, odb::Rect(0, 0, 1000, 200)},
+                                      {2, odb::Rect(800, 0, 1000, 2000)},
+                                      {1, odb::Rect(800, 1800, 3000, 2000)}};
+  std::vector<grt::GGuide> guides2 = {{2, odb::Rect(0, 0, 200, 600)}};
+
+  const std::string guideFile = "guideTest.guide";
+  {
+    std::ofstream out(guideFile);
+    out << "n1\n(\n"
+        << "0 0 1000 200 m1\n"
+        << "800 0 1000 2000 m2\n"
+        << "800 1800 3000 2000 m1\n"
+        << ")\n"
+        << "n2\n(\n"
+        << "0 0 200 600 m2\n"
+        << ")\n";
+  }
+
+  GuideParser fileParser(design.get(), logger.get());
+  GUIDE_FILE = guideFile;
+  fileParser.readGuide();
+  GUIDE_FILE = "";
+  std::remove(guideFile.c_str());
+
+  GuideParser memoryParser(design.get(), logger.get());
+  std::vector<frLayerNum> layerNums
+      = memoryParser.getGuideLayerNums(db->getTech());
+  BOOST_TEST(layerNums.size() == 3);
+  BOOST_TEST(layerNums[1] == 2);
+  BOOST_TEST(layerNums[2] == 4);
+  memoryParser.addGuides("n1", guides1, layerNums);
+  memoryParser.addGuides("n2", guides2, layerNums);
+
+  BOOST_TEST(memoryParser.tmpGuides.size() == fileParser.tmpGuides.size());
+  for (frNet* net : {n1, n2}) {
+    auto& fromFile = fileParser.tmpGuides[net];
+    auto& fromMemory = memoryParser.tmpGuides[net];
+    BOOST_TEST(fromMemory.size() == fromFile.size());
+    for (size_t i = 0; i < std::min(fromMemory.size(), fromFile.size());
+         i++) {
+      frBox fileBox, memoryBox;
+      fromFile[i].getBBox(fileBox);
+      fromMemory[i].getBBox(memoryBox);
+      BOOST_TEST(memoryBox == fileBox);
+      BOOST_TEST(fromMemory[i].getLayerNum() == fromFile[i].getLayerNum());
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -151,6 +151,7 @@ public:
   void inDbBTermPostConnect(dbBTerm *bterm) override;
   void inDbBTermPreDisconnect(dbBTerm *bterm) override;
   void inDbBTermDestroy(dbBTerm *bterm) override;
+  void inDbBlockRollback(dbBlock *block) override;
 
 private:
   dbSta *sta_;
@@ -575,6 +576,14 @@ dbStaCbk::inDbBTermDestroy(dbBTerm *bterm)
   sta_->deletePinBefore(network_->dbToSta(bterm));
 }
 
+void
+dbStaCbk::inDbBlockRollback(dbBlock *)
+{
+  // The instances, nets and pins the timing graph refers to may have been
+  // replaced, so the graph and the search are rebuilt from the block.
+  sta_->networkChanged();
+}
+
 ////////////////////////////////////////////////////////////////
 
 // Highlight path in the gui.
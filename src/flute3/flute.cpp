@@ -37,6 +37,8 @@
 #include <math.h>
 #include <string>
 #include <algorithm>
+#include <atomic>
+#include <mutex>
 #include "flute.h"
 
 namespace stt {
@@ -201,7 +203,10 @@ checkLUT(LUT_TYPE LUT1,
 
 // LUTs are initialized to this order at startup.
 static constexpr int lut_initial_d = 8;
-static int lut_valid_d = 0;
+static std::atomic<int> lut_valid_d(0);
+// Serializes growing the LUTs when routers on several threads need a
+// larger order at the same time.
+static std::mutex lut_mutex;
 
 // Use flute LUT file reader.
 #define LUT_FILE 1
@@ -295,6 +300,9 @@ initLUT(int to_d,
   const char *prt = prt_string.c_str();
 #endif
 
+  // Orders that are already valid may be in use by other threads, so
+  // their tables are decoded but not replaced.
+  const int valid_d = lut_valid_d;
   for (int d = 4; d <= to_d; d++) {
     int char_cnt;
     sscanf(pwv, "d=%d%n", &d, &char_cnt);
@@ -309,13 +317,14 @@ initLUT(int to_d,
 	int kk;
 	sscanf(pwv, "%d%n", &kk, &char_cnt);
 	pwv += char_cnt + 1;
-	numsoln[d][k] = numsoln[d][kk];
-	LUT[d][k] = LUT[d][kk];
+	if (d > valid_d) {
+	  numsoln[d][k] = numsoln[d][kk];
+	  LUT[d][k] = LUT[d][kk];
+	}
       } else {
 	pwv++;   // '\n'
-	numsoln[d][k] = ns;
 	struct csoln *p = new struct csoln[ns];
-	LUT[d][k] = p;
+	struct csoln *soln = p;
 	for (int i = 1; i <= ns; i++) {
 	  p->parent = charNum(*pwv++);
 
@@ -352,6 +361,11 @@ initLUT(int to_d,
 #endif
 	  p++;
 	}
+	if (d > valid_d) {
+	  numsoln[d][k] = ns;
+	  LUT[d][k] = soln;
+	} else
+	  delete [] soln;
       }
     }
   }
@@ -361,7 +375,9 @@ initLUT(int to_d,
 static void
 ensureLUT(int d) {
   if (d > lut_valid_d && d <= FLUTE_D) {
-    initLUT(FLUTE_D, LUT, numsoln);
+    std::lock_guard<std::mutex> lock(lut_mutex);
+    if (d > lut_valid_d)
+      initLUT(FLUTE_D, LUT, numsoln);
   }
 }
 
@@ -324,8 +324,8 @@ Selected LayoutViewer::selectAtPoint(odb::Point pt_dbu)
 
   // Just return the first one
 
-  if (insts.begin() != insts.end()) {
-    return Selected(std::get<2>(*insts.begin()));
+  if (!insts.empty()) {
+    return Selected(insts[0]);
   }
   return Selected();
 }
@@ -683,16 +683,10 @@ void LayoutViewer::drawBlock(QPainter* painter,
   Rect bbox = getBounds(block);
   painter->drawRect(bbox.xMin(), bbox.yMin(), bbox.dx(), bbox.dy());
 
-  auto inst_range = search_.searchInsts(
-      bounds.xMin(), bounds.yMin(), bounds.xMax(), bounds.yMax(), 1 * pixel);
-
-  // Cache the search results as we will iterate over the instances
+  // The search results are kept as we will iterate over the instances
   // for each layer.
-  std::vector<dbInst*> insts;
-  insts.reserve(10000);
-  for (auto& [box, poly, inst] : inst_range) {
-    insts.push_back(inst);
-  }
+  std::vector<dbInst*> insts = search_.searchInsts(
+      bounds.xMin(), bounds.yMin(), bounds.xMax(), bounds.yMax(), 1 * pixel);
 
   // Draw the instances bounds
   for (auto inst : insts) {
@@ -828,20 +822,18 @@ void LayoutViewer::drawBlock(QPainter* painter,
       Qt::BrushStyle brush_pattern = getPattern(layer);
       painter->setBrush(QBrush(color, brush_pattern));
       painter->setPen(QPen(color, 0));
-      auto iter = search_.searchFills(layer,
+      auto fills = search_.searchFills(layer,
                                        bounds.xMin(),
                                        bounds.yMin(),
                                        bounds.xMax(),
                                        bounds.yMax(),
                                        5 * pixel);
 
-      for (auto& i : iter) {
-        const auto& ll = std::get<0>(i).min_corner();
-        const auto& ur = std::get<0>(i).max_corner();
-        int w = ur.x() - ll.x();
-        int h = ur.y() - ll.y();
-        painter->drawRect(
-            QRect(QPoint(ll.x(), ll.y()), QPoint(ur.x(), ur.y())));
+      for (dbFill* fill : fills) {
+        Rect rect;
+        fill->getRect(rect);
+        painter->drawRect(QRect(QPoint(rect.xMin(), rect.yMin()),
+                                QPoint(rect.xMax(), rect.yMax())));
       }
     }
 
@@ -1183,21 +1175,28 @@ void LayoutScroll::zoomOut()
 
 void LayoutViewer::inDbPostMoveInst(dbInst*)
 {
-  // This is not very smart - we just clear all the search structure
-  // rather than try to surgically update it.  We need a pre & post
-  // callback from OpenDB to do this right.
-  // TODO:: Update this now with the new callbacks from OpenDB
-  if (search_init_) {
-    search_.clear();
-    search_init_ = false;
-  }
+  // The block's spatial index already has the instance at its new place
+  // and moves don't change the wire shapes, so only a repaint is needed.
+  update();
+}
+
+void LayoutViewer::inDbPostMoveInsts(const std::vector<dbInst*>&)
+{
+  // A batch of moves repaints once.
   update();
 }
 
 void LayoutViewer::inDbFillCreate(dbFill* fill)
 {
-  // This is not very smart - we just clear all the search structure
-  // rather than try to surgically update it.
+  // The block's spatial index already has the new fill.
+  update();
+}
+
+void LayoutViewer::inDbBlockRollback(dbBlock*)
+{
+  // The selected and highlighted objects may no longer exist.
+  Gui::get()->clearSelections();
+  Gui::get()->clearHighlights(-1);
   if (search_init_) {
     search_.clear();
     search_init_ = false;
@@ -112,7 +112,10 @@ class LayoutViewer : public QWidget, public odb::dbBlockCallBackObj
 
   // From dbBlockCallBackObj
   virtual void inDbPostMoveInst(odb::dbInst* inst) override;
+  virtual void inDbPostMoveInsts(
+      const std::vector<odb::dbInst*>& insts) override;
   virtual void inDbFillCreate(odb::dbFill* fill) override;
+  virtual void inDbBlockRollback(odb::dbBlock* block) override;
 
  signals:
   void location(qreal x, qreal y);
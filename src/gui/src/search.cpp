@@ -32,30 +32,28 @@
 
 #include "search.h"
 
+#include <algorithm>
 #include <tuple>
 #include <utility>
 
 #include "dbShape.h"
+#include "dbSpatialIndex.h"
 
 namespace gui {
 
 // Build the rtree's for the block
 void Search::init(odb::dbBlock* block)
 {
+  block_ = block;
+
+  // The wires are decoded one at a time here. If the block has a
+  // dbWireShapeCache (opt-in, see dbBlock::getWireShapeCache) the decoded
+  // shapes are read from it instead.
   for (odb::dbNet* net : block->getNets()) {
     addNet(net);
     addSNet(net);
   }
 
-  for (odb::dbInst* inst : block->getInsts()) {
-    odb::dbPlacementStatus status = inst->getPlacementStatus();
-    if (status == odb::dbPlacementStatus::NONE
-        || status == odb::dbPlacementStatus::UNPLACED) {
-      continue;
-    }
-    addInst(inst);
-  }
-
   for (odb::dbBTerm* term : block->getBTerms()) {
     for (odb::dbBPin* pin : term->getBPins()) {
       odb::dbPlacementStatus status = pin->getPlacementStatus();
@@ -76,15 +74,6 @@ void Search::init(odb::dbBlock* block)
       }
     }
   }
-
-  for (odb::dbFill* fill : block->getFills()) {
-    odb::Rect rect;
-    fill->getRect(rect);
-    Box box(Point(rect.xMin(), rect.yMin()), Point(rect.xMax(), rect.yMax()));
-    Polygon poly;
-    bg::convert(box, poly);
-    fills_[fill->getTechLayer()].insert(std::make_tuple(box, poly, fill));
-  }
 }
 
 void Search::addVia(odb::dbNet* net, odb::dbShape* shape, int x, int y)
@@ -162,20 +151,8 @@ void Search::addNet(odb::dbNet* net)
   }
 }
 
-void Search::addInst(odb::dbInst* inst)
-{
-  odb::dbBox* bbox = inst->getBBox();
-  Point ll(bbox->xMin(), bbox->yMin());
-  Point ur(bbox->xMax(), bbox->yMax());
-  Box box(ll, ur);
-  Polygon poly;
-  bg::convert(box, poly);
-  insts_.insert(std::make_tuple(box, poly, inst));
-}
-
 void Search::clear()
 {
-  insts_.clear();
   shapes_.clear();
 }
 
@@ -198,24 +175,6 @@ class Search::MinSizePredicate
   int min_size_;
 };
 
-template <typename T>
-class Search::MinHeightPredicate
-{
- public:
-  MinHeightPredicate(int min_height) : min_height_(min_height) {}
-  bool operator()(const std::tuple<Box, Polygon, T>& o) const
-  {
-    Box box = std::get<0>(o);
-    const Point& ll = box.min_corner();
-    const Point& ur = box.max_corner();
-    int h = ur.y() - ll.y();
-    return h >= min_height_;
-  }
-
- private:
-  int min_height_;
-};
-
 Search::ShapeRange Search::searchShapes(odb::dbTechLayer* layer,
                                         int x_lo,
                                         int y_lo,
@@ -242,47 +201,50 @@ Search::ShapeRange Search::searchShapes(odb::dbTechLayer* layer,
   return ShapeRange(rtree.qbegin(bgi::intersects(query)), rtree.qend());
 }
 
-Search::FillRange Search::searchFills(odb::dbTechLayer* layer,
-                                      int x_lo,
-                                      int y_lo,
-                                      int x_hi,
-                                      int y_hi,
-                                      int min_size)
+std::vector<odb::dbFill*> Search::searchFills(odb::dbTechLayer* layer,
+                                              int x_lo,
+                                              int y_lo,
+                                              int x_hi,
+                                              int y_hi,
+                                              int min_size)
 {
-  auto it = fills_.find(layer);
-  if (it == fills_.end()) {
-    return FillRange();
-  }
-
-  auto& rtree = it->second;
-  Box query(Point(x_lo, y_lo), Point(x_hi, y_hi));
+  std::vector<odb::dbFill*> fills;
+  block_->getSpatialIndex()->searchFills(
+      layer, odb::Rect(x_lo, y_lo, x_hi, y_hi), fills);
   if (min_size > 0) {
-    return FillRange(
-        rtree.qbegin(
-            bgi::intersects(query)
-            && bgi::satisfies(MinSizePredicate<odb::dbFill*>(min_size))),
-        rtree.qend());
+    auto small = [min_size](odb::dbFill* fill) {
+      odb::Rect rect;
+      fill->getRect(rect);
+      return std::max(rect.dx(), rect.dy()) < (uint) min_size;
+    };
+    fills.erase(std::remove_if(fills.begin(), fills.end(), small),
+                fills.end());
   }
 
-  return FillRange(rtree.qbegin(bgi::intersects(query)), rtree.qend());
+  return fills;
 }
 
-Search::InstRange Search::searchInsts(int x_lo,
-                                      int y_lo,
-                                      int x_hi,
-                                      int y_hi,
-                                      int min_height)
+std::vector<odb::dbInst*> Search::searchInsts(int x_lo,
+                                              int y_lo,
+                                              int x_hi,
+                                              int y_hi,
+                                              int min_height)
 {
-  Box query(Point(x_lo, y_lo), Point(x_hi, y_hi));
-  if (min_height > 0) {
-    return InstRange(
-        insts_.qbegin(
-            bgi::intersects(query)
-            && bgi::satisfies(MinHeightPredicate<odb::dbInst*>(min_height))),
-        insts_.qend());
-  }
+  std::vector<odb::dbInst*> insts;
+  block_->getSpatialIndex()->searchInsts(odb::Rect(x_lo, y_lo, x_hi, y_hi),
+                                         insts);
+  auto skip = [min_height](odb::dbInst* inst) {
+    odb::dbPlacementStatus status = inst->getPlacementStatus();
+    if (status == odb::dbPlacementStatus::NONE
+        || status == odb::dbPlacementStatus::UNPLACED) {
+      return true;
+    }
+    odb::dbBox* bbox = inst->getBBox();
+    return bbox->yMax() - bbox->yMin() < min_height;
+  };
+  insts.erase(std::remove_if(insts.begin(), insts.end(), skip), insts.end());
 
-  return InstRange(insts_.qbegin(bgi::intersects(query)), insts_.qend());
+  return insts;
 }
 
 }  // namespace gui
@@ -43,11 +43,11 @@ namespace bg = boost::geometry;
 namespace bgi = boost::geometry::index;
 
 // This is a geometric search structure.  It wraps up Boost's
-// rtree.  OpenDB also has some code for this purpose but I
-// find it confusing so just made a simpler solution for now.
+// rtree for the wire shapes and pins, which are drawn as polygons.
+// Instances and fills are found with the block's dbSpatialIndex.
 //
-// Currently this class is static once built and doesn't follow
-// db changes.  TODO: this should be into an observer of OpenDB.
+// The shapes are static once built and don't follow db changes;
+// the instances and fills do.
 class Search
 {
   using Point = bg::model::d2::point_xy<int, bg::cs::cartesian>;
@@ -63,9 +63,6 @@ class Search
   template <typename T>
   class MinSizePredicate;
 
-  template <typename T>
-  class MinHeightPredicate;
-
  public:
   // This is an iterator range for return values
   template <typename T>
@@ -86,9 +83,7 @@ class Search
     Iterator begin_;
     Iterator end_;
   };
-  using InstRange = Range<odb::dbInst*>;
   using ShapeRange = Range<odb::dbNet*>;
-  using FillRange = Range<odb::dbFill*>;
 
   // Build the structure for the given block.
   void init(odb::dbBlock* block);
@@ -104,19 +99,20 @@ class Search
 
   // Find all fills in the given bounds on the given layer which
   // are at least min_size in either dimension.
-  FillRange searchFills(odb::dbTechLayer* layer,
-                        int x_lo,
-                        int y_lo,
-                        int x_hi,
-                        int y_hi,
-                        int min_size = 0);
-
-  // Find all instances in the given bounds with height of at least min_height
-  InstRange searchInsts(int x_lo,
-                        int y_lo,
-                        int x_hi,
-                        int y_hi,
-                        int min_height = 0);
+  std::vector<odb::dbFill*> searchFills(odb::dbTechLayer* layer,
+                                        int x_lo,
+                                        int y_lo,
+                                        int x_hi,
+                                        int y_hi,
+                                        int min_size = 0);
+
+  // Find all placed instances in the given bounds with height of at
+  // least min_height
+  std::vector<odb::dbInst*> searchInsts(int x_lo,
+                                        int y_lo,
+                                        int x_hi,
+                                        int y_hi,
+                                        int min_height = 0);
 
   void clear();
 
@@ -124,12 +120,13 @@ class Search
   void addSNet(odb::dbNet* net);
   void addNet(odb::dbNet* net);
   void addVia(odb::dbNet* net, odb::dbShape* shape, int x, int y);
-  void addInst(odb::dbInst* inst);
+
+  // The block's spatial index is rebuilt after a rollback, so it is
+  // looked up for each query.
+  odb::dbBlock* block_ = nullptr;
 
   // The net is used for filter shapes by net type
   std::map<odb::dbTechLayer*, Rtree<odb::dbNet*>> shapes_;
-  std::map<odb::dbTechLayer*, Rtree<odb::dbFill*>> fills_;
-  Rtree<odb::dbInst*> insts_;
 };
 
 }  // namespace gui
@@ -201,20 +201,19 @@ Opendp::detailedPlacement(int max_displacment)
 void
 Opendp::updateDbInstLocations()
 {
+  vector<dbInst *> insts;
+  vector<int> xs, ys;
+  vector<dbOrientType> orients;
   for (Cell &cell : cells_) {
     if (!isFixed(&cell) && isStdCell(&cell)) {
-      dbInst *db_inst_ = cell.db_inst_;
-      // Only move the instance if necessary to avoid triggering callbacks.
-      if (db_inst_->getOrient() != cell.orient_)
-        db_inst_->setOrient(cell.orient_);
-      int x = core_.xMin() + cell.x_;
-      int y = core_.yMin() + cell.y_;
-      int inst_x, inst_y;
-      db_inst_->getLocation(inst_x, inst_y);
-      if (x != inst_x || y != inst_y)
-        db_inst_->setLocation(x, y);
+      insts.push_back(cell.db_inst_);
+      xs.push_back(core_.xMin() + cell.x_);
+      ys.push_back(core_.yMin() + cell.y_);
+      orients.push_back(cell.orient_);
     }
   }
+  // Unmoved instances are skipped and observers see the moves as one batch.
+  block_->setInstPlacement(insts, xs, ys, orients);
 }
 
 void
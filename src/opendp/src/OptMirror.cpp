@@ -48,6 +48,7 @@ using utl::DPL;
 using std::sort;
 using std::unordered_set;
 
+using odb::dbCallBackBatchScope;
 using odb::dbITerm;
 using odb::dbOrientType;
 
@@ -145,6 +146,8 @@ int
 Opendp::mirrorCandidates(vector<dbInst*> &mirror_candidates)
 {
   int mirror_count = 0;
+  // Callbacks see each instance move once, after any undo.
+  dbCallBackBatchScope batch(block_);
   for (dbInst *inst : mirror_candidates) {
     // Use hpwl of all nets connected to the instance terms
     // before/after to determine incremental change to total hpwl.
@@ -1785,6 +1785,8 @@ NesterovBase::updateDensityForceBin() {
 
 void
 NesterovBase::updateDbGCells() {
+  odb::dbBlock* block = pb_->db()->getChip()->getBlock();
+  odb::dbCallBackBatchScope batch(block);
   for(auto& gCell : gCells()) {
     if( gCell->isInstance() ) {
       odb::dbInst* inst = gCell->instance()->dbInst();
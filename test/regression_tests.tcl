@@ -3,6 +3,10 @@ record_tests {
   set_layer_rc1
 }
 
+record_pass_fail_tests {
+  report_db_memory1
+}
+
 define_test_group "non_flow" {"error1"}
 
 # Flow tests only check the return code and do not compare output logs.
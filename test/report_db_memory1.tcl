@@ -0,0 +1,25 @@
+# report_db_memory -json with a block name that needs escaping
+source "helpers.tcl"
+read_lef Nangate45/Nangate45.lef
+read_def reg3.def
+
+set block [ord::get_db_block]
+odb::dbBlock_create $block "child \"1\"\\x"
+
+set json_file [make_result_file report_db_memory1.json]
+report_db_memory -json $json_file
+
+set stream [open $json_file r]
+set json [read $stream]
+close $stream
+
+foreach expected [list {"name" : "reg1"} \
+                    {"name" : "child \"1\"\\x"} \
+                    {"name" : "dbInst"} \
+                    {"rss" : }] {
+  if { [string first $expected $json] == -1 } {
+    puts "fail: $expected not found in $json_file"
+    exit 1
+  }
+}
+puts "pass"